@@ -7,14 +7,47 @@
  */
 
 #include <Core/Assertion.h>
+#include <Core/Logging/Logger.h>
+#include <Core/Platform/PlatformCore.h>
+
+#include <cstdio>
 
 namespace CaveGame
 {
 
+// Set while the thread reports a failed assertion, so an assertion that fails inside the logger can't recurse.
+static thread_local bool t_is_reporting_assertion = false;
+
 void report_assertion_failed(const char* expression, const char* filename, const char* function, u32 line)
 {
-    // NOTE: Currently, there is nowhere to report the failed assertion information, thus
-    // no operation is actually performed in this function.
+    // NOTE: The first captured address is the return address into this function, so it is skipped. The reported stack
+    // starts with the function that contains the failed assertion.
+    constexpr u32 maximum_stack_depth = 32;
+    u64 return_addresses[maximum_stack_depth + 1];
+    const u32 captured_address_count = PlatformCore::capture_stack_trace(return_addresses, maximum_stack_depth + 1);
+    const u32 stack_depth = (captured_address_count > 0) ? (captured_address_count - 1) : 0;
+
+    // The return addresses point to the instruction after the call, which might belong to the next function.
+    char symbol_names[maximum_stack_depth][256];
+    for (u32 frame_index = 0; frame_index < stack_depth; ++frame_index)
+        PlatformCore::get_symbol_name(return_addresses[frame_index + 1] - 1, symbol_names[frame_index], sizeof(symbol_names[frame_index]));
+
+    // NOTE: Fatal records are flushed synchronously, so the message is written before the debug break is triggered.
+    if (Logger::is_initialized() && !t_is_reporting_assertion)
+    {
+        t_is_reporting_assertion = true;
+        CAVE_LOG_FATAL("Assertion '{}' failed in '{}' ({}:{}).", expression, function, filename, line);
+        for (u32 frame_index = 0; frame_index < stack_depth; ++frame_index)
+            CAVE_LOG_FATAL("    #{} {}", frame_index, symbol_names[frame_index]);
+        t_is_reporting_assertion = false;
+        return;
+    }
+
+    // The logger isn't running (yet or anymore), so the message is written directly to the console.
+    fprintf(stderr, "Assertion '%s' failed in '%s' (%s:%u).\n", expression, function, filename, line);
+    for (u32 frame_index = 0; frame_index < stack_depth; ++frame_index)
+        fprintf(stderr, "    #%u %s\n", frame_index, symbol_names[frame_index]);
+    fflush(stderr);
 }
 
 } // namespace CaveGame
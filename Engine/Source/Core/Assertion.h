@@ -10,83 +10,108 @@
 
 #include <Core/CoreTypes.h>
 
+//
+// The assertion level controls which assertions are evaluated:
+//   - CAVE_ASSERT_LEVEL_NONE    only CAVE_VERIFY is evaluated.
+//   - CAVE_ASSERT_LEVEL_DEFAULT CAVE_ASSERT is evaluated as well.
+//   - CAVE_ASSERT_LEVEL_DEBUG   CAVE_DEBUG_ASSERT is evaluated as well.
 //
 // The default assertion configurations states that:
 //   - CAVE_ASSERT       is enabled in Debug and Development builds.
 //   - CAVE_DEBUG_ASSERT is only enabled in Debug builds.
 //   - CAVE_VERIFY       is enabled in any build.
+// The build system disables the container and math assertions in Development builds (see below).
 //
 
-#if CAVE_CONFIGURATION_DEBUG
-    #define CAVE_ENABLE_ASSERTS       1
-    #define CAVE_ENABLE_DEBUG_ASSERTS 1
-    #define CAVE_ENABLE_VERIFIES      1
-#endif // CAVE_CONFIGURATION_DEBUG
+#define CAVE_ASSERT_LEVEL_NONE    0
+#define CAVE_ASSERT_LEVEL_DEFAULT 1
+#define CAVE_ASSERT_LEVEL_DEBUG   2
+
+#ifndef CAVE_ASSERT_LEVEL
+    #if CAVE_CONFIGURATION_DEBUG
+        #define CAVE_ASSERT_LEVEL CAVE_ASSERT_LEVEL_DEBUG
+    #elif CAVE_CONFIGURATION_DEVELOPMENT
+        #define CAVE_ASSERT_LEVEL CAVE_ASSERT_LEVEL_DEFAULT
+    #else
+        #define CAVE_ASSERT_LEVEL CAVE_ASSERT_LEVEL_NONE
+    #endif // CAVE_CONFIGURATION_DEBUG
+#endif // CAVE_ASSERT_LEVEL
 
-#if CAVE_CONFIGURATION_DEVELOPMENT
-    #define CAVE_ENABLE_ASSERTS       0
-    #define CAVE_ENABLE_DEBUG_ASSERTS 1
-    #define CAVE_ENABLE_VERIFIES      1
-#endif // CAVE_CONFIGURATION_DEBUG
+#define CAVE_ENABLE_ASSERTS       (CAVE_ASSERT_LEVEL >= CAVE_ASSERT_LEVEL_DEFAULT)
+#define CAVE_ENABLE_DEBUG_ASSERTS (CAVE_ASSERT_LEVEL >= CAVE_ASSERT_LEVEL_DEBUG)
+#define CAVE_ENABLE_VERIFIES      1
 
-#if CAVE_CONFIGURATION_SHIPPING
-    #define CAVE_ENABLE_ASSERTS       0
-    #define CAVE_ENABLE_DEBUG_ASSERTS 0
-    #define CAVE_ENABLE_VERIFIES      1
-#endif // CAVE_CONFIGURATION_DEBUG
+//
+// The assertions in the hot paths of the containers (element accessors, smart pointer dereferences) and of the math
+// library use their own module level, which defaults to the global level. The build system can lower the level of a
+// module (for example, to profile a Development build without the bound checks of the containers) while keeping the
+// assertions of the rest of the engine.
+//
+
+#ifndef CAVE_ASSERT_LEVEL_CONTAINERS
+    #define CAVE_ASSERT_LEVEL_CONTAINERS CAVE_ASSERT_LEVEL
+#endif // CAVE_ASSERT_LEVEL_CONTAINERS
+
+#ifndef CAVE_ASSERT_LEVEL_MATH
+    #define CAVE_ASSERT_LEVEL_MATH CAVE_ASSERT_LEVEL
+#endif // CAVE_ASSERT_LEVEL_MATH
 
 namespace CaveGame
 {
 
 //
-// Reports that an assertion has been triggerd, by writting (if possible) the relevant information
+// Reports that an assertion has been triggerd, by writting (if possible) the relevant information and the call stack
 // to the console and the output log file.
 //
-void report_assertion_failed(const char* expression, const char* filename, const char* function, u32 line);
+// NOTE: The function is never inlined and is marked as cold, so an assertion only costs a compare and a (predicted)
+// branch at the call site, while the reporting code is moved away from the hot code.
+//
+COLD NOINLINE void report_assertion_failed(const char* expression, const char* filename, const char* function, u32 line);
 
 } // namespace CaveGame
 
+//
+// If the provided expression evaluates to false, `report_assertion_failed` is invoked and a debug break is triggered.
+// The expression string is passed separately, so it is stringified before any macro it contains is expanded.
+//
+#define CAVE_ASSERT_IMPLEMENTATION(expression, expression_string)                                  \
+    if (!(expression)) UNLIKELY                                                                    \
+    {                                                                                              \
+        ::CaveGame::report_assertion_failed(expression_string, __FILE__, CAVE_FUNCTION, __LINE__); \
+        CAVE_DEBUGBREAK;                                                                           \
+    }
+
 #if CAVE_ENABLE_ASSERTS
-    //
-    // If the provided expression evaluates to false, `report_assertion_failed` is invoked and a debug break is triggered.
     // The expression is only evaluated if `CAVE_ENABLE_ASSERTS` is set to 1.
-    //
-    #define CAVE_ASSERT(expression)                                                              \
-        if (!(expression))                                                                       \
-        {                                                                                        \
-            ::CaveGame::report_assertion_failed(#expression, __FILE__, CAVE_FUNCTION, __LINE__); \
-            CAVE_DEBUGBREAK;                                                                     \
-        }
+    #define CAVE_ASSERT(expression) CAVE_ASSERT_IMPLEMENTATION(expression, #expression)
 #else
     #define CAVE_ASSERT(...)
 #endif // CAVE_ENABLE_ASSERTS
 
 #if CAVE_ENABLE_DEBUG_ASSERTS
-    //
-    // If the provided expression evaluates to false, `report_assertion_failed` is invoked and a debug break is triggered.
     // The expression is only evaluated if `CAVE_ENABLE_DEBUG_ASSERTS` is set to 1.
-    //
-    #define CAVE_DEBUG_ASSERT(expression)                                                        \
-        if (!(expression))                                                                       \
-        {                                                                                        \
-            ::CaveGame::report_assertion_failed(#expression, __FILE__, CAVE_FUNCTION, __LINE__); \
-            CAVE_DEBUGBREAK;                                                                     \
-        }
+    #define CAVE_DEBUG_ASSERT(expression) CAVE_ASSERT_IMPLEMENTATION(expression, #expression)
 #else
-    #define CAVE_ENABLE_DEBUG_ASSERTS(...)
+    #define CAVE_DEBUG_ASSERT(...)
 #endif // CAVE_ENABLE_DEBUG_ASSERTS
 
 #if CAVE_ENABLE_VERIFIES
-    //
-    // If the provided expression evaluates to false, `report_assertion_failed` is invoked and a debug break is triggered.
     // The expression is only evaluated if `CAVE_ENABLE_VERIFIES` is set to 1.
-    //
-    #define CAVE_VERIFY(expression)                                                              \
-        if (!(expression))                                                                       \
-        {                                                                                        \
-            ::CaveGame::report_assertion_failed(#expression, __FILE__, CAVE_FUNCTION, __LINE__); \
-            CAVE_DEBUGBREAK;                                                                     \
-        }
+    #define CAVE_VERIFY(expression) CAVE_ASSERT_IMPLEMENTATION(expression, #expression)
 #else
     #define CAVE_VERIFY(...)
 #endif // CAVE_ENABLE_VERIFIES
+
+#if CAVE_ASSERT_LEVEL_CONTAINERS >= CAVE_ASSERT_LEVEL_DEFAULT
+    // Same as `CAVE_ASSERT`, but controlled by the assertion level of the containers module.
+    #define CAVE_CONTAINERS_ASSERT(expression) CAVE_ASSERT_IMPLEMENTATION(expression, #expression)
+#else
+    #define CAVE_CONTAINERS_ASSERT(...)
+#endif // CAVE_ASSERT_LEVEL_CONTAINERS >= CAVE_ASSERT_LEVEL_DEFAULT
+
+#if CAVE_ASSERT_LEVEL_MATH >= CAVE_ASSERT_LEVEL_DEFAULT
+    // Same as `CAVE_ASSERT`, but controlled by the assertion level of the math module.
+    #define CAVE_MATH_ASSERT(expression) CAVE_ASSERT_IMPLEMENTATION(expression, #expression)
+#else
+    #define CAVE_MATH_ASSERT(...)
+#endif // CAVE_ASSERT_LEVEL_MATH >= CAVE_ASSERT_LEVEL_DEFAULT
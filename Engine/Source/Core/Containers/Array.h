@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Container that stores a fixed number of elements inline.
+// This is our equivalent implementation of the `std::array` container. It is an aggregate and fully
+// usable in constant expressions, which makes it the storage of choice for compile-time lookup tables.
+//
+template<typename T, usize Count>
+struct Array
+{
+    static_assert(Count > 0, "Zero-sized arrays are not supported!");
+
+    using Iterator = T*;
+    using ConstIterator = const T*;
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr T* elements() { return m_elements; }
+    NODISCARD ALWAYS_INLINE constexpr const T* elements() const { return m_elements; }
+
+    NODISCARD ALWAYS_INLINE static constexpr usize count() { return Count; }
+
+public:
+    //
+    // Returns the element stored at the given index in the internal array.
+    // If the index is out of bounds, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE constexpr T& at(usize index)
+    {
+        CAVE_CONTAINERS_ASSERT(index < Count);
+        return m_elements[index];
+    }
+
+    //
+    // Returns the element stored at the given index in the internal array.
+    // If the index is out of bounds, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE constexpr const T& at(usize index) const
+    {
+        CAVE_CONTAINERS_ASSERT(index < Count);
+        return m_elements[index];
+    }
+
+    // Direct wrappers around the `Array::at()` API.
+    NODISCARD ALWAYS_INLINE constexpr T& operator[](usize index) { return at(index); }
+    NODISCARD ALWAYS_INLINE constexpr const T& operator[](usize index) const { return at(index); }
+
+    //
+    // Returns the element stored at the given index, without checking the bounds in any build configuration.
+    // Intended for the hot loops whose indices are known to be in bounds (for example, when iterating up to `count()`).
+    //
+    NODISCARD ALWAYS_INLINE constexpr T& unchecked_at(usize index) { return m_elements[index]; }
+    NODISCARD ALWAYS_INLINE constexpr const T& unchecked_at(usize index) const { return m_elements[index]; }
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr Iterator begin() { return Iterator(m_elements); }
+    NODISCARD ALWAYS_INLINE constexpr Iterator end() { return Iterator(m_elements + Count); }
+
+    NODISCARD ALWAYS_INLINE constexpr ConstIterator begin() const { return ConstIterator(m_elements); }
+    NODISCARD ALWAYS_INLINE constexpr ConstIterator end() const { return ConstIterator(m_elements + Count); }
+
+public:
+    // NOTE: The storage must be public, otherwise the container would not be an aggregate and
+    // couldn't be brace-initialized.
+    T m_elements[Count];
+};
+
+} // namespace CaveGame
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+
+#include <atomic>
+#include <bit>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Bounded, lock-free queue with any number of producer and consumer threads, based on the design by Dmitry Vyukov.
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+// Every cell stores a sequence number, which tells the producers whether the cell is free for the current lap and the
+// consumers whether it holds an element. Thus, a push or a pop is a single compare-and-swap on the shared index plus
+// the accesses to the cell, and producers never contend with consumers (unless the queue is full or empty).
+//
+template<typename T>
+class MpmcQueue
+{
+    CAVE_MAKE_NONCOPYABLE(MpmcQueue);
+    CAVE_MAKE_NONMOVABLE(MpmcQueue);
+
+public:
+    // The capacity is rounded up to the next power of two.
+    ALWAYS_INLINE explicit MpmcQueue(usize capacity)
+        : m_capacity(std::bit_ceil(Math::max(capacity, static_cast<usize>(2))))
+        , m_index_mask(m_capacity - 1)
+    {
+        m_cells = static_cast<Cell*>(::operator new(m_capacity * sizeof(Cell), std::align_val_t(alignof(Cell))));
+        for (usize index = 0; index < m_capacity; ++index)
+            new (&m_cells[index].sequence) std::atomic<usize>(index);
+    }
+
+    ALWAYS_INLINE ~MpmcQueue()
+    {
+        // No other thread can access the queue anymore, thus every cell between the two indices holds an element.
+        const usize enqueue_index = m_enqueue_index.load(std::memory_order_relaxed);
+        for (usize index = m_dequeue_index.load(std::memory_order_relaxed); index != enqueue_index; ++index)
+            reinterpret_cast<T*>(m_cells[index & m_index_mask].storage)->~T();
+
+        for (usize index = 0; index < m_capacity; ++index)
+            m_cells[index].sequence.~atomic();
+        ::operator delete(m_cells, std::align_val_t(alignof(Cell)));
+    }
+
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_capacity; }
+
+public:
+    // Returns false if the queue is full.
+    template<typename... Args>
+    NODISCARD ALWAYS_INLINE bool try_emplace(Args&&... args)
+    {
+        usize enqueue_index = m_enqueue_index.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[enqueue_index & m_index_mask];
+            const usize sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr difference = static_cast<intptr>(sequence) - static_cast<intptr>(enqueue_index);
+
+            if (difference == 0)
+            {
+                // The cell is free for this lap. Try to claim it.
+                if (m_enqueue_index.compare_exchange_weak(enqueue_index, enqueue_index + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The cell still holds the element from the previous lap, thus the queue is full.
+                return false;
+            }
+            else
+            {
+                // Another producer has claimed the cell in the meantime.
+                enqueue_index = m_enqueue_index.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) T(forward<Args>(args)...);
+        cell->sequence.store(enqueue_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    NODISCARD ALWAYS_INLINE bool try_push(const T& element) { return try_emplace(element); }
+    NODISCARD ALWAYS_INLINE bool try_push(T&& element) { return try_emplace(move(element)); }
+
+    // Returns false if the queue is empty.
+    NODISCARD ALWAYS_INLINE bool try_pop(T& out_element)
+    {
+        usize dequeue_index = m_dequeue_index.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[dequeue_index & m_index_mask];
+            const usize sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr difference = static_cast<intptr>(sequence) - static_cast<intptr>(dequeue_index + 1);
+
+            if (difference == 0)
+            {
+                // The cell holds an element. Try to claim it.
+                if (m_dequeue_index.compare_exchange_weak(dequeue_index, dequeue_index + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The cell hasn't been written yet, thus the queue is empty.
+                return false;
+            }
+            else
+            {
+                // Another consumer has claimed the cell in the meantime.
+                dequeue_index = m_dequeue_index.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* element = reinterpret_cast<T*>(cell->storage);
+        out_element = move(*element);
+        element->~T();
+
+        // Mark the cell as free for the next lap.
+        cell->sequence.store(dequeue_index + m_capacity, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<usize> sequence;
+        alignas(T) u8 storage[sizeof(T)];
+    };
+
+private:
+    // Read-only after construction, shared by all threads.
+    alignas(64) Cell* m_cells { nullptr };
+    usize m_capacity;
+    usize m_index_mask;
+
+    alignas(64) std::atomic<usize> m_enqueue_index { 0 };
+    alignas(64) std::atomic<usize> m_dequeue_index { 0 };
+};
+
+} // namespace CaveGame
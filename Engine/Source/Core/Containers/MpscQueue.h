@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+// Base of the types that can be linked into an `MpscQueue`.
+struct MpscQueueNode
+{
+    std::atomic<MpscQueueNode*> next_node { nullptr };
+};
+
+//
+// Unbounded, intrusive queue with any number of producer threads and a single consumer thread, based on the design by
+// Dmitry Vyukov. https://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+//
+// Pushing is wait-free (a single atomic exchange) and never allocates memory, as the elements embed their links.
+// The queue doesn't own the elements: a node must stay alive (and must not be pushed again) until it has been popped.
+//
+// NOTE: A producer that is preempted in the middle of a push temporarily hides the nodes pushed after it, in which case
+// `MpscQueue::pop` returns null even though the queue isn't empty. The consumer should simply try again later.
+//
+template<typename T>
+class MpscQueue
+{
+    static_assert(is_derived_from<T, MpscQueueNode>, "The elements of an intrusive MPSC queue must derive from MpscQueueNode!");
+
+    CAVE_MAKE_NONCOPYABLE(MpscQueue);
+    CAVE_MAKE_NONMOVABLE(MpscQueue);
+
+public:
+    ALWAYS_INLINE MpscQueue()
+        : m_head_node(&m_stub_node)
+        , m_tail_node(&m_stub_node)
+    {}
+
+    // Can be called by any thread.
+    ALWAYS_INLINE void push(T* element) { push_node(static_cast<MpscQueueNode*>(element)); }
+
+    // Can only be called by the consumer thread. Returns null if the queue is empty.
+    NODISCARD T* pop()
+    {
+        MpscQueueNode* tail_node = m_tail_node;
+        MpscQueueNode* next_node = tail_node->next_node.load(std::memory_order_acquire);
+
+        // Skip the stub node, which is only used to keep the list non-empty.
+        if (tail_node == &m_stub_node)
+        {
+            if (next_node == nullptr)
+                return nullptr;
+
+            m_tail_node = next_node;
+            tail_node = next_node;
+            next_node = next_node->next_node.load(std::memory_order_acquire);
+        }
+
+        if (next_node != nullptr)
+        {
+            m_tail_node = next_node;
+            return static_cast<T*>(tail_node);
+        }
+
+        // The tail is the last linked node. If a producer is in the middle of a push, the node can't be popped yet.
+        if (tail_node != m_head_node.load(std::memory_order_acquire))
+            return nullptr;
+
+        // Push the stub node back, so that the last node can be unlinked.
+        push_node(&m_stub_node);
+
+        next_node = tail_node->next_node.load(std::memory_order_acquire);
+        if (next_node != nullptr)
+        {
+            m_tail_node = next_node;
+            return static_cast<T*>(tail_node);
+        }
+
+        return nullptr;
+    }
+
+private:
+    ALWAYS_INLINE void push_node(MpscQueueNode* node)
+    {
+        node->next_node.store(nullptr, std::memory_order_relaxed);
+        MpscQueueNode* previous_head_node = m_head_node.exchange(node, std::memory_order_acq_rel);
+
+        // NOTE: Between the exchange and this store, the nodes pushed after this one are unreachable for the consumer.
+        previous_head_node->next_node.store(node, std::memory_order_release);
+    }
+
+private:
+    // Written by the producer threads.
+    alignas(64) std::atomic<MpscQueueNode*> m_head_node;
+
+    // Accessed only by the consumer thread.
+    alignas(64) MpscQueueNode* m_tail_node;
+    MpscQueueNode m_stub_node;
+};
+
+} // namespace CaveGame
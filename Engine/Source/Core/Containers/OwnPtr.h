@@ -69,7 +69,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE T* get()
     {
-        CAVE_ASSERT(is_valid());
+        CAVE_CONTAINERS_ASSERT(is_valid());
         return m_instance;
     }
 
@@ -79,7 +79,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE const T* get() const
     {
-        CAVE_ASSERT(is_valid());
+        CAVE_CONTAINERS_ASSERT(is_valid());
         return m_instance;
     }
 
@@ -121,7 +121,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE T* get()
     {
-        CAVE_ASSERT(is_valid());
+        CAVE_CONTAINERS_ASSERT(is_valid());
         return m_instance;
     }
 
@@ -131,7 +131,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE const T* get() const
     {
-        CAVE_ASSERT(is_valid());
+        CAVE_CONTAINERS_ASSERT(is_valid());
         return m_instance;
     }
 
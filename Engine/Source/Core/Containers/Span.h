@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Non-owning view over a contiguous range of elements, such as a part of a `Vector` or of a memory mapped file.
+// The viewed elements must outlive the span.
+//
+template<typename T>
+class Span
+{
+public:
+    using Iterator = T*;
+
+public:
+    ALWAYS_INLINE constexpr Span() = default;
+
+    ALWAYS_INLINE constexpr Span(T* elements, usize count)
+        : m_elements(elements)
+        , m_count(count)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr T* elements() const { return m_elements; }
+    NODISCARD ALWAYS_INLINE constexpr usize count() const { return m_count; }
+    NODISCARD ALWAYS_INLINE constexpr usize byte_count() const { return m_count * sizeof(T); }
+
+    NODISCARD ALWAYS_INLINE constexpr bool is_empty() const { return (m_count == 0); }
+    NODISCARD ALWAYS_INLINE constexpr bool has_elements() const { return (m_count > 0); }
+
+public:
+    //
+    // Returns the element stored at the given index in the viewed range.
+    // If the index is out of bounds, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE constexpr T& at(usize index) const
+    {
+        CAVE_CONTAINERS_ASSERT(index < m_count);
+        return m_elements[index];
+    }
+
+    NODISCARD ALWAYS_INLINE constexpr T& operator[](usize index) const { return at(index); }
+
+    // Returns the element stored at the given index without checking the bounds. Meant for hot loops.
+    NODISCARD ALWAYS_INLINE constexpr T& unchecked_at(usize index) const { return m_elements[index]; }
+
+    // Returns the view over `count` elements, starting with the element at `offset`.
+    NODISCARD ALWAYS_INLINE constexpr Span slice(usize offset, usize count) const
+    {
+        CAVE_CONTAINERS_ASSERT(offset <= m_count && count <= m_count - offset);
+        return Span(m_elements + offset, count);
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr Iterator begin() const { return m_elements; }
+    NODISCARD ALWAYS_INLINE constexpr Iterator end() const { return m_elements + m_count; }
+
+private:
+    T* m_elements { nullptr };
+    usize m_count { 0 };
+};
+
+using ReadonlyByteSpan = Span<const u8>;
+using WriteableByteSpan = Span<u8>;
+
+} // namespace CaveGame
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+
+#include <atomic>
+#include <bit>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Bounded, wait-free queue with a single producer thread and a single consumer thread.
+//
+// Each side keeps a private copy of the index owned by the other side and only reloads it when the queue looks full
+// (for the producer) or empty (for the consumer). Thus, while the queue is neither full nor empty, pushing and popping
+// don't touch the cache line written by the other thread at all. The indices owned by each side are placed on separate
+// cache lines to avoid false sharing.
+//
+template<typename T>
+class SpscQueue
+{
+    CAVE_MAKE_NONCOPYABLE(SpscQueue);
+    CAVE_MAKE_NONMOVABLE(SpscQueue);
+
+public:
+    // The capacity is rounded up to the next power of two.
+    ALWAYS_INLINE explicit SpscQueue(usize capacity)
+        : m_capacity(std::bit_ceil(Math::max(capacity, static_cast<usize>(2))))
+        , m_index_mask(m_capacity - 1)
+    {
+        m_elements = static_cast<T*>(::operator new(m_capacity * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    ALWAYS_INLINE ~SpscQueue()
+    {
+        const usize tail_index = m_tail_index.load(std::memory_order_relaxed);
+        for (usize index = m_head_index.load(std::memory_order_relaxed); index != tail_index; ++index)
+            m_elements[index & m_index_mask].~T();
+        ::operator delete(m_elements, std::align_val_t(alignof(T)));
+    }
+
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_capacity; }
+
+    // Returns the number of elements in the queue. Only a snapshot, as the other thread might modify the queue.
+    NODISCARD ALWAYS_INLINE usize approximate_count() const
+    {
+        return m_tail_index.load(std::memory_order_acquire) - m_head_index.load(std::memory_order_acquire);
+    }
+
+public:
+    // Can only be called by the producer thread. Returns false if the queue is full.
+    template<typename... Args>
+    NODISCARD ALWAYS_INLINE bool try_emplace(Args&&... args)
+    {
+        const usize tail_index = m_tail_index.load(std::memory_order_relaxed);
+        if (tail_index - m_producer_cached_head_index == m_capacity)
+        {
+            m_producer_cached_head_index = m_head_index.load(std::memory_order_acquire);
+            if (tail_index - m_producer_cached_head_index == m_capacity)
+                return false;
+        }
+
+        new (m_elements + (tail_index & m_index_mask)) T(forward<Args>(args)...);
+        m_tail_index.store(tail_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    NODISCARD ALWAYS_INLINE bool try_push(const T& element) { return try_emplace(element); }
+    NODISCARD ALWAYS_INLINE bool try_push(T&& element) { return try_emplace(move(element)); }
+
+    // Can only be called by the consumer thread. Returns false if the queue is empty.
+    NODISCARD ALWAYS_INLINE bool try_pop(T& out_element)
+    {
+        const usize head_index = m_head_index.load(std::memory_order_relaxed);
+        if (head_index == m_consumer_cached_tail_index)
+        {
+            m_consumer_cached_tail_index = m_tail_index.load(std::memory_order_acquire);
+            if (head_index == m_consumer_cached_tail_index)
+                return false;
+        }
+
+        T& element = m_elements[head_index & m_index_mask];
+        out_element = move(element);
+        element.~T();
+        m_head_index.store(head_index + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Read-only after construction, shared by both threads.
+    alignas(64) T* m_elements { nullptr };
+    usize m_capacity;
+    usize m_index_mask;
+
+    // Written by the consumer thread.
+    alignas(64) std::atomic<usize> m_head_index { 0 };
+    usize m_consumer_cached_tail_index { 0 };
+
+    // Written by the producer thread.
+    alignas(64) std::atomic<usize> m_tail_index { 0 };
+    usize m_producer_cached_head_index { 0 };
+};
+
+} // namespace CaveGame
@@ -71,7 +71,7 @@ public:
 
     NODISCARD ALWAYS_INLINE StringView view() const
     {
-        CAVE_ASSERT(m_byte_count >= 1);
+        CAVE_CONTAINERS_ASSERT(m_byte_count >= 1);
         return StringView::create_from_utf8(characters(), m_byte_count - 1);
     }
 
@@ -11,6 +11,9 @@
 #include <Core/Assertion.h>
 #include <Core/CoreTypes.h>
 
+// Required for the placement new operator.
+#include <new>
+
 namespace CaveGame
 {
 
@@ -119,7 +122,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE T& at(usize index)
     {
-        CAVE_ASSERT(index < m_count);
+        CAVE_CONTAINERS_ASSERT(index < m_count);
         return m_elements[index];
     }
 
@@ -129,7 +132,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE const T& at(usize index) const
     {
-        CAVE_ASSERT(index < m_count);
+        CAVE_CONTAINERS_ASSERT(index < m_count);
         return m_elements[index];
     }
 
@@ -137,6 +140,13 @@ public:
     NODISCARD ALWAYS_INLINE T& operator[](usize index) { return at(index); }
     NODISCARD ALWAYS_INLINE const T& operator[](usize index) const { return at(index); }
 
+    //
+    // Returns the element stored at the given index, without checking the bounds in any build configuration.
+    // Intended for the hot loops whose indices are known to be in bounds (for example, when iterating up to `count()`).
+    //
+    NODISCARD ALWAYS_INLINE T& unchecked_at(usize index) { return m_elements[index]; }
+    NODISCARD ALWAYS_INLINE const T& unchecked_at(usize index) const { return m_elements[index]; }
+
     //
     // Returns the first element stored in the internal array. Note that this is not undefined behaviour
     // as the elements are stored contiguosly (and thus ordered) in memory.
@@ -144,7 +154,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE T& first()
     {
-        CAVE_ASSERT(has_elements());
+        CAVE_CONTAINERS_ASSERT(has_elements());
         return m_elements[0];
     }
 
@@ -155,7 +165,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE const T& first() const
     {
-        CAVE_ASSERT(has_elements());
+        CAVE_CONTAINERS_ASSERT(has_elements());
         return m_elements[0];
     }
 
@@ -166,7 +176,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE T& last()
     {
-        CAVE_ASSERT(has_elements());
+        CAVE_CONTAINERS_ASSERT(has_elements());
         return m_elements[m_count - 1];
     }
 
@@ -177,7 +187,7 @@ public:
     //
     NODISCARD ALWAYS_INLINE const T& last() const
     {
-        CAVE_ASSERT(has_elements());
+        CAVE_CONTAINERS_ASSERT(has_elements());
         return m_elements[m_count - 1];
     }
 
@@ -266,7 +276,7 @@ public:
         if (m_capacity == in_capacity)
             return;
 
-        CAVE_ASSERT(in_capacity > m_count);
+        CAVE_CONTAINERS_ASSERT(in_capacity > m_count);
         T* new_elements = allocate_memory(in_capacity);
         move_elements(new_elements, m_elements, m_count);
 
@@ -297,7 +307,7 @@ public:
     ALWAYS_INLINE void set_count_defaulted(usize in_count)
     {
         const usize current_count = m_count;
-        set_count_uninitialized();
+        set_count_uninitialized(in_count);
 
         // If the new count is greater than the current count the last `in_count - current_count` elements
         // must be initialized (using their default constructor). Note that if this is not the case, this loop does nothing.
@@ -310,7 +320,7 @@ public:
     ALWAYS_INLINE void set_count(usize in_count, const T& constructor_element)
     {
         const usize current_count = m_count;
-        set_count_uninitialized();
+        set_count_uninitialized(in_count);
 
         // If the new count is greater than the current count the last `in_count - current_count` elements
         // must be initialized (using their copy constructor). Note that if this is not the case, this loop does nothing.
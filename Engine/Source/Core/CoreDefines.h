@@ -20,11 +20,15 @@
     #define CAVE_PLATFORM_WINDOWS 0
 #endif // CAVE_PLATFORM_WINDOWS
 
+#ifndef CAVE_PLATFORM_LINUX
+    #define CAVE_PLATFORM_LINUX 0
+#endif // CAVE_PLATFORM_LINUX
+
 //
 // Ensure that at least one platform macro is set to 1.
 // Otherwise, the project configuration is wrong and a compiler error should be raised.
 //
-#if !CAVE_PLATFORM_WINDOWS
+#if !CAVE_PLATFORM_WINDOWS && !CAVE_PLATFORM_LINUX
     #error Unknown or unsupported platform!
 #endif // Any supported platform.
 
@@ -93,6 +97,32 @@
     #error Unknown or unsupported compiler!
 #endif // Any supported compiler.
 
+//======================================================================================
+// INSTRUCTION SET CONFIGURATION MACROS.
+//======================================================================================
+//
+// NOTE: The instruction set macros are derived from the flags the compiler exposes, which are
+// controlled by the `vectorextensions` option in the build system configuration.
+//
+
+// Both MSVC (when compiling with `/arch:AVX2`) and GCC/clang (when compiling with `-mavx2`) set `__AVX2__`.
+#ifdef __AVX2__
+    #define CAVE_SIMD_AVX2 1
+#endif // __AVX2__
+
+#ifndef CAVE_SIMD_AVX2
+    #define CAVE_SIMD_AVX2 0
+#endif // CAVE_SIMD_AVX2
+
+// MSVC doesn't expose a dedicated F16C macro, but every processor that supports AVX2 also supports F16C.
+#if defined(__F16C__) || (CAVE_COMPILER_MSVC && CAVE_SIMD_AVX2)
+    #define CAVE_SIMD_F16C 1
+#endif // defined(__F16C__) || (CAVE_COMPILER_MSVC && CAVE_SIMD_AVX2)
+
+#ifndef CAVE_SIMD_F16C
+    #define CAVE_SIMD_F16C 0
+#endif // CAVE_SIMD_F16C
+
 //======================================================================================
 // UTILITY (GENERAL PURPOSE) MACROS.
 //======================================================================================
@@ -101,6 +131,12 @@
     // Hint for the compiler that the function should always be inlined.
     #define ALWAYS_INLINE __forceinline
 
+    // Prevents the compiler from inlining the function.
+    #define NOINLINE __declspec(noinline)
+
+    // Hint for the compiler that the function is rarely invoked. MSVC has no equivalent attribute.
+    #define COLD
+
     // Traps the debugger. Triggers a breakpoint if a debugger is attached or crashes the program otherwise.
     #define CAVE_DEBUGBREAK __debugbreak()
 
@@ -108,6 +144,30 @@
     #define CAVE_FUNCTION __FUNCSIG__
 #endif // CAVE_COMPILER_MSVC
 
+#if CAVE_COMPILER_GCC || CAVE_COMPILER_CLANG
+    // Hint for the compiler that the function should always be inlined.
+    #define ALWAYS_INLINE inline __attribute__((always_inline))
+
+    // Prevents the compiler from inlining the function.
+    #define NOINLINE __attribute__((noinline))
+
+    //
+    // Hint for the compiler that the function is rarely invoked. The function is optimized for size and placed in a
+    // separate text section, and the branches that lead to its calls are treated as unlikely.
+    //
+    #define COLD __attribute__((cold))
+
+    // Traps the debugger. Triggers a breakpoint if a debugger is attached or crashes the program otherwise.
+    #if CAVE_COMPILER_CLANG
+        #define CAVE_DEBUGBREAK __builtin_debugtrap()
+    #else
+        #define CAVE_DEBUGBREAK __builtin_trap()
+    #endif // CAVE_COMPILER_CLANG
+
+    // Expands to the signature of the function in which the macro is located.
+    #define CAVE_FUNCTION __PRETTY_FUNCTION__
+#endif // CAVE_COMPILER_GCC || CAVE_COMPILER_CLANG
+
 // The compiler is encouraged to issue a warning if the function return value is not stored/used.
 #define NODISCARD [[nodiscard]]
 
@@ -11,7 +11,6 @@
 #include <Core/CoreDefines.h>
 #include <type_traits>
 
-#if CAVE_PLATFORM_WINDOWS
 namespace CaveGame
 {
 
@@ -22,7 +21,12 @@ namespace CaveGame
 using u8 = unsigned char;
 using u16 = unsigned short;
 using u32 = unsigned int;
+#if CAVE_PLATFORM_WINDOWS
 using u64 = unsigned long long;
+#elif CAVE_PLATFORM_LINUX
+// NOTE: On LP64 platforms `size_t` and `uint64_t` are defined as `unsigned long`, not as `unsigned long long`.
+using u64 = unsigned long;
+#endif // Any supported platform.
 
 //
 // Fixed-size primitive types that represent an signed integer.
@@ -31,7 +35,11 @@ using u64 = unsigned long long;
 using i8 = signed char;
 using i16 = signed short;
 using i32 = signed int;
+#if CAVE_PLATFORM_WINDOWS
 using i64 = signed long long;
+#elif CAVE_PLATFORM_LINUX
+using i64 = signed long;
+#endif // Any supported platform.
 
 //
 // Primitive types that represent integers which hold a size or memory address.
@@ -42,8 +50,10 @@ using ssize = i64;
 using uintptr = u64;
 using intptr = i64;
 
+static_assert(sizeof(u64) == 8 && sizeof(i64) == 8, "The 64-bit integer types are not correctly defined on the current platform!");
+static_assert(sizeof(usize) == sizeof(void*), "The size types are not correctly defined on the current platform!");
+
 } // namespace CaveGame
-#endif // CAVE_PLATFORM_WINDOWS
 
 // Marks the type in which this macro is placed as non-copyable, by marking the
 // copy constructor and assignment operator as deleted.
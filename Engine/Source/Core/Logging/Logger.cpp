@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Logging/Logger.h>
+#include <Core/Platform/FastClock.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Threading/Mutex.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+#include <atomic>
+#include <cstdio>
+
+namespace CaveGame
+{
+
+const char* get_log_severity_name(LogSeverity severity)
+{
+    switch (severity)
+    {
+        case LogSeverity::Trace: return "Trace";
+        case LogSeverity::Debug: return "Debug";
+        case LogSeverity::Info: return "Info";
+        case LogSeverity::Warning: return "Warning";
+        case LogSeverity::Error: return "Error";
+        case LogSeverity::Fatal: return "Fatal";
+    }
+
+    return "Unknown";
+}
+
+//
+// The records are stored contiguously in the ring buffer, aligned to 8 bytes. A record never wraps around the end of
+// the buffer: the space left at the end is skipped, and marked with a padding record (a record without a site) if
+// the record header fits in it.
+//
+struct LogRecordHeader
+{
+    const LogSite* site;
+    u64 ticks;
+    // The size of the record, including the header and the alignment padding.
+    u32 record_size;
+    // The size of the encoded arguments, which follow the header.
+    u32 payload_size;
+};
+
+static constexpr usize log_record_alignment = 8;
+
+//
+// Single-producer, single-consumer ring buffer that stores the records logged by a thread. The positions only ever
+// increase, and the offset in the buffer is obtained by wrapping them around the capacity.
+//
+struct LogThreadBuffer
+{
+    static constexpr usize maximum_thread_name_length = 31;
+
+    alignas(log_record_alignment) u8 data[Logger::thread_buffer_capacity];
+
+    // Written by the owner thread.
+    alignas(64) std::atomic<u64> write_position { 0 };
+    u64 pending_write_position { 0 };
+    u64 cached_read_position { 0 };
+    std::atomic<u64> dropped_record_count { 0 };
+
+    // Written by the thread that formats the records.
+    alignas(64) std::atomic<u64> read_position { 0 };
+    u64 reported_dropped_record_count { 0 };
+
+    u32 thread_index { 0 };
+    char thread_name[maximum_thread_name_length + 1] {};
+};
+
+static_assert((Logger::thread_buffer_capacity & (Logger::thread_buffer_capacity - 1)) == 0, "The capacity must be a power of two!");
+
+struct LoggerData
+{
+    std::atomic<bool> is_initialized { false };
+
+    // Protects the registration of the threads and their names.
+    SpinLock registry_lock;
+    LogThreadBuffer* thread_buffers[Logger::maximum_thread_count] {};
+    std::atomic<u32> thread_count { 0 };
+
+    // Serializes the formatting of the records, which is performed by the background thread or by `Logger::flush`.
+    Mutex output_lock;
+    FILE* log_file { nullptr };
+    u64 start_ticks { 0 };
+    char thread_names[Logger::maximum_thread_count][LogThreadBuffer::maximum_thread_name_length + 1] {};
+
+    Thread thread;
+    std::atomic<bool> should_stop { false };
+};
+
+static LoggerData s_logger;
+static thread_local LogThreadBuffer* t_thread_buffer = nullptr;
+static thread_local bool t_is_registration_failed = false;
+static thread_local bool t_is_logger_thread = false;
+// Set while the thread writes the records, so a failed assertion inside the formatting code can't deadlock the flush.
+static thread_local bool t_is_writing_records = false;
+
+// The background thread checks for new records at this interval when it has nothing to write.
+static constexpr u64 logger_polling_interval_nanoseconds = 2'000'000;
+
+#pragma region Recording
+
+static LogThreadBuffer* register_current_thread()
+{
+    if (t_is_registration_failed)
+        return nullptr;
+
+    ScopedLock<SpinLock> registry_lock(s_logger.registry_lock);
+
+    const u32 thread_index = s_logger.thread_count.load(std::memory_order_relaxed);
+    if (thread_index >= Logger::maximum_thread_count)
+    {
+        t_is_registration_failed = true;
+        return nullptr;
+    }
+
+    LogThreadBuffer* buffer = new LogThreadBuffer();
+    buffer->thread_index = thread_index;
+    snprintf(buffer->thread_name, sizeof(buffer->thread_name), "Thread %u", thread_index);
+
+    s_logger.thread_buffers[thread_index] = buffer;
+    s_logger.thread_count.store(thread_index + 1, std::memory_order_release);
+
+    t_thread_buffer = buffer;
+    return buffer;
+}
+
+u8* Logger::begin_record(const LogSite& site, usize payload_size)
+{
+    if (!s_logger.is_initialized.load(std::memory_order_relaxed))
+        return nullptr;
+
+    LogThreadBuffer* buffer = t_thread_buffer;
+    if (buffer == nullptr)
+    {
+        buffer = register_current_thread();
+        if (buffer == nullptr)
+            return nullptr;
+    }
+
+    const usize record_size = (sizeof(LogRecordHeader) + payload_size + log_record_alignment - 1) & ~(log_record_alignment - 1);
+    u64 write_position = buffer->write_position.load(std::memory_order_relaxed);
+    usize offset = write_position & (thread_buffer_capacity - 1);
+
+    // The records never wrap around the end of the buffer, so the remaining space might have to be skipped.
+    const usize remaining_size = thread_buffer_capacity - offset;
+    const usize required_size = record_size + (remaining_size < record_size ? remaining_size : 0);
+
+    if (write_position + required_size - buffer->cached_read_position > thread_buffer_capacity)
+    {
+        buffer->cached_read_position = buffer->read_position.load(std::memory_order_acquire);
+        if (required_size > thread_buffer_capacity || write_position + required_size - buffer->cached_read_position > thread_buffer_capacity)
+        {
+            // NOTE: Only the owner thread modifies the counter, so there is no need for an atomic increment.
+            buffer->dropped_record_count.store(buffer->dropped_record_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    if (remaining_size < record_size)
+    {
+        if (remaining_size >= sizeof(LogRecordHeader))
+        {
+            LogRecordHeader* padding_header = reinterpret_cast<LogRecordHeader*>(buffer->data + offset);
+            padding_header->site = nullptr;
+            padding_header->record_size = static_cast<u32>(remaining_size);
+        }
+
+        write_position += remaining_size;
+        offset = 0;
+    }
+
+    LogRecordHeader* header = reinterpret_cast<LogRecordHeader*>(buffer->data + offset);
+    header->site = &site;
+    header->ticks = FastClock::get_ticks();
+    header->record_size = static_cast<u32>(record_size);
+    header->payload_size = static_cast<u32>(payload_size);
+
+    buffer->pending_write_position = write_position + record_size;
+    return buffer->data + offset + sizeof(LogRecordHeader);
+}
+
+void Logger::end_record()
+{
+    LogThreadBuffer* buffer = t_thread_buffer;
+    buffer->write_position.store(buffer->pending_write_position, std::memory_order_release);
+}
+
+u64 Logger::get_dropped_record_count()
+{
+    u64 dropped_record_count = 0;
+    const u32 thread_count = s_logger.thread_count.load(std::memory_order_acquire);
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        dropped_record_count += s_logger.thread_buffers[thread_index]->dropped_record_count.load(std::memory_order_relaxed);
+    return dropped_record_count;
+}
+
+void Logger::set_current_thread_name(StringView name)
+{
+    LogThreadBuffer* buffer = t_thread_buffer;
+    if (buffer == nullptr)
+    {
+        buffer = register_current_thread();
+        if (buffer == nullptr)
+            return;
+    }
+
+    ScopedLock<SpinLock> registry_lock(s_logger.registry_lock);
+    const usize name_length = Math::min(name.byte_count(), LogThreadBuffer::maximum_thread_name_length);
+    for (usize index = 0; index < name_length; ++index)
+        buffer->thread_name[index] = name.characters()[index];
+    buffer->thread_name[name_length] = '\0';
+}
+
+#pragma endregion
+
+#pragma region Formatting
+
+// Appends text to a fixed size line, truncating it if it doesn't fit (the last byte is reserved for the new line).
+struct LogLine
+{
+    static constexpr usize capacity = 4 * KiB;
+
+    char characters[capacity];
+    usize length { 0 };
+
+    ALWAYS_INLINE void append(const char* text, usize text_length)
+    {
+        const usize copied_length = Math::min(text_length, capacity - 1 - length);
+        memcpy(characters + length, text, copied_length);
+        length += copied_length;
+    }
+
+    template<typename... Arguments>
+    void append_formatted(const char* format, Arguments... arguments)
+    {
+        const int written_length = snprintf(characters + length, capacity - length, format, arguments...);
+        if (written_length > 0)
+            length += Math::min(static_cast<usize>(written_length), capacity - 1 - length);
+    }
+};
+
+// Decodes the next argument from the payload and appends it to the line. Returns false if there are no arguments left.
+static bool append_next_argument(LogLine& line, const u8*& payload, const u8* payload_end)
+{
+    if (payload >= payload_end)
+        return false;
+
+    const LogArgumentType type = static_cast<LogArgumentType>(*payload++);
+    if (type == LogArgumentType::Bool || type == LogArgumentType::Character)
+    {
+        const u8 value = *payload++;
+        if (type == LogArgumentType::Bool)
+            line.append(value ? "true" : "false", value ? 4 : 5);
+        else
+            line.append(reinterpret_cast<const char*>(&value), 1);
+        return true;
+    }
+
+    if (type == LogArgumentType::String)
+    {
+        u32 byte_count;
+        memcpy(&byte_count, payload, sizeof(u32));
+        line.append(reinterpret_cast<const char*>(payload + sizeof(u32)), byte_count);
+        payload += sizeof(u32) + byte_count;
+        return true;
+    }
+
+    u64 value;
+    memcpy(&value, payload, sizeof(u64));
+    payload += sizeof(u64);
+
+    switch (type)
+    {
+        case LogArgumentType::SignedInteger: line.append_formatted("%lld", static_cast<long long>(static_cast<i64>(value))); break;
+        case LogArgumentType::UnsignedInteger: line.append_formatted("%llu", static_cast<unsigned long long>(value)); break;
+        case LogArgumentType::Pointer: line.append_formatted("0x%016llx", static_cast<unsigned long long>(value)); break;
+        case LogArgumentType::FloatingPoint:
+        {
+            double floating_point_value;
+            memcpy(&floating_point_value, &value, sizeof(double));
+            line.append_formatted("%g", floating_point_value);
+            break;
+        }
+        default: break;
+    }
+
+    return true;
+}
+
+static void format_record(LogLine& line, const LogRecordHeader& header, const char* thread_name)
+{
+    const LogSite& site = *header.site;
+    const u64 elapsed_ticks = (header.ticks > s_logger.start_ticks) ? (header.ticks - s_logger.start_ticks) : 0;
+    const u64 elapsed_microseconds = FastClock::ticks_to_nanoseconds(elapsed_ticks) / 1000;
+
+    line.length = 0;
+    line.append_formatted(
+        "[%5llu.%06llu] [%-7s] [%s] ",
+        static_cast<unsigned long long>(elapsed_microseconds / 1'000'000),
+        static_cast<unsigned long long>(elapsed_microseconds % 1'000'000),
+        get_log_severity_name(site.severity),
+        thread_name
+    );
+
+    // Every `{}` placeholder is replaced by the next argument. The placeholders without an argument are kept as is.
+    const u8* payload = reinterpret_cast<const u8*>(&header) + sizeof(LogRecordHeader);
+    const u8* payload_end = payload + header.payload_size;
+    const char* text_start = site.format;
+    for (const char* character = site.format; *character != '\0'; ++character)
+    {
+        if (character[0] != '{' || character[1] != '}')
+            continue;
+
+        line.append(text_start, static_cast<usize>(character - text_start));
+        if (!append_next_argument(line, payload, payload_end))
+            line.append("{}", 2);
+
+        ++character;
+        text_start = character + 1;
+    }
+    line.append(text_start, strlen(text_start));
+}
+
+static void write_line(const LogLine& line, LogSeverity severity)
+{
+    FILE* console = (severity >= LogSeverity::Warning) ? stderr : stdout;
+    fwrite(line.characters, 1, line.length, console);
+    fputc('\n', console);
+
+    if (s_logger.log_file)
+    {
+        fwrite(line.characters, 1, line.length, s_logger.log_file);
+        fputc('\n', s_logger.log_file);
+    }
+}
+
+// Returns the oldest unread record of the buffer, or null if it has none. Skips the padding at the end of the buffer.
+static const LogRecordHeader* peek_record(const LogThreadBuffer& buffer, u64& read_position, u64 write_position)
+{
+    while (read_position < write_position)
+    {
+        const usize offset = read_position & (Logger::thread_buffer_capacity - 1);
+        const usize remaining_size = Logger::thread_buffer_capacity - offset;
+        if (remaining_size < sizeof(LogRecordHeader))
+        {
+            read_position += remaining_size;
+            continue;
+        }
+
+        const LogRecordHeader* header = reinterpret_cast<const LogRecordHeader*>(buffer.data + offset);
+        if (header->site == nullptr)
+        {
+            read_position += header->record_size;
+            continue;
+        }
+
+        return header;
+    }
+
+    return nullptr;
+}
+
+//
+// Formats and writes the records published by all threads. The records of the different threads are merged by their
+// timestamps. Must be called while holding the output lock. Returns the number of written records.
+//
+static u64 write_pending_records()
+{
+    t_is_writing_records = true;
+
+    u32 thread_count;
+    {
+        ScopedLock<SpinLock> registry_lock(s_logger.registry_lock);
+        thread_count = s_logger.thread_count.load(std::memory_order_relaxed);
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+            memcpy(s_logger.thread_names[thread_index], s_logger.thread_buffers[thread_index]->thread_name, sizeof(s_logger.thread_names[thread_index]));
+    }
+
+    static LogLine line;
+    u64 read_positions[Logger::maximum_thread_count];
+    u64 write_positions[Logger::maximum_thread_count];
+
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        LogThreadBuffer& buffer = *s_logger.thread_buffers[thread_index];
+        read_positions[thread_index] = buffer.read_position.load(std::memory_order_relaxed);
+        write_positions[thread_index] = buffer.write_position.load(std::memory_order_acquire);
+
+        const u64 dropped_record_count = buffer.dropped_record_count.load(std::memory_order_relaxed);
+        if (dropped_record_count != buffer.reported_dropped_record_count)
+        {
+            line.length = 0;
+            line.append_formatted(
+                "[Logger] %llu records have been dropped by thread '%s' because its buffer was full.",
+                static_cast<unsigned long long>(dropped_record_count - buffer.reported_dropped_record_count),
+                s_logger.thread_names[thread_index]
+            );
+            write_line(line, LogSeverity::Warning);
+            buffer.reported_dropped_record_count = dropped_record_count;
+        }
+    }
+
+    u64 written_record_count = 0;
+    while (true)
+    {
+        const LogRecordHeader* oldest_header = nullptr;
+        u32 oldest_thread_index = 0;
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            const LogRecordHeader* header = peek_record(*s_logger.thread_buffers[thread_index], read_positions[thread_index], write_positions[thread_index]);
+            if (header && (oldest_header == nullptr || header->ticks < oldest_header->ticks))
+            {
+                oldest_header = header;
+                oldest_thread_index = thread_index;
+            }
+        }
+
+        if (oldest_header == nullptr)
+            break;
+
+        format_record(line, *oldest_header, s_logger.thread_names[oldest_thread_index]);
+        write_line(line, oldest_header->site->severity);
+        ++written_record_count;
+
+        // The space of the record is released as soon as it has been written, so the thread can reuse it.
+        read_positions[oldest_thread_index] += oldest_header->record_size;
+        s_logger.thread_buffers[oldest_thread_index]->read_position.store(read_positions[oldest_thread_index], std::memory_order_release);
+    }
+
+    if (written_record_count > 0)
+    {
+        fflush(stdout);
+        if (s_logger.log_file)
+            fflush(s_logger.log_file);
+    }
+
+    t_is_writing_records = false;
+    return written_record_count;
+}
+
+#pragma endregion
+
+static void logger_thread_entry_point(void*)
+{
+    t_is_logger_thread = true;
+    while (!s_logger.should_stop.load(std::memory_order_acquire))
+    {
+        u64 written_record_count;
+        {
+            ScopedLock<Mutex> output_lock(s_logger.output_lock);
+            written_record_count = write_pending_records();
+        }
+
+        if (written_record_count == 0)
+            PlatformCore::sleep_for_nanoseconds(logger_polling_interval_nanoseconds);
+    }
+}
+
+bool Logger::initialize(StringView log_filepath)
+{
+    if (s_logger.is_initialized.load(std::memory_order_relaxed))
+        return false;
+
+    s_logger.start_ticks = FastClock::get_ticks();
+    s_logger.should_stop.store(false, std::memory_order_relaxed);
+
+    bool is_log_file_opened = true;
+    if (!log_filepath.is_empty())
+    {
+        const String null_terminated_filepath = String(log_filepath);
+#if CAVE_COMPILER_MSVC
+        if (fopen_s(&s_logger.log_file, null_terminated_filepath.characters(), "w") != 0)
+            s_logger.log_file = nullptr;
+#else
+        s_logger.log_file = fopen(null_terminated_filepath.characters(), "w");
+#endif // CAVE_COMPILER_MSVC
+        is_log_file_opened = (s_logger.log_file != nullptr);
+    }
+
+    ThreadDescription description;
+    description.name = "Logger"sv;
+    description.priority = ThreadPriority::Low;
+    if (!s_logger.thread.create(logger_thread_entry_point, nullptr, description))
+    {
+        if (s_logger.log_file)
+            fclose(s_logger.log_file);
+        s_logger.log_file = nullptr;
+        return false;
+    }
+
+    s_logger.is_initialized.store(true, std::memory_order_release);
+    install_crash_handler();
+
+    if (!is_log_file_opened)
+        CAVE_LOG_WARNING("The log file '{}' can't be opened. Logging only to the console.", log_filepath);
+
+    return true;
+}
+
+void Logger::shutdown()
+{
+    if (!s_logger.is_initialized.load(std::memory_order_relaxed))
+        return;
+
+    uninstall_crash_handler();
+    s_logger.is_initialized.store(false, std::memory_order_relaxed);
+
+    s_logger.should_stop.store(true, std::memory_order_release);
+    s_logger.thread.join();
+
+    // Write the records that have been published after the background thread has stopped.
+    flush();
+
+    {
+        ScopedLock<SpinLock> registry_lock(s_logger.registry_lock);
+        const u32 thread_count = s_logger.thread_count.load(std::memory_order_relaxed);
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            delete s_logger.thread_buffers[thread_index];
+            s_logger.thread_buffers[thread_index] = nullptr;
+        }
+        s_logger.thread_count.store(0, std::memory_order_relaxed);
+    }
+
+    if (s_logger.log_file)
+        fclose(s_logger.log_file);
+    s_logger.log_file = nullptr;
+
+    // NOTE: The buffers of the other threads have been released, so they must not log anything from now on.
+    t_thread_buffer = nullptr;
+}
+
+bool Logger::is_initialized()
+{
+    return s_logger.is_initialized.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    if (t_is_writing_records)
+        return;
+
+    ScopedLock<Mutex> output_lock(s_logger.output_lock);
+    write_pending_records();
+}
+
+void Logger::flush_from_crash_handler(const char* crash_reason)
+{
+    //
+    // NOTE: The records can only be written if no other thread is writing them. If the background thread crashed, or
+    // it doesn't release the lock in a reasonable amount of time, only the crash reason is written.
+    //
+    bool is_output_locked = false;
+    if (!t_is_logger_thread && !t_is_writing_records)
+    {
+        constexpr u32 maximum_attempt_count = 100;
+        for (u32 attempt_index = 0; attempt_index < maximum_attempt_count && !is_output_locked; ++attempt_index)
+        {
+            is_output_locked = s_logger.output_lock.try_lock();
+            if (!is_output_locked)
+                PlatformCore::sleep_for_nanoseconds(1'000'000);
+        }
+    }
+
+    if (is_output_locked)
+        write_pending_records();
+
+    static LogLine line;
+    line.length = 0;
+    line.append_formatted("[Logger] The process has crashed: %s.", crash_reason);
+    write_line(line, LogSeverity::Fatal);
+
+    fflush(stderr);
+    if (s_logger.log_file)
+        fflush(s_logger.log_file);
+
+    if (is_output_locked)
+        s_logger.output_lock.unlock();
+}
+
+} // namespace CaveGame
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+
+#include <cstring>
+
+//
+// The log severities below the minimum severity are removed at compile time: their macros expand to nothing, so the
+// arguments aren't even evaluated. By default, Debug builds keep all messages, Development builds drop the trace
+// messages and Shipping builds keep only the informative messages and above.
+//
+
+#define CAVE_LOG_SEVERITY_TRACE   0
+#define CAVE_LOG_SEVERITY_DEBUG   1
+#define CAVE_LOG_SEVERITY_INFO    2
+#define CAVE_LOG_SEVERITY_WARNING 3
+#define CAVE_LOG_SEVERITY_ERROR   4
+#define CAVE_LOG_SEVERITY_FATAL   5
+
+#ifndef CAVE_LOG_MINIMUM_SEVERITY
+    #if CAVE_CONFIGURATION_DEBUG
+        #define CAVE_LOG_MINIMUM_SEVERITY CAVE_LOG_SEVERITY_TRACE
+    #elif CAVE_CONFIGURATION_DEVELOPMENT
+        #define CAVE_LOG_MINIMUM_SEVERITY CAVE_LOG_SEVERITY_DEBUG
+    #else
+        #define CAVE_LOG_MINIMUM_SEVERITY CAVE_LOG_SEVERITY_INFO
+    #endif // CAVE_CONFIGURATION_DEBUG
+#endif // CAVE_LOG_MINIMUM_SEVERITY
+
+namespace CaveGame
+{
+
+enum class LogSeverity : u8
+{
+    Trace = CAVE_LOG_SEVERITY_TRACE,
+    Debug = CAVE_LOG_SEVERITY_DEBUG,
+    Info = CAVE_LOG_SEVERITY_INFO,
+    Warning = CAVE_LOG_SEVERITY_WARNING,
+    Error = CAVE_LOG_SEVERITY_ERROR,
+    Fatal = CAVE_LOG_SEVERITY_FATAL,
+};
+
+NODISCARD const char* get_log_severity_name(LogSeverity severity);
+
+//
+// The static description of a log statement, created by the logging macros. The records only store the address of
+// the site, which identifies the format string, so the format string is never copied by the call site.
+//
+struct LogSite
+{
+    LogSeverity severity;
+    const char* format;
+    const char* filename;
+    u32 line;
+};
+
+enum class LogArgumentType : u8
+{
+    Bool,
+    Character,
+    SignedInteger,
+    UnsignedInteger,
+    FloatingPoint,
+    Pointer,
+    String,
+};
+
+#pragma region Argument Encoding
+
+//
+// The arguments are stored in the records as a type tag followed by the raw value. The strings are copied (they might
+// not outlive the record), prefixed by their length and truncated to `maximum_log_string_argument_length` bytes.
+//
+constexpr usize maximum_log_string_argument_length = 1 * KiB;
+
+namespace Detail
+{
+
+template<typename T>
+NODISCARD ALWAYS_INLINE usize get_encoded_log_argument_size(const T& argument)
+{
+    using ArgumentType = std::decay_t<T>;
+    if constexpr (std::is_same_v<ArgumentType, bool> || std::is_same_v<ArgumentType, char>)
+        return sizeof(LogArgumentType) + sizeof(u8);
+    else if constexpr (std::is_integral_v<ArgumentType> || std::is_enum_v<ArgumentType> || std::is_floating_point_v<ArgumentType>)
+        return sizeof(LogArgumentType) + sizeof(u64);
+    else if constexpr (std::is_same_v<ArgumentType, const char*> || std::is_same_v<ArgumentType, char*>)
+    {
+        // NOTE: The character arrays (including the string literals) decay to pointers, which are never null.
+        const char* characters = argument;
+        return sizeof(LogArgumentType) + sizeof(u32) + (characters ? Math::min(strlen(characters), maximum_log_string_argument_length) : 0);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, StringView>)
+        return sizeof(LogArgumentType) + sizeof(u32) + Math::min(argument.byte_count(), maximum_log_string_argument_length);
+    else if constexpr (std::is_same_v<ArgumentType, String>)
+        return sizeof(LogArgumentType) + sizeof(u32) + Math::min(argument.byte_count() - 1, maximum_log_string_argument_length);
+    else if constexpr (std::is_pointer_v<ArgumentType>)
+        return sizeof(LogArgumentType) + sizeof(u64);
+    else
+        static_assert(sizeof(ArgumentType) == 0, "The type of the log argument isn't supported!");
+}
+
+ALWAYS_INLINE void encode_log_argument_header(u8*& destination, LogArgumentType type)
+{
+    *destination = static_cast<u8>(type);
+    destination += sizeof(LogArgumentType);
+}
+
+ALWAYS_INLINE void encode_log_argument_value(u8*& destination, u64 value)
+{
+    memcpy(destination, &value, sizeof(u64));
+    destination += sizeof(u64);
+}
+
+ALWAYS_INLINE void encode_log_argument_string(u8*& destination, const char* characters, usize byte_count)
+{
+    const u32 encoded_byte_count = static_cast<u32>(Math::min(byte_count, maximum_log_string_argument_length));
+    encode_log_argument_header(destination, LogArgumentType::String);
+    memcpy(destination, &encoded_byte_count, sizeof(u32));
+    memcpy(destination + sizeof(u32), characters, encoded_byte_count);
+    destination += sizeof(u32) + encoded_byte_count;
+}
+
+template<typename T>
+ALWAYS_INLINE void encode_log_argument(u8*& destination, const T& argument)
+{
+    using ArgumentType = std::decay_t<T>;
+    if constexpr (std::is_same_v<ArgumentType, bool>)
+    {
+        encode_log_argument_header(destination, LogArgumentType::Bool);
+        *destination++ = argument ? 1 : 0;
+    }
+    else if constexpr (std::is_same_v<ArgumentType, char>)
+    {
+        encode_log_argument_header(destination, LogArgumentType::Character);
+        *destination++ = static_cast<u8>(argument);
+    }
+    else if constexpr (std::is_enum_v<ArgumentType>)
+    {
+        encode_log_argument_header(destination, LogArgumentType::SignedInteger);
+        encode_log_argument_value(destination, static_cast<u64>(static_cast<i64>(argument)));
+    }
+    else if constexpr (std::is_integral_v<ArgumentType>)
+    {
+        encode_log_argument_header(destination, std::is_signed_v<ArgumentType> ? LogArgumentType::SignedInteger : LogArgumentType::UnsignedInteger);
+        if constexpr (std::is_signed_v<ArgumentType>)
+            encode_log_argument_value(destination, static_cast<u64>(static_cast<i64>(argument)));
+        else
+            encode_log_argument_value(destination, static_cast<u64>(argument));
+    }
+    else if constexpr (std::is_floating_point_v<ArgumentType>)
+    {
+        const double value = static_cast<double>(argument);
+        u64 value_bits;
+        memcpy(&value_bits, &value, sizeof(u64));
+        encode_log_argument_header(destination, LogArgumentType::FloatingPoint);
+        encode_log_argument_value(destination, value_bits);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, const char*> || std::is_same_v<ArgumentType, char*>)
+    {
+        const char* characters = argument;
+        encode_log_argument_string(destination, characters, characters ? strlen(characters) : 0);
+    }
+    else if constexpr (std::is_same_v<ArgumentType, StringView>)
+    {
+        encode_log_argument_string(destination, argument.characters(), argument.byte_count());
+    }
+    else if constexpr (std::is_same_v<ArgumentType, String>)
+    {
+        encode_log_argument_string(destination, argument.characters(), argument.byte_count() - 1);
+    }
+    else
+    {
+        encode_log_argument_header(destination, LogArgumentType::Pointer);
+        encode_log_argument_value(destination, reinterpret_cast<uintptr>(argument));
+    }
+}
+
+} // namespace Detail
+
+#pragma endregion
+
+//
+// Asynchronous, binary logger.
+//
+// A log statement only copies the address of its call site (see `LogSite`), a timestamp and the raw arguments into
+// the ring buffer of the calling thread, which requires no locks and no system calls. A background thread formats the
+// records and writes them to the console and to the log file, so the threads that log never wait for any output.
+//
+// The format strings use `{}` as the placeholder for the next argument, regardless of its type. Supported arguments
+// are booleans, characters, integers, enumerations, floating point numbers, strings (`const char*`, `StringView` and
+// `String`) and pointers.
+//
+// When the ring buffer of a thread is full, new records are dropped (the logging thread never blocks) and counted;
+// the number of dropped records is reported in the log. Fatal records are flushed synchronously, and the pending
+// records are also flushed when the process crashes.
+//
+class Logger
+{
+public:
+    static constexpr u32 maximum_thread_count = 128;
+    static constexpr usize thread_buffer_capacity = 64 * KiB;
+
+public:
+    //
+    // Opens the log file (an empty path only logs to the console) and starts the background thread. Failing to open
+    // the log file isn't treated as an error. Returns false if the logger has already been initialized or if the
+    // background thread can't be created.
+    //
+    static bool initialize(StringView log_filepath);
+
+    // Writes the pending records and stops the background thread. No other thread must log after the shutdown.
+    static void shutdown();
+
+    NODISCARD static bool is_initialized();
+
+    //
+    // Sets the name of the calling thread, as displayed in the log. Invoked automatically when the thread name is set
+    // by `Thread::apply_current_thread_description`.
+    //
+    static void set_current_thread_name(StringView name);
+
+    // Formats and writes all the records that have been published so far, blocking the calling thread.
+    static void flush();
+
+    //
+    // Invoked by the platform crash handler. Writes the pending records (if the background thread isn't in the middle
+    // of writing them) followed by the crash reason.
+    //
+    static void flush_from_crash_handler(const char* crash_reason);
+
+    // Returns the number of records that have been dropped because the ring buffer of their thread was full.
+    NODISCARD static u64 get_dropped_record_count();
+
+public:
+    template<typename... Arguments>
+    ALWAYS_INLINE static void write(const LogSite& site, const Arguments&... arguments)
+    {
+        const usize payload_size = (static_cast<usize>(0) + ... + Detail::get_encoded_log_argument_size(arguments));
+        u8* payload = begin_record(site, payload_size);
+        if (payload == nullptr)
+            return;
+
+        (Detail::encode_log_argument(payload, arguments), ...);
+        end_record();
+
+        if (site.severity == LogSeverity::Fatal)
+            UNLIKELY flush();
+    }
+
+private:
+    // Returns null if the logger isn't initialized or if the ring buffer is full, in which case the record is dropped.
+    static u8* begin_record(const LogSite& site, usize payload_size);
+
+    // Publishes the record to the background thread.
+    static void end_record();
+
+    static void install_crash_handler();
+    static void uninstall_crash_handler();
+};
+
+} // namespace CaveGame
+
+// Logs a message with the given severity. The format must be a string literal, with a `{}` placeholder per argument.
+#define CAVE_LOG(severity, format, ...)                                                              \
+    do                                                                                               \
+    {                                                                                                \
+        static constexpr ::CaveGame::LogSite cave_log_site { severity, format, __FILE__, __LINE__ }; \
+        ::CaveGame::Logger::write(cave_log_site, ##__VA_ARGS__);                                     \
+    } while (false)
+
+#if CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_TRACE
+    #define CAVE_LOG_TRACE(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Trace, format, ##__VA_ARGS__)
+#else
+    #define CAVE_LOG_TRACE(...)
+#endif // CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_TRACE
+
+#if CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_DEBUG
+    #define CAVE_LOG_DEBUG(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Debug, format, ##__VA_ARGS__)
+#else
+    #define CAVE_LOG_DEBUG(...)
+#endif // CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_DEBUG
+
+#if CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_INFO
+    #define CAVE_LOG_INFO(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Info, format, ##__VA_ARGS__)
+#else
+    #define CAVE_LOG_INFO(...)
+#endif // CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_INFO
+
+#if CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_WARNING
+    #define CAVE_LOG_WARNING(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Warning, format, ##__VA_ARGS__)
+#else
+    #define CAVE_LOG_WARNING(...)
+#endif // CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_WARNING
+
+#if CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_ERROR
+    #define CAVE_LOG_ERROR(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Error, format, ##__VA_ARGS__)
+#else
+    #define CAVE_LOG_ERROR(...)
+#endif // CAVE_LOG_MINIMUM_SEVERITY <= CAVE_LOG_SEVERITY_ERROR
+
+// Fatal messages can't be removed at compile time.
+#define CAVE_LOG_FATAL(format, ...) CAVE_LOG(::CaveGame::LogSeverity::Fatal, format, ##__VA_ARGS__)
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/Geometry.h>
+
+#if CAVE_SIMD_AVX2
+    #include <immintrin.h>
+#endif // CAVE_SIMD_AVX2
+
+namespace CaveGame
+{
+
+// Bitmask with the bits of the first `lane_count` lanes of a packet set.
+NODISCARD ALWAYS_INLINE static u32 get_valid_lanes_mask(usize box_count, usize packet_index)
+{
+    const usize first_box_index = packet_index * AABBPacket::lane_count;
+    const usize remaining_box_count = box_count - first_box_index;
+    if (remaining_box_count >= AABBPacket::lane_count)
+        return (1U << AABBPacket::lane_count) - 1;
+    return (1U << remaining_box_count) - 1;
+}
+
+//
+// Appends the indices of the lanes whose bit is set in `lanes_mask` to the `out_indices` buffer.
+// The buffer must have room for all eight lanes. Returns the number of indices that were written.
+//
+NODISCARD ALWAYS_INLINE static usize compact_lane_indices(u32 lanes_mask, u32 base_index, u32* out_indices)
+{
+    // NOTE: The write is performed unconditionally and only the cursor advancement depends on the mask,
+    // which avoids a hard to predict branch per lane.
+    usize written_count = 0;
+    for (u32 lane = 0; lane < AABBPacket::lane_count; ++lane)
+    {
+        out_indices[written_count] = base_index + lane;
+        written_count += (lanes_mask >> lane) & 1;
+    }
+    return written_count;
+}
+
+#pragma region AABB
+
+void AABBPacket::pack(const AABB* boxes, usize box_count, AABBPacket* out_packets)
+{
+    const usize packet_count = (box_count + lane_count - 1) / lane_count;
+    for (usize packet_index = 0; packet_index < packet_count; ++packet_index)
+    {
+        AABBPacket& packet = out_packets[packet_index];
+        packet = AABBPacket();
+
+        const usize first_box_index = packet_index * lane_count;
+        for (u32 lane = 0; lane < lane_count && first_box_index + lane < box_count; ++lane)
+            packet.set(lane, boxes[first_box_index + lane]);
+    }
+}
+
+#pragma endregion
+
+#pragma region Ray
+
+bool Ray::intersects(const AABB& box, float max_distance, float& out_distance) const
+{
+    if (box.is_empty())
+        return false;
+
+    const float t1_x = (box.min.x - origin.x) * inv_direction.x;
+    const float t2_x = (box.max.x - origin.x) * inv_direction.x;
+    const float t1_y = (box.min.y - origin.y) * inv_direction.y;
+    const float t2_y = (box.max.y - origin.y) * inv_direction.y;
+    const float t1_z = (box.min.z - origin.z) * inv_direction.z;
+    const float t2_z = (box.max.z - origin.z) * inv_direction.z;
+
+    float t_enter = Math::max(Math::max(Math::min(t1_x, t2_x), Math::min(t1_y, t2_y)), Math::min(t1_z, t2_z));
+    float t_exit = Math::min(Math::min(Math::max(t1_x, t2_x), Math::max(t1_y, t2_y)), Math::max(t1_z, t2_z));
+
+    t_enter = Math::max(t_enter, 0.0F);
+    t_exit = Math::min(t_exit, max_distance);
+    if (t_enter > t_exit)
+        return false;
+
+    out_distance = t_enter;
+    return true;
+}
+
+u32 Ray::intersects(const AABBPacket& packet, float max_distance, float out_distances[AABBPacket::lane_count]) const
+{
+#if CAVE_SIMD_AVX2
+    const __m256 min_x = _mm256_load_ps(packet.min_x);
+    const __m256 min_y = _mm256_load_ps(packet.min_y);
+    const __m256 min_z = _mm256_load_ps(packet.min_z);
+    const __m256 max_x = _mm256_load_ps(packet.max_x);
+    const __m256 max_y = _mm256_load_ps(packet.max_y);
+    const __m256 max_z = _mm256_load_ps(packet.max_z);
+
+    const __m256 origin_x = _mm256_set1_ps(origin.x);
+    const __m256 origin_y = _mm256_set1_ps(origin.y);
+    const __m256 origin_z = _mm256_set1_ps(origin.z);
+    const __m256 inv_direction_x = _mm256_set1_ps(inv_direction.x);
+    const __m256 inv_direction_y = _mm256_set1_ps(inv_direction.y);
+    const __m256 inv_direction_z = _mm256_set1_ps(inv_direction.z);
+
+    const __m256 t1_x = _mm256_mul_ps(_mm256_sub_ps(min_x, origin_x), inv_direction_x);
+    const __m256 t2_x = _mm256_mul_ps(_mm256_sub_ps(max_x, origin_x), inv_direction_x);
+    const __m256 t1_y = _mm256_mul_ps(_mm256_sub_ps(min_y, origin_y), inv_direction_y);
+    const __m256 t2_y = _mm256_mul_ps(_mm256_sub_ps(max_y, origin_y), inv_direction_y);
+    const __m256 t1_z = _mm256_mul_ps(_mm256_sub_ps(min_z, origin_z), inv_direction_z);
+    const __m256 t2_z = _mm256_mul_ps(_mm256_sub_ps(max_z, origin_z), inv_direction_z);
+
+    __m256 t_enter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t1_x, t2_x), _mm256_min_ps(t1_y, t2_y)), _mm256_min_ps(t1_z, t2_z));
+    __m256 t_exit = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t1_x, t2_x), _mm256_max_ps(t1_y, t2_y)), _mm256_max_ps(t1_z, t2_z));
+
+    t_enter = _mm256_max_ps(t_enter, _mm256_setzero_ps());
+    t_exit = _mm256_min_ps(t_exit, _mm256_set1_ps(max_distance));
+
+    // Empty boxes (minimum corner greater than the maximum corner) would otherwise produce valid slabs.
+    const __m256 is_not_empty = _mm256_and_ps(
+        _mm256_and_ps(_mm256_cmp_ps(min_x, max_x, _CMP_LE_OQ), _mm256_cmp_ps(min_y, max_y, _CMP_LE_OQ)),
+        _mm256_cmp_ps(min_z, max_z, _CMP_LE_OQ)
+    );
+    const __m256 is_hit = _mm256_and_ps(_mm256_cmp_ps(t_enter, t_exit, _CMP_LE_OQ), is_not_empty);
+
+    _mm256_storeu_ps(out_distances, t_enter);
+    return static_cast<u32>(_mm256_movemask_ps(is_hit));
+#else
+    u32 hit_mask = 0;
+    for (u32 lane = 0; lane < AABBPacket::lane_count; ++lane)
+    {
+        if (intersects(packet.get(lane), max_distance, out_distances[lane]))
+            hit_mask |= (1U << lane);
+    }
+    return hit_mask;
+#endif // CAVE_SIMD_AVX2
+}
+
+bool Ray::raycast(const AABBPacket* packets, usize box_count, float max_distance, u32& out_box_index, float& out_distance) const
+{
+    const usize packet_count = (box_count + AABBPacket::lane_count - 1) / AABBPacket::lane_count;
+
+    bool has_hit = false;
+    float closest_distance = max_distance;
+    u32 closest_box_index = 0;
+
+    for (usize packet_index = 0; packet_index < packet_count; ++packet_index)
+    {
+        float distances[AABBPacket::lane_count];
+        u32 hit_mask = intersects(packets[packet_index], closest_distance, distances);
+        hit_mask &= get_valid_lanes_mask(box_count, packet_index);
+
+        if (hit_mask == 0)
+            continue;
+
+        for (u32 lane = 0; lane < AABBPacket::lane_count; ++lane)
+        {
+            if ((hit_mask >> lane) & 1)
+            {
+                if (!has_hit || distances[lane] < closest_distance)
+                {
+                    // NOTE: Shrinking the maximum distance allows the following packets to reject boxes
+                    // that are further away than the current closest hit.
+                    closest_distance = distances[lane];
+                    closest_box_index = static_cast<u32>(packet_index * AABBPacket::lane_count + lane);
+                    has_hit = true;
+                }
+            }
+        }
+    }
+
+    if (has_hit)
+    {
+        out_box_index = closest_box_index;
+        out_distance = closest_distance;
+    }
+    return has_hit;
+}
+
+#pragma endregion
+
+#pragma region Frustum
+
+Frustum Frustum::from_view_projection(const Matrix4& view_projection)
+{
+    const float(*m)[4] = view_projection.m;
+
+    // With the row-vector convention, the clip-space coordinates are obtained by multiplying the point
+    // with the matrix columns. Thus, each plane is a linear combination of the matrix columns.
+    const Vector4 column_x = Vector4(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const Vector4 column_y = Vector4(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const Vector4 column_z = Vector4(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const Vector4 column_w = Vector4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    const Vector4 plane_equations[PlaneIndex::Count] = {
+        column_w + column_x, // Left:   -w <= x.
+        column_w - column_x, // Right:   x <= w.
+        column_w + column_y, // Bottom: -w <= y.
+        column_w - column_y, // Top:     y <= w.
+        column_z,            // Near:    0 <= z.
+        column_w - column_z, // Far:     z <= w.
+    };
+
+    Frustum frustum;
+    for (u8 plane_index = 0; plane_index < PlaneIndex::Count; ++plane_index)
+    {
+        const Vector4& equation = plane_equations[plane_index];
+        frustum.planes[plane_index] = Plane::normalize(Plane(Vector3(equation.x, equation.y, equation.z), equation.w));
+    }
+
+    return frustum;
+}
+
+bool Frustum::is_visible(const AABB& box) const
+{
+    for (u8 plane_index = 0; plane_index < PlaneIndex::Count; ++plane_index)
+    {
+        const Plane& plane = planes[plane_index];
+
+        // The corner of the box that is furthest along the plane normal (the "positive vertex").
+        // If even this corner is behind the plane, the whole box is outside the frustum.
+        const float positive_x = (plane.normal.x >= 0.0F) ? box.max.x : box.min.x;
+        const float positive_y = (plane.normal.y >= 0.0F) ? box.max.y : box.min.y;
+        const float positive_z = (plane.normal.z >= 0.0F) ? box.max.z : box.min.z;
+
+        const float distance = (plane.normal.x * positive_x + plane.normal.y * positive_y) + (plane.normal.z * positive_z + plane.distance);
+        if (distance < 0.0F)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::is_visible(const Sphere& sphere) const
+{
+    for (u8 plane_index = 0; plane_index < PlaneIndex::Count; ++plane_index)
+    {
+        if (planes[plane_index].signed_distance(sphere.center) < -sphere.radius)
+            return false;
+    }
+
+    return true;
+}
+
+u32 Frustum::is_visible(const AABBPacket& packet) const
+{
+#if CAVE_SIMD_AVX2
+    const __m256 min_x = _mm256_load_ps(packet.min_x);
+    const __m256 min_y = _mm256_load_ps(packet.min_y);
+    const __m256 min_z = _mm256_load_ps(packet.min_z);
+    const __m256 max_x = _mm256_load_ps(packet.max_x);
+    const __m256 max_y = _mm256_load_ps(packet.max_y);
+    const __m256 max_z = _mm256_load_ps(packet.max_z);
+
+    __m256 is_outside = _mm256_setzero_ps();
+    for (u8 plane_index = 0; plane_index < PlaneIndex::Count; ++plane_index)
+    {
+        const Plane& plane = planes[plane_index];
+
+        // NOTE: The plane normal is the same for all lanes, so the positive vertex can be selected
+        // once per plane instead of blending per lane.
+        const __m256 positive_x = (plane.normal.x >= 0.0F) ? max_x : min_x;
+        const __m256 positive_y = (plane.normal.y >= 0.0F) ? max_y : min_y;
+        const __m256 positive_z = (plane.normal.z >= 0.0F) ? max_z : min_z;
+
+        const __m256 distance_xy = _mm256_add_ps(
+            _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), positive_x),
+            _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), positive_y)
+        );
+        const __m256 distance_zw = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.z), positive_z), _mm256_set1_ps(plane.distance));
+        const __m256 distance = _mm256_add_ps(distance_xy, distance_zw);
+
+        is_outside = _mm256_or_ps(is_outside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+
+    const u32 outside_mask = static_cast<u32>(_mm256_movemask_ps(is_outside));
+    return ~outside_mask & ((1U << AABBPacket::lane_count) - 1);
+#else
+    u32 visible_mask = 0;
+    for (u32 lane = 0; lane < AABBPacket::lane_count; ++lane)
+    {
+        if (is_visible(packet.get(lane)))
+            visible_mask |= (1U << lane);
+    }
+    return visible_mask;
+#endif // CAVE_SIMD_AVX2
+}
+
+void Frustum::cull(const AABBPacket* packets, usize box_count, Vector<u32>& out_visible_indices) const
+{
+    const usize packet_count = (box_count + AABBPacket::lane_count - 1) / AABBPacket::lane_count;
+    const usize initial_count = out_visible_indices.count();
+
+    // Reserve enough space for the worst case (all boxes being visible), including the padding lanes of
+    // the last packet, so the compaction can always write all eight lanes.
+    out_visible_indices.set_count_uninitialized(initial_count + packet_count * AABBPacket::lane_count);
+    u32* visible_indices = out_visible_indices.elements() + initial_count;
+    usize visible_count = 0;
+
+    for (usize packet_index = 0; packet_index < packet_count; ++packet_index)
+    {
+        const u32 visible_mask = is_visible(packets[packet_index]) & get_valid_lanes_mask(box_count, packet_index);
+        const u32 base_index = static_cast<u32>(packet_index * AABBPacket::lane_count);
+        visible_count += compact_lane_indices(visible_mask, base_index, visible_indices + visible_count);
+    }
+
+    out_visible_indices.set_count_uninitialized(initial_count + visible_count);
+}
+
+void Frustum::cull(const AABB* boxes, usize box_count, Vector<u32>& out_visible_indices) const
+{
+    const usize packet_count = (box_count + AABBPacket::lane_count - 1) / AABBPacket::lane_count;
+    const usize initial_count = out_visible_indices.count();
+
+    out_visible_indices.set_count_uninitialized(initial_count + packet_count * AABBPacket::lane_count);
+    u32* visible_indices = out_visible_indices.elements() + initial_count;
+    usize visible_count = 0;
+
+    for (usize packet_index = 0; packet_index < packet_count; ++packet_index)
+    {
+        // NOTE: Packing a single packet at a time keeps the working set in the L1 cache.
+        const usize first_box_index = packet_index * AABBPacket::lane_count;
+        AABBPacket packet;
+        AABBPacket::pack(boxes + first_box_index, Math::min<usize>(box_count - first_box_index, AABBPacket::lane_count), &packet);
+
+        const u32 visible_mask = is_visible(packet) & get_valid_lanes_mask(box_count, packet_index);
+        visible_count += compact_lane_indices(visible_mask, static_cast<u32>(first_box_index), visible_indices + visible_count);
+    }
+
+    out_visible_indices.set_count_uninitialized(initial_count + visible_count);
+}
+
+#pragma endregion
+
+} // namespace CaveGame
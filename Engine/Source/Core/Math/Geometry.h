@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Vector.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Math/Matrix.h>
+#include <Core/Math/Vector.h>
+
+namespace CaveGame
+{
+
+#pragma region AABB
+
+//
+// Axis-aligned bounding box, described by its minimum and maximum corners.
+// A box whose minimum corner is greater than its maximum corner (on any axis) is considered empty.
+//
+struct AABB
+{
+public:
+    // Returns a box that contains no points. Expanding it by any point yields a box containing only that point.
+    NODISCARD ALWAYS_INLINE static constexpr AABB empty()
+    {
+        const AABB result = AABB(Vector3(Math::large_number), Vector3(-Math::large_number));
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr AABB from_center_and_extents(Vector3 center, Vector3 extents)
+    {
+        const AABB result = AABB(center - extents, center + extents);
+        return result;
+    }
+
+public:
+    ALWAYS_INLINE constexpr AABB()
+        : min(0.0F)
+        , max(0.0F)
+    {}
+
+    ALWAYS_INLINE constexpr AABB(Vector3 in_min, Vector3 in_max)
+        : min(in_min)
+        , max(in_max)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr Vector3 center() const { return (min + max) * 0.5F; }
+    NODISCARD ALWAYS_INLINE constexpr Vector3 extents() const { return (max - min) * 0.5F; }
+
+    NODISCARD ALWAYS_INLINE constexpr bool is_empty() const { return (min.x > max.x) || (min.y > max.y) || (min.z > max.z); }
+
+    NODISCARD ALWAYS_INLINE constexpr bool contains(Vector3 point) const
+    {
+        // clang-format off
+        return (point.x >= min.x) && (point.x <= max.x) &&
+               (point.y >= min.y) && (point.y <= max.y) &&
+               (point.z >= min.z) && (point.z <= max.z);
+        // clang-format on
+    }
+
+    NODISCARD ALWAYS_INLINE constexpr bool intersects(const AABB& other) const
+    {
+        // clang-format off
+        return (min.x <= other.max.x) && (max.x >= other.min.x) &&
+               (min.y <= other.max.y) && (max.y >= other.min.y) &&
+               (min.z <= other.max.z) && (max.z >= other.min.z);
+        // clang-format on
+    }
+
+    // Grows the box (if required) such that it also contains the provided point.
+    ALWAYS_INLINE constexpr void expand(Vector3 point)
+    {
+        min = Vector3(Math::min(min.x, point.x), Math::min(min.y, point.y), Math::min(min.z, point.z));
+        max = Vector3(Math::max(max.x, point.x), Math::max(max.y, point.y), Math::max(max.z, point.z));
+    }
+
+    // Grows the box (if required) such that it also contains the provided box.
+    ALWAYS_INLINE constexpr void expand(const AABB& other)
+    {
+        expand(other.min);
+        expand(other.max);
+    }
+
+public:
+    Vector3 min;
+    Vector3 max;
+};
+
+//
+// Structure-of-arrays representation of eight axis-aligned bounding boxes, laid out such that
+// each component of all eight boxes can be loaded into a single 256-bit register.
+// Packets are the unit of work for the batched frustum and ray tests.
+//
+struct alignas(32) AABBPacket
+{
+public:
+    static constexpr u32 lane_count = 8;
+
+public:
+    // Initializes all lanes with empty boxes, which are rejected by both the frustum and the ray tests.
+    ALWAYS_INLINE AABBPacket()
+    {
+        for (u32 lane = 0; lane < lane_count; ++lane)
+            set(lane, AABB::empty());
+    }
+
+    ALWAYS_INLINE void set(u32 lane, const AABB& box)
+    {
+        CAVE_MATH_ASSERT(lane < lane_count);
+        min_x[lane] = box.min.x;
+        min_y[lane] = box.min.y;
+        min_z[lane] = box.min.z;
+        max_x[lane] = box.max.x;
+        max_y[lane] = box.max.y;
+        max_z[lane] = box.max.z;
+    }
+
+    NODISCARD ALWAYS_INLINE AABB get(u32 lane) const
+    {
+        CAVE_MATH_ASSERT(lane < lane_count);
+        return AABB(Vector3(min_x[lane], min_y[lane], min_z[lane]), Vector3(max_x[lane], max_y[lane], max_z[lane]));
+    }
+
+    //
+    // Converts an array of boxes into packets. The `out_packets` buffer must be able to store at least
+    // `(box_count + 7) / 8` packets. Lanes of the last packet that have no corresponding box are left empty.
+    //
+    static void pack(const AABB* boxes, usize box_count, AABBPacket* out_packets);
+
+public:
+    float min_x[lane_count];
+    float min_y[lane_count];
+    float min_z[lane_count];
+    float max_x[lane_count];
+    float max_y[lane_count];
+    float max_z[lane_count];
+};
+
+#pragma endregion
+
+#pragma region Sphere
+
+struct Sphere
+{
+public:
+    ALWAYS_INLINE constexpr Sphere()
+        : center(0.0F)
+        , radius(0.0F)
+    {}
+
+    ALWAYS_INLINE constexpr Sphere(Vector3 in_center, float in_radius)
+        : center(in_center)
+        , radius(in_radius)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr bool contains(Vector3 point) const { return Vector3::length_squared(point - center) <= radius * radius; }
+
+    NODISCARD ALWAYS_INLINE constexpr bool intersects(const Sphere& other) const
+    {
+        const float radius_sum = radius + other.radius;
+        return Vector3::length_squared(other.center - center) <= radius_sum * radius_sum;
+    }
+
+public:
+    Vector3 center;
+    float radius;
+};
+
+#pragma endregion
+
+#pragma region Plane
+
+//
+// Plane described by the equation `dot(normal, point) + distance = 0`.
+// Points for which the left-hand side of the equation is positive are considered to be in front of the plane.
+//
+struct Plane
+{
+public:
+    // Returns the plane with a unit-length normal that describes the same set of points.
+    NODISCARD ALWAYS_INLINE static Plane normalize(Plane plane)
+    {
+        const float length = Vector3::length(plane.normal);
+        CAVE_MATH_ASSERT(length > Math::small_number);
+        const float inv_length = 1.0F / length;
+        const Plane result = Plane(plane.normal * inv_length, plane.distance * inv_length);
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr Plane from_normal_and_point(Vector3 normal, Vector3 point)
+    {
+        const Plane result = Plane(normal, -Vector3::dot(normal, point));
+        return result;
+    }
+
+public:
+    ALWAYS_INLINE constexpr Plane()
+        : normal(0.0F, 1.0F, 0.0F)
+        , distance(0.0F)
+    {}
+
+    ALWAYS_INLINE constexpr Plane(Vector3 in_normal, float in_distance)
+        : normal(in_normal)
+        , distance(in_distance)
+    {}
+
+public:
+    // Returns the signed distance from the plane to the given point. Only meaningful if the plane is normalized.
+    NODISCARD ALWAYS_INLINE constexpr float signed_distance(Vector3 point) const { return Vector3::dot(normal, point) + distance; }
+
+public:
+    Vector3 normal;
+    float distance;
+};
+
+#pragma endregion
+
+#pragma region Ray
+
+struct Ray
+{
+public:
+    ALWAYS_INLINE constexpr Ray()
+        : origin(0.0F)
+        , direction(0.0F, 0.0F, 1.0F)
+        , inv_direction(Math::kinda_large_number, Math::kinda_large_number, 1.0F)
+    {}
+
+    //
+    // The direction is not required to be normalized, but the distances reported by the intersection
+    // functions are expressed in multiples of its length.
+    //
+    ALWAYS_INLINE constexpr Ray(Vector3 in_origin, Vector3 in_direction)
+        : origin(in_origin)
+        , direction(in_direction)
+        , inv_direction(safe_inverse(in_direction.x), safe_inverse(in_direction.y), safe_inverse(in_direction.z))
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE constexpr Vector3 point_at(float distance) const { return origin + direction * distance; }
+
+    //
+    // Computes the intersection between the ray and the box using the slab method.
+    // Returns true if the ray hits the box within `[0, max_distance]`, and writes the entry distance
+    // (or zero, if the origin is inside the box) to `out_distance`.
+    //
+    NODISCARD bool intersects(const AABB& box, float max_distance, float& out_distance) const;
+
+    //
+    // Tests the ray against all eight boxes of the packet simultaneously.
+    // Returns a bitmask where bit `N` is set if the box stored in lane `N` is hit within `[0, max_distance]`.
+    // The entry distances of the hit lanes are written to `out_distances`; the values of the other lanes are unspecified.
+    //
+    NODISCARD u32 intersects(const AABBPacket& packet, float max_distance, float out_distances[AABBPacket::lane_count]) const;
+
+    //
+    // Finds the closest box hit by the ray within `[0, max_distance]`.
+    // Returns false if no box is hit, in which case the output parameters are not modified.
+    //
+    NODISCARD bool raycast(const AABBPacket* packets, usize box_count, float max_distance, u32& out_box_index, float& out_distance) const;
+
+private:
+    //
+    // Avoids producing an infinity when the direction has a zero component. A very large value still
+    // produces correct slab distances without introducing NaNs in the `(min - origin) * inv_direction` product.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr float safe_inverse(float value)
+    {
+        if (Math::abs(value) < Math::small_number)
+            return (value < 0.0F) ? -Math::kinda_large_number : Math::kinda_large_number;
+        return 1.0F / value;
+    }
+
+public:
+    Vector3 origin;
+    Vector3 direction;
+    Vector3 inv_direction;
+};
+
+#pragma endregion
+
+#pragma region Frustum
+
+//
+// View frustum described by six inward-facing planes.
+// A point is inside the frustum if it is in front of (or on) all six planes.
+//
+struct Frustum
+{
+public:
+    enum PlaneIndex : u8
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count,
+    };
+
+public:
+    //
+    // Extracts the frustum planes from a view-projection matrix (Gribb-Hartmann method).
+    // The matrix is expected to follow the row-vector convention (`clip = point * matrix`) and to map
+    // the depth to the `[0, 1]` range, as used by Direct3D.
+    //
+    NODISCARD static Frustum from_view_projection(const Matrix4& view_projection);
+
+public:
+    NODISCARD bool is_visible(const AABB& box) const;
+    NODISCARD bool is_visible(const Sphere& sphere) const;
+
+    //
+    // Tests all eight boxes of the packet against the frustum simultaneously.
+    // Returns a bitmask where bit `N` is set if the box stored in lane `N` is (potentially) visible.
+    // The test is conservative: boxes that intersect the frustum corners might be reported as visible.
+    //
+    NODISCARD u32 is_visible(const AABBPacket& packet) const;
+
+    //
+    // Culls `box_count` boxes, stored as packets, against the frustum. The indices of the visible boxes are
+    // appended, in increasing order, to `out_visible_indices`.
+    //
+    void cull(const AABBPacket* packets, usize box_count, Vector<u32>& out_visible_indices) const;
+
+    //
+    // Wrapper around `Frustum::cull` that packs the boxes on the fly.
+    // Prefer storing the bounds as packets when they are culled every frame.
+    //
+    void cull(const AABB* boxes, usize box_count, Vector<u32>& out_visible_indices) const;
+
+public:
+    Plane planes[PlaneIndex::Count];
+};
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.h>
+#include <Core/Math/Vector.h>
+
+namespace CaveGame
+{
+
+//
+// Builds an array of `Count` elements by invoking `generator(index)` for every index.
+// When called in a constant expression (for example, to initialize a `static constexpr` variable) the
+// table is computed by the compiler and stored in the read-only data section of the executable.
+//
+template<typename T, usize Count, typename GeneratorFunction>
+NODISCARD ALWAYS_INLINE constexpr Array<T, Count> make_lookup_table(GeneratorFunction generator)
+{
+    Array<T, Count> table = {};
+    for (usize index = 0; index < Count; ++index)
+        table.m_elements[index] = generator(index);
+    return table;
+}
+
+//
+// Compile-time tables that describe the geometry of a unit cube.
+// Intended to be used by the voxel meshing and neighbor traversal code.
+//
+class CubeTables
+{
+public:
+    enum class Face : u8
+    {
+        PositiveX = 0,
+        NegativeX = 1,
+        PositiveY = 2,
+        NegativeY = 3,
+        PositiveZ = 4,
+        NegativeZ = 5,
+        Count = 6,
+    };
+
+    static constexpr usize face_count = static_cast<usize>(Face::Count);
+    static constexpr usize corner_count = 8;
+    static constexpr usize neighbor_count = 26;
+
+public:
+    // The outward-facing normal of each cube face, indexed by `CubeTables::Face`.
+    static constexpr Array<Vector3, face_count> face_normals = make_lookup_table<Vector3, face_count>(
+        [](usize face_index) -> Vector3
+        {
+            const float sign = (face_index % 2 == 0) ? 1.0F : -1.0F;
+            const usize axis = face_index / 2;
+            return Vector3((axis == 0) ? sign : 0.0F, (axis == 1) ? sign : 0.0F, (axis == 2) ? sign : 0.0F);
+        }
+    );
+
+    // The offset of each corner relative to the minimum corner of the cube. Bit N of the corner index
+    // selects the maximum side of the cube along the axis N.
+    static constexpr Array<Vector3, corner_count> corner_offsets = make_lookup_table<Vector3, corner_count>(
+        [](usize corner_index) -> Vector3
+        {
+            return Vector3(
+                static_cast<float>(corner_index & 1),
+                static_cast<float>((corner_index >> 1) & 1),
+                static_cast<float>((corner_index >> 2) & 1)
+            );
+        }
+    );
+
+    // The offsets towards all cubes that share a face, an edge or a corner with the cube.
+    static constexpr Array<Vector3, neighbor_count> neighbor_offsets = make_lookup_table<Vector3, neighbor_count>(
+        [](usize neighbor_index) -> Vector3
+        {
+            // There are 27 cells in a 3x3x3 block and the central one (index 13) is the cube itself.
+            const usize cell_index = (neighbor_index < 13) ? neighbor_index : (neighbor_index + 1);
+            return Vector3(
+                static_cast<float>(cell_index % 3) - 1.0F,
+                static_cast<float>((cell_index / 3) % 3) - 1.0F,
+                static_cast<float>(cell_index / 9) - 1.0F
+            );
+        }
+    );
+};
+
+} // namespace CaveGame
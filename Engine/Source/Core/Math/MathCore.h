@@ -52,25 +52,25 @@ public:
     //
 
     template<typename T>
-    NODISCARD ALWAYS_INLINE static T min(T a, T b)
+    NODISCARD ALWAYS_INLINE static constexpr T min(T a, T b)
     {
         return (a < b) ? a : b;
     }
 
     template<typename T>
-    NODISCARD ALWAYS_INLINE static T max(T a, T b)
+    NODISCARD ALWAYS_INLINE static constexpr T max(T a, T b)
     {
         return (a > b) ? a : b;
     }
 
     template<typename T>
-    NODISCARD ALWAYS_INLINE static T clamp(T value, T range_min, T range_max)
+    NODISCARD ALWAYS_INLINE static constexpr T clamp(T value, T range_min, T range_max)
     {
         return Math::min(Math::max(value, range_min), range_max);
     }
 
     template<typename T>
-    NODISCARD ALWAYS_INLINE static T abs(T value)
+    NODISCARD ALWAYS_INLINE static constexpr T abs(T value)
     {
         return (value < T(0)) ? -value : value;
     }
@@ -85,7 +85,7 @@ public:
     NODISCARD static float sin(float value);
     NODISCARD static float cos(float value);
     NODISCARD static float tan(float value);
-    NODISCARD static void sin_and_cos(float value, float& out_sin, float& out_cos);
+    static void sin_and_cos(float value, float& out_sin, float& out_cos);
 
     NODISCARD static float asin(float value);
     NODISCARD static float acos(float value);
@@ -19,7 +19,7 @@ namespace CaveGame
 struct Matrix3
 {
 public:
-    NODISCARD ALWAYS_INLINE static Matrix3 identity()
+    NODISCARD ALWAYS_INLINE static constexpr Matrix3 identity()
     {
         // clang-format off
         const Matrix3 result = Matrix3(
@@ -32,15 +32,14 @@ public:
     }
 
 public:
-    ALWAYS_INLINE Matrix3()
+    ALWAYS_INLINE constexpr Matrix3()
         : rows { Vector3(0), Vector3(0), Vector3(0) }
     {}
 
-    ALWAYS_INLINE Matrix3(const Matrix3& other)
-        : rows { other.rows[0], other.rows[1], other.rows[2] }
-    {}
+    constexpr Matrix3(const Matrix3& other) = default;
+    constexpr Matrix3& operator=(const Matrix3& other) = default;
 
-    ALWAYS_INLINE Matrix3(Vector3 row0, Vector3 row1, Vector3 row2)
+    ALWAYS_INLINE constexpr Matrix3(Vector3 row0, Vector3 row1, Vector3 row2)
         : rows { row0, row1, row2 }
     {}
 
@@ -60,7 +59,7 @@ public:
 struct Matrix4
 {
 public:
-    NODISCARD ALWAYS_INLINE static Matrix4 identity()
+    NODISCARD ALWAYS_INLINE static constexpr Matrix4 identity()
     {
         // clang-format off
         const Matrix4 result = Matrix4(
@@ -74,15 +73,14 @@ public:
     }
 
 public:
-    ALWAYS_INLINE Matrix4()
+    ALWAYS_INLINE constexpr Matrix4()
         : rows { Vector4(0), Vector4(0), Vector4(0), Vector4(0) }
     {}
 
-    ALWAYS_INLINE Matrix4(const Matrix4& other)
-        : rows { other.rows[0], other.rows[1], other.rows[2], other.rows[3] }
-    {}
+    constexpr Matrix4(const Matrix4& other) = default;
+    constexpr Matrix4& operator=(const Matrix4& other) = default;
 
-    ALWAYS_INLINE Matrix4(Vector4 row0, Vector4 row1, Vector4 row2, Vector4 row3)
+    ALWAYS_INLINE constexpr Matrix4(Vector4 row0, Vector4 row1, Vector4 row2, Vector4 row3)
         : rows { row0, row1, row2, row3 }
     {}
 
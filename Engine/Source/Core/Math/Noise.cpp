@@ -0,0 +1,826 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Math/Noise.h>
+#include <bit>
+
+#if CAVE_SIMD_AVX2
+    #include <immintrin.h>
+#endif // CAVE_SIMD_AVX2
+
+namespace CaveGame
+{
+
+//
+// NOTE: All noise algorithms are written once, against the "lanes" interface below, and are instantiated both for
+// scalar values and for AVX2 registers. Every operation of the interface maps to exactly one IEEE-754 operation (or
+// to an exact integer operation), which is what guarantees that both instantiations produce bit-identical results.
+// For this reason, the floor function is implemented using truncation in both code paths (`_mm256_floor_ps` would
+// differ from the scalar code for negative zero) and no fused multiply-add instructions are ever used.
+//
+
+#pragma region Lanes
+
+struct ScalarLanes
+{
+    using Float = float;
+    using Int = i32;
+    using Mask = bool;
+
+    static constexpr u32 width = 1;
+
+    NODISCARD ALWAYS_INLINE static Float splat(float value) { return value; }
+    NODISCARD ALWAYS_INLINE static Int splat_int(i32 value) { return value; }
+    NODISCARD ALWAYS_INLINE static Int lane_indices() { return 0; }
+    ALWAYS_INLINE static void store(float* destination, Float value) { *destination = value; }
+
+    NODISCARD ALWAYS_INLINE static Float add(Float a, Float b) { return a + b; }
+    NODISCARD ALWAYS_INLINE static Float sub(Float a, Float b) { return a - b; }
+    NODISCARD ALWAYS_INLINE static Float mul(Float a, Float b) { return a * b; }
+    NODISCARD ALWAYS_INLINE static Float min(Float a, Float b) { return (a < b) ? a : b; }
+    NODISCARD ALWAYS_INLINE static Float max(Float a, Float b) { return (a > b) ? a : b; }
+    NODISCARD ALWAYS_INLINE static Float sqrt(Float value) { return Math::sqrt(value); }
+
+    // Clears the sign bit, exactly like the vectorized implementation (`Math::abs` would keep the sign of negative zero).
+    NODISCARD ALWAYS_INLINE static Float abs(Float value) { return std::bit_cast<float>(std::bit_cast<u32>(value) & 0x7FFFFFFFU); }
+
+    NODISCARD ALWAYS_INLINE static Float floor(Float value)
+    {
+        const float truncated = static_cast<float>(static_cast<i32>(value));
+        return (truncated > value) ? (truncated - 1.0F) : truncated;
+    }
+
+    NODISCARD ALWAYS_INLINE static Int to_int(Float value) { return static_cast<i32>(value); }
+    NODISCARD ALWAYS_INLINE static Float to_float(Int value) { return static_cast<float>(value); }
+
+    NODISCARD ALWAYS_INLINE static Int add_int(Int a, Int b) { return static_cast<i32>(static_cast<u32>(a) + static_cast<u32>(b)); }
+    NODISCARD ALWAYS_INLINE static Int mul_int(Int a, Int b) { return static_cast<i32>(static_cast<u32>(a) * static_cast<u32>(b)); }
+    NODISCARD ALWAYS_INLINE static Int xor_int(Int a, Int b) { return a ^ b; }
+    NODISCARD ALWAYS_INLINE static Int and_int(Int a, Int b) { return a & b; }
+
+    template<u32 ShiftCount>
+    NODISCARD ALWAYS_INLINE static Int shift_right_int(Int value)
+    {
+        return static_cast<i32>(static_cast<u32>(value) >> ShiftCount);
+    }
+
+    NODISCARD ALWAYS_INLINE static Mask greater(Float a, Float b) { return a > b; }
+    NODISCARD ALWAYS_INLINE static Mask greater_equal(Float a, Float b) { return a >= b; }
+    NODISCARD ALWAYS_INLINE static Mask less(Float a, Float b) { return a < b; }
+    NODISCARD ALWAYS_INLINE static Mask mask_and(Mask a, Mask b) { return a && b; }
+
+    NODISCARD ALWAYS_INLINE static Float select(Mask mask, Float if_true, Float if_false) { return mask ? if_true : if_false; }
+    NODISCARD ALWAYS_INLINE static Float gather(const float* table, Int index) { return table[index]; }
+};
+
+#if CAVE_SIMD_AVX2
+
+struct Avx2Lanes
+{
+    using Float = __m256;
+    using Int = __m256i;
+    using Mask = __m256;
+
+    static constexpr u32 width = 8;
+
+    NODISCARD ALWAYS_INLINE static Float splat(float value) { return _mm256_set1_ps(value); }
+    NODISCARD ALWAYS_INLINE static Int splat_int(i32 value) { return _mm256_set1_epi32(value); }
+    NODISCARD ALWAYS_INLINE static Int lane_indices() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    ALWAYS_INLINE static void store(float* destination, Float value) { _mm256_storeu_ps(destination, value); }
+
+    NODISCARD ALWAYS_INLINE static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    NODISCARD ALWAYS_INLINE static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    NODISCARD ALWAYS_INLINE static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    NODISCARD ALWAYS_INLINE static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+    NODISCARD ALWAYS_INLINE static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+    NODISCARD ALWAYS_INLINE static Float sqrt(Float value) { return _mm256_sqrt_ps(value); }
+    NODISCARD ALWAYS_INLINE static Float abs(Float value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), value); }
+
+    NODISCARD ALWAYS_INLINE static Float floor(Float value)
+    {
+        const Float truncated = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(value));
+        const Float correction = _mm256_and_ps(_mm256_cmp_ps(truncated, value, _CMP_GT_OQ), _mm256_set1_ps(1.0F));
+        return _mm256_sub_ps(truncated, correction);
+    }
+
+    NODISCARD ALWAYS_INLINE static Int to_int(Float value) { return _mm256_cvttps_epi32(value); }
+    NODISCARD ALWAYS_INLINE static Float to_float(Int value) { return _mm256_cvtepi32_ps(value); }
+
+    NODISCARD ALWAYS_INLINE static Int add_int(Int a, Int b) { return _mm256_add_epi32(a, b); }
+    NODISCARD ALWAYS_INLINE static Int mul_int(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+    NODISCARD ALWAYS_INLINE static Int xor_int(Int a, Int b) { return _mm256_xor_si256(a, b); }
+    NODISCARD ALWAYS_INLINE static Int and_int(Int a, Int b) { return _mm256_and_si256(a, b); }
+
+    template<u32 ShiftCount>
+    NODISCARD ALWAYS_INLINE static Int shift_right_int(Int value)
+    {
+        return _mm256_srli_epi32(value, ShiftCount);
+    }
+
+    NODISCARD ALWAYS_INLINE static Mask greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    NODISCARD ALWAYS_INLINE static Mask greater_equal(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    NODISCARD ALWAYS_INLINE static Mask less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    NODISCARD ALWAYS_INLINE static Mask mask_and(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+
+    NODISCARD ALWAYS_INLINE static Float select(Mask mask, Float if_true, Float if_false) { return _mm256_blendv_ps(if_false, if_true, mask); }
+    NODISCARD ALWAYS_INLINE static Float gather(const float* table, Int index) { return _mm256_i32gather_ps(table, index, sizeof(float)); }
+};
+
+#endif // CAVE_SIMD_AVX2
+
+#pragma endregion
+
+#pragma region Hashing
+
+// Large primes used to decorrelate the lattice coordinates before hashing them.
+static constexpr i32 prime_x = 501125321;
+static constexpr i32 prime_y = 1136930381;
+static constexpr i32 prime_z = 1720413743;
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Int hash_2d(typename L::Int seed, typename L::Int x, typename L::Int y)
+{
+    using Int = typename L::Int;
+    Int hash = L::xor_int(seed, L::xor_int(L::mul_int(x, L::splat_int(prime_x)), L::mul_int(y, L::splat_int(prime_y))));
+    hash = L::mul_int(hash, L::splat_int(0x27D4EB2D));
+    hash = L::xor_int(hash, L::template shift_right_int<15>(hash));
+    return hash;
+}
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Int hash_3d(typename L::Int seed, typename L::Int x, typename L::Int y, typename L::Int z)
+{
+    using Int = typename L::Int;
+    const Int x_primed = L::mul_int(x, L::splat_int(prime_x));
+    const Int y_primed = L::mul_int(y, L::splat_int(prime_y));
+    const Int z_primed = L::mul_int(z, L::splat_int(prime_z));
+    Int hash = L::xor_int(L::xor_int(seed, x_primed), L::xor_int(y_primed, z_primed));
+    hash = L::mul_int(hash, L::splat_int(0x27D4EB2D));
+    hash = L::xor_int(hash, L::template shift_right_int<15>(hash));
+    return hash;
+}
+
+// Additional mixing round, used when many independent bits of the hash are consumed (such as the cellular jitter).
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Int remix_hash(typename L::Int hash)
+{
+    hash = L::mul_int(hash, L::splat_int(static_cast<i32>(0x85EBCA6BU)));
+    hash = L::xor_int(hash, L::template shift_right_int<13>(hash));
+    return hash;
+}
+
+#pragma endregion
+
+#pragma region Gradients
+
+// Unit directions towards the edges and the corners of a square.
+alignas(32) static constexpr float gradients_2d_x[8] = { 1.0F, -1.0F, 0.0F, 0.0F, 0.70710678F, -0.70710678F, 0.70710678F, -0.70710678F };
+alignas(32) static constexpr float gradients_2d_y[8] = { 0.0F, 0.0F, 1.0F, -1.0F, 0.70710678F, 0.70710678F, -0.70710678F, -0.70710678F };
+
+// Directions towards the twelve edges of a cube, with four of them repeated to obtain a power-of-two sized table.
+// clang-format off
+alignas(32) static constexpr float gradients_3d_x[16] = { 1, -1,  1, -1,  1, -1,  1, -1,  0,  0,  0,  0,  1,  0, -1,  0 };
+alignas(32) static constexpr float gradients_3d_y[16] = { 1,  1, -1, -1,  0,  0,  0,  0,  1, -1,  1, -1,  1, -1,  1, -1 };
+alignas(32) static constexpr float gradients_3d_z[16] = { 0,  0,  0,  0,  1,  1, -1, -1,  1,  1, -1, -1,  0,  1,  0, -1 };
+// clang-format on
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float gradient_dot_2d(typename L::Int hash, typename L::Float x, typename L::Float y)
+{
+    const typename L::Int index = L::and_int(hash, L::splat_int(7));
+    return L::add(L::mul(L::gather(gradients_2d_x, index), x), L::mul(L::gather(gradients_2d_y, index), y));
+}
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float gradient_dot_3d(typename L::Int hash, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    const typename L::Int index = L::and_int(hash, L::splat_int(15));
+    const typename L::Float dot_xy = L::add(L::mul(L::gather(gradients_3d_x, index), x), L::mul(L::gather(gradients_3d_y, index), y));
+    return L::add(dot_xy, L::mul(L::gather(gradients_3d_z, index), z));
+}
+
+#pragma endregion
+
+#pragma region Perlin
+
+// Scales that map the theoretical output range of the Perlin noise to approximately `[-1, 1]`.
+static constexpr float perlin_2d_scale = 1.4142135F;
+static constexpr float perlin_3d_scale = 0.9649214F;
+
+// The quintic interpolation curve `6t^5 - 15t^4 + 10t^3`, which has continuous first and second order derivatives.
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float interpolation_curve(typename L::Float t)
+{
+    const typename L::Float polynomial = L::add(L::mul(t, L::sub(L::mul(t, L::splat(6.0F)), L::splat(15.0F))), L::splat(10.0F));
+    return L::mul(L::mul(L::mul(t, t), t), polynomial);
+}
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float lerp(typename L::Float a, typename L::Float b, typename L::Float t)
+{
+    return L::add(a, L::mul(t, L::sub(b, a)));
+}
+
+template<typename L>
+NODISCARD static typename L::Float perlin_2d(typename L::Int seed, typename L::Float x, typename L::Float y)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+
+    const Float x_floor = L::floor(x);
+    const Float y_floor = L::floor(y);
+    const Int x0 = L::to_int(x_floor);
+    const Int y0 = L::to_int(y_floor);
+    const Int x1 = L::add_int(x0, L::splat_int(1));
+    const Int y1 = L::add_int(y0, L::splat_int(1));
+
+    const Float dx0 = L::sub(x, x_floor);
+    const Float dy0 = L::sub(y, y_floor);
+    const Float dx1 = L::sub(dx0, L::splat(1.0F));
+    const Float dy1 = L::sub(dy0, L::splat(1.0F));
+
+    const Float u = interpolation_curve<L>(dx0);
+    const Float v = interpolation_curve<L>(dy0);
+
+    const Float n00 = gradient_dot_2d<L>(hash_2d<L>(seed, x0, y0), dx0, dy0);
+    const Float n10 = gradient_dot_2d<L>(hash_2d<L>(seed, x1, y0), dx1, dy0);
+    const Float n01 = gradient_dot_2d<L>(hash_2d<L>(seed, x0, y1), dx0, dy1);
+    const Float n11 = gradient_dot_2d<L>(hash_2d<L>(seed, x1, y1), dx1, dy1);
+
+    const Float result = lerp<L>(lerp<L>(n00, n10, u), lerp<L>(n01, n11, u), v);
+    return L::mul(result, L::splat(perlin_2d_scale));
+}
+
+template<typename L>
+NODISCARD static typename L::Float perlin_3d(typename L::Int seed, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+
+    const Float x_floor = L::floor(x);
+    const Float y_floor = L::floor(y);
+    const Float z_floor = L::floor(z);
+    const Int x0 = L::to_int(x_floor);
+    const Int y0 = L::to_int(y_floor);
+    const Int z0 = L::to_int(z_floor);
+    const Int x1 = L::add_int(x0, L::splat_int(1));
+    const Int y1 = L::add_int(y0, L::splat_int(1));
+    const Int z1 = L::add_int(z0, L::splat_int(1));
+
+    const Float dx0 = L::sub(x, x_floor);
+    const Float dy0 = L::sub(y, y_floor);
+    const Float dz0 = L::sub(z, z_floor);
+    const Float dx1 = L::sub(dx0, L::splat(1.0F));
+    const Float dy1 = L::sub(dy0, L::splat(1.0F));
+    const Float dz1 = L::sub(dz0, L::splat(1.0F));
+
+    const Float u = interpolation_curve<L>(dx0);
+    const Float v = interpolation_curve<L>(dy0);
+    const Float w = interpolation_curve<L>(dz0);
+
+    const Float n000 = gradient_dot_3d<L>(hash_3d<L>(seed, x0, y0, z0), dx0, dy0, dz0);
+    const Float n100 = gradient_dot_3d<L>(hash_3d<L>(seed, x1, y0, z0), dx1, dy0, dz0);
+    const Float n010 = gradient_dot_3d<L>(hash_3d<L>(seed, x0, y1, z0), dx0, dy1, dz0);
+    const Float n110 = gradient_dot_3d<L>(hash_3d<L>(seed, x1, y1, z0), dx1, dy1, dz0);
+    const Float n001 = gradient_dot_3d<L>(hash_3d<L>(seed, x0, y0, z1), dx0, dy0, dz1);
+    const Float n101 = gradient_dot_3d<L>(hash_3d<L>(seed, x1, y0, z1), dx1, dy0, dz1);
+    const Float n011 = gradient_dot_3d<L>(hash_3d<L>(seed, x0, y1, z1), dx0, dy1, dz1);
+    const Float n111 = gradient_dot_3d<L>(hash_3d<L>(seed, x1, y1, z1), dx1, dy1, dz1);
+
+    const Float n_z0 = lerp<L>(lerp<L>(n000, n100, u), lerp<L>(n010, n110, u), v);
+    const Float n_z1 = lerp<L>(lerp<L>(n001, n101, u), lerp<L>(n011, n111, u), v);
+    return L::mul(lerp<L>(n_z0, n_z1, w), L::splat(perlin_3d_scale));
+}
+
+#pragma endregion
+
+#pragma region OpenSimplex2
+
+// Scales that map the theoretical output range of the OpenSimplex2 noise to approximately `[-1, 1]`.
+static constexpr float open_simplex2_2d_scale = 99.836F;
+static constexpr float open_simplex2_3d_scale = 32.694F;
+
+// The radius (squared) of the contribution of each lattice vertex.
+static constexpr float open_simplex2_2d_radius_squared = 0.5F;
+static constexpr float open_simplex2_3d_radius_squared = 0.6F;
+
+// Skew factors between the square lattice and the triangular (simplex) lattice.
+static constexpr float open_simplex2_2d_skew = 0.36602540378F;
+static constexpr float open_simplex2_2d_unskew = 0.21132486540F;
+
+// Contribution of a single lattice vertex: `(r^2 - d^2)^4 * dot(gradient, d)`, or zero if the vertex is too far away.
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float simplex_contribution(typename L::Float attenuation, typename L::Float gradient_dot)
+{
+    const typename L::Float attenuation_squared = L::mul(attenuation, attenuation);
+    const typename L::Float contribution = L::mul(L::mul(attenuation_squared, attenuation_squared), gradient_dot);
+    return L::select(L::greater(attenuation, L::splat(0.0F)), contribution, L::splat(0.0F));
+}
+
+//
+// The 2D variant evaluates the three vertices of the triangle that contains the sample, on a lattice obtained by
+// skewing the square lattice along its main diagonal.
+//
+template<typename L>
+NODISCARD static typename L::Float open_simplex2_2d(typename L::Int seed, typename L::Float x, typename L::Float y)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+
+    const Float skew = L::mul(L::add(x, y), L::splat(open_simplex2_2d_skew));
+    const Float i_floor = L::floor(L::add(x, skew));
+    const Float j_floor = L::floor(L::add(y, skew));
+    const Float unskew = L::mul(L::add(i_floor, j_floor), L::splat(open_simplex2_2d_unskew));
+
+    // Distances from the first vertex of the triangle.
+    const Float x0 = L::sub(x, L::sub(i_floor, unskew));
+    const Float y0 = L::sub(y, L::sub(j_floor, unskew));
+
+    // Select the lower or the upper triangle of the skewed cell.
+    const typename L::Mask is_lower_triangle = L::greater(x0, y0);
+    const Float i1 = L::select(is_lower_triangle, L::splat(1.0F), L::splat(0.0F));
+    const Float j1 = L::select(is_lower_triangle, L::splat(0.0F), L::splat(1.0F));
+
+    const Float x1 = L::add(L::sub(x0, i1), L::splat(open_simplex2_2d_unskew));
+    const Float y1 = L::add(L::sub(y0, j1), L::splat(open_simplex2_2d_unskew));
+    const Float x2 = L::add(L::sub(x0, L::splat(1.0F)), L::splat(2.0F * open_simplex2_2d_unskew));
+    const Float y2 = L::add(L::sub(y0, L::splat(1.0F)), L::splat(2.0F * open_simplex2_2d_unskew));
+
+    const Int i = L::to_int(i_floor);
+    const Int j = L::to_int(j_floor);
+    const Int i_1 = L::add_int(i, L::to_int(i1));
+    const Int j_1 = L::add_int(j, L::to_int(j1));
+    const Int i_2 = L::add_int(i, L::splat_int(1));
+    const Int j_2 = L::add_int(j, L::splat_int(1));
+
+    const Float radius_squared = L::splat(open_simplex2_2d_radius_squared);
+    const Float a0 = L::sub(L::sub(radius_squared, L::mul(x0, x0)), L::mul(y0, y0));
+    const Float a1 = L::sub(L::sub(radius_squared, L::mul(x1, x1)), L::mul(y1, y1));
+    const Float a2 = L::sub(L::sub(radius_squared, L::mul(x2, x2)), L::mul(y2, y2));
+
+    Float value = simplex_contribution<L>(a0, gradient_dot_2d<L>(hash_2d<L>(seed, i, j), x0, y0));
+    value = L::add(value, simplex_contribution<L>(a1, gradient_dot_2d<L>(hash_2d<L>(seed, i_1, j_1), x1, y1)));
+    value = L::add(value, simplex_contribution<L>(a2, gradient_dot_2d<L>(hash_2d<L>(seed, i_2, j_2), x2, y2)));
+    return L::mul(value, L::splat(open_simplex2_2d_scale));
+}
+
+//
+// The 3D variant evaluates the body-centered cubic lattice as two interleaved cubic lattices. For each of them,
+// the closest vertex and the next closest vertex (along the axis with the largest offset) are considered.
+// The domain is rotated first, such that the Y axis points along the main diagonal of the lattice, which hides
+// the lattice orientation on horizontal slices (the most visible ones in a voxel world).
+//
+template<typename L>
+NODISCARD static typename L::Float open_simplex2_3d(typename L::Int seed, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+    using Mask = typename L::Mask;
+
+    const Float rotation = L::mul(L::add(L::add(x, y), z), L::splat(2.0F / 3.0F));
+    const Float xr = L::sub(rotation, x);
+    const Float yr = L::sub(rotation, y);
+    const Float zr = L::sub(rotation, z);
+
+    const Float x_round = L::floor(L::add(xr, L::splat(0.5F)));
+    const Float y_round = L::floor(L::add(yr, L::splat(0.5F)));
+    const Float z_round = L::floor(L::add(zr, L::splat(0.5F)));
+    Int i = L::to_int(x_round);
+    Int j = L::to_int(y_round);
+    Int k = L::to_int(z_round);
+
+    Float x0 = L::sub(xr, x_round);
+    Float y0 = L::sub(yr, y_round);
+    Float z0 = L::sub(zr, z_round);
+
+    // The direction (on each axis) towards the next closest vertex.
+    Float x_sign = L::select(L::greater_equal(x0, L::splat(0.0F)), L::splat(-1.0F), L::splat(1.0F));
+    Float y_sign = L::select(L::greater_equal(y0, L::splat(0.0F)), L::splat(-1.0F), L::splat(1.0F));
+    Float z_sign = L::select(L::greater_equal(z0, L::splat(0.0F)), L::splat(-1.0F), L::splat(1.0F));
+
+    Float ax0 = L::abs(x0);
+    Float ay0 = L::abs(y0);
+    Float az0 = L::abs(z0);
+
+    const Float radius_squared = L::splat(open_simplex2_3d_radius_squared);
+    Float a = L::sub(L::sub(L::sub(radius_squared, L::mul(x0, x0)), L::mul(y0, y0)), L::mul(z0, z0));
+
+    Float value = L::splat(0.0F);
+    Int lattice_seed = seed;
+
+    for (u32 lattice_index = 0; lattice_index < 2; ++lattice_index)
+    {
+        // Contribution of the closest vertex.
+        value = L::add(value, simplex_contribution<L>(a, gradient_dot_3d<L>(hash_3d<L>(lattice_seed, i, j, k), x0, y0, z0)));
+
+        // Contribution of the next closest vertex, located along the axis with the largest offset.
+        const Mask use_x = L::mask_and(L::greater_equal(ax0, ay0), L::greater_equal(ax0, az0));
+        const Mask use_y = L::mask_and(L::greater(ay0, ax0), L::greater_equal(ay0, az0));
+
+        const Float axis_offset = L::select(use_x, ax0, L::select(use_y, ay0, az0));
+        const Float b = L::add(L::add(a, axis_offset), axis_offset);
+
+        const Float step_x = L::select(use_x, x_sign, L::splat(0.0F));
+        const Float step_y = L::select(use_x, L::splat(0.0F), L::select(use_y, y_sign, L::splat(0.0F)));
+        const Float step_z = L::select(use_x, L::splat(0.0F), L::select(use_y, L::splat(0.0F), z_sign));
+
+        const Int neighbor_i = L::add_int(i, L::to_int(L::sub(L::splat(0.0F), step_x)));
+        const Int neighbor_j = L::add_int(j, L::to_int(L::sub(L::splat(0.0F), step_y)));
+        const Int neighbor_k = L::add_int(k, L::to_int(L::sub(L::splat(0.0F), step_z)));
+        const Float neighbor_gradient_dot = gradient_dot_3d<L>(
+            hash_3d<L>(lattice_seed, neighbor_i, neighbor_j, neighbor_k),
+            L::add(x0, step_x),
+            L::add(y0, step_y),
+            L::add(z0, step_z)
+        );
+        value = L::add(value, simplex_contribution<L>(L::sub(b, L::splat(1.0F)), neighbor_gradient_dot));
+
+        if (lattice_index == 1)
+            break;
+
+        // Move to the second (interleaved) cubic lattice, which is offset by half a cell on every axis.
+        ax0 = L::sub(L::splat(0.5F), ax0);
+        ay0 = L::sub(L::splat(0.5F), ay0);
+        az0 = L::sub(L::splat(0.5F), az0);
+        x0 = L::mul(x_sign, ax0);
+        y0 = L::mul(y_sign, ay0);
+        z0 = L::mul(z_sign, az0);
+        a = L::add(a, L::sub(L::sub(L::splat(0.75F), ax0), L::add(ay0, az0)));
+
+        i = L::add_int(i, L::to_int(L::select(L::less(x_sign, L::splat(0.0F)), L::splat(1.0F), L::splat(0.0F))));
+        j = L::add_int(j, L::to_int(L::select(L::less(y_sign, L::splat(0.0F)), L::splat(1.0F), L::splat(0.0F))));
+        k = L::add_int(k, L::to_int(L::select(L::less(z_sign, L::splat(0.0F)), L::splat(1.0F), L::splat(0.0F))));
+
+        x_sign = L::sub(L::splat(0.0F), x_sign);
+        y_sign = L::sub(L::splat(0.0F), y_sign);
+        z_sign = L::sub(L::splat(0.0F), z_sign);
+        lattice_seed = L::xor_int(lattice_seed, L::splat_int(-1));
+    }
+
+    return L::mul(value, L::splat(open_simplex2_3d_scale));
+}
+
+#pragma endregion
+
+#pragma region Cellular
+
+// Maps the 10-bit jitter values stored in the cell hash to the `[0, 1]` range.
+static constexpr float cellular_jitter_scale = 1.0F / 1023.0F;
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float cellular_jitter(typename L::Int hash)
+{
+    return L::mul(L::to_float(L::and_int(hash, L::splat_int(1023))), L::splat(cellular_jitter_scale));
+}
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float
+cellular_result(CellularReturnType return_type, typename L::Float closest_squared, typename L::Float second_closest_squared)
+{
+    switch (return_type)
+    {
+        case CellularReturnType::Distance: return L::sub(L::mul(L::sqrt(closest_squared), L::splat(2.0F)), L::splat(1.0F));
+        case CellularReturnType::Distance2: return L::sub(L::mul(L::sqrt(second_closest_squared), L::splat(1.5F)), L::splat(1.0F));
+        case CellularReturnType::Distance2Sub:
+            return L::sub(L::mul(L::sub(L::sqrt(second_closest_squared), L::sqrt(closest_squared)), L::splat(2.0F)), L::splat(1.0F));
+    }
+
+    return L::splat(0.0F);
+}
+
+template<typename L>
+NODISCARD static typename L::Float cellular_2d(CellularReturnType return_type, typename L::Int seed, typename L::Float x, typename L::Float y)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+
+    const Float x_floor = L::floor(x);
+    const Float y_floor = L::floor(y);
+    const Int cell_x = L::to_int(x_floor);
+    const Int cell_y = L::to_int(y_floor);
+    const Float local_x = L::sub(x, x_floor);
+    const Float local_y = L::sub(y, y_floor);
+
+    Float closest = L::splat(Math::large_number);
+    Float second_closest = L::splat(Math::large_number);
+
+    for (i32 offset_y = -1; offset_y <= 1; ++offset_y)
+    {
+        for (i32 offset_x = -1; offset_x <= 1; ++offset_x)
+        {
+            const Int neighbor_x = L::add_int(cell_x, L::splat_int(offset_x));
+            const Int neighbor_y = L::add_int(cell_y, L::splat_int(offset_y));
+            const Int hash = remix_hash<L>(hash_2d<L>(seed, neighbor_x, neighbor_y));
+
+            // Position of the cell feature point, relative to the sample.
+            const Float point_x = L::sub(L::add(L::splat(static_cast<float>(offset_x)), cellular_jitter<L>(hash)), local_x);
+            const Float point_y = L::sub(L::add(L::splat(static_cast<float>(offset_y)), cellular_jitter<L>(L::template shift_right_int<10>(hash))), local_y);
+
+            const Float distance_squared = L::add(L::mul(point_x, point_x), L::mul(point_y, point_y));
+            second_closest = L::max(L::min(second_closest, distance_squared), closest);
+            closest = L::min(closest, distance_squared);
+        }
+    }
+
+    return cellular_result<L>(return_type, closest, second_closest);
+}
+
+template<typename L>
+NODISCARD static typename L::Float
+cellular_3d(CellularReturnType return_type, typename L::Int seed, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    using Float = typename L::Float;
+    using Int = typename L::Int;
+
+    const Float x_floor = L::floor(x);
+    const Float y_floor = L::floor(y);
+    const Float z_floor = L::floor(z);
+    const Int cell_x = L::to_int(x_floor);
+    const Int cell_y = L::to_int(y_floor);
+    const Int cell_z = L::to_int(z_floor);
+    const Float local_x = L::sub(x, x_floor);
+    const Float local_y = L::sub(y, y_floor);
+    const Float local_z = L::sub(z, z_floor);
+
+    Float closest = L::splat(Math::large_number);
+    Float second_closest = L::splat(Math::large_number);
+
+    for (i32 offset_z = -1; offset_z <= 1; ++offset_z)
+    {
+        for (i32 offset_y = -1; offset_y <= 1; ++offset_y)
+        {
+            for (i32 offset_x = -1; offset_x <= 1; ++offset_x)
+            {
+                const Int neighbor_x = L::add_int(cell_x, L::splat_int(offset_x));
+                const Int neighbor_y = L::add_int(cell_y, L::splat_int(offset_y));
+                const Int neighbor_z = L::add_int(cell_z, L::splat_int(offset_z));
+                const Int hash = remix_hash<L>(hash_3d<L>(seed, neighbor_x, neighbor_y, neighbor_z));
+
+                // Position of the cell feature point, relative to the sample.
+                const Float jitter_x = cellular_jitter<L>(hash);
+                const Float jitter_y = cellular_jitter<L>(L::template shift_right_int<10>(hash));
+                const Float jitter_z = cellular_jitter<L>(L::template shift_right_int<20>(hash));
+                const Float point_x = L::sub(L::add(L::splat(static_cast<float>(offset_x)), jitter_x), local_x);
+                const Float point_y = L::sub(L::add(L::splat(static_cast<float>(offset_y)), jitter_y), local_y);
+                const Float point_z = L::sub(L::add(L::splat(static_cast<float>(offset_z)), jitter_z), local_z);
+
+                const Float distance_squared = L::add(L::add(L::mul(point_x, point_x), L::mul(point_y, point_y)), L::mul(point_z, point_z));
+                second_closest = L::max(L::min(second_closest, distance_squared), closest);
+                closest = L::min(closest, distance_squared);
+            }
+        }
+    }
+
+    return cellular_result<L>(return_type, closest, second_closest);
+}
+
+#pragma endregion
+
+#pragma region Fractal
+
+// Seed offsets of the three domain warping noise fields, chosen such that they don't overlap with the octave seeds.
+static constexpr i32 domain_warp_seed_offset_x = 0x3C6EF372;
+static constexpr i32 domain_warp_seed_offset_y = 0x1B873593;
+static constexpr i32 domain_warp_seed_offset_z = 0x6A09E667;
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float
+sample_base_2d(const NoiseSettings& settings, typename L::Int seed, typename L::Float x, typename L::Float y)
+{
+    switch (settings.type)
+    {
+        case NoiseType::Perlin: return perlin_2d<L>(seed, x, y);
+        case NoiseType::OpenSimplex2: return open_simplex2_2d<L>(seed, x, y);
+        case NoiseType::Cellular: return cellular_2d<L>(settings.cellular_return_type, seed, x, y);
+    }
+
+    return L::splat(0.0F);
+}
+
+template<typename L>
+NODISCARD ALWAYS_INLINE static typename L::Float
+sample_base_3d(const NoiseSettings& settings, typename L::Int seed, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    switch (settings.type)
+    {
+        case NoiseType::Perlin: return perlin_3d<L>(seed, x, y, z);
+        case NoiseType::OpenSimplex2: return open_simplex2_3d<L>(seed, x, y, z);
+        case NoiseType::Cellular: return cellular_3d<L>(settings.cellular_return_type, seed, x, y, z);
+    }
+
+    return L::splat(0.0F);
+}
+
+//
+// Combines the octaves of the base noise according to the fractal type. The per-octave frequencies and amplitudes are
+// computed using scalar arithmetic, which is identical for all instantiations.
+//
+template<typename L>
+NODISCARD static typename L::Float sample_fractal_2d(const NoiseSettings& settings, typename L::Float x, typename L::Float y)
+{
+    using Float = typename L::Float;
+
+    if (settings.domain_warp_amplitude != 0.0F)
+    {
+        const Float warp_x = L::mul(x, L::splat(settings.domain_warp_frequency));
+        const Float warp_y = L::mul(y, L::splat(settings.domain_warp_frequency));
+        const Float offset_x = perlin_2d<L>(L::splat_int(settings.seed ^ domain_warp_seed_offset_x), warp_x, warp_y);
+        const Float offset_y = perlin_2d<L>(L::splat_int(settings.seed ^ domain_warp_seed_offset_y), warp_x, warp_y);
+        x = L::add(x, L::mul(offset_x, L::splat(settings.domain_warp_amplitude)));
+        y = L::add(y, L::mul(offset_y, L::splat(settings.domain_warp_amplitude)));
+    }
+
+    if (settings.fractal_type == FractalType::None || settings.octave_count == 0)
+    {
+        const Float frequency = L::splat(settings.frequency);
+        return sample_base_2d<L>(settings, L::splat_int(settings.seed), L::mul(x, frequency), L::mul(y, frequency));
+    }
+
+    Float sum = L::splat(0.0F);
+    float frequency = settings.frequency;
+    float amplitude = 1.0F;
+    float amplitude_sum = 0.0F;
+
+    for (u32 octave_index = 0; octave_index < settings.octave_count; ++octave_index)
+    {
+        const typename L::Int octave_seed = L::splat_int(settings.seed + static_cast<i32>(octave_index));
+        Float octave_value = sample_base_2d<L>(settings, octave_seed, L::mul(x, L::splat(frequency)), L::mul(y, L::splat(frequency)));
+
+        if (settings.fractal_type == FractalType::Ridged)
+        {
+            octave_value = L::sub(L::splat(1.0F), L::abs(octave_value));
+            octave_value = L::mul(octave_value, octave_value);
+        }
+
+        sum = L::add(sum, L::mul(octave_value, L::splat(amplitude)));
+        amplitude_sum += amplitude;
+        amplitude *= settings.gain;
+        frequency *= settings.lacunarity;
+    }
+
+    Float result = L::mul(sum, L::splat(1.0F / amplitude_sum));
+    if (settings.fractal_type == FractalType::Ridged)
+        result = L::sub(L::mul(result, L::splat(2.0F)), L::splat(1.0F));
+    return result;
+}
+
+template<typename L>
+NODISCARD static typename L::Float sample_fractal_3d(const NoiseSettings& settings, typename L::Float x, typename L::Float y, typename L::Float z)
+{
+    using Float = typename L::Float;
+
+    if (settings.domain_warp_amplitude != 0.0F)
+    {
+        const Float warp_x = L::mul(x, L::splat(settings.domain_warp_frequency));
+        const Float warp_y = L::mul(y, L::splat(settings.domain_warp_frequency));
+        const Float warp_z = L::mul(z, L::splat(settings.domain_warp_frequency));
+        const Float offset_x = perlin_3d<L>(L::splat_int(settings.seed ^ domain_warp_seed_offset_x), warp_x, warp_y, warp_z);
+        const Float offset_y = perlin_3d<L>(L::splat_int(settings.seed ^ domain_warp_seed_offset_y), warp_x, warp_y, warp_z);
+        const Float offset_z = perlin_3d<L>(L::splat_int(settings.seed ^ domain_warp_seed_offset_z), warp_x, warp_y, warp_z);
+        x = L::add(x, L::mul(offset_x, L::splat(settings.domain_warp_amplitude)));
+        y = L::add(y, L::mul(offset_y, L::splat(settings.domain_warp_amplitude)));
+        z = L::add(z, L::mul(offset_z, L::splat(settings.domain_warp_amplitude)));
+    }
+
+    if (settings.fractal_type == FractalType::None || settings.octave_count == 0)
+    {
+        const Float frequency = L::splat(settings.frequency);
+        return sample_base_3d<L>(settings, L::splat_int(settings.seed), L::mul(x, frequency), L::mul(y, frequency), L::mul(z, frequency));
+    }
+
+    Float sum = L::splat(0.0F);
+    float frequency = settings.frequency;
+    float amplitude = 1.0F;
+    float amplitude_sum = 0.0F;
+
+    for (u32 octave_index = 0; octave_index < settings.octave_count; ++octave_index)
+    {
+        const typename L::Int octave_seed = L::splat_int(settings.seed + static_cast<i32>(octave_index));
+        const Float octave_frequency = L::splat(frequency);
+        Float octave_value = sample_base_3d<L>(settings, octave_seed, L::mul(x, octave_frequency), L::mul(y, octave_frequency), L::mul(z, octave_frequency));
+
+        if (settings.fractal_type == FractalType::Ridged)
+        {
+            octave_value = L::sub(L::splat(1.0F), L::abs(octave_value));
+            octave_value = L::mul(octave_value, octave_value);
+        }
+
+        sum = L::add(sum, L::mul(octave_value, L::splat(amplitude)));
+        amplitude_sum += amplitude;
+        amplitude *= settings.gain;
+        frequency *= settings.lacunarity;
+    }
+
+    Float result = L::mul(sum, L::splat(1.0F / amplitude_sum));
+    if (settings.fractal_type == FractalType::Ridged)
+        result = L::sub(L::mul(result, L::splat(2.0F)), L::splat(1.0F));
+    return result;
+}
+
+#pragma endregion
+
+#pragma region Grid Generation
+
+//
+// Evaluates `L::width` consecutive samples along the X axis, starting at the grid index `x_index`.
+// The sample position is computed as `origin + index * spacing` in all code paths.
+//
+template<typename L>
+ALWAYS_INLINE static void fill_row_segment_2d(const NoiseSettings& settings, Vector2 origin, float spacing, u32 x_index, float y, float* out_values)
+{
+    const typename L::Int x_indices = L::add_int(L::splat_int(static_cast<i32>(x_index)), L::lane_indices());
+    const typename L::Float x = L::add(L::splat(origin.x), L::mul(L::to_float(x_indices), L::splat(spacing)));
+    L::store(out_values, sample_fractal_2d<L>(settings, x, L::splat(y)));
+}
+
+template<typename L>
+ALWAYS_INLINE static void fill_row_segment_3d(const NoiseSettings& settings, Vector3 origin, float spacing, u32 x_index, float y, float z, float* out_values)
+{
+    const typename L::Int x_indices = L::add_int(L::splat_int(static_cast<i32>(x_index)), L::lane_indices());
+    const typename L::Float x = L::add(L::splat(origin.x), L::mul(L::to_float(x_indices), L::splat(spacing)));
+    L::store(out_values, sample_fractal_3d<L>(settings, x, L::splat(y), L::splat(z)));
+}
+
+template<typename L>
+static void fill_grid_2d_generic(const NoiseSettings& settings, Vector2 origin, float spacing, u32 size_x, u32 size_y, float* out_values)
+{
+    for (u32 y_index = 0; y_index < size_y; ++y_index)
+    {
+        const float y = origin.y + static_cast<float>(y_index) * spacing;
+        float* row_values = out_values + static_cast<usize>(y_index) * size_x;
+
+        u32 x_index = 0;
+        for (; x_index + L::width <= size_x; x_index += L::width)
+            fill_row_segment_2d<L>(settings, origin, spacing, x_index, y, row_values + x_index);
+        for (; x_index < size_x; ++x_index)
+            fill_row_segment_2d<ScalarLanes>(settings, origin, spacing, x_index, y, row_values + x_index);
+    }
+}
+
+template<typename L>
+static void fill_grid_3d_generic(const NoiseSettings& settings, Vector3 origin, float spacing, u32 size_x, u32 size_y, u32 size_z, float* out_values)
+{
+    for (u32 z_index = 0; z_index < size_z; ++z_index)
+    {
+        const float z = origin.z + static_cast<float>(z_index) * spacing;
+        for (u32 y_index = 0; y_index < size_y; ++y_index)
+        {
+            const float y = origin.y + static_cast<float>(y_index) * spacing;
+            float* row_values = out_values + (static_cast<usize>(z_index) * size_y + y_index) * size_x;
+
+            u32 x_index = 0;
+            for (; x_index + L::width <= size_x; x_index += L::width)
+                fill_row_segment_3d<L>(settings, origin, spacing, x_index, y, z, row_values + x_index);
+            for (; x_index < size_x; ++x_index)
+                fill_row_segment_3d<ScalarLanes>(settings, origin, spacing, x_index, y, z, row_values + x_index);
+        }
+    }
+}
+
+#pragma endregion
+
+float Noise::sample_2d(const NoiseSettings& settings, float x, float y)
+{
+    return sample_fractal_2d<ScalarLanes>(settings, x, y);
+}
+
+float Noise::sample_3d(const NoiseSettings& settings, float x, float y, float z)
+{
+    return sample_fractal_3d<ScalarLanes>(settings, x, y, z);
+}
+
+void Noise::fill_grid_2d(const NoiseSettings& settings, Vector2 origin, float spacing, u32 size_x, u32 size_y, float* out_values)
+{
+#if CAVE_SIMD_AVX2
+    fill_grid_2d_generic<Avx2Lanes>(settings, origin, spacing, size_x, size_y, out_values);
+#else
+    fill_grid_2d_generic<ScalarLanes>(settings, origin, spacing, size_x, size_y, out_values);
+#endif // CAVE_SIMD_AVX2
+}
+
+void Noise::fill_grid_3d(const NoiseSettings& settings, Vector3 origin, float spacing, u32 size_x, u32 size_y, u32 size_z, float* out_values)
+{
+#if CAVE_SIMD_AVX2
+    fill_grid_3d_generic<Avx2Lanes>(settings, origin, spacing, size_x, size_y, size_z, out_values);
+#else
+    fill_grid_3d_generic<ScalarLanes>(settings, origin, spacing, size_x, size_y, size_z, out_values);
+#endif // CAVE_SIMD_AVX2
+}
+
+void Noise::fill_grid_2d_reference(const NoiseSettings& settings, Vector2 origin, float spacing, u32 size_x, u32 size_y, float* out_values)
+{
+    fill_grid_2d_generic<ScalarLanes>(settings, origin, spacing, size_x, size_y, out_values);
+}
+
+void Noise::fill_grid_3d_reference(const NoiseSettings& settings, Vector3 origin, float spacing, u32 size_x, u32 size_y, u32 size_z, float* out_values)
+{
+    fill_grid_3d_generic<ScalarLanes>(settings, origin, spacing, size_x, size_y, size_z, out_values);
+}
+
+} // namespace CaveGame
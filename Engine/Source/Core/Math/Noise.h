@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+#include <Core/Math/Vector.h>
+
+namespace CaveGame
+{
+
+enum class NoiseType : u8
+{
+    Perlin,
+    OpenSimplex2,
+    Cellular,
+};
+
+enum class FractalType : u8
+{
+    // A single octave of the base noise is evaluated.
+    None,
+    // Fractal Brownian motion: the octaves are summed with decreasing amplitudes.
+    FBm,
+    // The octaves are folded around zero and inverted, producing sharp ridges. Well suited for cave tunnels.
+    Ridged,
+};
+
+enum class CellularReturnType : u8
+{
+    // Distance to the closest feature point.
+    Distance,
+    // Distance to the second closest feature point.
+    Distance2,
+    // Difference between the distances to the second closest and the closest feature points.
+    Distance2Sub,
+};
+
+struct NoiseSettings
+{
+    NoiseType type { NoiseType::OpenSimplex2 };
+    FractalType fractal_type { FractalType::None };
+    CellularReturnType cellular_return_type { CellularReturnType::Distance };
+
+    i32 seed { 1337 };
+    float frequency { 0.01F };
+
+    // Fractal settings. Ignored if `fractal_type` is `FractalType::None`.
+    u32 octave_count { 3 };
+    float lacunarity { 2.0F };
+    float gain { 0.5F };
+
+    //
+    // Domain warping settings. The sample position is displaced by a Perlin noise vector field
+    // before the base noise is evaluated. Warping is disabled if the amplitude is zero.
+    //
+    float domain_warp_amplitude { 0.0F };
+    float domain_warp_frequency { 0.01F };
+};
+
+//
+// Coherent noise generation, with all noise types returning values approximately in the `[-1, 1]` range.
+//
+// The batch functions evaluate eight samples at once using AVX2 (if available). All computations are performed
+// in the same order and with the same precision in both the scalar and the vectorized code paths, thus the batch
+// functions produce bit-exact results compared to the scalar `sample_*` functions, on any machine.
+//
+class Noise
+{
+public:
+    // The size (on each axis) of the grids that are usually generated at once (one chunk).
+    static constexpr u32 grid_size = 32;
+
+public:
+    NODISCARD static float sample_2d(const NoiseSettings& settings, float x, float y);
+    NODISCARD static float sample_3d(const NoiseSettings& settings, float x, float y, float z);
+
+    //
+    // Fills a `size_x * size_y` grid of samples, starting at `origin` and with `spacing` units between two
+    // adjacent samples. The values are stored in row-major order (the X axis varies the fastest).
+    //
+    static void fill_grid_2d(const NoiseSettings& settings, Vector2 origin, float spacing, u32 size_x, u32 size_y, float* out_values);
+
+    //
+    // Fills a `size_x * size_y * size_z` grid of samples, starting at `origin` and with `spacing` units between two
+    // adjacent samples. The values are stored such that the X axis varies the fastest and the Z axis the slowest.
+    // The vectorized code path is used for all full groups of eight samples along the X axis.
+    //
+    static void fill_grid_3d(const NoiseSettings& settings, Vector3 origin, float spacing, u32 size_x, u32 size_y, u32 size_z, float* out_values);
+
+    // Wrapper around `Noise::fill_grid_3d` that generates a `grid_size^3` grid.
+    ALWAYS_INLINE static void fill_chunk_grid(const NoiseSettings& settings, Vector3 origin, float spacing, float* out_values)
+    {
+        fill_grid_3d(settings, origin, spacing, grid_size, grid_size, grid_size, out_values);
+    }
+
+public:
+    //
+    // Scalar reference implementations of the batch functions. They are slower, but produce the exact same
+    // values as the batch functions and are intended for validation.
+    //
+    static void fill_grid_2d_reference(const NoiseSettings& settings, Vector2 origin, float spacing, u32 size_x, u32 size_y, float* out_values);
+    static void fill_grid_3d_reference(
+        const NoiseSettings& settings,
+        Vector3 origin,
+        float spacing,
+        u32 size_x,
+        u32 size_y,
+        u32 size_z,
+        float* out_values
+    );
+};
+
+} // namespace CaveGame
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/Quantization.h>
+
+#include <bit>
+
+#if CAVE_SIMD_F16C
+    #include <immintrin.h>
+#endif // CAVE_SIMD_F16C
+
+namespace CaveGame
+{
+
+#pragma region Half Precision
+
+#if !CAVE_SIMD_F16C
+
+//
+// The scalar conversions are based on the branch-light algorithms described by Fabian Giesen.
+// https://gist.github.com/rygorous/2156668
+//
+
+NODISCARD static u16 float_to_half_scalar(float value)
+{
+    u32 bits = std::bit_cast<u32>(value);
+    const u32 sign = bits & 0x80000000U;
+    bits ^= sign;
+
+    u32 result;
+    if (bits >= 0x47800000U)
+    {
+        // The value is too large to be represented (infinity) or is a NaN. The NaN payload is truncated and
+        // the quiet bit is set, just like the F16C instructions do.
+        result = (bits > 0x7F800000U) ? (0x7E00U | ((bits >> 13) & 0x3FFU)) : 0x7C00U;
+    }
+    else if (bits < 0x38800000U)
+    {
+        //
+        // The value is a half-precision denormal (or zero). Adding the magic number makes the FPU shift the
+        // mantissa into place and perform the rounding (to the nearest even value, the default rounding mode).
+        //
+        static constexpr u32 denormal_magic = ((127 - 15) + (23 - 10) + 1) << 23;
+        const float shifted_value = std::bit_cast<float>(bits) + std::bit_cast<float>(denormal_magic);
+        result = std::bit_cast<u32>(shifted_value) - denormal_magic;
+    }
+    else
+    {
+        // Rebias the exponent and round the mantissa to the nearest even value. A mantissa overflow correctly
+        // increments the exponent, possibly producing infinity.
+        const u32 is_mantissa_odd = (bits >> 13) & 1;
+        bits += (static_cast<u32>(15 - 127) << 23) + 0xFFFU;
+        bits += is_mantissa_odd;
+        result = bits >> 13;
+    }
+
+    return static_cast<u16>(result | (sign >> 16));
+}
+
+NODISCARD static float half_to_float_scalar(u16 half)
+{
+    static constexpr u32 shifted_exponent_mask = 0x7C00U << 13;
+    static constexpr u32 denormal_magic = 113U << 23;
+
+    u32 bits = static_cast<u32>(half & 0x7FFFU) << 13;
+    const u32 exponent = bits & shifted_exponent_mask;
+    bits += static_cast<u32>(127 - 15) << 23;
+
+    if (exponent == shifted_exponent_mask)
+    {
+        // Infinity or NaN. Signaling NaNs are quieted, just like the F16C instructions do.
+        bits += static_cast<u32>(128 - 16) << 23;
+        if (bits & 0x007FFFFFU)
+            bits |= 0x00400000U;
+    }
+    else if (exponent == 0)
+    {
+        // Zero or denormal. Renormalize the value using the FPU.
+        bits += 1U << 23;
+        bits = std::bit_cast<u32>(std::bit_cast<float>(bits) - std::bit_cast<float>(denormal_magic));
+    }
+
+    bits |= static_cast<u32>(half & 0x8000U) << 16;
+    return std::bit_cast<float>(bits);
+}
+
+#endif // !CAVE_SIMD_F16C
+
+u16 Quantization::float_to_half(float value)
+{
+#if CAVE_SIMD_F16C
+    return static_cast<u16>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+    return float_to_half_scalar(value);
+#endif // CAVE_SIMD_F16C
+}
+
+float Quantization::half_to_float(u16 half)
+{
+#if CAVE_SIMD_F16C
+    return _cvtsh_ss(half);
+#else
+    return half_to_float_scalar(half);
+#endif // CAVE_SIMD_F16C
+}
+
+#pragma endregion
+
+#pragma region Octahedral Normals
+
+NODISCARD ALWAYS_INLINE static float sign_not_zero(float value)
+{
+    return (value >= 0.0F) ? 1.0F : -1.0F;
+}
+
+u32 Quantization::encode_octahedral_normal(Vector3 normal)
+{
+    // Project the vector onto the octahedron (|x| + |y| + |z| = 1).
+    const float inverse_l1_norm = 1.0F / (Math::abs(normal.x) + Math::abs(normal.y) + Math::abs(normal.z));
+    float u = normal.x * inverse_l1_norm;
+    float v = normal.y * inverse_l1_norm;
+
+    // Fold the lower hemisphere over the diagonals.
+    if (normal.z < 0.0F)
+    {
+        const float folded_u = (1.0F - Math::abs(v)) * sign_not_zero(u);
+        const float folded_v = (1.0F - Math::abs(u)) * sign_not_zero(v);
+        u = folded_u;
+        v = folded_v;
+    }
+
+    const u32 encoded_u = static_cast<u16>(float_to_snorm16(u));
+    const u32 encoded_v = static_cast<u16>(float_to_snorm16(v));
+    return encoded_u | (encoded_v << 16);
+}
+
+Vector3 Quantization::decode_octahedral_normal(u32 encoded_normal)
+{
+    float u = snorm16_to_float(static_cast<i16>(encoded_normal & 0xFFFF));
+    float v = snorm16_to_float(static_cast<i16>(encoded_normal >> 16));
+    const float z = 1.0F - Math::abs(u) - Math::abs(v);
+
+    // Unfold the lower hemisphere.
+    if (z < 0.0F)
+    {
+        const float unfolded_u = (1.0F - Math::abs(v)) * sign_not_zero(u);
+        const float unfolded_v = (1.0F - Math::abs(u)) * sign_not_zero(v);
+        u = unfolded_u;
+        v = unfolded_v;
+    }
+
+    return Vector3::normalize(Vector3(u, v, z));
+}
+
+#pragma endregion
+
+#pragma region Batch Conversions
+
+void Quantization::floats_to_halves(const float* values, usize value_count, u16* out_halves)
+{
+    usize value_index = 0;
+
+#if CAVE_SIMD_F16C
+    for (; value_index + 8 <= value_count; value_index += 8)
+    {
+        const __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(values + value_index), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out_halves + value_index), halves);
+    }
+#endif // CAVE_SIMD_F16C
+
+    for (; value_index < value_count; ++value_index)
+        out_halves[value_index] = float_to_half(values[value_index]);
+}
+
+void Quantization::halves_to_floats(const u16* halves, usize half_count, float* out_values)
+{
+    usize half_index = 0;
+
+#if CAVE_SIMD_F16C
+    for (; half_index + 8 <= half_count; half_index += 8)
+    {
+        const __m256 values = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(halves + half_index)));
+        _mm256_storeu_ps(out_values + half_index, values);
+    }
+#endif // CAVE_SIMD_F16C
+
+    for (; half_index < half_count; ++half_index)
+        out_values[half_index] = half_to_float(halves[half_index]);
+}
+
+void Quantization::floats_to_halves(const Vector<float>& values, Vector<u16>& out_halves)
+{
+    const usize initial_count = out_halves.count();
+    out_halves.set_count_uninitialized(initial_count + values.count());
+    floats_to_halves(values.elements(), values.count(), out_halves.elements() + initial_count);
+}
+
+void Quantization::halves_to_floats(const Vector<u16>& halves, Vector<float>& out_values)
+{
+    const usize initial_count = out_values.count();
+    out_values.set_count_uninitialized(initial_count + halves.count());
+    halves_to_floats(halves.elements(), halves.count(), out_values.elements() + initial_count);
+}
+
+void Quantization::floats_to_unorm8(const Vector<float>& values, Vector<u8>& out_values)
+{
+    const usize initial_count = out_values.count();
+    out_values.set_count_uninitialized(initial_count + values.count());
+
+    u8* destination = out_values.elements() + initial_count;
+    for (usize value_index = 0; value_index < values.count(); ++value_index)
+        destination[value_index] = float_to_unorm8(values.elements()[value_index]);
+}
+
+void Quantization::floats_to_snorm16(const Vector<float>& values, Vector<i16>& out_values)
+{
+    const usize initial_count = out_values.count();
+    out_values.set_count_uninitialized(initial_count + values.count());
+
+    i16* destination = out_values.elements() + initial_count;
+    for (usize value_index = 0; value_index < values.count(); ++value_index)
+        destination[value_index] = float_to_snorm16(values.elements()[value_index]);
+}
+
+void Quantization::encode_octahedral_normals(const Vector<Vector3>& normals, Vector<u32>& out_encoded_normals)
+{
+    const usize initial_count = out_encoded_normals.count();
+    out_encoded_normals.set_count_uninitialized(initial_count + normals.count());
+
+    u32* destination = out_encoded_normals.elements() + initial_count;
+    for (usize normal_index = 0; normal_index < normals.count(); ++normal_index)
+        destination[normal_index] = encode_octahedral_normal(normals.elements()[normal_index]);
+}
+
+void Quantization::decode_octahedral_normals(const Vector<u32>& encoded_normals, Vector<Vector3>& out_normals)
+{
+    const usize initial_count = out_normals.count();
+    out_normals.set_count_uninitialized(initial_count + encoded_normals.count());
+
+    Vector3* destination = out_normals.elements() + initial_count;
+    for (usize normal_index = 0; normal_index < encoded_normals.count(); ++normal_index)
+        destination[normal_index] = decode_octahedral_normal(encoded_normals.elements()[normal_index]);
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Math/Vector.h>
+
+namespace CaveGame
+{
+
+//
+// Conversions between floats and compact representations, used to shrink vertex and snapshot data.
+//
+// The half-precision conversions use the F16C instructions (if available). The scalar fallback rounds to the
+// nearest even value and handles denormals, infinities and NaNs exactly like the hardware, so both code paths
+// produce identical bits.
+//
+// The normalized integer conversions round to the nearest integer and clamp the input to the representable range.
+// Decoding an encoded value always yields the closest representable float, so encoding it again is lossless.
+//
+class Quantization
+{
+public:
+    NODISCARD static u16 float_to_half(float value);
+    NODISCARD static float half_to_float(u16 half);
+
+#pragma region Normalized Integers
+
+    // Maps the `[0, 1]` range to the `[0, 255]` range.
+    NODISCARD ALWAYS_INLINE static constexpr u8 float_to_unorm8(float value)
+    {
+        return static_cast<u8>(Math::clamp(value, 0.0F, 1.0F) * 255.0F + 0.5F);
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr float unorm8_to_float(u8 value) { return static_cast<float>(value) * (1.0F / 255.0F); }
+
+    // Maps the `[0, 1]` range to the `[0, 65535]` range.
+    NODISCARD ALWAYS_INLINE static constexpr u16 float_to_unorm16(float value)
+    {
+        return static_cast<u16>(Math::clamp(value, 0.0F, 1.0F) * 65535.0F + 0.5F);
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr float unorm16_to_float(u16 value) { return static_cast<float>(value) * (1.0F / 65535.0F); }
+
+    //
+    // Maps the `[-1, 1]` range to the `[-127, 127]` range. The value -128 is never produced by the encoder
+    // and is decoded as -1, which keeps zero exactly representable (as recommended by the D3D and GL specifications).
+    //
+    NODISCARD ALWAYS_INLINE static constexpr i8 float_to_snorm8(float value)
+    {
+        const float scaled_value = Math::clamp(value, -1.0F, 1.0F) * 127.0F;
+        return static_cast<i8>((scaled_value >= 0.0F) ? (scaled_value + 0.5F) : (scaled_value - 0.5F));
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr float snorm8_to_float(i8 value)
+    {
+        return Math::max(static_cast<float>(value) * (1.0F / 127.0F), -1.0F);
+    }
+
+    // Maps the `[-1, 1]` range to the `[-32767, 32767]` range. See `Quantization::float_to_snorm8` for details.
+    NODISCARD ALWAYS_INLINE static constexpr i16 float_to_snorm16(float value)
+    {
+        const float scaled_value = Math::clamp(value, -1.0F, 1.0F) * 32767.0F;
+        return static_cast<i16>((scaled_value >= 0.0F) ? (scaled_value + 0.5F) : (scaled_value - 0.5F));
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr float snorm16_to_float(i16 value)
+    {
+        return Math::max(static_cast<float>(value) * (1.0F / 32767.0F), -1.0F);
+    }
+
+#pragma endregion
+
+#pragma region Octahedral Normals
+
+    //
+    // Encodes a unit vector using the octahedral mapping, storing the two coordinates as snorm16 values
+    // (X in the lower 16 bits, Y in the upper 16 bits). Takes a third of the memory required by three floats.
+    // https://jcgt.org/published/0003/02/01/
+    //
+    NODISCARD static u32 encode_octahedral_normal(Vector3 normal);
+
+    // Decodes a normal encoded by `Quantization::encode_octahedral_normal`. The result is normalized.
+    NODISCARD static Vector3 decode_octahedral_normal(u32 encoded_normal);
+
+#pragma endregion
+
+#pragma region Batch Conversions
+
+    //
+    // Batch versions of the conversion functions, which process eight values at once using F16C (if available).
+    // The buffers must not overlap.
+    //
+    static void floats_to_halves(const float* values, usize value_count, u16* out_halves);
+    static void halves_to_floats(const u16* halves, usize half_count, float* out_values);
+
+    //
+    // Wrappers around the batch conversion functions that operate on containers.
+    // The converted values are appended to the output container.
+    //
+    static void floats_to_halves(const Vector<float>& values, Vector<u16>& out_halves);
+    static void halves_to_floats(const Vector<u16>& halves, Vector<float>& out_values);
+    static void floats_to_unorm8(const Vector<float>& values, Vector<u8>& out_values);
+    static void floats_to_snorm16(const Vector<float>& values, Vector<i16>& out_values);
+    static void encode_octahedral_normals(const Vector<Vector3>& normals, Vector<u32>& out_encoded_normals);
+    static void decode_octahedral_normals(const Vector<u32>& encoded_normals, Vector<Vector3>& out_normals);
+
+#pragma endregion
+};
+
+} // namespace CaveGame
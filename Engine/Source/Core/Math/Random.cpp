@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/Random.h>
+
+#if CAVE_SIMD_AVX2
+    #include <immintrin.h>
+#endif // CAVE_SIMD_AVX2
+
+namespace CaveGame
+{
+
+#pragma region Xoshiro256
+
+Xoshiro256 Xoshiro256::create_from_seed(u64 seed)
+{
+    Xoshiro256 generator;
+    for (u64& state_word : generator.m_state)
+    {
+        seed += 0x9E3779B97F4A7C15ULL;
+        state_word = Random::mix_u64(seed);
+    }
+
+    // NOTE: SplitMix64 never produces four consecutive zeros, so the all-zero state (which is invalid) can't be reached.
+    return generator;
+}
+
+void Xoshiro256::jump()
+{
+    static constexpr u64 jump_polynomial[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    apply_jump_polynomial(jump_polynomial);
+}
+
+void Xoshiro256::long_jump()
+{
+    static constexpr u64 long_jump_polynomial[4] = { 0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL };
+    apply_jump_polynomial(long_jump_polynomial);
+}
+
+void Xoshiro256::apply_jump_polynomial(const u64 polynomial[4])
+{
+    u64 jumped_state[4] = {};
+    for (u32 word_index = 0; word_index < 4; ++word_index)
+    {
+        for (u32 bit_index = 0; bit_index < 64; ++bit_index)
+        {
+            if (polynomial[word_index] & (1ULL << bit_index))
+            {
+                for (u32 state_index = 0; state_index < 4; ++state_index)
+                    jumped_state[state_index] ^= m_state[state_index];
+            }
+            MAYBE_UNUSED const u64 discarded = next_u64();
+        }
+    }
+
+    for (u32 state_index = 0; state_index < 4; ++state_index)
+        m_state[state_index] = jumped_state[state_index];
+}
+
+#pragma endregion
+
+#pragma region PCG32
+
+PCG32 PCG32::create_from_seed(u64 seed, u64 stream)
+{
+    // Follows the reference `pcg32_srandom_r` seeding procedure.
+    PCG32 generator;
+    generator.m_state = 0;
+    generator.m_increment = (stream << 1) | 1;
+    MAYBE_UNUSED const u32 first_discarded = generator.next_u32();
+    generator.m_state += seed;
+    MAYBE_UNUSED const u32 second_discarded = generator.next_u32();
+    return generator;
+}
+
+void PCG32::advance(u64 step_count)
+{
+    //
+    // Computes the affine transformation of advancing the LCG `step_count` times, by composing the single
+    // step transformation with itself using binary exponentiation.
+    // https://www.pcg-random.org/pdf/hmc-cs-2014-0905.pdf (Section 4.3.1).
+    //
+    u64 current_multiplier = multiplier;
+    u64 current_increment = m_increment;
+    u64 accumulated_multiplier = 1;
+    u64 accumulated_increment = 0;
+
+    while (step_count > 0)
+    {
+        if (step_count & 1)
+        {
+            accumulated_multiplier *= current_multiplier;
+            accumulated_increment = accumulated_increment * current_multiplier + current_increment;
+        }
+
+        current_increment = (current_multiplier + 1) * current_increment;
+        current_multiplier *= current_multiplier;
+        step_count >>= 1;
+    }
+
+    m_state = accumulated_multiplier * m_state + accumulated_increment;
+}
+
+#pragma endregion
+
+#pragma region Xoshiro256x8
+
+Xoshiro256x8 Xoshiro256x8::create_from_seed(u64 seed)
+{
+    Xoshiro256x8 generator;
+    Xoshiro256 lane_generator = Xoshiro256::create_from_seed(seed);
+
+    for (u32 lane = 0; lane < lane_count; ++lane)
+    {
+        const u64* lane_state = lane_generator.get_state();
+        for (u32 state_index = 0; state_index < 4; ++state_index)
+            generator.m_state[state_index][get_slot_of_lane(lane)] = lane_state[state_index];
+        lane_generator.jump();
+    }
+
+    return generator;
+}
+
+#if CAVE_SIMD_AVX2
+
+NODISCARD ALWAYS_INLINE static __m256i rotate_left_u64x4(__m256i value, int shift_count)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(value, shift_count), _mm256_srli_epi64(value, 64 - shift_count));
+}
+
+//
+// Advances four generators, whose state words are stored in the given registers, and returns their outputs.
+// Mirrors `Xoshiro256::next_u64()` exactly.
+//
+NODISCARD ALWAYS_INLINE static __m256i xoshiro256_next_u64x4(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3)
+{
+    const __m256i result = _mm256_add_epi64(rotate_left_u64x4(_mm256_add_epi64(s0, s3), 23), s0);
+    const __m256i t = _mm256_slli_epi64(s1, 17);
+
+    s2 = _mm256_xor_si256(s2, s0);
+    s3 = _mm256_xor_si256(s3, s1);
+    s1 = _mm256_xor_si256(s1, s2);
+    s0 = _mm256_xor_si256(s0, s3);
+    s2 = _mm256_xor_si256(s2, t);
+    s3 = rotate_left_u64x4(s3, 45);
+
+    return result;
+}
+
+#endif // CAVE_SIMD_AVX2
+
+void Xoshiro256x8::next_u32x8(u32 out_values[lane_count])
+{
+#if CAVE_SIMD_AVX2
+    __m256i* state = reinterpret_cast<__m256i*>(m_state);
+
+    // The first register of each state word holds the even lanes, the second holds the odd lanes.
+    __m256i even_s0 = _mm256_load_si256(state + 0), odd_s0 = _mm256_load_si256(state + 1);
+    __m256i even_s1 = _mm256_load_si256(state + 2), odd_s1 = _mm256_load_si256(state + 3);
+    __m256i even_s2 = _mm256_load_si256(state + 4), odd_s2 = _mm256_load_si256(state + 5);
+    __m256i even_s3 = _mm256_load_si256(state + 6), odd_s3 = _mm256_load_si256(state + 7);
+
+    const __m256i even_result = xoshiro256_next_u64x4(even_s0, even_s1, even_s2, even_s3);
+    const __m256i odd_result = xoshiro256_next_u64x4(odd_s0, odd_s1, odd_s2, odd_s3);
+
+    // Move the upper halves of the even lanes to the even 32-bit positions and blend in the (already in place)
+    // upper halves of the odd lanes.
+    const __m256i result = _mm256_blend_epi32(_mm256_srli_epi64(even_result, 32), odd_result, 0b10101010);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_values), result);
+
+    _mm256_store_si256(state + 0, even_s0), _mm256_store_si256(state + 1, odd_s0);
+    _mm256_store_si256(state + 2, even_s1), _mm256_store_si256(state + 3, odd_s1);
+    _mm256_store_si256(state + 4, even_s2), _mm256_store_si256(state + 5, odd_s2);
+    _mm256_store_si256(state + 6, even_s3), _mm256_store_si256(state + 7, odd_s3);
+#else
+    for (u32 lane = 0; lane < lane_count; ++lane)
+    {
+        const u32 slot = get_slot_of_lane(lane);
+        u64& s0 = m_state[0][slot];
+        u64& s1 = m_state[1][slot];
+        u64& s2 = m_state[2][slot];
+        u64& s3 = m_state[3][slot];
+
+        const u64 sum = s0 + s3;
+        const u64 result = ((sum << 23) | (sum >> 41)) + s0;
+        const u64 t = s1 << 17;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 45) | (s3 >> 19);
+
+        out_values[lane] = static_cast<u32>(result >> 32);
+    }
+#endif // CAVE_SIMD_AVX2
+}
+
+void Xoshiro256x8::fill_u32(u32* out_values, usize value_count)
+{
+    usize value_index = 0;
+    for (; value_index + lane_count <= value_count; value_index += lane_count)
+        next_u32x8(out_values + value_index);
+
+    if (value_index < value_count)
+    {
+        u32 last_values[lane_count];
+        next_u32x8(last_values);
+        for (u32 lane = 0; value_index < value_count; ++value_index, ++lane)
+            out_values[value_index] = last_values[lane];
+    }
+}
+
+void Xoshiro256x8::fill_float(float* out_values, usize value_count, float range_min, float range_max)
+{
+    const float range_size = range_max - range_min;
+
+    usize value_index = 0;
+    for (; value_index < value_count; value_index += lane_count)
+    {
+        alignas(32) u32 random_values[lane_count];
+        next_u32x8(random_values);
+
+#if CAVE_SIMD_AVX2
+        if (value_index + lane_count <= value_count)
+        {
+            // Mirrors `Random::u32_to_unit_float` followed by the range mapping.
+            const __m256i mantissa_bits = _mm256_srli_epi32(_mm256_load_si256(reinterpret_cast<const __m256i*>(random_values)), 8);
+            const __m256 unit_values = _mm256_mul_ps(_mm256_cvtepi32_ps(mantissa_bits), _mm256_set1_ps(1.0F / 16777216.0F));
+            const __m256 values = _mm256_add_ps(_mm256_set1_ps(range_min), _mm256_mul_ps(_mm256_set1_ps(range_size), unit_values));
+            _mm256_storeu_ps(out_values + value_index, values);
+            continue;
+        }
+#endif // CAVE_SIMD_AVX2
+
+        for (u32 lane = 0; lane < lane_count && value_index + lane < value_count; ++lane)
+            out_values[value_index + lane] = range_min + range_size * Random::u32_to_unit_float(random_values[lane]);
+    }
+}
+
+void Xoshiro256x8::fill_i32_in_range(i32* out_values, usize value_count, i32 range_min, i32 range_max)
+{
+    CAVE_MATH_ASSERT(range_min <= range_max);
+    const u32 bound = static_cast<u32>(range_max) - static_cast<u32>(range_min) + 1;
+
+    usize value_index = 0;
+    for (; value_index < value_count; value_index += lane_count)
+    {
+        alignas(32) u32 random_values[lane_count];
+        next_u32x8(random_values);
+
+#if CAVE_SIMD_AVX2
+        if (value_index + lane_count <= value_count)
+        {
+            // Mirrors `Random::u32_to_bounded`. The 32x32->64 multiplication only exists for the even 32-bit
+            // elements, so the odd elements are shifted into the even positions first. The span of the full `i32`
+            // range wraps to zero, in which case the random values are used unchanged.
+            const __m256i values = _mm256_load_si256(reinterpret_cast<const __m256i*>(random_values));
+            const __m256i bound_values = _mm256_set1_epi32(static_cast<i32>(bound));
+            const __m256i even_products = _mm256_mul_epu32(values, bound_values);
+            const __m256i odd_products = _mm256_mul_epu32(_mm256_srli_epi64(values, 32), bound_values);
+            __m256i bounded_values = _mm256_blend_epi32(_mm256_srli_epi64(even_products, 32), odd_products, 0b10101010);
+            if (bound == 0)
+                bounded_values = values;
+            const __m256i result = _mm256_add_epi32(bounded_values, _mm256_set1_epi32(range_min));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_values + value_index), result);
+            continue;
+        }
+#endif // CAVE_SIMD_AVX2
+
+        for (u32 lane = 0; lane < lane_count && value_index + lane < value_count; ++lane)
+            out_values[value_index + lane] = Random::u32_to_i32_in_range(random_values[lane], range_min, range_max);
+    }
+}
+
+#pragma endregion
+
+} // namespace CaveGame
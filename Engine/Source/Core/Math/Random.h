@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Utility functions shared by all random number generators.
+// All generators are deterministic: the same seed always produces the same sequence, on any platform.
+//
+class Random
+{
+public:
+    // The SplitMix64 finalizer. Maps any 64-bit value to a well distributed 64-bit value.
+    NODISCARD ALWAYS_INLINE static constexpr u64 mix_u64(u64 value)
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    //
+    // Derives the seed of a chunk from the world seed and the chunk coordinates. Neighboring chunks receive
+    // uncorrelated seeds, and the result doesn't depend on the order in which the chunks are generated.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr u64 derive_chunk_seed(u64 world_seed, i32 chunk_x, i32 chunk_y, i32 chunk_z)
+    {
+        u64 seed = mix_u64(world_seed);
+        seed = mix_u64(seed ^ (static_cast<u64>(static_cast<u32>(chunk_x)) * 0x9E3779B97F4A7C15ULL));
+        seed = mix_u64(seed ^ (static_cast<u64>(static_cast<u32>(chunk_y)) * 0xC2B2AE3D27D4EB4FULL));
+        seed = mix_u64(seed ^ (static_cast<u64>(static_cast<u32>(chunk_z)) * 0x165667B19E3779F9ULL));
+        return seed;
+    }
+
+    // Converts the 24 most significant bits of the value to a float in the `[0, 1)` range.
+    NODISCARD ALWAYS_INLINE static constexpr float u32_to_unit_float(u32 value) { return static_cast<float>(value >> 8) * (1.0F / 16777216.0F); }
+
+    //
+    // Maps the value to the `[0, bound)` range using a multiply-shift (Lemire's method, without rejection).
+    // The bias is at most `bound / 2^32`, which is negligible for the ranges used by the game.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr u32 u32_to_bounded(u32 value, u32 bound)
+    {
+        return static_cast<u32>((static_cast<u64>(value) * static_cast<u64>(bound)) >> 32);
+    }
+
+    //
+    // Maps the value to the `[range_min, range_max]` range. The span and the offset are computed with unsigned
+    // arithmetic, so that ranges wider than `INT32_MAX` don't overflow. The span of the full `i32` range wraps to
+    // zero, in which case the value is used unchanged.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr i32 u32_to_i32_in_range(u32 value, i32 range_min, i32 range_max)
+    {
+        const u32 bound = static_cast<u32>(range_max) - static_cast<u32>(range_min) + 1;
+        const u32 offset = (bound != 0) ? u32_to_bounded(value, bound) : value;
+        return static_cast<i32>(static_cast<u32>(range_min) + offset);
+    }
+};
+
+//
+// The xoshiro256++ generator, by David Blackman and Sebastiano Vigna. It has a period of 2^256 - 1 and its
+// `jump()` function advances the state by 2^128 steps, which produces non-overlapping streams.
+//
+class Xoshiro256
+{
+public:
+    // Initializes the state by expanding the seed using SplitMix64, as recommended by the authors.
+    NODISCARD static Xoshiro256 create_from_seed(u64 seed);
+
+    // Wrapper around `Xoshiro256::create_from_seed` and `Random::derive_chunk_seed`.
+    NODISCARD ALWAYS_INLINE static Xoshiro256 create_for_chunk(u64 world_seed, i32 chunk_x, i32 chunk_y, i32 chunk_z)
+    {
+        return create_from_seed(Random::derive_chunk_seed(world_seed, chunk_x, chunk_y, chunk_z));
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE u64 next_u64()
+    {
+        const u64 result = rotate_left(m_state[0] + m_state[3], 23) + m_state[0];
+        const u64 t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotate_left(m_state[3], 45);
+
+        return result;
+    }
+
+    // NOTE: The upper bits of the xoshiro256++ output have the best statistical quality.
+    NODISCARD ALWAYS_INLINE u32 next_u32() { return static_cast<u32>(next_u64() >> 32); }
+
+    // Returns a float uniformly distributed in the `[0, 1)` range.
+    NODISCARD ALWAYS_INLINE float next_float() { return Random::u32_to_unit_float(next_u32()); }
+
+    // Returns a float uniformly distributed in the `[range_min, range_max)` range.
+    NODISCARD ALWAYS_INLINE float next_float_in_range(float range_min, float range_max) { return range_min + (range_max - range_min) * next_float(); }
+
+    // Returns an integer uniformly distributed in the `[0, bound)` range.
+    NODISCARD ALWAYS_INLINE u32 next_u32_below(u32 bound) { return Random::u32_to_bounded(next_u32(), bound); }
+
+    // Returns an integer uniformly distributed in the `[range_min, range_max]` range.
+    NODISCARD ALWAYS_INLINE i32 next_i32_in_range(i32 range_min, i32 range_max)
+    {
+        CAVE_MATH_ASSERT(range_min <= range_max);
+        return Random::u32_to_i32_in_range(next_u32(), range_min, range_max);
+    }
+
+public:
+    // Advances the state by 2^128 steps. Can be used to generate 2^128 non-overlapping streams.
+    void jump();
+
+    // Advances the state by 2^192 steps. Can be used to generate 2^64 starting points, each of them with 2^64 `jump()` streams.
+    void long_jump();
+
+    NODISCARD ALWAYS_INLINE const u64* get_state() const { return m_state; }
+
+private:
+    NODISCARD ALWAYS_INLINE static constexpr u64 rotate_left(u64 value, u32 shift_count) { return (value << shift_count) | (value >> (64 - shift_count)); }
+
+    void apply_jump_polynomial(const u64 polynomial[4]);
+
+private:
+    u64 m_state[4] {};
+};
+
+//
+// The PCG32 generator (XSH-RR variant), by Melissa O'Neill. It has a small state (two 64-bit integers) and
+// supports 2^63 independent streams selected at seeding time, plus arbitrary distance jumps.
+//
+class PCG32
+{
+public:
+    static constexpr u64 multiplier = 6364136223846793005ULL;
+
+public:
+    //
+    // Initializes the generator with the given seed and stream. Generators that use different streams produce
+    // independent sequences, even when they are seeded with the same value.
+    //
+    NODISCARD static PCG32 create_from_seed(u64 seed, u64 stream = 0);
+
+    //
+    // Wrapper around `PCG32::create_from_seed` and `Random::derive_chunk_seed`.
+    // The stream is derived from the chunk coordinates as well.
+    //
+    NODISCARD ALWAYS_INLINE static PCG32 create_for_chunk(u64 world_seed, i32 chunk_x, i32 chunk_y, i32 chunk_z)
+    {
+        const u64 chunk_seed = Random::derive_chunk_seed(world_seed, chunk_x, chunk_y, chunk_z);
+        return create_from_seed(chunk_seed, Random::mix_u64(chunk_seed));
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE u32 next_u32()
+    {
+        const u64 old_state = m_state;
+        m_state = old_state * multiplier + m_increment;
+
+        const u32 xor_shifted = static_cast<u32>(((old_state >> 18) ^ old_state) >> 27);
+        const u32 rotation = static_cast<u32>(old_state >> 59);
+        return (xor_shifted >> rotation) | (xor_shifted << ((0U - rotation) & 31));
+    }
+
+    NODISCARD ALWAYS_INLINE u64 next_u64()
+    {
+        const u64 high = next_u32();
+        const u64 low = next_u32();
+        return (high << 32) | low;
+    }
+
+    // Returns a float uniformly distributed in the `[0, 1)` range.
+    NODISCARD ALWAYS_INLINE float next_float() { return Random::u32_to_unit_float(next_u32()); }
+
+    // Returns a float uniformly distributed in the `[range_min, range_max)` range.
+    NODISCARD ALWAYS_INLINE float next_float_in_range(float range_min, float range_max) { return range_min + (range_max - range_min) * next_float(); }
+
+    // Returns an integer uniformly distributed in the `[0, bound)` range.
+    NODISCARD ALWAYS_INLINE u32 next_u32_below(u32 bound) { return Random::u32_to_bounded(next_u32(), bound); }
+
+    // Returns an integer uniformly distributed in the `[range_min, range_max]` range.
+    NODISCARD ALWAYS_INLINE i32 next_i32_in_range(i32 range_min, i32 range_max)
+    {
+        CAVE_MATH_ASSERT(range_min <= range_max);
+        return Random::u32_to_i32_in_range(next_u32(), range_min, range_max);
+    }
+
+public:
+    // Advances the state by `step_count` steps in `O(log(step_count))` time. The generator is not required to be consumed.
+    void advance(u64 step_count);
+
+    // Advances the state by 2^48 steps, splitting the current stream into 2^16 non-overlapping sub-streams.
+    ALWAYS_INLINE void jump() { advance(1ULL << 48); }
+
+private:
+    u64 m_state { 0 };
+    u64 m_increment { 1 };
+};
+
+//
+// Eight independent xoshiro256++ generators, advanced simultaneously using AVX2 (if available).
+// Lane N is seeded with the state of `Xoshiro256::create_from_seed(seed)` jumped N times, so the lanes never
+// overlap. The scalar fallback produces exactly the same values.
+//
+class Xoshiro256x8
+{
+public:
+    static constexpr u32 lane_count = 8;
+
+public:
+    NODISCARD static Xoshiro256x8 create_from_seed(u64 seed);
+
+    // Wrapper around `Xoshiro256x8::create_from_seed` and `Random::derive_chunk_seed`.
+    NODISCARD ALWAYS_INLINE static Xoshiro256x8 create_for_chunk(u64 world_seed, i32 chunk_x, i32 chunk_y, i32 chunk_z)
+    {
+        return create_from_seed(Random::derive_chunk_seed(world_seed, chunk_x, chunk_y, chunk_z));
+    }
+
+public:
+    // Generates the next value of every lane, storing the upper 32 bits of lane N to `out_values[N]`.
+    void next_u32x8(u32 out_values[lane_count]);
+
+    //
+    // Fills the buffer with random values. A call to this function is equivalent to calling `next_u32x8`
+    // repeatedly and concatenating the outputs; the values of the last incomplete group are discarded.
+    //
+    void fill_u32(u32* out_values, usize value_count);
+
+    // Fills the buffer with floats uniformly distributed in the `[range_min, range_max)` range.
+    void fill_float(float* out_values, usize value_count, float range_min = 0.0F, float range_max = 1.0F);
+
+    // Fills the buffer with integers uniformly distributed in the `[range_min, range_max]` range.
+    void fill_i32_in_range(i32* out_values, usize value_count, i32 range_min, i32 range_max);
+
+private:
+    //
+    // The state is stored in a structure-of-arrays layout. The lanes are interleaved such that the even lanes
+    // occupy the first four slots and the odd lanes the last four, which allows the vectorized code to
+    // extract the upper halves of two 4x64-bit registers into a single 8x32-bit register with one blend.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr u32 get_slot_of_lane(u32 lane) { return (lane % 2) * (lane_count / 2) + (lane / 2); }
+
+private:
+    alignas(32) u64 m_state[4][lane_count] {};
+};
+
+} // namespace CaveGame
@@ -20,7 +20,7 @@ namespace CaveGame
 struct Vector2
 {
 public:
-    NODISCARD ALWAYS_INLINE static float length_squared(Vector2 vector)
+    NODISCARD ALWAYS_INLINE static constexpr float length_squared(Vector2 vector)
     {
         const float result = (vector.x * vector.x) + (vector.y * vector.y);
         return result;
@@ -33,7 +33,7 @@ public:
         return result;
     }
 
-    NODISCARD ALWAYS_INLINE static float dot(Vector2 a, Vector2 b)
+    NODISCARD ALWAYS_INLINE static constexpr float dot(Vector2 a, Vector2 b)
     {
         const float result = (a.x * b.x) + (a.y * b.y);
         return result;
@@ -42,29 +42,27 @@ public:
     NODISCARD ALWAYS_INLINE static Vector2 normalize(Vector2 vector)
     {
         const float length = Vector2::length(vector);
-        CAVE_ASSERT(length > Math::small_number);
+        CAVE_MATH_ASSERT(length > Math::small_number);
         const float inv_length = 1.0F / length;
         const Vector2 result = Vector2(vector.x * inv_length, vector.y * inv_length);
         return result;
     }
 
 public:
-    ALWAYS_INLINE Vector2()
+    ALWAYS_INLINE constexpr Vector2()
         : x(0.0F)
         , y(0.0F)
     {}
 
-    ALWAYS_INLINE Vector2(const Vector2& other)
-        : x(other.x)
-        , y(other.y)
-    {}
+    constexpr Vector2(const Vector2& other) = default;
+    constexpr Vector2& operator=(const Vector2& other) = default;
 
-    ALWAYS_INLINE Vector2(float in_x, float in_y)
+    ALWAYS_INLINE constexpr Vector2(float in_x, float in_y)
         : x(in_x)
         , y(in_y)
     {}
 
-    ALWAYS_INLINE Vector2(float scalar)
+    ALWAYS_INLINE constexpr Vector2(float scalar)
         : x(scalar)
         , y(scalar)
     {}
@@ -72,7 +70,7 @@ public:
 public:
     // Wrapper around `Vector2::length_squared`.
     // See the above function declaration for documentation.
-    NODISCARD ALWAYS_INLINE float length_squared() const { return Vector2::length_squared(*this); }
+    NODISCARD ALWAYS_INLINE constexpr float length_squared() const { return Vector2::length_squared(*this); }
 
     // Wrapper around `Vector2::length`.
     // See the above function declaration for documentation.
@@ -89,30 +87,34 @@ public:
     NODISCARD ALWAYS_INLINE float& operator[](Math::Axis axis)
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 2);
+        CAVE_MATH_ASSERT(value_index < 2);
         return value_ptr()[value_index];
     }
 
     NODISCARD ALWAYS_INLINE const float& operator[](Math::Axis axis) const
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 2);
+        CAVE_MATH_ASSERT(value_index < 2);
         return value_ptr()[value_index];
     }
 
+    // Returns the component along the given axis, without checking that the axis is valid in any build configuration.
+    NODISCARD ALWAYS_INLINE float& unchecked_at(Math::Axis axis) { return value_ptr()[static_cast<u8>(axis)]; }
+    NODISCARD ALWAYS_INLINE const float& unchecked_at(Math::Axis axis) const { return value_ptr()[static_cast<u8>(axis)]; }
+
 public:
     float x;
     float y;
 };
 
 // Component-wise addition operator.
-NODISCARD ALWAYS_INLINE Vector2 operator+(Vector2 a, Vector2 b)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator+(Vector2 a, Vector2 b)
 {
     const Vector2 result = Vector2(a.x + b.x, a.y + b.y);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector2& operator+=(Vector2& self, Vector2 other)
+NODISCARD ALWAYS_INLINE constexpr Vector2& operator+=(Vector2& self, Vector2 other)
 {
     self.x += other.x;
     self.y += other.y;
@@ -120,13 +122,13 @@ NODISCARD ALWAYS_INLINE Vector2& operator+=(Vector2& self, Vector2 other)
 }
 
 // Component-wise subtraction operator.
-NODISCARD ALWAYS_INLINE Vector2 operator-(Vector2 lhs, Vector2 rhs)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator-(Vector2 lhs, Vector2 rhs)
 {
     const Vector2 result = Vector2(lhs.x - rhs.x, lhs.y - rhs.y);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector2& operator-=(Vector2& self, Vector2 other)
+NODISCARD ALWAYS_INLINE constexpr Vector2& operator-=(Vector2& self, Vector2 other)
 {
     self.x -= other.x;
     self.y -= other.y;
@@ -134,27 +136,27 @@ NODISCARD ALWAYS_INLINE Vector2& operator-=(Vector2& self, Vector2 other)
 }
 
 // Component-wise negation operator.
-NODISCARD ALWAYS_INLINE Vector2 operator-(Vector2 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator-(Vector2 vector)
 {
     const Vector2 result = Vector2(-vector.x, -vector.y);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector2 operator*(Vector2 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator*(Vector2 vector, float scalar)
 {
     const Vector2 result = Vector2(vector.x * scalar, vector.y * scalar);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector2 operator*(float scalar, Vector2 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator*(float scalar, Vector2 vector)
 {
     const Vector2 result = Vector2(vector.x * scalar, vector.y * scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector2& operator*=(Vector2& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector2& operator*=(Vector2& self, float scalar)
 {
     self.x *= scalar;
     self.y *= scalar;
@@ -162,14 +164,14 @@ NODISCARD ALWAYS_INLINE Vector2& operator*=(Vector2& self, float scalar)
 }
 
 // Component-wise scalar division operator.
-NODISCARD ALWAYS_INLINE Vector2 operator/(Vector2 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector2 operator/(Vector2 vector, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     const Vector2 result = Vector2(vector.x * inv_scalar, vector.y * inv_scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector2& operator/=(Vector2& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector2& operator/=(Vector2& self, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     self.x *= inv_scalar;
@@ -184,7 +186,7 @@ NODISCARD ALWAYS_INLINE Vector2& operator/=(Vector2& self, float scalar)
 struct Vector3
 {
 public:
-    NODISCARD ALWAYS_INLINE static float length_squared(Vector3 vector)
+    NODISCARD ALWAYS_INLINE static constexpr float length_squared(Vector3 vector)
     {
         const float result = (vector.x * vector.x) + (vector.y * vector.y) + (vector.z * vector.z);
         return result;
@@ -197,13 +199,13 @@ public:
         return result;
     }
 
-    NODISCARD ALWAYS_INLINE static float dot(Vector3 a, Vector3 b)
+    NODISCARD ALWAYS_INLINE static constexpr float dot(Vector3 a, Vector3 b)
     {
         const float result = (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
         return result;
     }
 
-    NODISCARD ALWAYS_INLINE static Vector3 cross(Vector3 lhs, Vector3 rhs)
+    NODISCARD ALWAYS_INLINE static constexpr Vector3 cross(Vector3 lhs, Vector3 rhs)
     {
         // clang-format off
         const Vector3 result = Vector3(
@@ -218,7 +220,7 @@ public:
     NODISCARD ALWAYS_INLINE static Vector3 normalize(Vector3 vector)
     {
         const float length = Vector3::length(vector);
-        CAVE_ASSERT(length > Math::small_number);
+        CAVE_MATH_ASSERT(length > Math::small_number);
         const float inv_length = 1.0F / length;
 
         const Vector3 result = Vector3(vector.x * inv_length, vector.y * inv_length, vector.z * inv_length);
@@ -226,25 +228,22 @@ public:
     }
 
 public:
-    ALWAYS_INLINE Vector3()
+    ALWAYS_INLINE constexpr Vector3()
         : x(0.0F)
         , y(0.0F)
         , z(0.0F)
     {}
 
-    ALWAYS_INLINE Vector3(const Vector3& other)
-        : x(other.x)
-        , y(other.y)
-        , z(other.z)
-    {}
+    constexpr Vector3(const Vector3& other) = default;
+    constexpr Vector3& operator=(const Vector3& other) = default;
 
-    ALWAYS_INLINE Vector3(float in_x, float in_y, float in_z)
+    ALWAYS_INLINE constexpr Vector3(float in_x, float in_y, float in_z)
         : x(in_x)
         , y(in_y)
         , z(in_z)
     {}
 
-    ALWAYS_INLINE Vector3(float scalar)
+    ALWAYS_INLINE constexpr Vector3(float scalar)
         : x(scalar)
         , y(scalar)
         , z(scalar)
@@ -253,7 +252,7 @@ public:
 public:
     // Wrapper around `Vector3::length_squared`.
     // See the above function declaration for documentation.
-    NODISCARD ALWAYS_INLINE float length_squared() const { return Vector3::length_squared(*this); }
+    NODISCARD ALWAYS_INLINE constexpr float length_squared() const { return Vector3::length_squared(*this); }
 
     // Wrapper around `Vector3::length`.
     // See the above function declaration for documentation.
@@ -270,17 +269,21 @@ public:
     NODISCARD ALWAYS_INLINE float& operator[](Math::Axis axis)
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 3);
+        CAVE_MATH_ASSERT(value_index < 3);
         return value_ptr()[value_index];
     }
 
     NODISCARD ALWAYS_INLINE const float& operator[](Math::Axis axis) const
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 3);
+        CAVE_MATH_ASSERT(value_index < 3);
         return value_ptr()[value_index];
     }
 
+    // Returns the component along the given axis, without checking that the axis is valid in any build configuration.
+    NODISCARD ALWAYS_INLINE float& unchecked_at(Math::Axis axis) { return value_ptr()[static_cast<u8>(axis)]; }
+    NODISCARD ALWAYS_INLINE const float& unchecked_at(Math::Axis axis) const { return value_ptr()[static_cast<u8>(axis)]; }
+
 public:
     float x;
     float y;
@@ -288,13 +291,13 @@ public:
 };
 
 // Component-wise addition operator.
-NODISCARD ALWAYS_INLINE Vector3 operator+(Vector3 a, Vector3 b)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator+(Vector3 a, Vector3 b)
 {
     const Vector3 result = Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector3& operator+=(Vector3& self, Vector3 other)
+NODISCARD ALWAYS_INLINE constexpr Vector3& operator+=(Vector3& self, Vector3 other)
 {
     self.x += other.x;
     self.y += other.y;
@@ -303,13 +306,13 @@ NODISCARD ALWAYS_INLINE Vector3& operator+=(Vector3& self, Vector3 other)
 }
 
 // Component-wise subtraction operator.
-NODISCARD ALWAYS_INLINE Vector3 operator-(Vector3 lhs, Vector3 rhs)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator-(Vector3 lhs, Vector3 rhs)
 {
     const Vector3 result = Vector3(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector3& operator-=(Vector3& self, Vector3 other)
+NODISCARD ALWAYS_INLINE constexpr Vector3& operator-=(Vector3& self, Vector3 other)
 {
     self.x -= other.x;
     self.y -= other.y;
@@ -318,27 +321,27 @@ NODISCARD ALWAYS_INLINE Vector3& operator-=(Vector3& self, Vector3 other)
 }
 
 // Component-wise negation operator.
-NODISCARD ALWAYS_INLINE Vector3 operator-(Vector3 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator-(Vector3 vector)
 {
     const Vector3 result = Vector3(-vector.x, -vector.y, -vector.z);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector3 operator*(Vector3 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator*(Vector3 vector, float scalar)
 {
     const Vector3 result = Vector3(vector.x * scalar, vector.y * scalar, vector.z * scalar);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector3 operator*(float scalar, Vector3 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator*(float scalar, Vector3 vector)
 {
     const Vector3 result = Vector3(vector.x * scalar, vector.y * scalar, vector.z * scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector3& operator*=(Vector3& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector3& operator*=(Vector3& self, float scalar)
 {
     self.x *= scalar;
     self.y *= scalar;
@@ -347,14 +350,14 @@ NODISCARD ALWAYS_INLINE Vector3& operator*=(Vector3& self, float scalar)
 }
 
 // Component-wise scalar division operator.
-NODISCARD ALWAYS_INLINE Vector3 operator/(Vector3 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector3 operator/(Vector3 vector, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     const Vector3 result = Vector3(vector.x * inv_scalar, vector.y * inv_scalar, vector.z * inv_scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector3& operator/=(Vector3& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector3& operator/=(Vector3& self, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     self.x *= inv_scalar;
@@ -370,28 +373,24 @@ NODISCARD ALWAYS_INLINE Vector3& operator/=(Vector3& self, float scalar)
 struct Vector4
 {
 public:
-    ALWAYS_INLINE Vector4()
+    ALWAYS_INLINE constexpr Vector4()
         : x(0.0F)
         , y(0.0F)
         , z(0.0F)
         , w(0.0F)
     {}
 
-    ALWAYS_INLINE Vector4(const Vector4& other)
-        : x(other.x)
-        , y(other.y)
-        , z(other.z)
-        , w(other.w)
-    {}
+    constexpr Vector4(const Vector4& other) = default;
+    constexpr Vector4& operator=(const Vector4& other) = default;
 
-    ALWAYS_INLINE Vector4(float in_x, float in_y, float in_z, float in_w)
+    ALWAYS_INLINE constexpr Vector4(float in_x, float in_y, float in_z, float in_w)
         : x(in_x)
         , y(in_y)
         , z(in_z)
         , w(in_w)
     {}
 
-    ALWAYS_INLINE Vector4(float scalar)
+    ALWAYS_INLINE constexpr Vector4(float scalar)
         : x(scalar)
         , y(scalar)
         , z(scalar)
@@ -405,17 +404,21 @@ public:
     NODISCARD ALWAYS_INLINE float& operator[](Math::Axis axis)
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 4);
+        CAVE_MATH_ASSERT(value_index < 4);
         return value_ptr()[value_index];
     }
 
     NODISCARD ALWAYS_INLINE const float& operator[](Math::Axis axis) const
     {
         const u8 value_index = static_cast<u8>(axis);
-        CAVE_ASSERT(value_index < 4);
+        CAVE_MATH_ASSERT(value_index < 4);
         return value_ptr()[value_index];
     }
 
+    // Returns the component along the given axis, without checking that the axis is valid in any build configuration.
+    NODISCARD ALWAYS_INLINE float& unchecked_at(Math::Axis axis) { return value_ptr()[static_cast<u8>(axis)]; }
+    NODISCARD ALWAYS_INLINE const float& unchecked_at(Math::Axis axis) const { return value_ptr()[static_cast<u8>(axis)]; }
+
 public:
     float x;
     float y;
@@ -424,13 +427,13 @@ public:
 };
 
 // Component-wise addition operator.
-NODISCARD ALWAYS_INLINE Vector4 operator+(Vector4 a, Vector4 b)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator+(Vector4 a, Vector4 b)
 {
     const Vector4 result = Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector4& operator+=(Vector4& self, Vector4 other)
+NODISCARD ALWAYS_INLINE constexpr Vector4& operator+=(Vector4& self, Vector4 other)
 {
     self.x += other.x;
     self.y += other.y;
@@ -440,13 +443,13 @@ NODISCARD ALWAYS_INLINE Vector4& operator+=(Vector4& self, Vector4 other)
 }
 
 // Component-wise subtraction operator.
-NODISCARD ALWAYS_INLINE Vector4 operator-(Vector4 lhs, Vector4 rhs)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator-(Vector4 lhs, Vector4 rhs)
 {
     const Vector4 result = Vector4(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector4& operator-=(Vector4& self, Vector4 other)
+NODISCARD ALWAYS_INLINE constexpr Vector4& operator-=(Vector4& self, Vector4 other)
 {
     self.x -= other.x;
     self.y -= other.y;
@@ -456,27 +459,27 @@ NODISCARD ALWAYS_INLINE Vector4& operator-=(Vector4& self, Vector4 other)
 }
 
 // Component-wise negation operator.
-NODISCARD ALWAYS_INLINE Vector4 operator-(Vector4 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator-(Vector4 vector)
 {
     const Vector4 result = Vector4(-vector.x, -vector.y, -vector.z, -vector.w);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector4 operator*(Vector4 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator*(Vector4 vector, float scalar)
 {
     const Vector4 result = Vector4(vector.x * scalar, vector.y * scalar, vector.z * scalar, vector.w * scalar);
     return result;
 }
 
 // Component-wise scalar multiplication operator.
-NODISCARD ALWAYS_INLINE Vector4 operator*(float scalar, Vector4 vector)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator*(float scalar, Vector4 vector)
 {
     const Vector4 result = Vector4(vector.x * scalar, vector.y * scalar, vector.z * scalar, vector.w * scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector4& operator*=(Vector4& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector4& operator*=(Vector4& self, float scalar)
 {
     self.x *= scalar;
     self.y *= scalar;
@@ -486,14 +489,14 @@ NODISCARD ALWAYS_INLINE Vector4& operator*=(Vector4& self, float scalar)
 }
 
 // Component-wise scalar division operator.
-NODISCARD ALWAYS_INLINE Vector4 operator/(Vector4 vector, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector4 operator/(Vector4 vector, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     const Vector4 result = Vector4(vector.x * inv_scalar, vector.y * inv_scalar, vector.z * inv_scalar, vector.w * inv_scalar);
     return result;
 }
 
-NODISCARD ALWAYS_INLINE Vector4& operator/=(Vector4& self, float scalar)
+NODISCARD ALWAYS_INLINE constexpr Vector4& operator/=(Vector4& self, float scalar)
 {
     const float inv_scalar = 1.0F / scalar;
     self.x *= inv_scalar;
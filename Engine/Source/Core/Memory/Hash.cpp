@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Memory/Hash.h>
+
+#include <cstring>
+
+namespace CaveGame
+{
+
+static constexpr u64 s_prime_1 = 0x9E3779B185EBCA87ULL;
+static constexpr u64 s_prime_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr u64 s_prime_3 = 0x165667B19E3779F9ULL;
+static constexpr u64 s_prime_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr u64 s_prime_5 = 0x27D4EB2F165667C5ULL;
+
+NODISCARD ALWAYS_INLINE static u64 rotate_left(u64 value, u32 amount)
+{
+    return (value << amount) | (value >> (64 - amount));
+}
+
+// NOTE: The reads are performed with `memcpy`, as the bytes are usually not aligned. Only little endian is supported.
+NODISCARD ALWAYS_INLINE static u64 read_u64(const u8* bytes)
+{
+    u64 value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u32 read_u32(const u8* bytes)
+{
+    u32 value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u64 round(u64 accumulator, u64 input)
+{
+    accumulator += input * s_prime_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * s_prime_1;
+}
+
+NODISCARD ALWAYS_INLINE static u64 merge_round(u64 accumulator, u64 value)
+{
+    accumulator ^= round(0, value);
+    return accumulator * s_prime_1 + s_prime_4;
+}
+
+u64 hash_bytes(const void* bytes, usize byte_count, u64 seed)
+{
+    const u8* current = static_cast<const u8*>(bytes);
+    const u8* const end = current + byte_count;
+    u64 hash;
+
+    if (byte_count >= 32)
+    {
+        // Four independent lanes, so the multiplications of consecutive stripes can execute in parallel.
+        u64 lane_0 = seed + s_prime_1 + s_prime_2;
+        u64 lane_1 = seed + s_prime_2;
+        u64 lane_2 = seed;
+        u64 lane_3 = seed - s_prime_1;
+
+        const u8* const last_stripe = end - 32;
+        do
+        {
+            lane_0 = round(lane_0, read_u64(current + 0));
+            lane_1 = round(lane_1, read_u64(current + 8));
+            lane_2 = round(lane_2, read_u64(current + 16));
+            lane_3 = round(lane_3, read_u64(current + 24));
+            current += 32;
+        } while (current <= last_stripe);
+
+        hash = rotate_left(lane_0, 1) + rotate_left(lane_1, 7) + rotate_left(lane_2, 12) + rotate_left(lane_3, 18);
+        hash = merge_round(hash, lane_0);
+        hash = merge_round(hash, lane_1);
+        hash = merge_round(hash, lane_2);
+        hash = merge_round(hash, lane_3);
+    }
+    else
+    {
+        hash = seed + s_prime_5;
+    }
+
+    hash += static_cast<u64>(byte_count);
+
+    while (current + 8 <= end)
+    {
+        hash ^= round(0, read_u64(current));
+        hash = rotate_left(hash, 27) * s_prime_1 + s_prime_4;
+        current += 8;
+    }
+
+    if (current + 4 <= end)
+    {
+        hash ^= static_cast<u64>(read_u32(current)) * s_prime_1;
+        hash = rotate_left(hash, 23) * s_prime_2 + s_prime_3;
+        current += 4;
+    }
+
+    while (current < end)
+    {
+        hash ^= static_cast<u64>(*current) * s_prime_5;
+        hash = rotate_left(hash, 11) * s_prime_1;
+        ++current;
+    }
+
+    // The final avalanche, which makes every input bit affect every output bit.
+    hash ^= hash >> 33;
+    hash *= s_prime_2;
+    hash ^= hash >> 29;
+    hash *= s_prime_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace CaveGame
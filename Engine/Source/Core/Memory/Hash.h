@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Computes the 64-bit xxHash (XXH64) of the given bytes. Fast (several GB/s) and well distributed, but not
+// cryptographically secure, thus it must only be used to detect accidental corruption or to index tables.
+// The result is the same on every platform, so it can be stored in files.
+//
+NODISCARD u64 hash_bytes(const void* bytes, usize byte_count, u64 seed = 0);
+
+} // namespace CaveGame
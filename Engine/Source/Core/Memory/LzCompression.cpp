@@ -0,0 +1,956 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Memory/Hash.h>
+#include <Core/Memory/LzCompression.h>
+
+#include <bit>
+#include <cstring>
+
+namespace CaveGame
+{
+
+static constexpr usize s_minimum_match_length = 4;
+static constexpr usize s_maximum_offset = 65535;
+static constexpr usize s_maximum_dictionary_byte_count = 64 * 1024;
+
+//
+// The last bytes of a block are always literals and no match starts close to the end of a block, which allows the
+// compressor to read a few bytes past the current position without checking the bounds.
+//
+static constexpr usize s_last_literal_count = 5;
+static constexpr usize s_match_start_limit = 12;
+
+static constexpr u32 s_fast_hash_log = 12;
+static constexpr u32 s_high_hash_log = 15;
+static constexpr u32 s_high_maximum_attempt_count = 256;
+
+// Once a match is this long, searching for a longer one isn't worth the time.
+static constexpr usize s_high_sufficient_match_length = 4096;
+
+#pragma region Helpers
+
+// NOTE: The reads and writes are performed with `memcpy`, as the bytes are usually not aligned. Only little endian is supported.
+NODISCARD ALWAYS_INLINE static u16 read_u16(const u8* bytes)
+{
+    u16 value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u32 read_u32(const u8* bytes)
+{
+    u32 value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u64 read_u64(const u8* bytes)
+{
+    u64 value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+ALWAYS_INLINE static void write_u16(u8* bytes, u16 value)
+{
+    memcpy(bytes, &value, sizeof(value));
+}
+
+ALWAYS_INLINE static void write_u32(u8* bytes, u32 value)
+{
+    memcpy(bytes, &value, sizeof(value));
+}
+
+ALWAYS_INLINE static void write_u64(u8* bytes, u64 value)
+{
+    memcpy(bytes, &value, sizeof(value));
+}
+
+NODISCARD ALWAYS_INLINE static u32 hash_sequence(u32 sequence, u32 hash_log)
+{
+    return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+// Returns the number of equal bytes at the beginning of `a` and `b`, comparing at most until `a_limit`.
+NODISCARD ALWAYS_INLINE static usize count_matching_bytes(const u8* a, const u8* b, const u8* a_limit)
+{
+    const u8* a_start = a;
+    while (a + sizeof(u64) <= a_limit)
+    {
+        const u64 difference = read_u64(a) ^ read_u64(b);
+        if (difference != 0)
+            return static_cast<usize>(a - a_start) + static_cast<usize>(std::countr_zero(difference) / 8);
+        a += sizeof(u64);
+        b += sizeof(u64);
+    }
+
+    while (a < a_limit && *a == *b)
+    {
+        ++a;
+        ++b;
+    }
+    return static_cast<usize>(a - a_start);
+}
+
+//
+// The data that matches can reference: the dictionary, immediately followed by the source. Positions in the window
+// are indices, where the first source byte has the index equal to the dictionary size.
+//
+struct LzWindow
+{
+    const u8* dictionary { nullptr };
+    u32 dictionary_byte_count { 0 };
+    const u8* source { nullptr };
+
+    NODISCARD ALWAYS_INLINE const u8* get_pointer(u32 index) const
+    {
+        return (index < dictionary_byte_count) ? (dictionary + index) : (source + (index - dictionary_byte_count));
+    }
+
+    NODISCARD ALWAYS_INLINE u32 get_index(const u8* position) const { return dictionary_byte_count + static_cast<u32>(position - source); }
+
+    // Returns the length of the match between the source position (compared at most until `limit`) and the candidate.
+    NODISCARD ALWAYS_INLINE usize count_match(const u8* position, const u8* limit, u32 candidate_index) const
+    {
+        if (candidate_index >= dictionary_byte_count)
+            return count_matching_bytes(position, source + (candidate_index - dictionary_byte_count), limit);
+
+        // The match starts in the dictionary and continues at the beginning of the source once it reaches the end of the dictionary.
+        const usize remaining_dictionary_byte_count = dictionary_byte_count - candidate_index;
+        const u8* dictionary_limit = (static_cast<usize>(limit - position) > remaining_dictionary_byte_count) ? (position + remaining_dictionary_byte_count) : limit;
+        const usize length = count_matching_bytes(position, dictionary + candidate_index, dictionary_limit);
+        if (position + length != dictionary_limit || dictionary_limit == limit)
+            return length;
+        return length + count_matching_bytes(dictionary_limit, source, limit);
+    }
+};
+
+NODISCARD ALWAYS_INLINE static u8* write_length_extension(u8* output, usize length)
+{
+    while (length >= 255)
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<u8>(length);
+    return output;
+}
+
+// Writes a command that contains the literals and the match. Returns nullptr if the destination is too small.
+NODISCARD static u8* write_command(u8* output, const u8* output_end, const u8* literals, usize literal_count, usize offset, usize match_length)
+{
+    const usize match_length_code = match_length - s_minimum_match_length;
+    const usize maximum_byte_count = 1 + (literal_count / 255 + 1) + literal_count + sizeof(u16) + (match_length_code / 255 + 1);
+    if (static_cast<usize>(output_end - output) < maximum_byte_count)
+        return nullptr;
+
+    u8* token = output++;
+    u8 token_value;
+    if (literal_count >= 15)
+    {
+        token_value = 15 << 4;
+        output = write_length_extension(output, literal_count - 15);
+    }
+    else
+    {
+        token_value = static_cast<u8>(literal_count << 4);
+    }
+
+    memcpy(output, literals, literal_count);
+    output += literal_count;
+
+    write_u16(output, static_cast<u16>(offset));
+    output += sizeof(u16);
+
+    if (match_length_code >= 15)
+    {
+        token_value |= 15;
+        output = write_length_extension(output, match_length_code - 15);
+    }
+    else
+    {
+        token_value |= static_cast<u8>(match_length_code);
+    }
+
+    *token = token_value;
+    return output;
+}
+
+// Writes the last command of a block, which only contains literals. Returns nullptr if the destination is too small.
+NODISCARD static u8* write_last_literals(u8* output, const u8* output_end, const u8* literals, usize literal_count)
+{
+    const usize maximum_byte_count = 1 + (literal_count / 255 + 1) + literal_count;
+    if (static_cast<usize>(output_end - output) < maximum_byte_count)
+        return nullptr;
+
+    if (literal_count >= 15)
+    {
+        *output++ = 15 << 4;
+        output = write_length_extension(output, literal_count - 15);
+    }
+    else
+    {
+        *output++ = static_cast<u8>(literal_count << 4);
+    }
+
+    // NOTE: Empty sources can be null, and passing null to `memcpy` is undefined even if nothing is copied.
+    if (literal_count > 0)
+        memcpy(output, literals, literal_count);
+    return output + literal_count;
+}
+
+#pragma endregion
+
+#pragma region LzDictionary
+
+void LzDictionary::initialize(const void* bytes, usize byte_count)
+{
+    const usize kept_byte_count = (byte_count > s_maximum_dictionary_byte_count) ? s_maximum_dictionary_byte_count : byte_count;
+    const u8* kept_bytes = static_cast<const u8*>(bytes) + (byte_count - kept_byte_count);
+
+    m_bytes.set_count_uninitialized(kept_byte_count);
+    memcpy(m_bytes.elements(), kept_bytes, kept_byte_count);
+
+    // NOTE: Zero is reserved for frames that don't use a dictionary.
+    m_id = static_cast<u32>(hash_bytes(kept_bytes, kept_byte_count));
+    if (m_id == 0)
+        m_id = 1;
+
+    m_fast_hash_table.set_count_uninitialized(static_cast<usize>(1) << s_fast_hash_log);
+    memset(m_fast_hash_table.elements(), 0, m_fast_hash_table.count() * sizeof(u32));
+    for (usize index = 0; index + sizeof(u32) <= kept_byte_count; ++index)
+        m_fast_hash_table[hash_sequence(read_u32(kept_bytes + index), s_fast_hash_log)] = static_cast<u32>(index);
+}
+
+#pragma endregion
+
+#pragma region Compression
+
+usize LzCodec::compress_block(
+    const void* source,
+    usize source_byte_count,
+    void* destination,
+    usize destination_capacity,
+    LzCompressionLevel level,
+    const LzDictionary* dictionary
+)
+{
+    if (source_byte_count > maximum_block_byte_count)
+        return 0;
+
+    // Dictionaries that are shorter than a match can't be referenced.
+    if (dictionary && dictionary->m_bytes.count() < s_minimum_match_length)
+        dictionary = nullptr;
+
+    const u8* source_bytes = static_cast<const u8*>(source);
+    u8* destination_bytes = static_cast<u8*>(destination);
+    switch (level)
+    {
+        case LzCompressionLevel::Fast: return compress_block_fast(source_bytes, source_byte_count, destination_bytes, destination_capacity, dictionary);
+        case LzCompressionLevel::High: return compress_block_high(source_bytes, source_byte_count, destination_bytes, destination_capacity, dictionary);
+    }
+
+    CAVE_ASSERT(false);
+    return 0;
+}
+
+usize LzCodec::compress_block_fast(const u8* source, usize source_byte_count, u8* destination, usize destination_capacity, const LzDictionary* dictionary)
+{
+    LzWindow window;
+    window.source = source;
+
+    // NOTE: The table is small enough to live on the stack (and in the L1 cache). Empty slots refer to the first
+    // byte of the window, which is harmless, as every candidate is verified before being used.
+    u32 hash_table[1 << s_fast_hash_log];
+    if (dictionary)
+    {
+        window.dictionary = dictionary->m_bytes.elements();
+        window.dictionary_byte_count = static_cast<u32>(dictionary->m_bytes.count());
+        memcpy(hash_table, dictionary->m_fast_hash_table.elements(), sizeof(hash_table));
+    }
+    else
+    {
+        memset(hash_table, 0, sizeof(hash_table));
+    }
+
+    const u8* source_end = source + source_byte_count;
+    const u8* anchor = source;
+    u8* output = destination;
+    const u8* output_end = destination + destination_capacity;
+
+    if (source_byte_count > s_match_start_limit)
+    {
+        const u8* match_start_limit = source_end - s_match_start_limit;
+        const u8* match_end_limit = source_end - s_last_literal_count;
+        const u8* position = source;
+
+        while (position <= match_start_limit)
+        {
+            // Search for a match. The step grows while no match is found, which quickly skips incompressible data.
+            u32 candidate_index = 0;
+            u32 position_index = 0;
+            u32 search_count = 1 << 6;
+            while (position <= match_start_limit)
+            {
+                const u32 sequence = read_u32(position);
+                u32& slot = hash_table[hash_sequence(sequence, s_fast_hash_log)];
+                candidate_index = slot;
+                position_index = window.get_index(position);
+                slot = position_index;
+
+                if (candidate_index < position_index && position_index - candidate_index <= s_maximum_offset && read_u32(window.get_pointer(candidate_index)) == sequence)
+                    break;
+                position += search_count++ >> 6;
+            }
+            if (position > match_start_limit)
+                break;
+
+            const usize offset = position_index - candidate_index;
+            usize match_length = s_minimum_match_length + window.count_match(position + s_minimum_match_length, match_end_limit, candidate_index + s_minimum_match_length);
+
+            // Extend the match backwards, over the literals that precede it.
+            const u8* candidate = window.get_pointer(candidate_index);
+            const u8* candidate_lower_bound = (candidate_index < window.dictionary_byte_count) ? window.dictionary : source;
+            while (position > anchor && candidate > candidate_lower_bound && position[-1] == candidate[-1])
+            {
+                --position;
+                --candidate;
+                ++match_length;
+            }
+
+            output = write_command(output, output_end, anchor, static_cast<usize>(position - anchor), offset, match_length);
+            if (!output)
+                return 0;
+
+            position += match_length;
+            anchor = position;
+
+            // Insert a position from the end of the match, which is often the start of the next match.
+            if (position <= match_start_limit)
+                hash_table[hash_sequence(read_u32(position - 2), s_fast_hash_log)] = window.get_index(position - 2);
+        }
+    }
+
+    output = write_last_literals(output, output_end, anchor, static_cast<usize>(source_end - anchor));
+    if (!output)
+        return 0;
+    return static_cast<usize>(output - destination);
+}
+
+//
+// Hash chains over the window: `heads` stores the last position of every hash and `chain` stores the distance from
+// every position to the previous position with the same hash (or zero). The chain is indexed by the low 16 bits of
+// the position, which is enough because older positions are out of the offset range.
+//
+struct LzHashChains
+{
+    static constexpr u32 invalid_index = static_cast<u32>(-1);
+
+    Vector<u32> heads;
+    Vector<u16> chain;
+    u32 next_insert_index { 0 };
+
+    void initialize(const LzWindow& window)
+    {
+        heads.set_count_uninitialized(static_cast<usize>(1) << s_high_hash_log);
+        memset(heads.elements(), 0xFF, heads.count() * sizeof(u32));
+        chain.set_count_uninitialized(s_maximum_offset + 1);
+
+        // The last bytes of the dictionary are skipped, as the sequences that start there continue in the source.
+        if (window.dictionary_byte_count >= sizeof(u32))
+            insert_until(window, window.dictionary_byte_count - static_cast<u32>(sizeof(u32)) + 1);
+        next_insert_index = window.dictionary_byte_count;
+    }
+
+    ALWAYS_INLINE void insert_until(const LzWindow& window, u32 end_index)
+    {
+        for (; next_insert_index < end_index; ++next_insert_index)
+        {
+            u32& head = heads[hash_sequence(read_u32(window.get_pointer(next_insert_index)), s_high_hash_log)];
+            const u32 distance = next_insert_index - head;
+            chain[next_insert_index & s_maximum_offset] = (head != invalid_index && distance <= s_maximum_offset) ? static_cast<u16>(distance) : 0;
+            head = next_insert_index;
+        }
+    }
+
+    // Returns the length of the longest match for the position, or zero if there is none.
+    usize find_longest_match(const LzWindow& window, const u8* position, const u8* limit, usize& out_offset)
+    {
+        const u32 position_index = window.get_index(position);
+        insert_until(window, position_index);
+
+        const u32 sequence = read_u32(position);
+        u32 candidate_index = heads[hash_sequence(sequence, s_high_hash_log)];
+        usize best_length = 0;
+
+        for (u32 attempt_index = 0; attempt_index < s_high_maximum_attempt_count; ++attempt_index)
+        {
+            if (candidate_index == invalid_index || position_index - candidate_index > s_maximum_offset)
+                break;
+
+            const u8* candidate = window.get_pointer(candidate_index);
+            const bool is_candidate_in_source = (candidate_index >= window.dictionary_byte_count);
+
+            // Candidates from the source can be rejected quickly, by comparing the byte that would make the match longer.
+            if (read_u32(candidate) == sequence && (!is_candidate_in_source || best_length == 0 || candidate[best_length] == position[best_length]))
+            {
+                const usize length = s_minimum_match_length + window.count_match(position + s_minimum_match_length, limit, candidate_index + s_minimum_match_length);
+                if (length > best_length)
+                {
+                    best_length = length;
+                    out_offset = position_index - candidate_index;
+                    if (position + length == limit || length >= s_high_sufficient_match_length)
+                        break;
+                }
+            }
+
+            const u16 distance = chain[candidate_index & s_maximum_offset];
+            if (distance == 0)
+                break;
+            candidate_index -= distance;
+        }
+
+        return best_length;
+    }
+};
+
+usize LzCodec::compress_block_high(const u8* source, usize source_byte_count, u8* destination, usize destination_capacity, const LzDictionary* dictionary)
+{
+    LzWindow window;
+    window.source = source;
+    if (dictionary)
+    {
+        window.dictionary = dictionary->m_bytes.elements();
+        window.dictionary_byte_count = static_cast<u32>(dictionary->m_bytes.count());
+    }
+
+    const u8* source_end = source + source_byte_count;
+    const u8* anchor = source;
+    u8* output = destination;
+    const u8* output_end = destination + destination_capacity;
+
+    if (source_byte_count > s_match_start_limit)
+    {
+        LzHashChains hash_chains;
+        hash_chains.initialize(window);
+
+        const u8* match_start_limit = source_end - s_match_start_limit;
+        const u8* match_end_limit = source_end - s_last_literal_count;
+        const u8* position = source;
+
+        while (position <= match_start_limit)
+        {
+            usize offset = 0;
+            usize match_length = hash_chains.find_longest_match(window, position, match_end_limit, offset);
+            if (match_length == 0)
+            {
+                ++position;
+                continue;
+            }
+
+            // Lazy matching: emit the current byte as a literal if the next position has a longer match.
+            while (position + 1 <= match_start_limit)
+            {
+                usize next_offset = 0;
+                const usize next_match_length = hash_chains.find_longest_match(window, position + 1, match_end_limit, next_offset);
+                if (next_match_length <= match_length)
+                    break;
+
+                ++position;
+                match_length = next_match_length;
+                offset = next_offset;
+            }
+
+            output = write_command(output, output_end, anchor, static_cast<usize>(position - anchor), offset, match_length);
+            if (!output)
+                return 0;
+
+            position += match_length;
+            anchor = position;
+        }
+    }
+
+    output = write_last_literals(output, output_end, anchor, static_cast<usize>(source_end - anchor));
+    if (!output)
+        return 0;
+    return static_cast<usize>(output - destination);
+}
+
+#pragma endregion
+
+#pragma region Decompression
+
+// Reads the extension bytes of a length. Returns false if the block ends before the last extension byte.
+NODISCARD ALWAYS_INLINE static bool read_length_extension(const u8*& input, const u8* input_end, usize& length)
+{
+    u8 extension;
+    do
+    {
+        if (input >= input_end)
+            return false;
+        extension = *input++;
+        length += extension;
+    } while (extension == 255);
+    return true;
+}
+
+//
+// Copies a match that starts `offset` bytes behind the output. The bytes can overlap (an offset of one repeats the
+// last byte), in which case they can't be copied in pieces that are longer than the offset.
+//
+ALWAYS_INLINE static u8* copy_match(u8* output, const u8* output_end, usize offset, usize match_length)
+{
+    u8* match_end = output + match_length;
+
+    //
+    // NOTE: The match is copied in 16 byte pieces, which can write up to 15 bytes past its end. That is fine as long
+    // as they are inside the destination, because the following commands overwrite them, thus only the bytes that are
+    // too close to the end of the destination are copied one at a time.
+    //
+    const usize slack_byte_count = static_cast<usize>(output_end - match_end);
+    usize piece_byte_count = match_length;
+    if (slack_byte_count < 16)
+        piece_byte_count = (match_length > 16 - slack_byte_count) ? (match_length - (16 - slack_byte_count)) : 0;
+    u8* pieces_end = output + piece_byte_count;
+
+    if (output < pieces_end)
+    {
+        const u8* match = output - offset;
+        if (offset >= 16)
+        {
+            do
+            {
+                memcpy(output, match, 16);
+                output += 16;
+                match += 16;
+            } while (output < pieces_end);
+        }
+        else
+        {
+            //
+            // Short offsets repeat a pattern (such as runs of the same voxel). Copying them through memory would load
+            // bytes that have just been stored, which stalls the store forwarding, so the pattern is built once and
+            // then stored repeatedly. The output advances by the largest multiple of the offset that fits in a piece.
+            //
+            static constexpr u8 pattern_steps[16] = { 0, 16, 16, 15, 16, 15, 12, 14, 16, 9, 10, 11, 12, 13, 14, 15 };
+
+            // Offsets that divide eight (the voxels are usually 16-bit values) are broadcast without a loop.
+            u8 pattern[16];
+            switch (offset)
+            {
+                case 1: write_u64(pattern, static_cast<u64>(match[0]) * 0x0101010101010101ULL); break;
+                case 2: write_u64(pattern, static_cast<u64>(read_u16(match)) * 0x0001000100010001ULL); break;
+                case 4: write_u64(pattern, static_cast<u64>(read_u32(match)) * 0x0000000100000001ULL); break;
+                case 8: write_u64(pattern, read_u64(match)); break;
+                default:
+                    memcpy(pattern, match, 16);
+                    for (usize index = offset; index < 16; ++index)
+                        pattern[index] = pattern[index - offset];
+                    break;
+            }
+            if ((offset & (offset - 1)) == 0)
+                memcpy(pattern + 8, pattern, 8);
+
+            const usize step = pattern_steps[offset];
+            do
+            {
+                memcpy(output, pattern, 16);
+                output += step;
+            } while (output < pieces_end);
+        }
+    }
+
+    while (output < match_end)
+    {
+        *output = *(output - offset);
+        ++output;
+    }
+    return match_end;
+}
+
+bool LzCodec::decompress_block(
+    const void* source,
+    usize source_byte_count,
+    void* destination,
+    usize destination_capacity,
+    usize& out_byte_count,
+    const LzDictionary* dictionary
+)
+{
+    const u8* input = static_cast<const u8*>(source);
+    const u8* input_end = input + source_byte_count;
+    u8* output_start = static_cast<u8*>(destination);
+    u8* output = output_start;
+    const u8* output_end = output_start + destination_capacity;
+
+    const u8* dictionary_end = dictionary ? (dictionary->m_bytes.elements() + dictionary->m_bytes.count()) : nullptr;
+    const usize dictionary_byte_count = dictionary ? dictionary->m_bytes.count() : 0;
+
+    while (true)
+    {
+        if (input >= input_end)
+            return false;
+        const u8 token = *input++;
+
+        usize literal_count = token >> 4;
+        if (literal_count == 15 && !read_length_extension(input, input_end, literal_count))
+            return false;
+        if (literal_count > static_cast<usize>(input_end - input) || literal_count > static_cast<usize>(output_end - output))
+            return false;
+
+        // Short literal runs are copied as a single 16 byte piece when there is enough room on both sides.
+        if (literal_count <= 16 && input_end - input >= 16 && output_end - output >= 16)
+            memcpy(output, input, 16);
+        else if (literal_count > 0)
+            memcpy(output, input, literal_count);
+        input += literal_count;
+        output += literal_count;
+
+        // The last command only contains literals.
+        if (input == input_end)
+            break;
+
+        if (input_end - input < 2)
+            return false;
+        const usize offset = read_u16(input);
+        input += sizeof(u16);
+
+        usize match_length = token & 15;
+        if (match_length == 15 && !read_length_extension(input, input_end, match_length))
+            return false;
+        match_length += s_minimum_match_length;
+
+        if (offset == 0 || match_length > static_cast<usize>(output_end - output))
+            return false;
+
+        const usize decompressed_byte_count = static_cast<usize>(output - output_start);
+        if (offset > decompressed_byte_count)
+        {
+            // The match starts in the dictionary, and it might continue at the beginning of the output.
+            const usize dictionary_distance = offset - decompressed_byte_count;
+            if (dictionary_distance > dictionary_byte_count)
+                return false;
+
+            const u8* match = dictionary_end - dictionary_distance;
+            if (match_length <= dictionary_distance)
+            {
+                memcpy(output, match, match_length);
+                output += match_length;
+                continue;
+            }
+
+            memcpy(output, match, dictionary_distance);
+            output += dictionary_distance;
+            match_length -= dictionary_distance;
+        }
+
+        output = copy_match(output, output_end, offset, match_length);
+    }
+
+    out_byte_count = static_cast<usize>(output - output_start);
+    return true;
+}
+
+#pragma endregion
+
+#pragma region Frames
+
+static constexpr u32 s_stored_block_flag = 0x80000000;
+static constexpr u32 s_minimum_block_byte_count_log2 = 16;
+static constexpr u32 s_maximum_block_byte_count_log2 = 22;
+
+bool LzFrameCompressor::initialize(LzWriteFunction write_function, void* user_data, const LzFrameSettings& settings, const LzDictionary* dictionary)
+{
+    const u32 block_byte_count_log2 = static_cast<u32>(std::countr_zero(settings.block_byte_count));
+    if (!std::has_single_bit(settings.block_byte_count) || block_byte_count_log2 < s_minimum_block_byte_count_log2 || block_byte_count_log2 > s_maximum_block_byte_count_log2)
+        return false;
+
+    m_write_function = write_function;
+    m_user_data = user_data;
+    m_settings = settings;
+    m_dictionary = dictionary;
+
+    m_block.set_count_uninitialized(settings.block_byte_count);
+    m_block_byte_count = 0;
+    // The compressed block is prefixed by its header and followed by its hash, so they are written together.
+    m_compressed_block.set_count_uninitialized(sizeof(u32) + settings.block_byte_count + sizeof(u32));
+    m_total_byte_count = 0;
+
+    LzFrameHeader header = {};
+    header.magic = LzFrameHeader::magic_value;
+    header.version = LzFrameHeader::current_version;
+    header.flags = settings.hash_blocks ? LzFrameHeader::flag_block_hashes : 0;
+    header.block_byte_count_log2 = static_cast<u8>(block_byte_count_log2);
+    header.dictionary_id = dictionary ? dictionary->get_id() : 0;
+    return m_write_function(&header, sizeof(header), m_user_data);
+}
+
+bool LzFrameCompressor::write(const void* bytes, usize byte_count)
+{
+    const u8* input = static_cast<const u8*>(bytes);
+    while (byte_count > 0)
+    {
+        // Full blocks are compressed directly from the input, without being copied.
+        if (m_block_byte_count == 0 && byte_count >= m_settings.block_byte_count)
+        {
+            if (!write_block(input, m_settings.block_byte_count))
+                return false;
+            input += m_settings.block_byte_count;
+            byte_count -= m_settings.block_byte_count;
+            continue;
+        }
+
+        const usize remaining_block_byte_count = m_settings.block_byte_count - m_block_byte_count;
+        const usize copied_byte_count = (byte_count < remaining_block_byte_count) ? byte_count : remaining_block_byte_count;
+        memcpy(m_block.elements() + m_block_byte_count, input, copied_byte_count);
+        m_block_byte_count += copied_byte_count;
+        input += copied_byte_count;
+        byte_count -= copied_byte_count;
+
+        if (m_block_byte_count == m_settings.block_byte_count)
+        {
+            if (!write_block(m_block.elements(), m_block_byte_count))
+                return false;
+            m_block_byte_count = 0;
+        }
+    }
+
+    return true;
+}
+
+bool LzFrameCompressor::finish()
+{
+    if (m_block_byte_count > 0)
+    {
+        if (!write_block(m_block.elements(), m_block_byte_count))
+            return false;
+        m_block_byte_count = 0;
+    }
+
+    u8 end_mark[sizeof(u32) + sizeof(u64)];
+    write_u32(end_mark, 0);
+    write_u64(end_mark + sizeof(u32), m_total_byte_count);
+    return m_write_function(end_mark, sizeof(end_mark), m_user_data);
+}
+
+bool LzFrameCompressor::write_block(const u8* bytes, usize byte_count)
+{
+    m_total_byte_count += byte_count;
+    u8* compressed_block = m_compressed_block.elements();
+
+    // NOTE: A capacity lower than the block size makes the compression fail as soon as it can't shrink the block,
+    // in which case it is stored uncompressed.
+    const usize compressed_byte_count = LzCodec::compress_block(bytes, byte_count, compressed_block + sizeof(u32), byte_count - 1, m_settings.level, m_dictionary);
+
+    const u32 block_hash = m_settings.hash_blocks ? static_cast<u32>(hash_bytes(bytes, byte_count)) : 0;
+    const usize hash_byte_count = m_settings.hash_blocks ? sizeof(u32) : 0;
+
+    if (compressed_byte_count > 0)
+    {
+        write_u32(compressed_block, static_cast<u32>(compressed_byte_count));
+        write_u32(compressed_block + sizeof(u32) + compressed_byte_count, block_hash);
+        return m_write_function(compressed_block, sizeof(u32) + compressed_byte_count + hash_byte_count, m_user_data);
+    }
+
+    u8 block_header[sizeof(u32)];
+    write_u32(block_header, static_cast<u32>(byte_count) | s_stored_block_flag);
+    if (!m_write_function(block_header, sizeof(block_header), m_user_data) || !m_write_function(bytes, byte_count, m_user_data))
+        return false;
+
+    u8 hash_bytes_buffer[sizeof(u32)];
+    write_u32(hash_bytes_buffer, block_hash);
+    return (hash_byte_count == 0 || m_write_function(hash_bytes_buffer, sizeof(hash_bytes_buffer), m_user_data));
+}
+
+void LzFrameDecompressor::initialize(LzWriteFunction write_function, void* user_data, const LzDictionary* dictionary)
+{
+    m_write_function = write_function;
+    m_user_data = user_data;
+    m_dictionary = dictionary;
+
+    m_state = State::Header;
+    m_total_byte_count = 0;
+    m_pending.clear();
+}
+
+bool LzFrameDecompressor::feed(const void* bytes, usize byte_count)
+{
+    const u8* cursor = static_cast<const u8*>(bytes);
+    const u8* end = cursor + byte_count;
+
+    while (cursor < end)
+    {
+        bool succeeded = true;
+        switch (m_state)
+        {
+            case State::Header:
+            {
+                const u8* header = acquire(sizeof(LzFrameHeader), cursor, end);
+                if (!header)
+                    return true;
+                succeeded = process_header(header);
+                break;
+            }
+            case State::BlockHeader:
+            {
+                const u8* block_header = acquire(sizeof(u32), cursor, end);
+                if (!block_header)
+                    return true;
+
+                const u32 block_header_value = read_u32(block_header);
+                if (block_header_value == 0)
+                {
+                    m_state = State::EndMark;
+                    break;
+                }
+
+                m_is_block_compressed = ((block_header_value & s_stored_block_flag) == 0);
+                m_stored_block_byte_count = block_header_value & ~s_stored_block_flag;
+                // Compressed blocks are always smaller than the block size, otherwise they are stored.
+                succeeded = (m_stored_block_byte_count > 0 && m_stored_block_byte_count <= m_block_byte_count);
+                m_state = State::BlockData;
+                break;
+            }
+            case State::BlockData:
+            {
+                const u8* block = acquire(m_stored_block_byte_count, cursor, end);
+                if (!block)
+                    return true;
+                succeeded = process_block(block);
+                break;
+            }
+            case State::BlockHash:
+            {
+                const u8* block_hash = acquire(sizeof(u32), cursor, end);
+                if (!block_hash)
+                    return true;
+                succeeded = (read_u32(block_hash) == static_cast<u32>(hash_bytes(m_block.elements(), m_decompressed_block_byte_count)));
+                succeeded = succeeded && m_write_function(m_block.elements(), m_decompressed_block_byte_count, m_user_data);
+                m_state = State::BlockHeader;
+                break;
+            }
+            case State::EndMark:
+            {
+                const u8* total_byte_count = acquire(sizeof(u64), cursor, end);
+                if (!total_byte_count)
+                    return true;
+                succeeded = (read_u64(total_byte_count) == m_total_byte_count);
+                m_state = State::Finished;
+                break;
+            }
+            case State::Finished:
+            case State::Failed:
+                // Any byte that follows the end of the frame is an error.
+                succeeded = false;
+                break;
+        }
+
+        m_pending.clear();
+        if (!succeeded)
+        {
+            m_state = State::Failed;
+            return false;
+        }
+    }
+
+    return (m_state != State::Failed);
+}
+
+const u8* LzFrameDecompressor::acquire(usize byte_count, const u8*& cursor, const u8* end)
+{
+    if (m_pending.is_empty() && static_cast<usize>(end - cursor) >= byte_count)
+    {
+        const u8* bytes = cursor;
+        cursor += byte_count;
+        return bytes;
+    }
+
+    const usize missing_byte_count = byte_count - m_pending.count();
+    const usize available_byte_count = (static_cast<usize>(end - cursor) < missing_byte_count) ? static_cast<usize>(end - cursor) : missing_byte_count;
+    const usize pending_byte_count = m_pending.count();
+    m_pending.set_count_uninitialized(pending_byte_count + available_byte_count);
+    memcpy(m_pending.elements() + pending_byte_count, cursor, available_byte_count);
+    cursor += available_byte_count;
+
+    return (m_pending.count() == byte_count) ? m_pending.elements() : nullptr;
+}
+
+bool LzFrameDecompressor::process_header(const u8* bytes)
+{
+    LzFrameHeader header;
+    memcpy(&header, bytes, sizeof(header));
+
+    if (header.magic != LzFrameHeader::magic_value || header.version != LzFrameHeader::current_version)
+        return false;
+    if ((header.flags & ~LzFrameHeader::flag_block_hashes) != 0)
+        return false;
+    if (header.block_byte_count_log2 < s_minimum_block_byte_count_log2 || header.block_byte_count_log2 > s_maximum_block_byte_count_log2)
+        return false;
+    if (header.dictionary_id != (m_dictionary ? m_dictionary->get_id() : 0))
+        return false;
+
+    m_has_block_hashes = (header.flags & LzFrameHeader::flag_block_hashes) != 0;
+    m_block_byte_count = static_cast<usize>(1) << header.block_byte_count_log2;
+    m_block.set_count_uninitialized(m_block_byte_count);
+    m_state = State::BlockHeader;
+    return true;
+}
+
+bool LzFrameDecompressor::process_block(const u8* bytes)
+{
+    if (m_is_block_compressed)
+    {
+        if (!LzCodec::decompress_block(bytes, m_stored_block_byte_count, m_block.elements(), m_block_byte_count, m_decompressed_block_byte_count, m_dictionary))
+            return false;
+    }
+    else
+    {
+        memcpy(m_block.elements(), bytes, m_stored_block_byte_count);
+        m_decompressed_block_byte_count = m_stored_block_byte_count;
+    }
+
+    m_total_byte_count += m_decompressed_block_byte_count;
+    if (m_has_block_hashes)
+    {
+        m_state = State::BlockHash;
+        return true;
+    }
+
+    m_state = State::BlockHeader;
+    return m_write_function(m_block.elements(), m_decompressed_block_byte_count, m_user_data);
+}
+
+static bool append_to_vector(const void* bytes, usize byte_count, void* user_data)
+{
+    Vector<u8>& destination = *static_cast<Vector<u8>*>(user_data);
+    const usize previous_byte_count = destination.count();
+    destination.set_count_uninitialized(previous_byte_count + byte_count);
+    memcpy(destination.elements() + previous_byte_count, bytes, byte_count);
+    return true;
+}
+
+bool compress_lz_frame(const void* bytes, usize byte_count, Vector<u8>& out_frame, const LzFrameSettings& settings, const LzDictionary* dictionary)
+{
+    out_frame.ensure_capacity(out_frame.count() + sizeof(LzFrameHeader) + LzCodec::get_compressed_byte_count_bound(byte_count));
+
+    LzFrameCompressor compressor;
+    return compressor.initialize(append_to_vector, &out_frame, settings, dictionary) && compressor.write(bytes, byte_count) && compressor.finish();
+}
+
+bool decompress_lz_frame(const void* frame, usize frame_byte_count, Vector<u8>& out_bytes, const LzDictionary* dictionary)
+{
+    LzFrameDecompressor decompressor;
+    decompressor.initialize(append_to_vector, &out_bytes, dictionary);
+    return decompressor.feed(frame, frame_byte_count) && decompressor.is_finished();
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Span.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// LZ77-family compression with an LZ4-like block format, tuned for fast decompression.
+//
+// A block is a sequence of commands. Each command starts with a token byte, whose high nibble is the literal count
+// and whose low nibble is the match length minus four (a nibble of 15 is continued by extension bytes, which are
+// summed until one is lower than 255). The token is followed by the literals and by the 16-bit little endian match
+// offset. The last command of a block only contains literals.
+//
+// NOTE: The offsets are limited to 64 KiB, thus matches (and dictionaries) can only reach the last 64 KiB of data.
+//
+
+enum class LzCompressionLevel : u8
+{
+    // Greedy matching with a small hash table. Fast enough to compress saves and network packets at runtime.
+    Fast,
+
+    //
+    // Searches hash chains for the longest match and defers matches when the next position has a longer one.
+    // Several times slower to compress, but the output decompresses just as fast. Meant for offline cooking.
+    //
+    High,
+};
+
+//
+// Data that is expected to be similar to the compressed data (such as a typical voxel chunk), which the matches can
+// reference as if it preceded the data. Greatly improves the ratio of small payloads, which otherwise contain few
+// repetitions. The exact same dictionary must be used to decompress the data.
+//
+class LzDictionary
+{
+public:
+    // Only the last 64 KiB of the bytes can be referenced, thus only those are copied.
+    void initialize(const void* bytes, usize byte_count);
+
+    NODISCARD ALWAYS_INLINE ReadonlyByteSpan get_bytes() const { return ReadonlyByteSpan(m_bytes.elements(), m_bytes.count()); }
+
+    // Returns a hash of the dictionary bytes, stored in the frames to detect mismatching dictionaries.
+    NODISCARD ALWAYS_INLINE u32 get_id() const { return m_id; }
+
+private:
+    friend class LzCodec;
+
+    Vector<u8> m_bytes;
+    u32 m_id { 0 };
+
+    // The hash table of the fast compression level, filled with the dictionary positions.
+    Vector<u32> m_fast_hash_table;
+};
+
+class LzCodec
+{
+public:
+    // The largest number of bytes that can be compressed as a single block.
+    static constexpr usize maximum_block_byte_count = 0x7E000000;
+
+    // No command decompresses to more than 255 times its encoded size (a match length extension byte of 255 is the
+    // densest encoding), thus neither can a block or a frame. Bounds the decompressed size of untrusted data.
+    static constexpr usize maximum_expansion_ratio = 255;
+
+    // Returns the largest compressed size of a block with the given number of bytes, which occurs if the bytes can't
+    // be compressed at all.
+    NODISCARD static constexpr usize get_compressed_byte_count_bound(usize byte_count) { return byte_count + byte_count / 255 + 16; }
+
+    //
+    // Compresses the bytes as a single block. Returns the compressed size, or zero if the destination capacity is too
+    // small (a capacity of `get_compressed_byte_count_bound(byte_count)` is always enough).
+    //
+    NODISCARD static usize compress_block(
+        const void* source,
+        usize source_byte_count,
+        void* destination,
+        usize destination_capacity,
+        LzCompressionLevel level = LzCompressionLevel::Fast,
+        const LzDictionary* dictionary = nullptr
+    );
+
+    //
+    // Decompresses a block into the destination. Returns false if the block is malformed or if it doesn't fit in the
+    // destination capacity. The input is never trusted: malformed blocks never read or write out of bounds.
+    //
+    NODISCARD static bool decompress_block(
+        const void* source,
+        usize source_byte_count,
+        void* destination,
+        usize destination_capacity,
+        usize& out_byte_count,
+        const LzDictionary* dictionary = nullptr
+    );
+
+private:
+    static usize compress_block_fast(const u8* source, usize source_byte_count, u8* destination, usize destination_capacity, const LzDictionary* dictionary);
+    static usize compress_block_high(const u8* source, usize source_byte_count, u8* destination, usize destination_capacity, const LzDictionary* dictionary);
+};
+
+#pragma region Frames
+
+//
+// The frame format wraps a stream of any length: a header, independently compressed blocks and an end mark followed
+// by the total decompressed size. Blocks that don't shrink are stored uncompressed.
+//
+struct LzFrameHeader
+{
+    static constexpr u32 magic_value = 0x465A4C43; // 'CLZF'
+    static constexpr u8 current_version = 1;
+
+    // Every block is followed by the low 32 bits of the hash of its decompressed bytes.
+    static constexpr u8 flag_block_hashes = 1 << 0;
+
+    u32 magic;
+    u8 version;
+    u8 flags;
+    u8 block_byte_count_log2;
+    u8 reserved;
+    // The identifier of the dictionary (see `LzDictionary::get_id`), or zero if the frame doesn't use one.
+    u32 dictionary_id;
+};
+static_assert(sizeof(LzFrameHeader) == 12);
+
+struct LzFrameSettings
+{
+    LzCompressionLevel level { LzCompressionLevel::Fast };
+
+    // The size of the blocks the stream is split into, which must be a power of two between 64 KiB and 4 MiB.
+    u32 block_byte_count { 256 * 1024 };
+
+    // Hashing the blocks detects corruption, at the cost of some decompression throughput.
+    bool hash_blocks { true };
+};
+
+// Receives the output of a frame compressor or decompressor. Returning false aborts the stream.
+using LzWriteFunction = bool (*)(const void* bytes, usize byte_count, void* user_data);
+
+//
+// Compresses a stream of bytes, which can be written in pieces of any size, into a frame.
+//
+class LzFrameCompressor
+{
+    CAVE_MAKE_NONCOPYABLE(LzFrameCompressor);
+    CAVE_MAKE_NONMOVABLE(LzFrameCompressor);
+
+public:
+    LzFrameCompressor() = default;
+
+    // Writes the frame header. The dictionary must outlive the compressor.
+    bool initialize(LzWriteFunction write_function, void* user_data, const LzFrameSettings& settings = {}, const LzDictionary* dictionary = nullptr);
+
+    // Compresses and writes every block that has been filled. Returns false if the write function has failed.
+    bool write(const void* bytes, usize byte_count);
+
+    // Writes the last (partial) block and the end mark. The compressor can be initialized again afterwards.
+    bool finish();
+
+private:
+    bool write_block(const u8* bytes, usize byte_count);
+
+private:
+    LzWriteFunction m_write_function { nullptr };
+    void* m_user_data { nullptr };
+    LzFrameSettings m_settings;
+    const LzDictionary* m_dictionary { nullptr };
+
+    Vector<u8> m_block;
+    usize m_block_byte_count { 0 };
+    Vector<u8> m_compressed_block;
+    u64 m_total_byte_count { 0 };
+};
+
+//
+// Decompresses a frame, which can be fed in pieces of any size (for example, as it arrives from the network).
+// The decompressed bytes are passed to the write function one block at a time.
+//
+class LzFrameDecompressor
+{
+    CAVE_MAKE_NONCOPYABLE(LzFrameDecompressor);
+    CAVE_MAKE_NONMOVABLE(LzFrameDecompressor);
+
+public:
+    LzFrameDecompressor() = default;
+
+    // The dictionary must be the one used to compress the frame, and it must outlive the decompressor.
+    void initialize(LzWriteFunction write_function, void* user_data, const LzDictionary* dictionary = nullptr);
+
+    //
+    // Consumes the compressed bytes. Returns false if the frame is malformed or corrupted, if the bytes continue
+    // past the end of the frame or if the write function has failed. Once it has failed, the decompressor rejects
+    // any further bytes.
+    //
+    bool feed(const void* bytes, usize byte_count);
+
+    // Returns true once the whole frame (including the end mark) has been consumed.
+    NODISCARD ALWAYS_INLINE bool is_finished() const { return (m_state == State::Finished); }
+
+private:
+    enum class State : u8
+    {
+        Header,
+        BlockHeader,
+        BlockData,
+        BlockHash,
+        EndMark,
+        Finished,
+        Failed,
+    };
+
+    //
+    // Returns the next `byte_count` bytes of the frame, either directly from the fed bytes or (if they are split
+    // across several calls) after gathering them in `m_pending`. Returns nullptr if not enough bytes have been fed.
+    //
+    const u8* acquire(usize byte_count, const u8*& cursor, const u8* end);
+
+    bool process_header(const u8* bytes);
+    bool process_block(const u8* bytes);
+
+private:
+    LzWriteFunction m_write_function { nullptr };
+    void* m_user_data { nullptr };
+    const LzDictionary* m_dictionary { nullptr };
+
+    State m_state { State::Header };
+    bool m_has_block_hashes { false };
+    usize m_block_byte_count { 0 };
+    u32 m_stored_block_byte_count { 0 };
+    bool m_is_block_compressed { false };
+    usize m_decompressed_block_byte_count { 0 };
+    u64 m_total_byte_count { 0 };
+
+    Vector<u8> m_pending;
+    Vector<u8> m_block;
+};
+
+#pragma endregion
+
+// Compresses the bytes into a single frame, which is appended to the output.
+bool compress_lz_frame(const void* bytes, usize byte_count, Vector<u8>& out_frame, const LzFrameSettings& settings = {}, const LzDictionary* dictionary = nullptr);
+
+// Decompresses a complete frame, appending the decompressed bytes to the output. Returns false if the frame is malformed.
+bool decompress_lz_frame(const void* frame, usize frame_byte_count, Vector<u8>& out_bytes, const LzDictionary* dictionary = nullptr);
+
+} // namespace CaveGame
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Platform/AsyncFileIo.h>
+#include <Core/Platform/File.h>
+#include <Core/Platform/Futex.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/Metrics.h>
+#include <Core/Threading/Mutex.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+namespace CaveGame
+{
+
+struct AsyncFileIoData
+{
+    std::atomic<bool> is_initialized { false };
+    AsyncIoBackend backend { AsyncIoBackend::Native };
+
+    // The number of requests that have been submitted, but whose status hasn't been finalized yet.
+    std::atomic<u32> outstanding_request_count { 0 };
+
+    // Protects the queue of requests that haven't been handed over to the backend yet, and the native submission queue.
+    Mutex submission_lock;
+    AsyncIoRequest* first_queued_request { nullptr };
+    AsyncIoRequest* last_queued_request { nullptr };
+    // The number of requests queued since the thread pool has last been signaled.
+    u32 unsignaled_request_count { 0 };
+
+    // Protects the native completion queue. Only a single thread reaps the completions at a time.
+    Mutex completion_lock;
+
+    // The finished requests whose callbacks haven't been invoked yet.
+    SpinLock finished_lock;
+    AsyncIoRequest* first_finished_request { nullptr };
+    AsyncIoRequest* last_finished_request { nullptr };
+
+    Vector<File*> registered_files;
+    Vector<AsyncIoBuffer> registered_buffers;
+
+    Thread pool_threads[AsyncFileIo::thread_pool_thread_count];
+    Semaphore pool_semaphore;
+    std::atomic<bool> should_stop_pool { false };
+
+    MetricCounter finished_request_counter;
+    MetricCounter failed_request_counter;
+    MetricCounter transferred_byte_counter;
+};
+
+static AsyncFileIoData s_async_file_io;
+
+static void append_request(AsyncIoRequest*& first_request, AsyncIoRequest*& last_request, AsyncIoRequest& request)
+{
+    request.next_request = nullptr;
+    if (last_request != nullptr)
+        last_request->next_request = &request;
+    else
+        first_request = &request;
+    last_request = &request;
+}
+
+static AsyncIoRequest* pop_request(AsyncIoRequest*& first_request, AsyncIoRequest*& last_request)
+{
+    AsyncIoRequest* request = first_request;
+    if (request == nullptr)
+        return nullptr;
+
+    first_request = request->next_request;
+    if (first_request == nullptr)
+        last_request = nullptr;
+    request->next_request = nullptr;
+    return request;
+}
+
+// Publishes the final status of the request. The request can be destroyed by its owner as soon as the status is stored.
+static void finalize_request(AsyncIoRequest& request, AsyncIoStatus status)
+{
+    s_async_file_io.outstanding_request_count.fetch_sub(1, std::memory_order_relaxed);
+    request.status.store(static_cast<u32>(status), std::memory_order_release);
+
+    // NOTE: Only the thread pool waiters sleep on the status, while the native waiters sleep in the kernel.
+    if (s_async_file_io.backend == AsyncIoBackend::ThreadPool)
+        Futex::wake_all(request.status);
+}
+
+#pragma region Lifetime
+
+bool AsyncFileIo::initialize(u32 queue_depth, AsyncIoBackend backend)
+{
+    if (s_async_file_io.is_initialized.load(std::memory_order_relaxed))
+        return false;
+    CAVE_ASSERT(queue_depth > 0);
+
+    s_async_file_io.finished_request_counter = Metrics::register_counter("async_io.finished_requests"sv);
+    s_async_file_io.failed_request_counter = Metrics::register_counter("async_io.failed_requests"sv);
+    s_async_file_io.transferred_byte_counter = Metrics::register_counter("async_io.transferred_bytes"sv);
+
+    if (backend == AsyncIoBackend::Native)
+    {
+        ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+        if (!initialize_native_backend(queue_depth))
+            backend = AsyncIoBackend::ThreadPool;
+    }
+
+    s_async_file_io.backend = backend;
+    if (backend == AsyncIoBackend::ThreadPool)
+    {
+        if (!s_async_file_io.pool_semaphore.initialize())
+            return false;
+
+        s_async_file_io.should_stop_pool.store(false, std::memory_order_relaxed);
+        ThreadDescription description;
+        description.name = "AsyncFileIo"sv;
+        for (u32 thread_index = 0; thread_index < thread_pool_thread_count; ++thread_index)
+        {
+            if (!s_async_file_io.pool_threads[thread_index].create(thread_pool_entry_point, nullptr, description))
+            {
+                s_async_file_io.should_stop_pool.store(true, std::memory_order_release);
+                s_async_file_io.pool_semaphore.signal(thread_index);
+                for (u32 created_thread_index = 0; created_thread_index < thread_index; ++created_thread_index)
+                    s_async_file_io.pool_threads[created_thread_index].join();
+                s_async_file_io.pool_semaphore.shutdown();
+                return false;
+            }
+        }
+    }
+
+    s_async_file_io.is_initialized.store(true, std::memory_order_release);
+    return true;
+}
+
+void AsyncFileIo::shutdown()
+{
+    if (!s_async_file_io.is_initialized.load(std::memory_order_relaxed))
+        return;
+
+    // Drain all the requests, including their callbacks, which might submit new requests.
+    while (s_async_file_io.outstanding_request_count.load(std::memory_order_acquire) > 0)
+    {
+        process_completions();
+        if (s_async_file_io.backend == AsyncIoBackend::Native)
+        {
+            ScopedLock<Mutex> completion_lock(s_async_file_io.completion_lock);
+            reap_native_completions(true);
+        }
+        else
+        {
+            PlatformCore::yield_thread();
+        }
+    }
+
+    s_async_file_io.is_initialized.store(false, std::memory_order_relaxed);
+    s_async_file_io.registered_files.clear_and_shrink();
+    s_async_file_io.registered_buffers.clear_and_shrink();
+
+    if (s_async_file_io.backend == AsyncIoBackend::Native)
+    {
+        ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+        shutdown_native_backend();
+    }
+    else
+    {
+        s_async_file_io.should_stop_pool.store(true, std::memory_order_release);
+        s_async_file_io.pool_semaphore.signal(thread_pool_thread_count);
+        for (u32 thread_index = 0; thread_index < thread_pool_thread_count; ++thread_index)
+            s_async_file_io.pool_threads[thread_index].join();
+        s_async_file_io.pool_semaphore.shutdown();
+    }
+}
+
+bool AsyncFileIo::is_initialized()
+{
+    return s_async_file_io.is_initialized.load(std::memory_order_acquire);
+}
+
+AsyncIoBackend AsyncFileIo::get_backend()
+{
+    return s_async_file_io.backend;
+}
+
+#pragma endregion
+
+#pragma region Registration
+
+bool AsyncFileIo::register_files(File* const* files, u32 file_count)
+{
+    CAVE_ASSERT(is_initialized());
+    CAVE_ASSERT(s_async_file_io.outstanding_request_count.load(std::memory_order_relaxed) == 0);
+
+    ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+    if (s_async_file_io.backend == AsyncIoBackend::Native && !register_native_files(files, file_count))
+        return false;
+
+    s_async_file_io.registered_files.clear();
+    for (u32 file_index = 0; file_index < file_count; ++file_index)
+        s_async_file_io.registered_files.add(files[file_index]);
+    return true;
+}
+
+void AsyncFileIo::unregister_files()
+{
+    CAVE_ASSERT(s_async_file_io.outstanding_request_count.load(std::memory_order_relaxed) == 0);
+
+    ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+    if (s_async_file_io.backend == AsyncIoBackend::Native)
+        unregister_native_files();
+    s_async_file_io.registered_files.clear();
+}
+
+bool AsyncFileIo::register_buffers(const AsyncIoBuffer* buffers, u32 buffer_count)
+{
+    CAVE_ASSERT(is_initialized());
+    CAVE_ASSERT(s_async_file_io.outstanding_request_count.load(std::memory_order_relaxed) == 0);
+
+    ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+    if (s_async_file_io.backend == AsyncIoBackend::Native && !register_native_buffers(buffers, buffer_count))
+        return false;
+
+    s_async_file_io.registered_buffers.clear();
+    for (u32 buffer_index = 0; buffer_index < buffer_count; ++buffer_index)
+        s_async_file_io.registered_buffers.add(buffers[buffer_index]);
+    return true;
+}
+
+void AsyncFileIo::unregister_buffers()
+{
+    CAVE_ASSERT(s_async_file_io.outstanding_request_count.load(std::memory_order_relaxed) == 0);
+
+    ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+    if (s_async_file_io.backend == AsyncIoBackend::Native)
+        unregister_native_buffers();
+    s_async_file_io.registered_buffers.clear();
+}
+
+#pragma endregion
+
+#pragma region Requests
+
+void AsyncFileIo::submit(AsyncIoRequest& request)
+{
+    CAVE_ASSERT(is_initialized());
+    CAVE_ASSERT(request.get_status() != AsyncIoStatus::Pending);
+    CAVE_ASSERT(request.file != nullptr || request.registered_file_index < s_async_file_io.registered_files.count());
+    CAVE_ASSERT(request.registered_buffer_index == AsyncIoRequest::unregistered_index || request.registered_buffer_index < s_async_file_io.registered_buffers.count());
+
+    request.transferred_byte_count = 0;
+    request.status.store(static_cast<u32>(AsyncIoStatus::Pending), std::memory_order_relaxed);
+    s_async_file_io.outstanding_request_count.fetch_add(1, std::memory_order_relaxed);
+
+    ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+    append_request(s_async_file_io.first_queued_request, s_async_file_io.last_queued_request, request);
+    ++s_async_file_io.unsignaled_request_count;
+}
+
+void AsyncFileIo::flush_submissions()
+{
+    if (s_async_file_io.backend == AsyncIoBackend::Native)
+    {
+        ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+        if (s_async_file_io.first_queued_request == nullptr)
+            return;
+
+        while (s_async_file_io.first_queued_request != nullptr && prepare_native_request(*s_async_file_io.first_queued_request))
+            pop_request(s_async_file_io.first_queued_request, s_async_file_io.last_queued_request);
+        submit_native_requests();
+        return;
+    }
+
+    u32 unsignaled_request_count;
+    {
+        ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+        unsignaled_request_count = s_async_file_io.unsignaled_request_count;
+        s_async_file_io.unsignaled_request_count = 0;
+    }
+
+    if (unsignaled_request_count > 0)
+        s_async_file_io.pool_semaphore.signal(unsignaled_request_count);
+}
+
+void AsyncFileIo::process_completions()
+{
+    flush_submissions();
+
+    // NOTE: If another thread is reaping the completions, they are collected into the finished queue anyway.
+    if (s_async_file_io.backend == AsyncIoBackend::Native && s_async_file_io.completion_lock.try_lock())
+    {
+        reap_native_completions(false);
+        s_async_file_io.completion_lock.unlock();
+
+        // The reaped requests have made room in the queue for the requests that didn't fit before.
+        flush_submissions();
+    }
+
+    AsyncIoRequest* request;
+    {
+        ScopedLock<SpinLock> finished_lock(s_async_file_io.finished_lock);
+        request = s_async_file_io.first_finished_request;
+        s_async_file_io.first_finished_request = nullptr;
+        s_async_file_io.last_finished_request = nullptr;
+    }
+
+    while (request != nullptr)
+    {
+        // NOTE: The callback can reuse the request, so the link must be read before the callback is invoked.
+        AsyncIoRequest* next_request = request->next_request;
+        request->next_request = nullptr;
+
+        const bool is_successful = (request->transferred_byte_count == request->byte_count);
+        finalize_request(*request, is_successful ? AsyncIoStatus::Completed : AsyncIoStatus::Failed);
+        request->callback(*request);
+        request = next_request;
+    }
+}
+
+void AsyncFileIo::wait(AsyncIoRequest& request)
+{
+    CAVE_ASSERT(request.callback == nullptr);
+    CAVE_ASSERT(request.get_status() != AsyncIoStatus::Idle);
+
+    flush_submissions();
+    while (!request.is_finished())
+    {
+        if (s_async_file_io.backend == AsyncIoBackend::Native)
+        {
+            {
+                ScopedLock<Mutex> completion_lock(s_async_file_io.completion_lock);
+                if (request.is_finished())
+                    break;
+                reap_native_completions(true);
+            }
+
+            flush_submissions();
+        }
+        else
+        {
+            Futex::wait(request.status, static_cast<u32>(AsyncIoStatus::Pending));
+        }
+    }
+}
+
+void AsyncFileIo::finish_request(AsyncIoRequest& request, bool is_successful, u32 transferred_byte_count)
+{
+    request.transferred_byte_count = is_successful ? transferred_byte_count : 0;
+    is_successful = is_successful && (transferred_byte_count == request.byte_count);
+
+    s_async_file_io.finished_request_counter.add();
+    s_async_file_io.transferred_byte_counter.add(request.transferred_byte_count);
+    if (!is_successful)
+        s_async_file_io.failed_request_counter.add();
+
+    if (request.callback != nullptr)
+    {
+        // The request stays pending until its callback is invoked by `process_completions`.
+        ScopedLock<SpinLock> finished_lock(s_async_file_io.finished_lock);
+        append_request(s_async_file_io.first_finished_request, s_async_file_io.last_finished_request, request);
+        return;
+    }
+
+    finalize_request(request, is_successful ? AsyncIoStatus::Completed : AsyncIoStatus::Failed);
+}
+
+#pragma endregion
+
+#pragma region Thread Pool
+
+void AsyncFileIo::thread_pool_entry_point(MAYBE_UNUSED void* user_data)
+{
+    while (true)
+    {
+        s_async_file_io.pool_semaphore.wait();
+
+        AsyncIoRequest* request;
+        {
+            ScopedLock<Mutex> submission_lock(s_async_file_io.submission_lock);
+            request = pop_request(s_async_file_io.first_queued_request, s_async_file_io.last_queued_request);
+        }
+
+        if (request == nullptr)
+        {
+            if (s_async_file_io.should_stop_pool.load(std::memory_order_acquire))
+                break;
+            continue;
+        }
+
+        const bool is_registered_file = (request->registered_file_index != AsyncIoRequest::unregistered_index);
+        File* file = is_registered_file ? s_async_file_io.registered_files[request->registered_file_index] : request->file;
+
+        bool is_successful;
+        if (request->operation == AsyncIoOperation::Read)
+            is_successful = file->read_at(request->offset, request->buffer, request->byte_count);
+        else
+            is_successful = file->write_at(request->offset, request->buffer, request->byte_count);
+
+        finish_request(*request, is_successful, is_successful ? request->byte_count : 0);
+    }
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+class File;
+struct AsyncIoRequest;
+
+enum class AsyncIoOperation : u8
+{
+    Read,
+    Write,
+};
+
+enum class AsyncIoStatus : u32
+{
+    // The request hasn't been submitted yet (or it has been reset after finishing).
+    Idle,
+    Pending,
+    // All the requested bytes have been transferred.
+    Completed,
+    // An error has occurred or the end of the file has been reached before all bytes have been transferred.
+    Failed,
+};
+
+enum class AsyncIoBackend : u8
+{
+    // Uses `io_uring` on Linux, if the kernel supports it. Falls back to `AsyncIoBackend::ThreadPool` otherwise.
+    Native,
+    // Performs blocking positional reads and writes on a small pool of dedicated threads.
+    ThreadPool,
+};
+
+using AsyncIoCallback = void (*)(AsyncIoRequest& request);
+
+//
+// A read or a write that is executed asynchronously by `AsyncFileIo`. The request is owned by the caller and must stay
+// alive (and unmodified) until it has finished.
+//
+struct AsyncIoRequest
+{
+    static constexpr u32 unregistered_index = static_cast<u32>(-1);
+
+    AsyncIoOperation operation { AsyncIoOperation::Read };
+
+    // The file to read from or to write into. Ignored if the request uses a registered file.
+    File* file { nullptr };
+    // The index of the file in the table passed to `AsyncFileIo::register_files`.
+    u32 registered_file_index { unregistered_index };
+    // The index of the registered buffer (see `AsyncFileIo::register_buffers`) that contains `buffer`.
+    u32 registered_buffer_index { unregistered_index };
+
+    u64 offset { 0 };
+    void* buffer { nullptr };
+    u32 byte_count { 0 };
+
+    //
+    // Invoked by `AsyncFileIo::process_completions` once the request has finished, on the thread that processes the
+    // completions (the main thread). The request can be reused or destroyed by the callback.
+    //
+    AsyncIoCallback callback { nullptr };
+    void* user_data { nullptr };
+
+    // The number of bytes that have been transferred. Valid once the request has finished.
+    u32 transferred_byte_count { 0 };
+
+    NODISCARD ALWAYS_INLINE AsyncIoStatus get_status() const { return static_cast<AsyncIoStatus>(status.load(std::memory_order_acquire)); }
+    NODISCARD ALWAYS_INLINE bool is_finished() const { return (get_status() == AsyncIoStatus::Completed || get_status() == AsyncIoStatus::Failed); }
+
+    // Stored as a plain integer, so the threads that wait for the request can use it as a futex word.
+    std::atomic<u32> status { static_cast<u32>(AsyncIoStatus::Idle) };
+    // Links the request into the internal queues of `AsyncFileIo`.
+    AsyncIoRequest* next_request { nullptr };
+};
+
+struct AsyncIoBuffer
+{
+    void* data { nullptr };
+    usize byte_count { 0 };
+};
+
+//
+// Asynchronous file reads and writes into caller-provided buffers, meant for streaming the world from disk without
+// blocking the main thread or the job workers.
+//
+// The requests are queued by `submit` and handed over to the operating system in batches by `flush_submissions`.
+// On Linux, the native backend uses `io_uring`: a whole batch is submitted with a single system call and the
+// completions are read from a ring shared with the kernel, without any system call. Files and buffers that are used
+// by many requests can be registered, which saves the kernel from looking up the file and pinning the buffer pages
+// for every request. Windows (and kernels without `io_uring`) use the thread pool backend.
+//
+// The completions are processed once per frame by `Engine::run`, which invokes the callbacks of the finished requests
+// on the main thread. Jobs that can't continue without the data can block on a request with `wait` instead.
+//
+// NOTE: Requests can be submitted and waited for from any thread.
+//
+class AsyncFileIo
+{
+public:
+    static constexpr u32 default_queue_depth = 256;
+    static constexpr u32 thread_pool_thread_count = 2;
+
+public:
+    //
+    // Creates the submission queue with the given depth (the maximum number of requests handed over to the operating
+    // system at once) and starts the backend. Returns false if the service has already been initialized or if no
+    // backend can be started.
+    //
+    static bool initialize(u32 queue_depth = default_queue_depth, AsyncIoBackend backend = AsyncIoBackend::Native);
+
+    // Waits for all the submitted requests to finish and stops the backend. The pending callbacks are invoked.
+    static void shutdown();
+
+    NODISCARD static bool is_initialized();
+    NODISCARD static AsyncIoBackend get_backend();
+
+public:
+    //
+    // Registers the files that the requests refer to by `AsyncIoRequest::registered_file_index`, replacing the files
+    // registered before. The files must stay open until they are unregistered, and no request may be in flight.
+    //
+    static bool register_files(File* const* files, u32 file_count);
+    static void unregister_files();
+
+    // Registers the buffers that the requests refer to by `AsyncIoRequest::registered_buffer_index`.
+    static bool register_buffers(const AsyncIoBuffer* buffers, u32 buffer_count);
+    static void unregister_buffers();
+
+public:
+    // Queues the request. It is handed over to the operating system by the next `flush_submissions` call.
+    static void submit(AsyncIoRequest& request);
+
+    // Hands over the queued requests to the operating system, as many as the queue depth allows.
+    static void flush_submissions();
+
+    // Collects the finished requests and invokes their callbacks on the calling thread. Called once per frame.
+    static void process_completions();
+
+    //
+    // Blocks the calling thread until the request has finished, submitting the queued requests if required.
+    // NOTE: Requests with a callback can't be waited for, as they only finish when the main thread processes them.
+    //
+    static void wait(AsyncIoRequest& request);
+
+private:
+    //
+    // The native backend, implemented by the platform (see `LinuxAsyncFileIo.cpp`). All functions are called with
+    // the submission lock held, except `reap_native_completions`, which is called with the completion lock held.
+    //
+    static bool initialize_native_backend(u32 queue_depth);
+    static void shutdown_native_backend();
+    static bool register_native_files(File* const* files, u32 file_count);
+    static void unregister_native_files();
+    static bool register_native_buffers(const AsyncIoBuffer* buffers, u32 buffer_count);
+    static void unregister_native_buffers();
+
+    // Prepares the request for submission. Returns false if the queue is full.
+    static bool prepare_native_request(AsyncIoRequest& request);
+    // Submits all the prepared requests with a single system call.
+    static void submit_native_requests();
+    //
+    // Finishes the requests whose completions are available. If `should_wait` is set and no completion is available,
+    // blocks until at least one request has finished.
+    //
+    static void reap_native_completions(bool should_wait);
+
+    // Publishes the result of the request. Called by the backends.
+    static void finish_request(AsyncIoRequest& request, bool is_successful, u32 transferred_byte_count);
+
+    static void thread_pool_entry_point(void* user_data);
+};
+
+} // namespace CaveGame
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/FastClock.h>
+
+#if !CAVE_COMPILER_MSVC
+    #include <cpuid.h>
+#endif // !CAVE_COMPILER_MSVC
+
+namespace CaveGame
+{
+
+FastClock::Calibration FastClock::s_calibration;
+
+//
+// The invariant TSC support is reported by bit 8 of the EDX register of the 0x80000007 CPUID leaf.
+// Intel 64 and IA-32 Architectures Software Developer's Manual, Volume 3B, Section 18.17.1.
+//
+static bool has_invariant_time_stamp_counter()
+{
+    static constexpr u32 advanced_power_management_leaf = 0x80000007;
+    static constexpr u32 invariant_tsc_bit = 1U << 8;
+
+#if CAVE_COMPILER_MSVC
+    int registers[4] = {};
+    __cpuid(registers, static_cast<int>(0x80000000));
+    if (static_cast<u32>(registers[0]) < advanced_power_management_leaf)
+        return false;
+
+    __cpuid(registers, static_cast<int>(advanced_power_management_leaf));
+    return (static_cast<u32>(registers[3]) & invariant_tsc_bit) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < advanced_power_management_leaf)
+        return false;
+
+    if (!__get_cpuid(advanced_power_management_leaf, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & invariant_tsc_bit) != 0;
+#endif // CAVE_COMPILER_MSVC
+}
+
+//
+// Measures the frequency of the time-stamp counter against the platform tick counter, over a short busy-wait.
+// Returns zero if the measurement isn't plausible.
+//
+static u64 measure_time_stamp_counter_frequency()
+{
+    // The duration of the calibration interval, expressed as a fraction of a second (10 milliseconds).
+    static constexpr u64 calibration_interval_divisor = 100;
+    // Time-stamp counters that run slower than this are certainly misreported.
+    static constexpr u64 minimum_plausible_frequency = 100'000'000;
+
+    const u64 platform_frequency = PlatformCore::get_tick_counter_frequency();
+    const u64 platform_start = PlatformCore::get_current_tick_counter();
+    const u64 time_stamp_start = __rdtsc();
+
+    u64 platform_end;
+    do
+    {
+        platform_end = PlatformCore::get_current_tick_counter();
+    } while (platform_end - platform_start < platform_frequency / calibration_interval_divisor);
+
+    const u64 time_stamp_end = __rdtsc();
+    if (time_stamp_end <= time_stamp_start)
+        return 0;
+
+    const double elapsed_seconds = static_cast<double>(platform_end - platform_start) / static_cast<double>(platform_frequency);
+    const u64 frequency = static_cast<u64>(static_cast<double>(time_stamp_end - time_stamp_start) / elapsed_seconds);
+    return (frequency >= minimum_plausible_frequency) ? frequency : 0;
+}
+
+bool FastClock::initialize()
+{
+    if (s_calibration.is_initialized)
+    {
+        // The clock has already been initialized.
+        return false;
+    }
+
+    Calibration calibration;
+    if (has_invariant_time_stamp_counter())
+    {
+        calibration.tick_frequency = measure_time_stamp_counter_frequency();
+        calibration.is_using_time_stamp_counter = (calibration.tick_frequency != 0);
+    }
+
+    if (!calibration.is_using_time_stamp_counter)
+    {
+        // NOTE: The time-stamp counter is either not invariant (it can't be used for measuring time) or its
+        // frequency couldn't be measured. Fall back to the platform tick counter.
+        calibration.tick_frequency = PlatformCore::get_tick_counter_frequency();
+    }
+
+    CAVE_VERIFY(calibration.tick_frequency != 0);
+    calibration.nanoseconds_multiplier = (1'000'000'000ULL << nanoseconds_shift) / calibration.tick_frequency;
+    calibration.is_initialized = true;
+
+    s_calibration = calibration;
+    return true;
+}
+
+} // namespace CaveGame
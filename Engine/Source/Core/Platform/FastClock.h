@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Platform/PlatformCore.h>
+
+#if CAVE_COMPILER_MSVC
+    #include <intrin.h>
+#else
+    #include <x86intrin.h>
+#endif // CAVE_COMPILER_MSVC
+
+namespace CaveGame
+{
+
+//
+// Low overhead clock, intended for timestamping a large number of events (profiling, instrumentation, frame timing).
+//
+// If the processor has an invariant time-stamp counter (its rate is constant, regardless of the power state of the
+// core, and it is synchronized between all cores) the clock reads it directly, which costs a few nanoseconds.
+// Otherwise, the clock falls back to the platform tick counter (`PlatformCore::get_current_tick_counter`).
+//
+// The clock must be calibrated by calling `FastClock::initialize()` before it is used. The calibration is performed
+// by `initialize_core_systems()`, before any other thread is started. Afterwards the clock state is never modified,
+// thus it is safe to use the clock from any thread.
+//
+class FastClock
+{
+public:
+    //
+    // Detects whether the time-stamp counter is invariant and measures its frequency against the platform tick
+    // counter. Blocks the calling thread for about 10 milliseconds. Returns false if the clock is already initialized.
+    //
+    static bool initialize();
+
+    NODISCARD ALWAYS_INLINE static bool is_initialized() { return s_calibration.is_initialized; }
+    NODISCARD ALWAYS_INLINE static bool is_using_time_stamp_counter() { return s_calibration.is_using_time_stamp_counter; }
+
+    // Returns the frequency of the clock, measured in ticks per second.
+    NODISCARD ALWAYS_INLINE static u64 get_tick_frequency() { return s_calibration.tick_frequency; }
+
+public:
+    //
+    // Returns the current value of the clock. The read is not ordered with respect to the surrounding instructions,
+    // so the processor might execute it slightly earlier or later than it appears in the program.
+    //
+    NODISCARD ALWAYS_INLINE static u64 get_ticks()
+    {
+        CAVE_DEBUG_ASSERT(is_initialized());
+        if (s_calibration.is_using_time_stamp_counter)
+            return __rdtsc();
+        return PlatformCore::get_current_tick_counter();
+    }
+
+    //
+    // Returns the current value of the clock, only after all previous instructions have been executed.
+    // Slightly more expensive than `FastClock::get_ticks()`, but suitable for measuring very short intervals.
+    //
+    NODISCARD ALWAYS_INLINE static u64 get_ticks_ordered()
+    {
+        CAVE_DEBUG_ASSERT(is_initialized());
+        if (s_calibration.is_using_time_stamp_counter)
+        {
+            u32 processor_id;
+            return __rdtscp(&processor_id);
+        }
+        return PlatformCore::get_current_tick_counter();
+    }
+
+    // Converts a tick count to nanoseconds using a multiplication and a shift (no division).
+    NODISCARD ALWAYS_INLINE static u64 ticks_to_nanoseconds(u64 tick_count)
+    {
+        CAVE_DEBUG_ASSERT(is_initialized());
+#if CAVE_COMPILER_MSVC
+        u64 product_high;
+        const u64 product_low = _umul128(tick_count, s_calibration.nanoseconds_multiplier, &product_high);
+        return __shiftright128(product_low, product_high, nanoseconds_shift);
+#else
+        const unsigned __int128 product = static_cast<unsigned __int128>(tick_count) * s_calibration.nanoseconds_multiplier;
+        return static_cast<u64>(product >> nanoseconds_shift);
+#endif // CAVE_COMPILER_MSVC
+    }
+
+    NODISCARD ALWAYS_INLINE static float ticks_to_seconds(u64 tick_count) { return static_cast<float>(ticks_to_nanoseconds(tick_count)) * 1e-9F; }
+
+private:
+    static constexpr u32 nanoseconds_shift = 32;
+
+    struct Calibration
+    {
+        bool is_initialized { false };
+        bool is_using_time_stamp_counter { false };
+        u64 tick_frequency { 0 };
+        // Equal to `(10^9 << nanoseconds_shift) / tick_frequency`.
+        u64 nanoseconds_multiplier { 0 };
+    };
+
+    static Calibration s_calibration;
+};
+
+} // namespace CaveGame
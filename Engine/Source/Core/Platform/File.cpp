@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/File.h>
+
+#include <cstring>
+
+namespace CaveGame
+{
+
+bool FileSystem::read_entire_file(StringView filepath, Vector<u8>& out_bytes)
+{
+    File file;
+    if (!file.open(filepath, FileOpenMode::Read))
+        return false;
+
+    const u64 byte_count = file.get_byte_count();
+    out_bytes.set_count_uninitialized(static_cast<usize>(byte_count));
+    const bool is_successful = file.read_at(0, out_bytes.elements(), out_bytes.count());
+    file.close();
+    return is_successful;
+}
+
+bool FileSystem::write_entire_file_atomically(StringView filepath, const void* bytes, usize byte_count)
+{
+    // NOTE: The temporary file must be on the same file system as the destination, otherwise it can't be renamed.
+    const StringView temporary_suffix = ".tmp"sv;
+    Vector<char> temporary_filepath_characters;
+    temporary_filepath_characters.set_count_uninitialized(filepath.byte_count() + temporary_suffix.byte_count());
+    memcpy(temporary_filepath_characters.elements(), filepath.characters(), filepath.byte_count());
+    memcpy(temporary_filepath_characters.elements() + filepath.byte_count(), temporary_suffix.characters(), temporary_suffix.byte_count());
+    const StringView temporary_filepath = StringView::create_from_utf8(temporary_filepath_characters.elements(), temporary_filepath_characters.count());
+
+    File file;
+    if (!file.open(temporary_filepath, FileOpenMode::Create))
+        return false;
+
+    // The data must reach the storage device before the rename, otherwise a power loss can leave an empty file behind.
+    const bool is_written = file.write_at(0, bytes, byte_count) && file.flush();
+    file.close();
+
+    if (!is_written || !replace_file(temporary_filepath, filepath))
+    {
+        delete_file(temporary_filepath);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace CaveGame
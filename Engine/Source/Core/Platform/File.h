@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+enum class FileOpenMode : u8
+{
+    // Opens an existing file for reading.
+    Read,
+    // Opens an existing file for reading and writing.
+    ReadWrite,
+    // Creates the file for reading and writing. If the file already exists, it is truncated.
+    Create,
+};
+
+//
+// Wrapper around a native file handle. All reads and writes are positional (`pread` and `pwrite` on Linux), so the
+// file has no cursor and multiple threads can read from the same file concurrently.
+//
+// NOTE: The paths are UTF-8 encoded and can use forward slashes on all platforms.
+//
+class File
+{
+    CAVE_MAKE_NONCOPYABLE(File);
+    CAVE_MAKE_NONMOVABLE(File);
+
+public:
+    File() = default;
+    ALWAYS_INLINE ~File() { CAVE_ASSERT(m_native_handle == invalid_native_handle); }
+
+    // Returns false if the file is already open or if it can't be opened with the given mode.
+    bool open(StringView filepath, FileOpenMode mode);
+    void close();
+
+    NODISCARD ALWAYS_INLINE bool is_open() const { return (m_native_handle != invalid_native_handle); }
+
+    // Returns the file descriptor on Linux and the file handle on Windows.
+    NODISCARD ALWAYS_INLINE intptr get_native_handle() const { return m_native_handle; }
+
+    // Returns the size of the file, measured in bytes. Returns zero if the size can't be determined.
+    NODISCARD u64 get_byte_count() const;
+
+    // Resizes the file. The bytes added at the end of the file are zero-initialized.
+    bool set_byte_count(u64 byte_count);
+
+    //
+    // Reads exactly `byte_count` bytes starting at the given offset. Returns false if an error occurs or if the end
+    // of the file is reached before all bytes have been read.
+    //
+    bool read_at(u64 offset, void* out_buffer, usize byte_count) const;
+
+    // Writes exactly `byte_count` bytes starting at the given offset, extending the file if required.
+    bool write_at(u64 offset, const void* buffer, usize byte_count);
+
+    // Blocks until the written data has reached the storage device, so it survives a power loss.
+    bool flush();
+
+private:
+    // The file descriptor on Linux and the file handle on Windows (where `INVALID_HANDLE_VALUE` is also -1).
+    static constexpr intptr invalid_native_handle = -1;
+
+    intptr m_native_handle { invalid_native_handle };
+};
+
+enum class FileMappingAccess : u8
+{
+    ReadOnly,
+    // The modifications are written back to the file. The size of the file can't be changed through the mapping.
+    ReadWrite,
+};
+
+// Describes how a mapped range is going to be accessed, so the operating system can adapt its read-ahead.
+enum class FileAccessHint : u8
+{
+    Normal,
+    // The range is read from the beginning to the end, so the pages can be read ahead aggressively.
+    Sequential,
+    // The range is read in a random order, so reading ahead only wastes memory.
+    Random,
+    // The range will be accessed soon, so its pages should be read into the page cache in the background.
+    WillNeed,
+};
+
+//
+// Maps an entire file into the address space of the process. The mapped bytes are served directly from the page
+// cache of the operating system, so reading an asset through a mapping never copies it.
+//
+// NOTE: The access hints are only implemented on Linux (with `madvise`). On Windows, only `FileAccessHint::WillNeed`
+// is implemented (with `PrefetchVirtualMemory`) and the other hints are ignored.
+//
+class MappedFile
+{
+    CAVE_MAKE_NONCOPYABLE(MappedFile);
+    CAVE_MAKE_NONMOVABLE(MappedFile);
+
+public:
+    MappedFile() = default;
+    ALWAYS_INLINE ~MappedFile() { CAVE_ASSERT(!m_is_open); }
+
+    //
+    // Maps the file with the given access. Returns false if a file is already mapped or if the file can't be mapped.
+    // An empty file is mapped successfully, but its data is null.
+    //
+    bool open(StringView filepath, FileMappingAccess access = FileMappingAccess::ReadOnly);
+    void close();
+
+    NODISCARD ALWAYS_INLINE bool is_open() const { return m_is_open; }
+    NODISCARD ALWAYS_INLINE const u8* data() const { return m_data; }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+
+    // Only available if the file has been mapped with `FileMappingAccess::ReadWrite`.
+    NODISCARD ALWAYS_INLINE u8* mutable_data() const
+    {
+        CAVE_ASSERT(m_access == FileMappingAccess::ReadWrite);
+        return m_data;
+    }
+
+    void advise(FileAccessHint hint, usize offset, usize byte_count) const;
+    ALWAYS_INLINE void advise(FileAccessHint hint) const { advise(hint, 0, m_byte_count); }
+
+    // Writes the modified pages back to the file and blocks until they have reached the storage device.
+    bool flush();
+
+private:
+    u8* m_data { nullptr };
+    usize m_byte_count { 0 };
+    // The file handle, which is kept open on Windows so the mapping can be flushed. Unused on Linux.
+    void* m_native_handle { nullptr };
+    FileMappingAccess m_access { FileMappingAccess::ReadOnly };
+    bool m_is_open { false };
+};
+
+struct DirectoryEntry
+{
+    // The name of the entry, without the path of the directory.
+    String name;
+    // The size of the file, measured in bytes. Always zero for directories.
+    u64 byte_count { 0 };
+    bool is_directory { false };
+};
+
+class FileSystem
+{
+public:
+    NODISCARD static bool file_exists(StringView filepath);
+    NODISCARD static bool directory_exists(StringView directory_path);
+
+    // Creates the directory. Returns true if the directory already exists.
+    static bool create_directory(StringView directory_path);
+
+    static bool delete_file(StringView filepath);
+
+    //
+    // Lists the files and the directories of the directory, excluding `.` and `..`, in no particular order.
+    // Returns false if the directory can't be opened.
+    //
+    static bool enumerate_directory(StringView directory_path, Vector<DirectoryEntry>& out_entries);
+
+    //
+    // Renames the source file to the destination, replacing the destination if it exists. The replacement is atomic:
+    // a process that opens the destination either sees the old file or the new one, never a partially written file.
+    //
+    static bool replace_file(StringView source_filepath, StringView destination_filepath);
+
+public:
+    // Reads the entire file into the buffer. Prefer `MappedFile` for large files that don't need to be copied.
+    static bool read_entire_file(StringView filepath, Vector<u8>& out_bytes);
+
+    //
+    // Writes the bytes into a temporary file next to the destination, flushes it and replaces the destination with it.
+    // If the process crashes (or the power is lost) meanwhile, the destination is left untouched, so saving never
+    // corrupts the previous save.
+    //
+    static bool write_entire_file_atomically(StringView filepath, const void* bytes, usize byte_count);
+};
+
+} // namespace CaveGame
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Address-based waiting, the building block of the blocking synchronization primitives (see `Core/Threading`).
+// Maps to `futex` on Linux and to `WaitOnAddress` on Windows. Both only affect the threads of the current process.
+//
+class Futex
+{
+public:
+    //
+    // Blocks the calling thread while the word is equal to the expected value. The check and the suspension are
+    // performed atomically with respect to the wake functions. The function can return spuriously, thus the caller
+    // must always check the condition it is waiting for again.
+    //
+    static void wait(const std::atomic<u32>& word, u32 expected_value);
+
+    // Wakes up at most one of the threads waiting on the word.
+    static void wake_one(std::atomic<u32>& word);
+
+    // Wakes up all the threads waiting on the word.
+    static void wake_all(std::atomic<u32>& word);
+};
+
+static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "The futex word must be a plain 32-bit integer!");
+
+} // namespace CaveGame
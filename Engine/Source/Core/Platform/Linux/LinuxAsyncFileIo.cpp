@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Containers/Vector.h>
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/AsyncFileIo.h>
+    #include <Core/Platform/File.h>
+
+    #include <atomic>
+    #include <cerrno>
+    #include <cstring>
+    #include <linux/io_uring.h>
+    #include <new>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: The `io_uring` system calls are invoked directly (instead of through `liburing`), so the engine doesn't depend
+// on any library that isn't installed by default. Only the small subset of the interface used here is implemented.
+//
+struct IoUringQueue
+{
+    int ring_descriptor { -1 };
+
+    void* submission_ring { nullptr };
+    usize submission_ring_byte_count { 0 };
+    u32* submission_head { nullptr };
+    u32* submission_tail { nullptr };
+    u32* submission_array { nullptr };
+    u32 submission_mask { 0 };
+    u32 submission_entry_count { 0 };
+    io_uring_sqe* submission_entries { nullptr };
+
+    void* completion_ring { nullptr };
+    usize completion_ring_byte_count { 0 };
+    u32* completion_head { nullptr };
+    u32* completion_tail { nullptr };
+    u32 completion_mask { 0 };
+    u32 completion_entry_count { 0 };
+    io_uring_cqe* completion_entries { nullptr };
+
+    // The tail of the submission ring, including the prepared entries that haven't been published to the kernel yet.
+    u32 local_submission_tail { 0 };
+    u32 prepared_request_count { 0 };
+
+    //
+    // The number of requests submitted to the kernel whose completions haven't been reaped yet. Never exceeds the size
+    // of the completion ring, so the kernel never has to buffer the completions that don't fit.
+    //
+    std::atomic<u32> in_flight_request_count { 0 };
+
+    bool has_registered_files { false };
+    bool has_registered_buffers { false };
+};
+
+static IoUringQueue s_io_uring;
+
+static int io_uring_setup(u32 entry_count, io_uring_params* parameters)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entry_count, parameters));
+}
+
+static int io_uring_enter(int ring_descriptor, u32 submission_count, u32 minimum_completion_count, u32 flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring_descriptor, submission_count, minimum_completion_count, flags, nullptr, 0));
+}
+
+static int io_uring_register(int ring_descriptor, u32 opcode, const void* arguments, u32 argument_count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ring_descriptor, opcode, arguments, argument_count));
+}
+
+// The kernel reads and writes the ring indices concurrently, so they must be accessed atomically.
+NODISCARD ALWAYS_INLINE static u32 load_ring_index(u32* index, std::memory_order order)
+{
+    return std::atomic_ref<u32>(*index).load(order);
+}
+
+ALWAYS_INLINE static void store_ring_index(u32* index, u32 value)
+{
+    std::atomic_ref<u32>(*index).store(value, std::memory_order_release);
+}
+
+// Returns true if the kernel implements the operations used by the backend (they have been added in Linux 5.6).
+static bool are_required_operations_supported(int ring_descriptor)
+{
+    constexpr u32 probe_operation_count = IORING_OP_LAST;
+    alignas(io_uring_probe) u8 probe_storage[sizeof(io_uring_probe) + probe_operation_count * sizeof(io_uring_probe_op)] = {};
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probe_storage);
+    if (io_uring_register(ring_descriptor, IORING_REGISTER_PROBE, probe, probe_operation_count) < 0)
+        return false;
+
+    const u8 required_operations[] = { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED };
+    for (const u8 operation : required_operations)
+    {
+        if (operation > probe->last_op || !(probe->ops[operation].flags & IO_URING_OP_SUPPORTED))
+            return false;
+    }
+
+    return true;
+}
+
+static void release_io_uring()
+{
+    if (s_io_uring.submission_entries != nullptr)
+        munmap(s_io_uring.submission_entries, s_io_uring.submission_entry_count * sizeof(io_uring_sqe));
+    if (s_io_uring.completion_ring != nullptr && s_io_uring.completion_ring != s_io_uring.submission_ring)
+        munmap(s_io_uring.completion_ring, s_io_uring.completion_ring_byte_count);
+    if (s_io_uring.submission_ring != nullptr)
+        munmap(s_io_uring.submission_ring, s_io_uring.submission_ring_byte_count);
+    if (s_io_uring.ring_descriptor >= 0)
+        close(s_io_uring.ring_descriptor);
+
+    s_io_uring.~IoUringQueue();
+    new (&s_io_uring) IoUringQueue();
+}
+
+bool AsyncFileIo::initialize_native_backend(u32 queue_depth)
+{
+    io_uring_params parameters = {};
+    s_io_uring.ring_descriptor = io_uring_setup(queue_depth, &parameters);
+    if (s_io_uring.ring_descriptor < 0)
+    {
+        // The kernel is older than 5.1, or `io_uring` has been disabled (for example, by a seccomp filter).
+        s_io_uring.ring_descriptor = -1;
+        return false;
+    }
+
+    if (!are_required_operations_supported(s_io_uring.ring_descriptor))
+    {
+        release_io_uring();
+        return false;
+    }
+
+    s_io_uring.submission_ring_byte_count = parameters.sq_off.array + parameters.sq_entries * sizeof(u32);
+    s_io_uring.completion_ring_byte_count = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+
+    // NOTE: Since Linux 5.4, both rings are mapped with a single call.
+    const bool is_single_mapping = (parameters.features & IORING_FEAT_SINGLE_MMAP);
+    if (is_single_mapping)
+    {
+        s_io_uring.submission_ring_byte_count = Math::max(s_io_uring.submission_ring_byte_count, s_io_uring.completion_ring_byte_count);
+        s_io_uring.completion_ring_byte_count = s_io_uring.submission_ring_byte_count;
+    }
+
+    void* submission_ring = mmap(nullptr, s_io_uring.submission_ring_byte_count, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s_io_uring.ring_descriptor, IORING_OFF_SQ_RING);
+    if (submission_ring == MAP_FAILED)
+    {
+        release_io_uring();
+        return false;
+    }
+    s_io_uring.submission_ring = submission_ring;
+
+    void* completion_ring = submission_ring;
+    if (!is_single_mapping)
+    {
+        completion_ring = mmap(nullptr, s_io_uring.completion_ring_byte_count, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s_io_uring.ring_descriptor, IORING_OFF_CQ_RING);
+        if (completion_ring == MAP_FAILED)
+        {
+            release_io_uring();
+            return false;
+        }
+    }
+    s_io_uring.completion_ring = completion_ring;
+
+    s_io_uring.submission_entry_count = parameters.sq_entries;
+    void* submission_entries = mmap(nullptr, parameters.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, s_io_uring.ring_descriptor, IORING_OFF_SQES);
+    if (submission_entries == MAP_FAILED)
+    {
+        release_io_uring();
+        return false;
+    }
+    s_io_uring.submission_entries = static_cast<io_uring_sqe*>(submission_entries);
+
+    u8* submission_ring_bytes = static_cast<u8*>(submission_ring);
+    s_io_uring.submission_head = reinterpret_cast<u32*>(submission_ring_bytes + parameters.sq_off.head);
+    s_io_uring.submission_tail = reinterpret_cast<u32*>(submission_ring_bytes + parameters.sq_off.tail);
+    s_io_uring.submission_array = reinterpret_cast<u32*>(submission_ring_bytes + parameters.sq_off.array);
+    s_io_uring.submission_mask = *reinterpret_cast<u32*>(submission_ring_bytes + parameters.sq_off.ring_mask);
+
+    u8* completion_ring_bytes = static_cast<u8*>(completion_ring);
+    s_io_uring.completion_head = reinterpret_cast<u32*>(completion_ring_bytes + parameters.cq_off.head);
+    s_io_uring.completion_tail = reinterpret_cast<u32*>(completion_ring_bytes + parameters.cq_off.tail);
+    s_io_uring.completion_mask = *reinterpret_cast<u32*>(completion_ring_bytes + parameters.cq_off.ring_mask);
+    s_io_uring.completion_entry_count = parameters.cq_entries;
+    s_io_uring.completion_entries = reinterpret_cast<io_uring_cqe*>(completion_ring_bytes + parameters.cq_off.cqes);
+
+    s_io_uring.local_submission_tail = load_ring_index(s_io_uring.submission_tail, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncFileIo::shutdown_native_backend()
+{
+    CAVE_ASSERT(s_io_uring.in_flight_request_count.load(std::memory_order_relaxed) == 0);
+    release_io_uring();
+}
+
+bool AsyncFileIo::register_native_files(File* const* files, u32 file_count)
+{
+    unregister_native_files();
+    if (file_count == 0)
+        return true;
+
+    Vector<int> file_descriptors;
+    file_descriptors.set_count_uninitialized(file_count);
+    for (u32 file_index = 0; file_index < file_count; ++file_index)
+        file_descriptors[file_index] = static_cast<int>(files[file_index]->get_native_handle());
+
+    if (io_uring_register(s_io_uring.ring_descriptor, IORING_REGISTER_FILES, file_descriptors.elements(), file_count) < 0)
+        return false;
+
+    s_io_uring.has_registered_files = true;
+    return true;
+}
+
+void AsyncFileIo::unregister_native_files()
+{
+    if (!s_io_uring.has_registered_files)
+        return;
+
+    io_uring_register(s_io_uring.ring_descriptor, IORING_UNREGISTER_FILES, nullptr, 0);
+    s_io_uring.has_registered_files = false;
+}
+
+bool AsyncFileIo::register_native_buffers(const AsyncIoBuffer* buffers, u32 buffer_count)
+{
+    unregister_native_buffers();
+    if (buffer_count == 0)
+        return true;
+
+    Vector<iovec> buffer_descriptions;
+    buffer_descriptions.set_count_uninitialized(buffer_count);
+    for (u32 buffer_index = 0; buffer_index < buffer_count; ++buffer_index)
+    {
+        buffer_descriptions[buffer_index].iov_base = buffers[buffer_index].data;
+        buffer_descriptions[buffer_index].iov_len = buffers[buffer_index].byte_count;
+    }
+
+    // NOTE: The registered buffers are pinned in physical memory, which counts against `RLIMIT_MEMLOCK` on older kernels.
+    if (io_uring_register(s_io_uring.ring_descriptor, IORING_REGISTER_BUFFERS, buffer_descriptions.elements(), buffer_count) < 0)
+        return false;
+
+    s_io_uring.has_registered_buffers = true;
+    return true;
+}
+
+void AsyncFileIo::unregister_native_buffers()
+{
+    if (!s_io_uring.has_registered_buffers)
+        return;
+
+    io_uring_register(s_io_uring.ring_descriptor, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    s_io_uring.has_registered_buffers = false;
+}
+
+bool AsyncFileIo::prepare_native_request(AsyncIoRequest& request)
+{
+    const u32 in_flight_request_count = s_io_uring.in_flight_request_count.load(std::memory_order_relaxed);
+    if (in_flight_request_count + s_io_uring.prepared_request_count >= s_io_uring.completion_entry_count)
+        return false;
+
+    const u32 submission_head = load_ring_index(s_io_uring.submission_head, std::memory_order_acquire);
+    if (s_io_uring.local_submission_tail - submission_head >= s_io_uring.submission_entry_count)
+        return false;
+
+    const u32 entry_index = s_io_uring.local_submission_tail & s_io_uring.submission_mask;
+    io_uring_sqe& entry = s_io_uring.submission_entries[entry_index];
+    memset(&entry, 0, sizeof(entry));
+
+    const bool is_read = (request.operation == AsyncIoOperation::Read);
+    if (request.registered_buffer_index != AsyncIoRequest::unregistered_index)
+    {
+        entry.opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        entry.buf_index = static_cast<u16>(request.registered_buffer_index);
+    }
+    else
+    {
+        entry.opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+
+    if (request.registered_file_index != AsyncIoRequest::unregistered_index)
+    {
+        entry.fd = static_cast<i32>(request.registered_file_index);
+        entry.flags = IOSQE_FIXED_FILE;
+    }
+    else
+    {
+        entry.fd = static_cast<i32>(request.file->get_native_handle());
+    }
+
+    entry.off = request.offset;
+    entry.addr = reinterpret_cast<u64>(request.buffer);
+    entry.len = request.byte_count;
+    entry.user_data = reinterpret_cast<u64>(&request);
+
+    s_io_uring.submission_array[entry_index] = entry_index;
+    ++s_io_uring.local_submission_tail;
+    ++s_io_uring.prepared_request_count;
+    return true;
+}
+
+void AsyncFileIo::submit_native_requests()
+{
+    if (s_io_uring.prepared_request_count == 0)
+        return;
+
+    // Publish the prepared entries to the kernel.
+    store_ring_index(s_io_uring.submission_tail, s_io_uring.local_submission_tail);
+    s_io_uring.in_flight_request_count.fetch_add(s_io_uring.prepared_request_count, std::memory_order_relaxed);
+
+    u32 remaining_request_count = s_io_uring.prepared_request_count;
+    s_io_uring.prepared_request_count = 0;
+    while (remaining_request_count > 0)
+    {
+        const int submitted_request_count = io_uring_enter(s_io_uring.ring_descriptor, remaining_request_count, 0, 0);
+        if (submitted_request_count < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+
+            // The entries stay in the submission ring, and are submitted again by the next system call.
+            CAVE_ASSERT(false);
+            return;
+        }
+
+        remaining_request_count -= static_cast<u32>(submitted_request_count);
+    }
+}
+
+void AsyncFileIo::reap_native_completions(bool should_wait)
+{
+    while (true)
+    {
+        u32 completion_head = load_ring_index(s_io_uring.completion_head, std::memory_order_relaxed);
+        const u32 completion_tail = load_ring_index(s_io_uring.completion_tail, std::memory_order_acquire);
+        if (completion_head != completion_tail)
+        {
+            while (completion_head != completion_tail)
+            {
+                const io_uring_cqe& completion = s_io_uring.completion_entries[completion_head & s_io_uring.completion_mask];
+                AsyncIoRequest* request = reinterpret_cast<AsyncIoRequest*>(completion.user_data);
+                const i32 result = completion.res;
+
+                // Release the completion entry before finishing the request, as the kernel can reuse it immediately.
+                store_ring_index(s_io_uring.completion_head, ++completion_head);
+                s_io_uring.in_flight_request_count.fetch_sub(1, std::memory_order_relaxed);
+
+                // A negative result is the error code, while a positive result is the number of transferred bytes.
+                finish_request(*request, result >= 0, (result >= 0) ? static_cast<u32>(result) : 0);
+            }
+            return;
+        }
+
+        if (!should_wait || s_io_uring.in_flight_request_count.load(std::memory_order_relaxed) == 0)
+            return;
+
+        if (io_uring_enter(s_io_uring.ring_descriptor, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+            return;
+    }
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Platform/File.h>
+
+    #include <cerrno>
+    #include <cstdio>
+    #include <cstring>
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+#pragma region File
+
+bool File::open(StringView filepath, FileOpenMode mode)
+{
+    if (m_native_handle != invalid_native_handle)
+        return false;
+
+    int flags = O_CLOEXEC;
+    switch (mode)
+    {
+        case FileOpenMode::Read: flags |= O_RDONLY; break;
+        case FileOpenMode::ReadWrite: flags |= O_RDWR; break;
+        case FileOpenMode::Create: flags |= O_RDWR | O_CREAT | O_TRUNC; break;
+    }
+
+    const String null_terminated_filepath = String(filepath);
+    int file_descriptor;
+    do
+    {
+        file_descriptor = ::open(null_terminated_filepath.characters(), flags, 0644);
+    } while (file_descriptor < 0 && errno == EINTR);
+
+    if (file_descriptor < 0)
+        return false;
+
+    m_native_handle = file_descriptor;
+    return true;
+}
+
+void File::close()
+{
+    if (m_native_handle == invalid_native_handle)
+        return;
+
+    // NOTE: The descriptor is released even if `close` fails, so it must never be retried.
+    ::close(static_cast<int>(m_native_handle));
+    m_native_handle = invalid_native_handle;
+}
+
+u64 File::get_byte_count() const
+{
+    CAVE_ASSERT(is_open());
+    struct stat file_status;
+    if (fstat(static_cast<int>(m_native_handle), &file_status) != 0)
+        return 0;
+    return static_cast<u64>(file_status.st_size);
+}
+
+bool File::set_byte_count(u64 byte_count)
+{
+    CAVE_ASSERT(is_open());
+    return (ftruncate(static_cast<int>(m_native_handle), static_cast<off_t>(byte_count)) == 0);
+}
+
+bool File::read_at(u64 offset, void* out_buffer, usize byte_count) const
+{
+    CAVE_ASSERT(is_open());
+    u8* destination = static_cast<u8*>(out_buffer);
+    usize read_byte_count = 0;
+
+    // NOTE: A single `pread` call can read fewer bytes than requested (at most ~2 GiB on Linux), even before the end.
+    while (read_byte_count < byte_count)
+    {
+        const ssize_t result = pread(static_cast<int>(m_native_handle), destination + read_byte_count, byte_count - read_byte_count, static_cast<off_t>(offset + read_byte_count));
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        // The end of the file has been reached.
+        if (result == 0)
+            return false;
+
+        read_byte_count += static_cast<usize>(result);
+    }
+
+    return true;
+}
+
+bool File::write_at(u64 offset, const void* buffer, usize byte_count)
+{
+    CAVE_ASSERT(is_open());
+    const u8* source = static_cast<const u8*>(buffer);
+    usize written_byte_count = 0;
+
+    while (written_byte_count < byte_count)
+    {
+        const ssize_t result = pwrite(static_cast<int>(m_native_handle), source + written_byte_count, byte_count - written_byte_count, static_cast<off_t>(offset + written_byte_count));
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        written_byte_count += static_cast<usize>(result);
+    }
+
+    return true;
+}
+
+bool File::flush()
+{
+    CAVE_ASSERT(is_open());
+    // NOTE: `fdatasync` skips the metadata that isn't required to read the data back (such as the modification time).
+    return (fdatasync(static_cast<int>(m_native_handle)) == 0);
+}
+
+#pragma endregion
+
+#pragma region MappedFile
+
+static int get_advice(FileAccessHint hint)
+{
+    switch (hint)
+    {
+        case FileAccessHint::Normal: return MADV_NORMAL;
+        case FileAccessHint::Sequential: return MADV_SEQUENTIAL;
+        case FileAccessHint::Random: return MADV_RANDOM;
+        case FileAccessHint::WillNeed: return MADV_WILLNEED;
+    }
+
+    CAVE_ASSERT(false);
+    return MADV_NORMAL;
+}
+
+bool MappedFile::open(StringView filepath, FileMappingAccess access)
+{
+    if (m_is_open)
+        return false;
+
+    const String null_terminated_filepath = String(filepath);
+    const int flags = ((access == FileMappingAccess::ReadWrite) ? O_RDWR : O_RDONLY) | O_CLOEXEC;
+    const int file_descriptor = ::open(null_terminated_filepath.characters(), flags);
+    if (file_descriptor < 0)
+        return false;
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0)
+    {
+        ::close(file_descriptor);
+        return false;
+    }
+
+    // NOTE: Empty files can't be mapped, as `mmap` fails for zero-sized ranges.
+    const usize byte_count = static_cast<usize>(file_status.st_size);
+    void* data = nullptr;
+    if (byte_count > 0)
+    {
+        const int protection = (access == FileMappingAccess::ReadWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        data = mmap(nullptr, byte_count, protection, MAP_SHARED, file_descriptor, 0);
+    }
+
+    // NOTE: The mapping keeps a reference to the file, so the file descriptor isn't needed anymore.
+    ::close(file_descriptor);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<u8*>(data);
+    m_byte_count = byte_count;
+    m_access = access;
+    m_is_open = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!m_is_open)
+        return;
+
+    if (m_data != nullptr)
+        munmap(m_data, m_byte_count);
+
+    m_data = nullptr;
+    m_byte_count = 0;
+    m_is_open = false;
+}
+
+void MappedFile::advise(FileAccessHint hint, usize offset, usize byte_count) const
+{
+    CAVE_ASSERT(m_is_open);
+    CAVE_ASSERT(offset <= m_byte_count && byte_count <= m_byte_count - offset);
+    if (m_data == nullptr || byte_count == 0)
+        return;
+
+    // NOTE: The range passed to `madvise` must start at a page boundary. The mapping itself always starts at one.
+    static const usize s_page_size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+    const usize aligned_offset = offset & ~(s_page_size - 1);
+    madvise(m_data + aligned_offset, byte_count + (offset - aligned_offset), get_advice(hint));
+}
+
+bool MappedFile::flush()
+{
+    CAVE_ASSERT(m_is_open);
+    if (m_data == nullptr || m_access != FileMappingAccess::ReadWrite)
+        return true;
+    return (msync(m_data, m_byte_count, MS_SYNC) == 0);
+}
+
+#pragma endregion
+
+#pragma region FileSystem
+
+bool FileSystem::file_exists(StringView filepath)
+{
+    const String null_terminated_filepath = String(filepath);
+    struct stat file_status;
+    return (stat(null_terminated_filepath.characters(), &file_status) == 0 && S_ISREG(file_status.st_mode));
+}
+
+bool FileSystem::directory_exists(StringView directory_path)
+{
+    const String null_terminated_directory_path = String(directory_path);
+    struct stat directory_status;
+    return (stat(null_terminated_directory_path.characters(), &directory_status) == 0 && S_ISDIR(directory_status.st_mode));
+}
+
+bool FileSystem::create_directory(StringView directory_path)
+{
+    const String null_terminated_directory_path = String(directory_path);
+    if (mkdir(null_terminated_directory_path.characters(), 0755) == 0)
+        return true;
+    return (errno == EEXIST && directory_exists(directory_path));
+}
+
+bool FileSystem::delete_file(StringView filepath)
+{
+    const String null_terminated_filepath = String(filepath);
+    return (unlink(null_terminated_filepath.characters()) == 0);
+}
+
+bool FileSystem::enumerate_directory(StringView directory_path, Vector<DirectoryEntry>& out_entries)
+{
+    const String null_terminated_directory_path = String(directory_path);
+    DIR* directory = opendir(null_terminated_directory_path.characters());
+    if (directory == nullptr)
+        return false;
+
+    while (const dirent* directory_entry = readdir(directory))
+    {
+        if (strcmp(directory_entry->d_name, ".") == 0 || strcmp(directory_entry->d_name, "..") == 0)
+            continue;
+
+        // The size is only available through `stat`, which also resolves the type on file systems without `d_type`.
+        struct stat entry_status;
+        if (fstatat(dirfd(directory), directory_entry->d_name, &entry_status, 0) != 0)
+            continue;
+
+        out_entries.emplace();
+        DirectoryEntry& entry = out_entries.last();
+        entry.name = StringView::create_from_utf8(directory_entry->d_name);
+        entry.is_directory = S_ISDIR(entry_status.st_mode);
+        entry.byte_count = entry.is_directory ? 0 : static_cast<u64>(entry_status.st_size);
+    }
+
+    closedir(directory);
+    return true;
+}
+
+bool FileSystem::replace_file(StringView source_filepath, StringView destination_filepath)
+{
+    const String null_terminated_source_filepath = String(source_filepath);
+    const String null_terminated_destination_filepath = String(destination_filepath);
+    if (rename(null_terminated_source_filepath.characters(), null_terminated_destination_filepath.characters()) != 0)
+        return false;
+
+    //
+    // NOTE: The rename is only durable once the directory that contains the destination has been flushed. Failing to
+    // flush the directory isn't treated as an error, as the rename itself has already succeeded.
+    //
+    const char* characters = null_terminated_destination_filepath.characters();
+    const char* last_separator = strrchr(characters, '/');
+    String directory_path = "."sv;
+    if (last_separator != nullptr)
+    {
+        // The root directory is the only one whose path ends with the separator.
+        const usize directory_path_length = (last_separator != characters) ? static_cast<usize>(last_separator - characters) : 1;
+        directory_path = StringView::create_from_utf8(characters, directory_path_length);
+    }
+
+    const int directory_descriptor = ::open(directory_path.characters(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directory_descriptor >= 0)
+    {
+        fsync(directory_descriptor);
+        ::close(directory_descriptor);
+    }
+
+    return true;
+}
+
+#pragma endregion
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
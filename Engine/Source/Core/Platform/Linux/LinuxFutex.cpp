@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Platform/Futex.h>
+
+    #include <climits>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: The private futex operations skip the lookup of the shared memory mappings, as the primitives are never
+// placed in memory that is shared with other processes.
+//
+
+void Futex::wait(const std::atomic<u32>& word, u32 expected_value)
+{
+    // Interruptions (EINTR) and value mismatches (EAGAIN) are reported as spurious wake-ups.
+    syscall(SYS_futex, reinterpret_cast<const u32*>(&word), FUTEX_WAIT_PRIVATE, expected_value, nullptr, nullptr, 0);
+}
+
+void Futex::wake_one(std::atomic<u32>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void Futex::wake_all(std::atomic<u32>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
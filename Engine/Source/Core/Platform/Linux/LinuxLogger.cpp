@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Logging/Logger.h>
+
+    #include <csignal>
+    #include <cstdio>
+
+namespace CaveGame
+{
+
+struct CrashSignal
+{
+    int signal_number;
+    const char* description;
+};
+
+static constexpr CrashSignal s_crash_signals[] = {
+    { SIGSEGV, "segmentation fault (SIGSEGV)" },
+    { SIGBUS, "bus error (SIGBUS)" },
+    { SIGILL, "illegal instruction (SIGILL)" },
+    { SIGFPE, "floating point exception (SIGFPE)" },
+    { SIGABRT, "abort (SIGABRT)" },
+    { SIGTRAP, "trap (SIGTRAP)" },
+};
+
+static struct sigaction s_previous_crash_actions[ARRAY_COUNT(s_crash_signals)];
+
+//
+// The crash handler of the main thread runs on an alternate stack, so the pending records are flushed even when the
+// crash is caused by a stack overflow.
+//
+static constexpr usize s_crash_handler_stack_size = 64 * KiB;
+alignas(16) static u8 s_crash_handler_stack[s_crash_handler_stack_size];
+
+static void crash_signal_handler(int signal_number)
+{
+    const char* description = "unknown signal";
+    for (const CrashSignal& crash_signal : s_crash_signals)
+    {
+        if (crash_signal.signal_number == signal_number)
+            description = crash_signal.description;
+    }
+
+    Logger::flush_from_crash_handler(description);
+
+    //
+    // NOTE: The handler has been installed with `SA_RESETHAND`, so the default action is restored by now. Raising the
+    // signal again terminates the process as if the handler never existed (including the core dump), once the handler
+    // returns and the signal is unblocked.
+    //
+    raise(signal_number);
+}
+
+void Logger::install_crash_handler()
+{
+    stack_t alternate_stack = {};
+    alternate_stack.ss_sp = s_crash_handler_stack;
+    alternate_stack.ss_size = s_crash_handler_stack_size;
+    sigaltstack(&alternate_stack, nullptr);
+
+    struct sigaction action = {};
+    action.sa_handler = crash_signal_handler;
+    action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+
+    for (usize signal_index = 0; signal_index < ARRAY_COUNT(s_crash_signals); ++signal_index)
+        sigaction(s_crash_signals[signal_index].signal_number, &action, &s_previous_crash_actions[signal_index]);
+}
+
+void Logger::uninstall_crash_handler()
+{
+    for (usize signal_index = 0; signal_index < ARRAY_COUNT(s_crash_signals); ++signal_index)
+        sigaction(s_crash_signals[signal_index].signal_number, &s_previous_crash_actions[signal_index], nullptr);
+
+    stack_t disabled_stack = {};
+    disabled_stack.ss_flags = SS_DISABLE;
+    sigaltstack(&disabled_stack, nullptr);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Platform/PerformanceCounters.h>
+
+    #include <cstring>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+NODISCARD static bool get_perf_event_config(PerformanceCounterType counter_type, u32& out_type, u64& out_config)
+{
+    // The generic cache events are encoded as `cache | (operation << 8) | (result << 16)`.
+    static constexpr u64 cache_read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    switch (counter_type)
+    {
+        case PerformanceCounterType::Cycles:
+            out_type = PERF_TYPE_HARDWARE;
+            out_config = PERF_COUNT_HW_CPU_CYCLES;
+            return true;
+        case PerformanceCounterType::Instructions:
+            out_type = PERF_TYPE_HARDWARE;
+            out_config = PERF_COUNT_HW_INSTRUCTIONS;
+            return true;
+        case PerformanceCounterType::L1DataCacheMisses:
+            out_type = PERF_TYPE_HW_CACHE;
+            out_config = PERF_COUNT_HW_CACHE_L1D | cache_read_miss;
+            return true;
+        case PerformanceCounterType::LastLevelCacheMisses:
+            out_type = PERF_TYPE_HARDWARE;
+            out_config = PERF_COUNT_HW_CACHE_MISSES;
+            return true;
+        case PerformanceCounterType::BranchMisses:
+            out_type = PERF_TYPE_HARDWARE;
+            out_config = PERF_COUNT_HW_BRANCH_MISSES;
+            return true;
+        case PerformanceCounterType::Count: break;
+    }
+
+    return false;
+}
+
+bool PerformanceCounterGroup::open()
+{
+    if (is_open())
+    {
+        // The counter group has already been opened.
+        return false;
+    }
+
+    for (u8 counter_index = 0; counter_index < static_cast<u8>(PerformanceCounterType::Count); ++counter_index)
+    {
+        const PerformanceCounterType counter_type = static_cast<PerformanceCounterType>(counter_index);
+
+        u32 event_type;
+        u64 event_config;
+        if (!get_perf_event_config(counter_type, event_type, event_config))
+            continue;
+
+        perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = event_type;
+        attributes.config = event_config;
+
+        attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        // The whole group is enabled at once, through its leader.
+        const bool is_leader = (m_leader_native_handle < 0);
+        attributes.disabled = is_leader ? 1 : 0;
+
+        // NOTE: The counters only count the events of the calling thread (pid 0), on any processor (cpu -1).
+        const i32 native_handle = static_cast<i32>(syscall(SYS_perf_event_open, &attributes, 0, -1, m_leader_native_handle, PERF_FLAG_FD_CLOEXEC));
+        if (native_handle < 0)
+        {
+            // The counter isn't supported or isn't allowed, which isn't treated as an error.
+            continue;
+        }
+
+        if (is_leader)
+            m_leader_native_handle = native_handle;
+
+        m_native_handles[counter_index] = native_handle;
+        m_read_order[m_open_counter_count++] = counter_type;
+        m_available_counter_mask |= 1u << counter_index;
+    }
+
+    if (!is_open())
+        return false;
+
+    ioctl(m_leader_native_handle, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader_native_handle, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerformanceCounterGroup::close()
+{
+    for (i32& native_handle : m_native_handles)
+    {
+        if (native_handle >= 0)
+            ::close(native_handle);
+        native_handle = -1;
+    }
+
+    m_leader_native_handle = -1;
+    m_open_counter_count = 0;
+    m_available_counter_mask = 0;
+}
+
+bool PerformanceCounterGroup::read(PerformanceCounterSample& out_sample) const
+{
+    if (!is_open())
+        return false;
+
+    // The layout of the data returned for a group: `{ count, time_enabled, time_running, values[count] }`.
+    u64 buffer[3 + static_cast<u8>(PerformanceCounterType::Count)];
+    const ssize_t byte_count = ::read(m_leader_native_handle, buffer, sizeof(buffer));
+    if (byte_count < static_cast<ssize_t>(3 * sizeof(u64)) || buffer[0] != m_open_counter_count)
+        return false;
+
+    const u64 time_enabled = buffer[1];
+    const u64 time_running = buffer[2];
+    if (time_running == 0)
+    {
+        // The group hasn't been scheduled on the processor yet.
+        return false;
+    }
+
+    for (u32 read_index = 0; read_index < m_open_counter_count; ++read_index)
+    {
+        u64 value = buffer[3 + read_index];
+        if (time_running < time_enabled)
+            value = static_cast<u64>(static_cast<double>(value) * (static_cast<double>(time_enabled) / static_cast<double>(time_running)));
+        out_sample.values[static_cast<u8>(m_read_order[read_index])] = value;
+    }
+
+    return true;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
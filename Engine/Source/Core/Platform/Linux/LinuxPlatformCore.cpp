@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Assertion.h>
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/PlatformCore.h>
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <cstring>
+    #include <cxxabi.h>
+    #include <dlfcn.h>
+    #include <execinfo.h>
+    #include <sched.h>
+    #include <time.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// The tick counter is represented by the monotonic clock, measured in nanoseconds. On all modern kernels
+// `clock_gettime` is serviced by the vDSO, so no system call is performed.
+// https://man7.org/linux/man-pages/man7/vdso.7.html
+//
+static constexpr u64 s_nanoseconds_per_second = 1000000000;
+
+u64 PlatformCore::get_current_tick_counter()
+{
+    timespec current_time;
+    if (clock_gettime(CLOCK_MONOTONIC, &current_time) != 0)
+    {
+        // For some reason, the `clock_gettime` call failed.
+        CAVE_ASSERT(false);
+        return 0;
+    }
+
+    return static_cast<u64>(current_time.tv_sec) * s_nanoseconds_per_second + static_cast<u64>(current_time.tv_nsec);
+}
+
+u64 PlatformCore::get_tick_counter_frequency()
+{
+    return s_nanoseconds_per_second;
+}
+
+void PlatformCore::sleep_for_nanoseconds(u64 nanoseconds)
+{
+    timespec sleep_duration;
+    sleep_duration.tv_sec = static_cast<time_t>(nanoseconds / s_nanoseconds_per_second);
+    sleep_duration.tv_nsec = static_cast<long>(nanoseconds % s_nanoseconds_per_second);
+
+    // NOTE: If the sleep is interrupted by a signal it isn't resumed. The callers must not rely on the exact duration anyway.
+    clock_nanosleep(CLOCK_MONOTONIC, 0, &sleep_duration, nullptr);
+}
+
+u32 PlatformCore::get_logical_processor_count()
+{
+    // NOTE: The affinity mask of the process is respected, so containers and `taskset` limits are reported correctly.
+    cpu_set_t affinity_mask;
+    if (sched_getaffinity(0, sizeof(affinity_mask), &affinity_mask) == 0)
+        return static_cast<u32>(CPU_COUNT(&affinity_mask));
+
+    const long online_processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (online_processor_count > 0) ? static_cast<u32>(online_processor_count) : 1;
+}
+
+void PlatformCore::yield_thread()
+{
+    sched_yield();
+}
+
+u32 PlatformCore::get_current_process_id()
+{
+    return static_cast<u32>(getpid());
+}
+
+u64 PlatformCore::get_resident_memory_byte_count()
+{
+    // NOTE: The second field of `/proc/self/statm` is the resident set size, measured in pages.
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+
+    unsigned long long total_page_count = 0;
+    unsigned long long resident_page_count = 0;
+    const int read_field_count = fscanf(file, "%llu %llu", &total_page_count, &resident_page_count);
+    fclose(file);
+
+    if (read_field_count != 2)
+        return 0;
+    return static_cast<u64>(resident_page_count) * static_cast<u64>(sysconf(_SC_PAGESIZE));
+}
+
+u32 PlatformCore::capture_stack_trace(u64* out_addresses, u32 maximum_address_count)
+{
+    // NOTE: The first captured address is the return address into this function, so it is skipped.
+    constexpr u32 maximum_captured_address_count = 128;
+    void* addresses[maximum_captured_address_count + 1];
+
+    const int captured_address_count = backtrace(addresses, static_cast<int>(Math::min(maximum_address_count, maximum_captured_address_count) + 1));
+    if (captured_address_count <= 1)
+        return 0;
+
+    for (int address_index = 1; address_index < captured_address_count; ++address_index)
+        out_addresses[address_index - 1] = reinterpret_cast<uintptr>(addresses[address_index]);
+    return static_cast<u32>(captured_address_count - 1);
+}
+
+void PlatformCore::get_symbol_name(u64 address, char* out_buffer, usize buffer_size)
+{
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(address), &info) == 0)
+    {
+        snprintf(out_buffer, buffer_size, "0x%llx", static_cast<unsigned long long>(address));
+        return;
+    }
+
+    if (info.dli_sname == nullptr)
+    {
+        const char* module_name = (info.dli_fname != nullptr) ? info.dli_fname : "unknown";
+        if (const char* last_separator = strrchr(module_name, '/'))
+            module_name = last_separator + 1;
+
+        snprintf(out_buffer, buffer_size, "%s+0x%llx", module_name, static_cast<unsigned long long>(address - reinterpret_cast<uintptr>(info.dli_fbase)));
+        return;
+    }
+
+    i32 status = 0;
+    char* demangled_name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    snprintf(out_buffer, buffer_size, "%s", (status == 0 && demangled_name != nullptr) ? demangled_name : info.dli_sname);
+    free(demangled_name);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Platform/PlatformCore.h>
+    #include <Core/Platform/ProcessorTopology.h>
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <cstring>
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sched.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// The topology is read from the sysfs CPU hierarchy, as documented in:
+// https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-devices-system-cpu
+// https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-devices-system-cpu
+//
+
+// Reads a small sysfs file into the buffer, as a null-terminated string. Returns false if the file can't be read.
+NODISCARD static bool read_sysfs_file(const char* filepath, char* buffer, usize buffer_size)
+{
+    const int file_descriptor = open(filepath, O_RDONLY | O_CLOEXEC);
+    if (file_descriptor < 0)
+        return false;
+
+    const ssize_t read_byte_count = read(file_descriptor, buffer, buffer_size - 1);
+    close(file_descriptor);
+    if (read_byte_count <= 0)
+        return false;
+
+    buffer[read_byte_count] = '\0';
+    return true;
+}
+
+//
+// Reads a file that contains a processor list (such as "0-3,8-11") and returns the first processor in the list.
+// As the lists are sorted, the first processor identifies the whole group.
+//
+NODISCARD static bool read_first_processor_of_list(const char* filepath, u64& out_processor_index)
+{
+    char buffer[256];
+    if (!read_sysfs_file(filepath, buffer, sizeof(buffer)))
+        return false;
+
+    char* number_end = nullptr;
+    out_processor_index = strtoull(buffer, &number_end, 10);
+    return (number_end != buffer);
+}
+
+NODISCARD static bool read_integer(const char* filepath, u64& out_value)
+{
+    char buffer[64];
+    if (!read_sysfs_file(filepath, buffer, sizeof(buffer)))
+        return false;
+
+    char* number_end = nullptr;
+    out_value = strtoull(buffer, &number_end, 10);
+    return (number_end != buffer);
+}
+
+// The processor directory contains a `nodeN` link to the NUMA node the processor belongs to.
+static void read_numa_node(u32 processor_index, u64& out_numa_node_id)
+{
+    char directory_path[128];
+    snprintf(directory_path, sizeof(directory_path), "/sys/devices/system/cpu/cpu%u", processor_index);
+
+    DIR* directory = opendir(directory_path);
+    if (!directory)
+        return;
+
+    while (const dirent* entry = readdir(directory))
+    {
+        if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+        {
+            out_numa_node_id = strtoull(entry->d_name + 4, nullptr, 10);
+            break;
+        }
+    }
+
+    closedir(directory);
+}
+
+static void read_cache_groups(u32 processor_index, Detail::RawLogicalProcessorInfo& raw_processor)
+{
+    char path[192];
+    for (u32 cache_index = 0; cache_index < 16; ++cache_index)
+    {
+        u64 cache_level;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", processor_index, cache_index);
+        if (!read_integer(path, cache_level))
+            break;
+
+        char cache_type[32];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", processor_index, cache_index);
+        if (!read_sysfs_file(path, cache_type, sizeof(cache_type)) || strncmp(cache_type, "Instruction", 11) == 0)
+            continue;
+
+        u64 first_sharing_processor;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", processor_index, cache_index);
+        if (!read_first_processor_of_list(path, first_sharing_processor))
+            continue;
+
+        if (cache_level == 2)
+            raw_processor.l2_cache_id = first_sharing_processor;
+        else if (cache_level == 3)
+            raw_processor.l3_cache_id = first_sharing_processor;
+    }
+}
+
+bool PlatformCore::query_processor_topology(ProcessorTopology& out_topology)
+{
+    cpu_set_t affinity_mask;
+    if (sched_getaffinity(0, sizeof(affinity_mask), &affinity_mask) != 0)
+    {
+        CPU_ZERO(&affinity_mask);
+        for (u32 processor_index = 0; processor_index < get_logical_processor_count(); ++processor_index)
+            CPU_SET(processor_index, &affinity_mask);
+    }
+
+    bool is_topology_complete = true;
+    Vector<Detail::RawLogicalProcessorInfo> raw_processors;
+
+    for (u32 processor_index = 0; processor_index < CPU_SETSIZE && processor_index < ProcessorSet::maximum_processor_count; ++processor_index)
+    {
+        if (!CPU_ISSET(processor_index, &affinity_mask))
+            continue;
+
+        // The defaults describe a processor that doesn't share anything, which is used when sysfs isn't available.
+        Detail::RawLogicalProcessorInfo raw_processor = {};
+        raw_processor.processor_index = processor_index;
+        raw_processor.physical_core_id = processor_index;
+        raw_processor.l2_cache_id = processor_index;
+
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", processor_index);
+        if (!read_first_processor_of_list(path, raw_processor.physical_core_id))
+            is_topology_complete = false;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", processor_index);
+        if (!read_integer(path, raw_processor.package_id))
+            is_topology_complete = false;
+
+        // Without a dedicated L3 cache entry, the processors of a package are assumed to share the last level cache.
+        raw_processor.l3_cache_id = raw_processor.package_id;
+        read_cache_groups(processor_index, raw_processor);
+
+        // NOTE: Kernels compiled without NUMA support don't expose the node links, in which case there is a single node.
+        read_numa_node(processor_index, raw_processor.numa_node_id);
+
+        raw_processors.add(raw_processor);
+    }
+
+    Detail::build_processor_topology(raw_processors, out_topology);
+    return is_topology_complete;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
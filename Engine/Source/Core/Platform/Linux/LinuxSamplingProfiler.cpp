@@ -0,0 +1,585 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Containers/String.h>
+    #include <Core/Containers/Vector.h>
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/PlatformCore.h>
+    #include <Core/Profiling/SamplingProfiler.h>
+    #include <Core/Threading/ScopedLock.h>
+    #include <Core/Threading/SpinLock.h>
+
+    #include <algorithm>
+    #include <atomic>
+    #include <csignal>
+    #include <cstdio>
+    #include <cstring>
+    #include <ctime>
+    #include <pthread.h>
+    #include <sys/syscall.h>
+    #include <ucontext.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+static constexpr u32 s_maximum_sampled_thread_count = 128;
+static constexpr u32 s_maximum_thread_name_length = 31;
+
+struct SampleSlot
+{
+    //
+    // The number of frames, followed by the addresses of the frames (the interrupted instruction first).
+    // NOTE: The words are atomic only because a slot might be read while the signal handler overwrites it.
+    //
+    std::atomic<u64> words[1 + SamplingProfiler::maximum_stack_depth];
+};
+
+// The ring buffer of a thread. Written only by the signal handler that runs on the thread.
+struct SampleRingBuffer
+{
+    SampleSlot slots[SamplingProfiler::sample_capacity_per_thread];
+
+    // The total number of samples that have ever been written into the buffer.
+    alignas(64) std::atomic<u64> write_index { 0 };
+
+    // The number of samples that have been moved into the aggregated call stack table.
+    u64 processed_index { 0 };
+};
+
+struct SampledThread
+{
+    pid_t thread_id { 0 };
+    clockid_t cpu_clock_id {};
+    timer_t timer {};
+    bool has_timer { false };
+
+    // The stack walk never reads memory above the top of the stack of the thread.
+    uintptr stack_high_address { 0 };
+
+    // Allocated when the thread is sampled for the first time.
+    std::atomic<SampleRingBuffer*> buffer { nullptr };
+
+    u32 thread_index { 0 };
+    char name[s_maximum_thread_name_length + 1] {};
+};
+
+struct AggregatedStack
+{
+    u64 hash;
+    u32 thread_index;
+    u32 depth;
+    usize first_frame_index;
+    u64 sample_count;
+};
+
+struct SamplingProfilerData
+{
+    // Protects everything except the atomic flag, which is read by the signal handler.
+    SpinLock lock;
+    std::atomic<bool> is_running { false };
+    bool is_signal_handler_installed { false };
+    u32 sampling_frequency { SamplingProfiler::default_sampling_frequency };
+
+    SampledThread* threads[s_maximum_sampled_thread_count] {};
+    u32 thread_count { 0 };
+
+    // The aggregated call stacks. The frames of all stacks are stored in a single pool.
+    Vector<AggregatedStack> stacks;
+    Vector<u64> frame_pool;
+    // Open-addressing hash table that stores `stack index + 1`, or zero for the empty slots.
+    Vector<u32> stack_table;
+
+    u64 sample_count { 0 };
+    u64 lost_sample_count { 0 };
+};
+
+static SamplingProfilerData s_sampling_profiler;
+static thread_local SampledThread* t_sampled_thread = nullptr;
+
+#pragma region Signal Handler
+
+//
+// NOTE: The handler can interrupt the thread at any point, so it must only perform async-signal-safe operations:
+// no locks, no memory allocations and no library calls.
+//
+static void handle_profiling_signal(int, siginfo_t*, void* user_context)
+{
+    SampledThread* sampled_thread = t_sampled_thread;
+    if (sampled_thread == nullptr || !s_sampling_profiler.is_running.load(std::memory_order_relaxed))
+        return;
+
+    SampleRingBuffer* buffer = sampled_thread->buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr)
+        return;
+
+    const ucontext_t* context = static_cast<const ucontext_t*>(user_context);
+    const uintptr instruction_address = static_cast<uintptr>(context->uc_mcontext.gregs[REG_RIP]);
+    uintptr frame_address = static_cast<uintptr>(context->uc_mcontext.gregs[REG_RBP]);
+    // NOTE: The stack range reported for the main thread includes the pages the stack can still grow into, which
+    // aren't mapped yet. Every live frame is above the stack pointer of the interrupted code, which is mapped.
+    const uintptr stack_low_address = static_cast<uintptr>(context->uc_mcontext.gregs[REG_RSP]);
+
+    const u64 write_index = buffer->write_index.load(std::memory_order_relaxed);
+
+    // NOTE: The same publication protocol as for the profiler events (see `Profiler::record_event`).
+    std::atomic_thread_fence(std::memory_order_release);
+    SampleSlot& slot = buffer->slots[write_index % SamplingProfiler::sample_capacity_per_thread];
+
+    u64 depth = 0;
+    slot.words[1 + depth++].store(instruction_address, std::memory_order_relaxed);
+
+    //
+    // Every frame starts with the frame pointer of the caller, followed by the return address. If the interrupted code
+    // doesn't maintain the frame pointer, the register holds an arbitrary value, thus every frame is validated against
+    // the bounds of the stack before it is read.
+    //
+    while (depth < SamplingProfiler::maximum_stack_depth)
+    {
+        if (frame_address < stack_low_address || frame_address + 2 * sizeof(uintptr) > sampled_thread->stack_high_address ||
+            (frame_address % sizeof(uintptr)) != 0)
+            break;
+
+        const uintptr* frame = reinterpret_cast<const uintptr*>(frame_address);
+        const uintptr caller_frame_address = frame[0];
+        const uintptr return_address = frame[1];
+        if (return_address == 0)
+            break;
+
+        slot.words[1 + depth++].store(return_address, std::memory_order_relaxed);
+
+        // The stack grows downwards, so the frames of the callers are always at higher addresses.
+        if (caller_frame_address <= frame_address)
+            break;
+        frame_address = caller_frame_address;
+    }
+
+    slot.words[0].store(depth, std::memory_order_relaxed);
+    buffer->write_index.store(write_index + 1, std::memory_order_release);
+}
+
+#pragma endregion
+
+#pragma region Threads
+
+// Must be called with the lock held.
+static void start_sampling_thread(SampledThread& sampled_thread)
+{
+    if (sampled_thread.has_timer)
+        return;
+
+    if (sampled_thread.buffer.load(std::memory_order_relaxed) == nullptr)
+        sampled_thread.buffer.store(new SampleRingBuffer(), std::memory_order_release);
+
+    sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    // NOTE: Older versions of glibc don't define the `sigev_notify_thread_id` alias.
+    event._sigev_un._tid = sampled_thread.thread_id;
+
+    // NOTE: Creating the timer fails if the thread has exited, in which case it simply isn't sampled.
+    if (timer_create(sampled_thread.cpu_clock_id, &event, &sampled_thread.timer) != 0)
+        return;
+
+    const u64 period_nanoseconds = 1000000000ull / s_sampling_profiler.sampling_frequency;
+    itimerspec timer_specification;
+    timer_specification.it_interval.tv_sec = static_cast<time_t>(period_nanoseconds / 1000000000ull);
+    timer_specification.it_interval.tv_nsec = static_cast<long>(period_nanoseconds % 1000000000ull);
+    timer_specification.it_value = timer_specification.it_interval;
+
+    if (timer_settime(sampled_thread.timer, 0, &timer_specification, nullptr) != 0)
+    {
+        timer_delete(sampled_thread.timer);
+        return;
+    }
+
+    sampled_thread.has_timer = true;
+}
+
+// Must be called with the lock held.
+static void stop_sampling_thread(SampledThread& sampled_thread)
+{
+    if (!sampled_thread.has_timer)
+        return;
+
+    timer_delete(sampled_thread.timer);
+    sampled_thread.has_timer = false;
+}
+
+void SamplingProfiler::register_current_thread(StringView name)
+{
+    SampledThread* sampled_thread = t_sampled_thread;
+    const bool is_registered = (sampled_thread != nullptr);
+
+    if (!is_registered)
+    {
+        sampled_thread = new SampledThread();
+        sampled_thread->thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+
+        pthread_attr_t attributes;
+        void* stack_address = nullptr;
+        usize stack_size = 0;
+        if (pthread_getcpuclockid(pthread_self(), &sampled_thread->cpu_clock_id) != 0 || pthread_getattr_np(pthread_self(), &attributes) != 0)
+        {
+            delete sampled_thread;
+            return;
+        }
+
+        pthread_attr_getstack(&attributes, &stack_address, &stack_size);
+        pthread_attr_destroy(&attributes);
+        sampled_thread->stack_high_address = reinterpret_cast<uintptr>(stack_address) + stack_size;
+    }
+
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+
+    const usize name_length = Math::min(name.byte_count(), static_cast<usize>(s_maximum_thread_name_length));
+    memcpy(sampled_thread->name, name.characters(), name_length);
+    sampled_thread->name[name_length] = '\0';
+
+    if (is_registered)
+        return;
+
+    if (s_sampling_profiler.thread_count >= s_maximum_sampled_thread_count)
+    {
+        delete sampled_thread;
+        return;
+    }
+
+    sampled_thread->thread_index = s_sampling_profiler.thread_count;
+    s_sampling_profiler.threads[s_sampling_profiler.thread_count++] = sampled_thread;
+    t_sampled_thread = sampled_thread;
+
+    if (s_sampling_profiler.is_running.load(std::memory_order_relaxed))
+        start_sampling_thread(*sampled_thread);
+}
+
+#pragma endregion
+
+#pragma region Aggregation
+
+NODISCARD static u64 hash_stack(u32 thread_index, const u64* frames, u32 depth)
+{
+    // FNV-1a, applied to whole words.
+    u64 hash = 0xCBF29CE484222325ull ^ thread_index;
+    for (u32 frame_index = 0; frame_index < depth; ++frame_index)
+        hash = (hash ^ frames[frame_index]) * 0x100000001B3ull;
+    return hash;
+}
+
+// Must be called with the lock held.
+static void rebuild_stack_table(usize slot_count)
+{
+    Vector<u32>& stack_table = s_sampling_profiler.stack_table;
+    stack_table.clear();
+    stack_table.set_count(slot_count, 0);
+
+    const usize slot_mask = slot_count - 1;
+    for (usize stack_index = 0; stack_index < s_sampling_profiler.stacks.count(); ++stack_index)
+    {
+        usize slot_index = s_sampling_profiler.stacks[stack_index].hash & slot_mask;
+        while (stack_table[slot_index] != 0)
+            slot_index = (slot_index + 1) & slot_mask;
+        stack_table[slot_index] = static_cast<u32>(stack_index + 1);
+    }
+}
+
+// Must be called with the lock held.
+static void aggregate_stack(u32 thread_index, const u64* frames, u32 depth)
+{
+    // Keep the load factor of the table below one half.
+    if ((s_sampling_profiler.stacks.count() + 1) * 2 > s_sampling_profiler.stack_table.count())
+        rebuild_stack_table(Math::max(s_sampling_profiler.stack_table.count() * 2, static_cast<usize>(1024)));
+
+    const u64 hash = hash_stack(thread_index, frames, depth);
+    const usize slot_mask = s_sampling_profiler.stack_table.count() - 1;
+    usize slot_index = hash & slot_mask;
+
+    while (const u32 stack_index_plus_one = s_sampling_profiler.stack_table[slot_index])
+    {
+        AggregatedStack& stack = s_sampling_profiler.stacks[stack_index_plus_one - 1];
+        if (stack.hash == hash && stack.thread_index == thread_index && stack.depth == depth &&
+            memcmp(s_sampling_profiler.frame_pool.elements() + stack.first_frame_index, frames, depth * sizeof(u64)) == 0)
+        {
+            ++stack.sample_count;
+            return;
+        }
+
+        slot_index = (slot_index + 1) & slot_mask;
+    }
+
+    s_sampling_profiler.stacks.add({ hash, thread_index, depth, s_sampling_profiler.frame_pool.count(), 1 });
+    for (u32 frame_index = 0; frame_index < depth; ++frame_index)
+        s_sampling_profiler.frame_pool.add(frames[frame_index]);
+    s_sampling_profiler.stack_table[slot_index] = static_cast<u32>(s_sampling_profiler.stacks.count());
+}
+
+// Must be called with the lock held.
+static void process_thread_samples(SampledThread& sampled_thread)
+{
+    static constexpr u64 capacity = SamplingProfiler::sample_capacity_per_thread;
+
+    SampleRingBuffer* buffer = sampled_thread.buffer.load(std::memory_order_relaxed);
+    if (buffer == nullptr)
+        return;
+
+    const u64 end_index = buffer->write_index.load(std::memory_order_acquire);
+    u64 begin_index = buffer->processed_index;
+    if (end_index - begin_index > capacity)
+    {
+        s_sampling_profiler.lost_sample_count += (end_index - capacity) - begin_index;
+        begin_index = end_index - capacity;
+    }
+
+    u64 frames[SamplingProfiler::maximum_stack_depth];
+    for (u64 sample_index = begin_index; sample_index < end_index; ++sample_index)
+    {
+        const SampleSlot& slot = buffer->slots[sample_index % capacity];
+        const u32 depth = static_cast<u32>(Math::min(slot.words[0].load(std::memory_order_relaxed), static_cast<u64>(SamplingProfiler::maximum_stack_depth)));
+        for (u32 frame_index = 0; frame_index < depth; ++frame_index)
+        {
+            frames[frame_index] = slot.words[1 + frame_index].load(std::memory_order_relaxed);
+
+            // The return addresses point after the call instruction, which might belong to the next function or line.
+            if (frame_index > 0)
+                --frames[frame_index];
+        }
+
+        // Discard the sample if the signal handler might have overwritten its slot while it was copied.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer->write_index.load(std::memory_order_relaxed) >= sample_index + capacity)
+        {
+            ++s_sampling_profiler.lost_sample_count;
+            continue;
+        }
+
+        aggregate_stack(sampled_thread.thread_index, frames, depth);
+        ++s_sampling_profiler.sample_count;
+    }
+
+    buffer->processed_index = end_index;
+}
+
+#pragma endregion
+
+bool SamplingProfiler::start(u32 sampling_frequency)
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    if (s_sampling_profiler.is_running.load(std::memory_order_relaxed))
+    {
+        // The sampling profiler is already running.
+        return false;
+    }
+
+    if (!s_sampling_profiler.is_signal_handler_installed)
+    {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = handle_profiling_signal;
+        // NOTE: The interrupted system calls are restarted, so the sampling is transparent to the rest of the engine.
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGPROF, &action, nullptr) != 0)
+            return false;
+        s_sampling_profiler.is_signal_handler_installed = true;
+    }
+
+    s_sampling_profiler.sampling_frequency = Math::max(sampling_frequency, 1u);
+    s_sampling_profiler.is_running.store(true, std::memory_order_relaxed);
+
+    for (u32 thread_index = 0; thread_index < s_sampling_profiler.thread_count; ++thread_index)
+        start_sampling_thread(*s_sampling_profiler.threads[thread_index]);
+    return true;
+}
+
+void SamplingProfiler::stop()
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    s_sampling_profiler.is_running.store(false, std::memory_order_relaxed);
+
+    for (u32 thread_index = 0; thread_index < s_sampling_profiler.thread_count; ++thread_index)
+        stop_sampling_thread(*s_sampling_profiler.threads[thread_index]);
+}
+
+void SamplingProfiler::shutdown()
+{
+    stop();
+    reset();
+
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    if (s_sampling_profiler.is_signal_handler_installed)
+    {
+        // NOTE: Signals that are still pending are ignored from now on.
+        signal(SIGPROF, SIG_IGN);
+        s_sampling_profiler.is_signal_handler_installed = false;
+    }
+
+    for (u32 thread_index = 0; thread_index < s_sampling_profiler.thread_count; ++thread_index)
+    {
+        SampledThread* sampled_thread = s_sampling_profiler.threads[thread_index];
+        delete sampled_thread->buffer.load(std::memory_order_relaxed);
+        delete sampled_thread;
+        s_sampling_profiler.threads[thread_index] = nullptr;
+    }
+
+    s_sampling_profiler.thread_count = 0;
+    t_sampled_thread = nullptr;
+}
+
+bool SamplingProfiler::is_running()
+{
+    return s_sampling_profiler.is_running.load(std::memory_order_relaxed);
+}
+
+void SamplingProfiler::process_samples()
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    for (u32 thread_index = 0; thread_index < s_sampling_profiler.thread_count; ++thread_index)
+        process_thread_samples(*s_sampling_profiler.threads[thread_index]);
+}
+
+u64 SamplingProfiler::get_sample_count()
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    return s_sampling_profiler.sample_count;
+}
+
+u64 SamplingProfiler::get_lost_sample_count()
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+    return s_sampling_profiler.lost_sample_count;
+}
+
+void SamplingProfiler::reset()
+{
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+
+    // The pending samples are discarded as well.
+    for (u32 thread_index = 0; thread_index < s_sampling_profiler.thread_count; ++thread_index)
+    {
+        if (SampleRingBuffer* buffer = s_sampling_profiler.threads[thread_index]->buffer.load(std::memory_order_relaxed))
+            buffer->processed_index = buffer->write_index.load(std::memory_order_acquire);
+    }
+
+    s_sampling_profiler.stacks.clear_and_shrink();
+    s_sampling_profiler.frame_pool.clear_and_shrink();
+    s_sampling_profiler.stack_table.clear_and_shrink();
+    s_sampling_profiler.sample_count = 0;
+    s_sampling_profiler.lost_sample_count = 0;
+}
+
+#pragma region Folded Stacks
+
+static void append_characters(Vector<char>& out_characters, const char* characters)
+{
+    for (const char* character = characters; *character != '\0'; ++character)
+    {
+        // The semicolons separate the frames in the folded format, so they can't appear in the symbol names.
+        out_characters.add((*character == ';' || *character == '\n') ? ':' : *character);
+    }
+}
+
+// Appends the null-terminated name of the function that contains the address.
+static void append_symbol_name(Vector<char>& out_characters, u64 address)
+{
+    char name_buffer[512];
+    PlatformCore::get_symbol_name(address, name_buffer, sizeof(name_buffer));
+    append_characters(out_characters, name_buffer);
+    out_characters.add('\0');
+}
+
+bool SamplingProfiler::write_folded_stacks(StringView filepath)
+{
+    process_samples();
+
+    const String filepath_string = String(filepath);
+    FILE* file = fopen(filepath_string.characters(), "wb");
+    if (!file)
+        return false;
+
+    ScopedLock<SpinLock> lock(s_sampling_profiler.lock);
+
+    // Symbolizing an address is slow, so every distinct address is only symbolized once.
+    Vector<u64> addresses;
+    for (const u64 address : s_sampling_profiler.frame_pool)
+        addresses.add(address);
+
+    u64* addresses_begin = addresses.elements();
+    std::sort(addresses_begin, addresses_begin + addresses.count());
+    addresses.set_count_uninitialized(static_cast<usize>(std::unique(addresses_begin, addresses_begin + addresses.count()) - addresses_begin));
+
+    Vector<char> symbol_names;
+    Vector<usize> symbol_name_offsets;
+    for (const u64 address : addresses)
+    {
+        symbol_name_offsets.add(symbol_names.count());
+        append_symbol_name(symbol_names, address);
+    }
+
+    //
+    // The stacks are aggregated by address, so the samples taken at different instructions of the same functions are
+    // stored as different stacks. The folded lines are merged once symbolized, thus every line is unique.
+    //
+    struct FoldedLine
+    {
+        usize characters_offset;
+        u64 sample_count;
+    };
+
+    Vector<char> line_characters;
+    Vector<FoldedLine> lines;
+    for (const AggregatedStack& stack : s_sampling_profiler.stacks)
+    {
+        lines.add({ line_characters.count(), stack.sample_count });
+        append_characters(line_characters, s_sampling_profiler.threads[stack.thread_index]->name);
+
+        // The frames are stored starting with the interrupted function, while the folded format starts with the root.
+        for (u32 frame_index = stack.depth; frame_index > 0; --frame_index)
+        {
+            const u64 address = s_sampling_profiler.frame_pool[stack.first_frame_index + frame_index - 1];
+            const usize symbol_index = static_cast<usize>(std::lower_bound(addresses.elements(), addresses.elements() + addresses.count(), address) - addresses.elements());
+
+            line_characters.add(';');
+            append_characters(line_characters, symbol_names.elements() + symbol_name_offsets[symbol_index]);
+        }
+
+        line_characters.add('\0');
+    }
+
+    const char* line_characters_begin = line_characters.elements();
+    std::sort(
+        lines.elements(),
+        lines.elements() + lines.count(),
+        [line_characters_begin](const FoldedLine& a, const FoldedLine& b)
+        { return strcmp(line_characters_begin + a.characters_offset, line_characters_begin + b.characters_offset) < 0; }
+    );
+
+    for (usize line_index = 0; line_index < lines.count();)
+    {
+        const char* line = line_characters_begin + lines[line_index].characters_offset;
+        u64 sample_count = 0;
+        for (; line_index < lines.count() && strcmp(line_characters_begin + lines[line_index].characters_offset, line) == 0; ++line_index)
+            sample_count += lines[line_index].sample_count;
+
+        fprintf(file, "%s %llu\n", line, static_cast<unsigned long long>(sample_count));
+    }
+
+    const bool is_successful = (ferror(file) == 0);
+    fclose(file);
+    return is_successful;
+}
+
+#pragma endregion
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Platform/SharedMemory.h>
+
+    #include <cstdio>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: The POSIX shared memory object names must start with a slash and contain no other slashes. The slash is
+// prepended here, so the names are the same on all platforms.
+//
+static constexpr usize s_maximum_object_name_length = 255;
+
+static void get_shared_memory_object_name(StringView name, char (&out_object_name)[s_maximum_object_name_length + 1])
+{
+    snprintf(out_object_name, sizeof(out_object_name), "/%.*s", static_cast<int>(name.byte_count()), name.characters());
+}
+
+bool SharedMemoryRegion::create(StringView name, usize byte_count)
+{
+    if (m_data != nullptr || byte_count == 0)
+        return false;
+
+    char object_name[s_maximum_object_name_length + 1];
+    get_shared_memory_object_name(name, object_name);
+    const int file_descriptor = shm_open(object_name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (file_descriptor < 0)
+        return false;
+
+    // The new pages of the object are zero-filled by the kernel.
+    if (ftruncate(file_descriptor, static_cast<off_t>(byte_count)) != 0)
+    {
+        ::close(file_descriptor);
+        shm_unlink(object_name);
+        return false;
+    }
+
+    void* data = mmap(nullptr, byte_count, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    // NOTE: The mapping keeps the object alive, so the file descriptor isn't needed anymore.
+    ::close(file_descriptor);
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(object_name);
+        return false;
+    }
+
+    m_data = data;
+    m_byte_count = byte_count;
+    m_is_owner = true;
+    m_name = StringView::create_from_utf8(object_name);
+    return true;
+}
+
+bool SharedMemoryRegion::open(StringView name)
+{
+    if (m_data != nullptr)
+        return false;
+
+    char object_name[s_maximum_object_name_length + 1];
+    get_shared_memory_object_name(name, object_name);
+    const int file_descriptor = shm_open(object_name, O_RDONLY, 0);
+    if (file_descriptor < 0)
+        return false;
+
+    struct stat object_status;
+    if (fstat(file_descriptor, &object_status) != 0 || object_status.st_size <= 0)
+    {
+        ::close(file_descriptor);
+        return false;
+    }
+
+    const usize byte_count = static_cast<usize>(object_status.st_size);
+    void* data = mmap(nullptr, byte_count, PROT_READ, MAP_SHARED, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = data;
+    m_byte_count = byte_count;
+    m_is_owner = false;
+    return true;
+}
+
+void SharedMemoryRegion::close()
+{
+    if (m_data == nullptr)
+        return;
+
+    munmap(m_data, m_byte_count);
+    if (m_is_owner)
+        shm_unlink(m_name.characters());
+
+    m_data = nullptr;
+    m_byte_count = 0;
+    m_is_owner = false;
+    m_name = String();
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/Thread.h>
+
+    #include <cstring>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <semaphore.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+namespace CaveGame
+{
+
+//
+// The native thread handle stores the `pthread_t` value, which is an integer on Linux.
+// NOTE: A valid `pthread_t` is never zero, so the null handle still represents a thread that hasn't been created.
+//
+static_assert(sizeof(pthread_t) <= sizeof(void*));
+
+// The maximum length of a thread name, including the null terminator, enforced by the kernel.
+static constexpr usize s_maximum_thread_name_size = 16;
+
+struct LinuxThreadStartData
+{
+    Thread::EntryPoint entry_point;
+    void* user_data;
+
+    // The description is copied, as the name might not outlive the call to `Thread::create`.
+    char name[s_maximum_thread_name_size];
+    ThreadPriority priority;
+    ProcessorSet affinity;
+};
+
+static void* linux_thread_start_routine(void* parameter)
+{
+    LinuxThreadStartData* start_data = static_cast<LinuxThreadStartData*>(parameter);
+
+    ThreadDescription description;
+    description.name = StringView::create_from_utf8(start_data->name);
+    description.priority = start_data->priority;
+    description.affinity = start_data->affinity;
+    Thread::apply_current_thread_description(description);
+
+    const Thread::EntryPoint entry_point = start_data->entry_point;
+    void* user_data = start_data->user_data;
+    delete start_data;
+
+    entry_point(user_data);
+    return nullptr;
+}
+
+bool Thread::create(EntryPoint entry_point, void* user_data, const ThreadDescription& description)
+{
+    if (m_native_handle != nullptr)
+    {
+        // The thread has already been created.
+        return false;
+    }
+
+    LinuxThreadStartData* start_data = new LinuxThreadStartData();
+    start_data->entry_point = entry_point;
+    start_data->user_data = user_data;
+    start_data->priority = description.priority;
+    start_data->affinity = description.affinity;
+
+    const usize name_byte_count = (description.name.byte_count() < s_maximum_thread_name_size) ? description.name.byte_count() : (s_maximum_thread_name_size - 1);
+    memcpy(start_data->name, description.name.characters(), name_byte_count);
+    start_data->name[name_byte_count] = '\0';
+
+    pthread_t thread_handle;
+    if (pthread_create(&thread_handle, nullptr, linux_thread_start_routine, start_data) != 0)
+    {
+        delete start_data;
+        return false;
+    }
+
+    m_native_handle = reinterpret_cast<void*>(static_cast<uintptr>(thread_handle));
+    return true;
+}
+
+void Thread::join()
+{
+    if (m_native_handle == nullptr)
+    {
+        // The thread hasn't been created or has already been joined.
+        return;
+    }
+
+    const pthread_t thread_handle = static_cast<pthread_t>(reinterpret_cast<uintptr>(m_native_handle));
+    pthread_join(thread_handle, nullptr);
+    m_native_handle = nullptr;
+}
+
+void Thread::set_current_thread_name(StringView name)
+{
+    char null_terminated_name[s_maximum_thread_name_size];
+    const usize name_byte_count = (name.byte_count() < s_maximum_thread_name_size) ? name.byte_count() : (s_maximum_thread_name_size - 1);
+    memcpy(null_terminated_name, name.characters(), name_byte_count);
+    null_terminated_name[name_byte_count] = '\0';
+
+    pthread_setname_np(pthread_self(), null_terminated_name);
+}
+
+bool Thread::set_current_thread_priority(ThreadPriority priority)
+{
+    //
+    // Threads scheduled with the default policy (`SCHED_OTHER`) are prioritized using their nice value, which on Linux
+    // is a per-thread attribute (despite what POSIX specifies).
+    // https://man7.org/linux/man-pages/man7/sched.7.html
+    //
+    int nice_value = 0;
+    switch (priority)
+    {
+        case ThreadPriority::Low: nice_value = 5; break;
+        case ThreadPriority::Normal: nice_value = 0; break;
+        case ThreadPriority::High: nice_value = -5; break;
+        case ThreadPriority::Highest: nice_value = -10; break;
+    }
+
+    const id_t thread_id = static_cast<id_t>(syscall(SYS_gettid));
+    return (setpriority(PRIO_PROCESS, thread_id, nice_value) == 0);
+}
+
+bool Thread::set_current_thread_affinity(const ProcessorSet& affinity)
+{
+    if (affinity.is_empty())
+        return false;
+
+    cpu_set_t affinity_mask;
+    CPU_ZERO(&affinity_mask);
+    for (u32 processor_index = 0; processor_index < ProcessorSet::maximum_processor_count && processor_index < CPU_SETSIZE; ++processor_index)
+    {
+        if (affinity.contains(processor_index))
+            CPU_SET(processor_index, &affinity_mask);
+    }
+
+    return (pthread_setaffinity_np(pthread_self(), sizeof(affinity_mask), &affinity_mask) == 0);
+}
+
+bool Semaphore::initialize(u32 initial_count)
+{
+    if (m_native_handle != nullptr)
+    {
+        // The semaphore has already been initialized.
+        return false;
+    }
+
+    sem_t* semaphore = new sem_t();
+    if (sem_init(semaphore, 0, initial_count) != 0)
+    {
+        delete semaphore;
+        return false;
+    }
+
+    m_native_handle = semaphore;
+    return true;
+}
+
+void Semaphore::shutdown()
+{
+    if (m_native_handle == nullptr)
+    {
+        // The semaphore has already been shut down.
+        return;
+    }
+
+    sem_t* semaphore = static_cast<sem_t*>(m_native_handle);
+    sem_destroy(semaphore);
+    delete semaphore;
+    m_native_handle = nullptr;
+}
+
+void Semaphore::wait()
+{
+    CAVE_ASSERT(m_native_handle != nullptr);
+    sem_t* semaphore = static_cast<sem_t*>(m_native_handle);
+
+    // NOTE: The wait is interrupted when a signal is delivered to the thread, in which case it must be restarted.
+    while (sem_wait(semaphore) != 0)
+        ;
+}
+
+void Semaphore::signal(u32 count)
+{
+    CAVE_ASSERT(m_native_handle != nullptr);
+    sem_t* semaphore = static_cast<sem_t*>(m_native_handle);
+
+    for (u32 index = 0; index < count; ++index)
+        sem_post(semaphore);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
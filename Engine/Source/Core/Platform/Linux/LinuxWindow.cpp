@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/Window.h>
+
+    #include <signal.h>
+    #include <stdlib.h>
+
+//
+// The Linux backend is headless: it is used by the dedicated servers and the benchmarking machines, which have no
+// display attached. No native window is created and the event queue only contains synthetic events:
+//   - SIGINT and SIGTERM request the window to close, which allows the game loop to shut down cleanly.
+//   - If the `CAVE_HEADLESS_FRAME_LIMIT` environment variable is set, the window requests to close after the
+//     event queue has been processed the given number of times (once per frame). Used by the benchmarks.
+//
+
+namespace CaveGame
+{
+
+// The reported client area size. Matches the most common resolution of the machines the game is profiled on.
+static constexpr u32 s_headless_client_area_width = 1920;
+static constexpr u32 s_headless_client_area_height = 1080;
+
+//
+// There is no native window object, but the native handle is used to determine whether or not the window is
+// initialized. Thus, it is set to the address of this placeholder.
+//
+static u8 s_headless_native_handle_placeholder;
+
+static volatile sig_atomic_t s_close_signal_received = 0;
+static u64 s_remaining_frame_count = 0;
+static bool s_has_frame_limit = false;
+
+static void linux_close_signal_handler(int)
+{
+    s_close_signal_received = 1;
+}
+
+static void linux_install_close_signal_handlers()
+{
+    struct sigaction signal_action = {};
+    signal_action.sa_handler = linux_close_signal_handler;
+    sigemptyset(&signal_action.sa_mask);
+
+    sigaction(SIGINT, &signal_action, nullptr);
+    sigaction(SIGTERM, &signal_action, nullptr);
+}
+
+bool Window::initialize()
+{
+    if (m_native_handle != nullptr)
+    {
+        // The window has already been initialized.
+        return false;
+    }
+
+    linux_install_close_signal_handlers();
+
+    s_has_frame_limit = false;
+    if (const char* frame_limit_string = getenv("CAVE_HEADLESS_FRAME_LIMIT"))
+    {
+        char* frame_limit_end = nullptr;
+        const unsigned long long frame_limit = strtoull(frame_limit_string, &frame_limit_end, 10);
+        if (frame_limit_end != frame_limit_string && *frame_limit_end == '\0')
+        {
+            s_remaining_frame_count = static_cast<u64>(frame_limit);
+            s_has_frame_limit = true;
+        }
+    }
+
+    m_native_handle = &s_headless_native_handle_placeholder;
+    return true;
+}
+
+void Window::shutdown()
+{
+    if (m_native_handle == nullptr)
+    {
+        // The window has already been shut down.
+        return;
+    }
+
+    m_native_handle = nullptr;
+}
+
+void Window::process_event_queue()
+{
+    CAVE_ASSERT(m_native_handle != nullptr);
+
+    if (s_close_signal_received)
+        mark_as_should_close();
+
+    if (s_has_frame_limit)
+    {
+        if (s_remaining_frame_count == 0)
+            mark_as_should_close();
+        else
+            --s_remaining_frame_count;
+    }
+}
+
+u32 Window::get_client_area_width() const
+{
+    return s_headless_client_area_width;
+}
+
+u32 Window::get_client_area_height() const
+{
+    return s_headless_client_area_height;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/PerformanceCounters.h>
+
+namespace CaveGame
+{
+
+const char* get_performance_counter_name(PerformanceCounterType counter_type)
+{
+    switch (counter_type)
+    {
+        case PerformanceCounterType::Cycles: return "Cycles";
+        case PerformanceCounterType::Instructions: return "Instructions";
+        case PerformanceCounterType::L1DataCacheMisses: return "L1DataCacheMisses";
+        case PerformanceCounterType::LastLevelCacheMisses: return "LastLevelCacheMisses";
+        case PerformanceCounterType::BranchMisses: return "BranchMisses";
+        case PerformanceCounterType::Count: break;
+    }
+
+    CAVE_ASSERT(false);
+    return "Unknown";
+}
+
+PerformanceCounterGroup::PerformanceCounterGroup()
+{
+    for (i32& native_handle : m_native_handles)
+        native_handle = -1;
+}
+
+} // namespace CaveGame
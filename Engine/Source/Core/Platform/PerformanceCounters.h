@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+enum class PerformanceCounterType : u8
+{
+    Cycles,
+    Instructions,
+    L1DataCacheMisses,
+    LastLevelCacheMisses,
+    BranchMisses,
+
+    Count,
+};
+
+NODISCARD const char* get_performance_counter_name(PerformanceCounterType counter_type);
+
+struct PerformanceCounterSample
+{
+    // Indexed by `PerformanceCounterType`. The counters that aren't available are always zero.
+    u64 values[static_cast<u8>(PerformanceCounterType::Count)] {};
+
+    NODISCARD ALWAYS_INLINE u64 get(PerformanceCounterType counter_type) const { return values[static_cast<u8>(counter_type)]; }
+};
+
+//
+// A group of hardware performance counters that count the events of the thread that opened them, only while it runs
+// in user mode. The counters of a group are always scheduled together, so their values are consistent with each other.
+//
+// Only implemented on Linux (using `perf_event_open`). The counters are often unavailable: the processor might not
+// expose them (for example inside virtual machines) or `/proc/sys/kernel/perf_event_paranoid` might forbid them.
+//
+class PerformanceCounterGroup
+{
+    CAVE_MAKE_NONCOPYABLE(PerformanceCounterGroup);
+    CAVE_MAKE_NONMOVABLE(PerformanceCounterGroup);
+
+public:
+    PerformanceCounterGroup();
+    ALWAYS_INLINE ~PerformanceCounterGroup() { CAVE_ASSERT(!is_open()); }
+
+    //
+    // Opens the counters for the calling thread. The counters that aren't supported are skipped.
+    // Returns false if the group is already open or if no counter can be opened.
+    //
+    bool open();
+    void close();
+
+    NODISCARD ALWAYS_INLINE bool is_open() const { return (m_available_counter_mask != 0); }
+    NODISCARD ALWAYS_INLINE bool is_available(PerformanceCounterType counter_type) const
+    {
+        return (m_available_counter_mask & (1u << static_cast<u8>(counter_type))) != 0;
+    }
+
+    //
+    // Reads all the counters with a single system call. If the processor had to multiplex the counters (share them
+    // with other groups), the values are extrapolated to the entire time the group has been enabled.
+    // Can only be called by the thread that opened the group. Returns false if the counters can't be read.
+    //
+    bool read(PerformanceCounterSample& out_sample) const;
+
+private:
+    // The native handles (file descriptors on Linux) of the counters. The first open counter leads the group.
+    i32 m_native_handles[static_cast<u8>(PerformanceCounterType::Count)];
+    i32 m_leader_native_handle { -1 };
+
+    // The counter types in the order in which they were added to the group, which is also the order they are read in.
+    PerformanceCounterType m_read_order[static_cast<u8>(PerformanceCounterType::Count)] {};
+    u32 m_open_counter_count { 0 };
+    u32 m_available_counter_mask { 0 };
+};
+
+} // namespace CaveGame
@@ -13,6 +13,8 @@
 namespace CaveGame
 {
 
+struct ProcessorTopology;
+
 class PlatformCore
 {
 public:
@@ -21,6 +23,47 @@ public:
 
     // Returns the frequency of the performance counter, measured in ticks per second.
     static u64 get_tick_counter_frequency();
+
+    //
+    // Suspends the execution of the calling thread for (at least) the given number of nanoseconds.
+    // The actual duration depends on the scheduler granularity and is usually longer than requested.
+    //
+    static void sleep_for_nanoseconds(u64 nanoseconds);
+
+    // Returns the number of logical processors (hardware threads) that are available to the process.
+    static u32 get_logical_processor_count();
+
+    //
+    // Detects the physical cores, caches and NUMA nodes of the logical processors that are available to the process.
+    // Querying the topology is slow (it reads many small files on Linux), so it should only be done at startup.
+    // Returns false if the topology can't be determined, in which case every logical processor is reported as a
+    // separate physical core.
+    //
+    static bool query_processor_topology(ProcessorTopology& out_topology);
+
+    // Gives up the remainder of the calling thread time slice, allowing other threads to run.
+    static void yield_thread();
+
+    NODISCARD static u32 get_current_process_id();
+
+    //
+    // Returns the amount of physical memory used by the process (the resident set on Linux, the working set on
+    // Windows), measured in bytes. Returns zero if it can't be determined.
+    //
+    NODISCARD static u64 get_resident_memory_byte_count();
+
+    //
+    // Captures the return addresses of the calling thread stack, starting with the caller of this function.
+    // Returns the number of captured addresses, which is at most `maximum_address_count`.
+    //
+    static u32 capture_stack_trace(u64* out_addresses, u32 maximum_address_count);
+
+    //
+    // Writes the name of the function that contains the code address to the buffer, truncated if it doesn't fit.
+    // If the function name isn't available (it isn't exported), the module name and the offset in the module are
+    // written instead, which can be resolved offline (for example, with `addr2line`).
+    //
+    static void get_symbol_name(u64 address, char* out_buffer, usize buffer_size);
 };
 
 } // namespace CaveGame
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/ProcessorTopology.h>
+
+#if CAVE_COMPILER_MSVC
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif // CAVE_COMPILER_MSVC
+
+namespace CaveGame
+{
+
+#pragma region CPUID
+
+struct CpuidRegisters
+{
+    u32 eax { 0 };
+    u32 ebx { 0 };
+    u32 ecx { 0 };
+    u32 edx { 0 };
+};
+
+NODISCARD static CpuidRegisters query_cpuid(u32 leaf, u32 subleaf = 0)
+{
+    CpuidRegisters registers;
+#if CAVE_COMPILER_MSVC
+    int values[4] = {};
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    registers.eax = static_cast<u32>(values[0]);
+    registers.ebx = static_cast<u32>(values[1]);
+    registers.ecx = static_cast<u32>(values[2]);
+    registers.edx = static_cast<u32>(values[3]);
+#else
+    __cpuid_count(leaf, subleaf, registers.eax, registers.ebx, registers.ecx, registers.edx);
+#endif // CAVE_COMPILER_MSVC
+    return registers;
+}
+
+//
+// Reads the cache sizes from the deterministic cache parameters leaf. Intel processors report them using the 0x4 leaf,
+// while AMD processors use the 0x8000001D leaf (if the topology extensions are supported). Both leaves share the same
+// layout. Intel 64 and IA-32 Architectures Software Developer's Manual, Volume 2A, CPUID instruction reference.
+//
+static void read_cache_sizes(ProcessorTopology& topology)
+{
+    static constexpr u32 amd_topology_extensions_bit = 1U << 22;
+
+    const CpuidRegisters vendor_registers = query_cpuid(0);
+    const u32 maximum_basic_leaf = vendor_registers.eax;
+    const u32 maximum_extended_leaf = query_cpuid(0x80000000).eax;
+
+    // The vendor string is stored in the EBX, EDX and ECX registers, in this order. "AuthenticAMD" starts with "Auth".
+    const bool is_amd_processor = (vendor_registers.ebx == 0x68747541);
+
+    u32 cache_parameters_leaf = 0;
+    if (is_amd_processor && maximum_extended_leaf >= 0x8000001D && (query_cpuid(0x80000001).ecx & amd_topology_extensions_bit))
+        cache_parameters_leaf = 0x8000001D;
+    else if (!is_amd_processor && maximum_basic_leaf >= 4)
+        cache_parameters_leaf = 4;
+    else
+        return;
+
+    // NOTE: The number of subleaves is bounded, in case a (virtualized) processor never reports the terminating subleaf.
+    for (u32 subleaf = 0; subleaf < 16; ++subleaf)
+    {
+        const CpuidRegisters registers = query_cpuid(cache_parameters_leaf, subleaf);
+
+        // 0 = No more caches, 1 = Data cache, 2 = Instruction cache, 3 = Unified cache.
+        const u32 cache_type = registers.eax & 0x1F;
+        if (cache_type == 0)
+            break;
+        if (cache_type == 2)
+            continue;
+
+        const u32 cache_level = (registers.eax >> 5) & 0x7;
+        const u32 way_count = (registers.ebx >> 22) + 1;
+        const u32 partition_count = ((registers.ebx >> 12) & 0x3FF) + 1;
+        const u32 line_size = (registers.ebx & 0xFFF) + 1;
+        const u32 set_count = registers.ecx + 1;
+        const u32 cache_size = way_count * partition_count * line_size * set_count;
+
+        if (cache_level == 1)
+        {
+            topology.l1_data_cache_size = cache_size;
+            topology.cache_line_size = line_size;
+        }
+        else if (cache_level == 2)
+        {
+            topology.l2_cache_size = cache_size;
+        }
+        else if (cache_level == 3)
+        {
+            topology.l3_cache_size = cache_size;
+        }
+    }
+}
+
+static void read_processor_name(ProcessorTopology& topology)
+{
+    if (query_cpuid(0x80000000).eax < 0x80000004)
+        return;
+
+    // The brand string is stored in the 0x80000002, 0x80000003 and 0x80000004 leaves, 16 characters each.
+    char brand_string[49] = {};
+    for (u32 leaf_offset = 0; leaf_offset < 3; ++leaf_offset)
+    {
+        const CpuidRegisters registers = query_cpuid(0x80000002 + leaf_offset);
+        const u32 values[4] = { registers.eax, registers.ebx, registers.ecx, registers.edx };
+        for (u32 byte_index = 0; byte_index < 16; ++byte_index)
+            brand_string[leaf_offset * 16 + byte_index] = static_cast<char>(values[byte_index / 4] >> ((byte_index % 4) * 8));
+    }
+
+    // Some processors pad the brand string with leading spaces.
+    const char* name_characters = brand_string;
+    while (*name_characters == ' ')
+        ++name_characters;
+    topology.processor_name = StringView::create_from_utf8(name_characters);
+}
+
+#pragma endregion
+
+// Returns the dense index assigned to the identifier, assigning the next index if it hasn't been encountered before.
+NODISCARD static u32 get_dense_index(Vector<u64>& encountered_ids, u64 id)
+{
+    for (usize index = 0; index < encountered_ids.count(); ++index)
+    {
+        if (encountered_ids[index] == id)
+            return static_cast<u32>(index);
+    }
+
+    encountered_ids.add(id);
+    return static_cast<u32>(encountered_ids.count() - 1);
+}
+
+void Detail::build_processor_topology(const Vector<RawLogicalProcessorInfo>& raw_logical_processors, ProcessorTopology& out_topology)
+{
+    Vector<u64> physical_core_ids;
+    Vector<u64> package_ids;
+    Vector<u64> numa_node_ids;
+    Vector<u64> l2_cache_ids;
+    Vector<u64> l3_cache_ids;
+
+    out_topology.logical_processors.clear();
+    for (const RawLogicalProcessorInfo& raw_processor : raw_logical_processors)
+    {
+        LogicalProcessorInfo processor = {};
+        processor.processor_index = raw_processor.processor_index;
+        processor.physical_core_index = get_dense_index(physical_core_ids, raw_processor.physical_core_id);
+        processor.package_index = get_dense_index(package_ids, raw_processor.package_id);
+        processor.numa_node_index = get_dense_index(numa_node_ids, raw_processor.numa_node_id);
+        processor.l2_cache_group_index = get_dense_index(l2_cache_ids, raw_processor.l2_cache_id);
+        processor.l3_cache_group_index = get_dense_index(l3_cache_ids, raw_processor.l3_cache_id);
+        out_topology.logical_processors.add(processor);
+    }
+
+    // Sort the processors by their physical core (insertion sort, as the processors are usually almost sorted already).
+    LogicalProcessorInfo* processors = out_topology.logical_processors.elements();
+    for (usize index = 1; index < out_topology.logical_processors.count(); ++index)
+    {
+        const LogicalProcessorInfo processor = processors[index];
+        usize insert_index = index;
+        while (insert_index > 0 && (processors[insert_index - 1].physical_core_index > processor.physical_core_index ||
+                                    (processors[insert_index - 1].physical_core_index == processor.physical_core_index &&
+                                     processors[insert_index - 1].processor_index > processor.processor_index)))
+        {
+            processors[insert_index] = processors[insert_index - 1];
+            --insert_index;
+        }
+        processors[insert_index] = processor;
+    }
+
+    for (usize index = 0; index < out_topology.logical_processors.count(); ++index)
+    {
+        const bool is_sibling_of_previous = (index > 0 && processors[index - 1].physical_core_index == processors[index].physical_core_index);
+        processors[index].smt_sibling_index = is_sibling_of_previous ? (processors[index - 1].smt_sibling_index + 1) : 0;
+    }
+
+    out_topology.physical_core_count = static_cast<u32>(physical_core_ids.count());
+    out_topology.package_count = static_cast<u32>(package_ids.count());
+    out_topology.numa_node_count = static_cast<u32>(numa_node_ids.count());
+    out_topology.l2_cache_group_count = static_cast<u32>(l2_cache_ids.count());
+    out_topology.l3_cache_group_count = static_cast<u32>(l3_cache_ids.count());
+
+    read_cache_sizes(out_topology);
+    read_processor_name(out_topology);
+}
+
+} // namespace CaveGame
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+
+#include <bit>
+
+namespace CaveGame
+{
+
+//
+// A set of logical processors, used to express thread affinities.
+//
+// On Windows, the index of a logical processor is `group * 64 + number_within_group`. A set can only contain the
+// processors of a single processor group, as a thread can't be bound to processors from multiple groups.
+//
+class ProcessorSet
+{
+public:
+    static constexpr u32 maximum_processor_count = 1024;
+
+public:
+    ProcessorSet() = default;
+
+    NODISCARD ALWAYS_INLINE static ProcessorSet from_processor(u32 processor_index)
+    {
+        ProcessorSet processor_set;
+        processor_set.add(processor_index);
+        return processor_set;
+    }
+
+    ALWAYS_INLINE void add(u32 processor_index)
+    {
+        CAVE_ASSERT(processor_index < maximum_processor_count);
+        m_words[processor_index / 64] |= (1ULL << (processor_index % 64));
+    }
+
+    ALWAYS_INLINE void remove(u32 processor_index)
+    {
+        CAVE_ASSERT(processor_index < maximum_processor_count);
+        m_words[processor_index / 64] &= ~(1ULL << (processor_index % 64));
+    }
+
+    NODISCARD ALWAYS_INLINE bool contains(u32 processor_index) const
+    {
+        if (processor_index >= maximum_processor_count)
+            return false;
+        return (m_words[processor_index / 64] & (1ULL << (processor_index % 64))) != 0;
+    }
+
+    NODISCARD ALWAYS_INLINE u32 count() const
+    {
+        u32 processor_count = 0;
+        for (u64 word : m_words)
+            processor_count += static_cast<u32>(std::popcount(word));
+        return processor_count;
+    }
+
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (count() == 0); }
+
+    // Returns the bits of the 64 processors that start at the given index (which must be a multiple of 64).
+    NODISCARD ALWAYS_INLINE u64 get_word(u32 first_processor_index) const
+    {
+        CAVE_ASSERT(first_processor_index % 64 == 0 && first_processor_index < maximum_processor_count);
+        return m_words[first_processor_index / 64];
+    }
+
+private:
+    u64 m_words[maximum_processor_count / 64] {};
+};
+
+struct LogicalProcessorInfo
+{
+    // The index used by the operating system to identify the processor (see `ProcessorSet`).
+    u32 processor_index;
+
+    //
+    // The following indices are dense (they start at zero and have no gaps), regardless of how the operating
+    // system numbers the corresponding hardware. Processors that have the same index share the resource.
+    //
+    u32 physical_core_index;
+    u32 package_index;
+    u32 numa_node_index;
+    u32 l2_cache_group_index;
+    u32 l3_cache_group_index;
+
+    // The position of the processor among the hardware threads of its physical core. Zero for the first one.
+    u32 smt_sibling_index;
+};
+
+//
+// Describes the processors available to the process, as reported by the operating system (`/sys` on Linux and
+// `GetLogicalProcessorInformationEx` on Windows), with the cache details read using CPUID.
+//
+struct ProcessorTopology
+{
+    // Sorted by the physical core index, and then by the SMT sibling index.
+    Vector<LogicalProcessorInfo> logical_processors;
+
+    u32 physical_core_count { 0 };
+    u32 package_count { 0 };
+    u32 numa_node_count { 0 };
+    u32 l2_cache_group_count { 0 };
+    u32 l3_cache_group_count { 0 };
+
+    // The cache sizes, measured in bytes. Zero if the cache level doesn't exist or couldn't be detected.
+    u32 cache_line_size { 64 };
+    u32 l1_data_cache_size { 0 };
+    u32 l2_cache_size { 0 };
+    u32 l3_cache_size { 0 };
+
+    String processor_name;
+
+    NODISCARD ALWAYS_INLINE u32 get_logical_processor_count() const { return static_cast<u32>(logical_processors.count()); }
+};
+
+namespace Detail
+{
+
+//
+// The platform-specific identifiers of the hardware resources used by a logical processor. The identifiers are only
+// meaningful when compared with each other (processors that share a resource have the same identifier).
+//
+struct RawLogicalProcessorInfo
+{
+    u32 processor_index;
+    u64 physical_core_id;
+    u64 package_id;
+    u64 numa_node_id;
+    u64 l2_cache_id;
+    u64 l3_cache_id;
+};
+
+//
+// Builds the topology from the raw identifiers collected by the platform layer: assigns the dense indices, sorts the
+// processors and reads the processor details using CPUID.
+//
+void build_processor_topology(const Vector<RawLogicalProcessorInfo>& raw_logical_processors, ProcessorTopology& out_topology);
+
+} // namespace Detail
+
+} // namespace CaveGame
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Named memory region that can be mapped by other processes. Implemented with POSIX shared memory on Linux (the
+// region is visible in `/dev/shm`) and with a named file mapping on Windows.
+//
+// NOTE: On Linux the region outlives the process that created it until it is closed, so a crashed process leaves its
+// region behind. It is replaced when a region with the same name is created again.
+//
+class SharedMemoryRegion
+{
+    CAVE_MAKE_NONCOPYABLE(SharedMemoryRegion);
+    CAVE_MAKE_NONMOVABLE(SharedMemoryRegion);
+
+public:
+    SharedMemoryRegion() = default;
+    ALWAYS_INLINE ~SharedMemoryRegion() { CAVE_ASSERT(m_data == nullptr); }
+
+    //
+    // Creates the region (replacing any region with the same name) and maps it for reading and writing. The memory
+    // is zero-initialized. Returns false if the region is already open or if it can't be created.
+    //
+    bool create(StringView name, usize byte_count);
+
+    // Maps an existing region, created by another process, for reading only. Returns false if it can't be opened.
+    bool open(StringView name);
+
+    // Unmaps the region. If the region has been created by this object, its name is also removed.
+    void close();
+
+    NODISCARD ALWAYS_INLINE bool is_open() const { return (m_data != nullptr); }
+    NODISCARD ALWAYS_INLINE void* data() const { return m_data; }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+
+private:
+    void* m_data { nullptr };
+    usize m_byte_count { 0 };
+    void* m_native_handle { nullptr };
+    bool m_is_owner { false };
+    // The name of the created region, which is removed when the region is closed. Only used on Linux.
+    String m_name;
+};
+
+} // namespace CaveGame
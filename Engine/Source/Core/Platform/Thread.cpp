@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Logging/Logger.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/Profiler.h>
+#include <Core/Profiling/SamplingProfiler.h>
+
+namespace CaveGame
+{
+
+bool Thread::create(EntryPoint entry_point, void* user_data)
+{
+    return create(entry_point, user_data, ThreadDescription());
+}
+
+void Thread::apply_current_thread_description(const ThreadDescription& description)
+{
+    if (!description.name.is_empty())
+    {
+        set_current_thread_name(description.name);
+        Logger::set_current_thread_name(description.name);
+        Profiler::set_current_thread_name(description.name);
+        SamplingProfiler::register_current_thread(description.name);
+    }
+
+    // NOTE: The thread attributes are only hints, so failing to apply them isn't treated as an error.
+    if (description.priority != ThreadPriority::Normal)
+        set_current_thread_priority(description.priority);
+
+    if (!description.affinity.is_empty())
+        set_current_thread_affinity(description.affinity);
+}
+
+} // namespace CaveGame
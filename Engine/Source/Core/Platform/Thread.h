@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+#include <Core/Platform/ProcessorTopology.h>
+
+namespace CaveGame
+{
+
+//
+// The scheduling priority of a thread, relative to the other threads of the process.
+// NOTE: On Linux, raising the priority above normal requires the `CAP_SYS_NICE` capability.
+//
+enum class ThreadPriority : u8
+{
+    Low,
+    Normal,
+    High,
+    Highest,
+};
+
+struct ThreadDescription
+{
+    // The name of the thread, displayed by debuggers and profilers. Truncated to 15 characters on Linux.
+    StringView name;
+
+    ThreadPriority priority { ThreadPriority::Normal };
+
+    // The logical processors the thread is allowed to run on. An empty set doesn't restrict the thread.
+    ProcessorSet affinity;
+};
+
+//
+// Wrapper around a native operating system thread.
+//
+class Thread
+{
+    CAVE_MAKE_NONCOPYABLE(Thread);
+    CAVE_MAKE_NONMOVABLE(Thread);
+
+public:
+    using EntryPoint = void (*)(void* user_data);
+
+public:
+    Thread() = default;
+    ALWAYS_INLINE ~Thread() { CAVE_ASSERT(m_native_handle == nullptr); }
+
+    //
+    // Creates the native thread, which starts by invoking `entry_point(user_data)`.
+    // Returns false if the thread has already been created or if the thread creation has failed.
+    //
+    bool create(EntryPoint entry_point, void* user_data);
+
+    //
+    // Creates the native thread and applies the name, priority and affinity before the entry point is invoked.
+    // Failing to apply any of the attributes doesn't prevent the thread from being created.
+    //
+    bool create(EntryPoint entry_point, void* user_data, const ThreadDescription& description);
+
+    //
+    // Blocks the calling thread until the thread finishes its execution and releases the native thread object.
+    // Must be called for every thread that has been successfully created.
+    //
+    void join();
+
+    NODISCARD ALWAYS_INLINE bool is_created() const { return (m_native_handle != nullptr); }
+
+public:
+    static void set_current_thread_name(StringView name);
+
+    // Returns false if the priority can't be changed (usually because the process lacks the required privileges).
+    static bool set_current_thread_priority(ThreadPriority priority);
+
+    // Returns false if the set is empty or contains processors that aren't available to the process.
+    static bool set_current_thread_affinity(const ProcessorSet& affinity);
+
+    // Applies all the attributes from the description to the calling thread.
+    static void apply_current_thread_description(const ThreadDescription& description);
+
+private:
+    void* m_native_handle { nullptr };
+};
+
+//
+// Counting semaphore, used to block threads until work is available.
+//
+class Semaphore
+{
+    CAVE_MAKE_NONCOPYABLE(Semaphore);
+    CAVE_MAKE_NONMOVABLE(Semaphore);
+
+public:
+    Semaphore() = default;
+    ALWAYS_INLINE ~Semaphore() { CAVE_ASSERT(m_native_handle == nullptr); }
+
+    // Creates the native semaphore object. Returns false if the semaphore creation has failed.
+    bool initialize(u32 initial_count = 0);
+    void shutdown();
+
+    // Blocks the calling thread until the count is greater than zero, and then decrements it.
+    void wait();
+
+    // Increments the count by the given value, waking up at most `count` waiting threads.
+    void signal(u32 count = 1);
+
+private:
+    void* m_native_handle { nullptr };
+};
+
+} // namespace CaveGame
@@ -9,32 +9,35 @@
 #pragma once
 
 #include <Core/Assertion.h>
-#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/FastClock.h>
 
 namespace CaveGame
 {
 
+//
+// Measures the time elapsed between its creation and the moment it is stopped, using `FastClock`.
+//
 class Timer
 {
 public:
     ALWAYS_INLINE Timer()
         : m_performance_counter_end(0)
     {
-        m_performance_counter_start = PlatformCore::get_current_tick_counter();
+        m_performance_counter_start = FastClock::get_ticks();
     }
 
     ALWAYS_INLINE void stop()
     {
         // The timer was already stopped.
         CAVE_ASSERT(!is_stopped());
-        m_performance_counter_end = PlatformCore::get_current_tick_counter();
+        m_performance_counter_end = FastClock::get_ticks();
     }
 
     NODISCARD ALWAYS_INLINE bool is_stopped() const { return (m_performance_counter_end > 0); }
 
 public:
     //
-    // Returns the number of ticks between the timer creation and the moment the `stop()` function was invoked.
+    // Returns the number of `FastClock` ticks between the timer creation and the moment the `stop()` function was invoked.
     // If the timer hasn't been stopped yet, this function returns zero (0).
     //
     NODISCARD ALWAYS_INLINE u64 elapsed_ticks() const
@@ -57,8 +60,7 @@ public:
     NODISCARD ALWAYS_INLINE float elapsed_seconds() const
     {
         const u64 tick_count = elapsed_ticks();
-        const u64 tick_frequency = PlatformCore::get_tick_counter_frequency();
-        return static_cast<float>(tick_count) / static_cast<float>(tick_frequency);
+        return FastClock::ticks_to_seconds(tick_count);
     }
 
     NODISCARD ALWAYS_INLINE float stop_and_get_elapsed_seconds()
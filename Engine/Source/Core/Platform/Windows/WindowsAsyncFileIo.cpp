@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/AsyncFileIo.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: There is no native backend on Windows yet, so the thread pool backend is always used. An I/O completion port
+// (or the `IoRing` API, available since Windows 11) would be the equivalent of `io_uring`.
+//
+
+bool AsyncFileIo::initialize_native_backend(MAYBE_UNUSED u32 queue_depth)
+{
+    return false;
+}
+
+void AsyncFileIo::shutdown_native_backend()
+{}
+
+bool AsyncFileIo::register_native_files(MAYBE_UNUSED File* const* files, MAYBE_UNUSED u32 file_count)
+{
+    return false;
+}
+
+void AsyncFileIo::unregister_native_files()
+{}
+
+bool AsyncFileIo::register_native_buffers(MAYBE_UNUSED const AsyncIoBuffer* buffers, MAYBE_UNUSED u32 buffer_count)
+{
+    return false;
+}
+
+void AsyncFileIo::unregister_native_buffers()
+{}
+
+bool AsyncFileIo::prepare_native_request(MAYBE_UNUSED AsyncIoRequest& request)
+{
+    return false;
+}
+
+void AsyncFileIo::submit_native_requests()
+{}
+
+void AsyncFileIo::reap_native_completions(MAYBE_UNUSED bool should_wait)
+{}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/File.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+    #include <cwchar>
+
+namespace CaveGame
+{
+
+//
+// NOTE: The paths are converted to UTF-16 and passed to the wide functions, as the ANSI functions interpret them in
+// the code page of the system, which usually isn't UTF-8.
+//
+static constexpr usize s_maximum_path_length = 1024;
+
+static bool get_wide_path(StringView path, wchar_t (&out_wide_path)[s_maximum_path_length + 1])
+{
+    if (path.is_empty())
+        return false;
+
+    const int wide_character_count = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, path.characters(), static_cast<int>(path.byte_count()), out_wide_path, static_cast<int>(s_maximum_path_length));
+    if (wide_character_count <= 0)
+        return false;
+
+    out_wide_path[wide_character_count] = 0;
+    return true;
+}
+
+// The largest number of bytes transferred by a single `ReadFile` or `WriteFile` call, whose counts are 32-bit.
+static constexpr usize s_maximum_transfer_byte_count = 1ull << 30;
+
+#pragma region File
+
+bool File::open(StringView filepath, FileOpenMode mode)
+{
+    if (m_native_handle != invalid_native_handle)
+        return false;
+
+    wchar_t wide_filepath[s_maximum_path_length + 1];
+    if (!get_wide_path(filepath, wide_filepath))
+        return false;
+
+    DWORD desired_access = GENERIC_READ;
+    DWORD creation_disposition = OPEN_EXISTING;
+    switch (mode)
+    {
+        case FileOpenMode::Read: break;
+        case FileOpenMode::ReadWrite: desired_access |= GENERIC_WRITE; break;
+        case FileOpenMode::Create:
+            desired_access |= GENERIC_WRITE;
+            creation_disposition = CREATE_ALWAYS;
+            break;
+    }
+
+    // NOTE: Sharing the deletion allows other files to atomically replace this one while it is open, as on Linux.
+    const DWORD share_mode = FILE_SHARE_READ | FILE_SHARE_DELETE;
+    HANDLE file_handle = CreateFileW(wide_filepath, desired_access, share_mode, nullptr, creation_disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    m_native_handle = reinterpret_cast<intptr>(file_handle);
+    return true;
+}
+
+void File::close()
+{
+    if (m_native_handle == invalid_native_handle)
+        return;
+
+    CloseHandle(reinterpret_cast<HANDLE>(m_native_handle));
+    m_native_handle = invalid_native_handle;
+}
+
+u64 File::get_byte_count() const
+{
+    CAVE_ASSERT(is_open());
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(reinterpret_cast<HANDLE>(m_native_handle), &file_size))
+        return 0;
+    return static_cast<u64>(file_size.QuadPart);
+}
+
+bool File::set_byte_count(u64 byte_count)
+{
+    CAVE_ASSERT(is_open());
+    FILE_END_OF_FILE_INFO end_of_file_information;
+    end_of_file_information.EndOfFile.QuadPart = static_cast<LONGLONG>(byte_count);
+    return SetFileInformationByHandle(reinterpret_cast<HANDLE>(m_native_handle), FileEndOfFileInfo, &end_of_file_information, sizeof(end_of_file_information));
+}
+
+bool File::read_at(u64 offset, void* out_buffer, usize byte_count) const
+{
+    CAVE_ASSERT(is_open());
+    u8* destination = static_cast<u8*>(out_buffer);
+    usize read_byte_count = 0;
+
+    while (read_byte_count < byte_count)
+    {
+        // NOTE: The offset of a synchronous handle is passed through the `OVERLAPPED` structure, which makes the read positional.
+        const u64 read_offset = offset + read_byte_count;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(read_offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(read_offset >> 32);
+
+        const DWORD requested_byte_count = static_cast<DWORD>(Math::min(byte_count - read_byte_count, s_maximum_transfer_byte_count));
+        DWORD transferred_byte_count = 0;
+        if (!ReadFile(reinterpret_cast<HANDLE>(m_native_handle), destination + read_byte_count, requested_byte_count, &transferred_byte_count, &overlapped))
+            return false;
+
+        // The end of the file has been reached.
+        if (transferred_byte_count == 0)
+            return false;
+
+        read_byte_count += transferred_byte_count;
+    }
+
+    return true;
+}
+
+bool File::write_at(u64 offset, const void* buffer, usize byte_count)
+{
+    CAVE_ASSERT(is_open());
+    const u8* source = static_cast<const u8*>(buffer);
+    usize written_byte_count = 0;
+
+    while (written_byte_count < byte_count)
+    {
+        const u64 write_offset = offset + written_byte_count;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(write_offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(write_offset >> 32);
+
+        const DWORD requested_byte_count = static_cast<DWORD>(Math::min(byte_count - written_byte_count, s_maximum_transfer_byte_count));
+        DWORD transferred_byte_count = 0;
+        if (!WriteFile(reinterpret_cast<HANDLE>(m_native_handle), source + written_byte_count, requested_byte_count, &transferred_byte_count, &overlapped))
+            return false;
+
+        written_byte_count += transferred_byte_count;
+    }
+
+    return true;
+}
+
+bool File::flush()
+{
+    CAVE_ASSERT(is_open());
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(m_native_handle));
+}
+
+#pragma endregion
+
+#pragma region MappedFile
+
+bool MappedFile::open(StringView filepath, FileMappingAccess access)
+{
+    if (m_is_open)
+        return false;
+
+    wchar_t wide_filepath[s_maximum_path_length + 1];
+    if (!get_wide_path(filepath, wide_filepath))
+        return false;
+
+    const bool is_writable = (access == FileMappingAccess::ReadWrite);
+    const DWORD desired_access = is_writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+    HANDLE file_handle = CreateFileW(wide_filepath, desired_access, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size))
+    {
+        CloseHandle(file_handle);
+        return false;
+    }
+
+    // NOTE: Empty files can't be mapped, as `CreateFileMapping` fails for zero-sized files.
+    const usize byte_count = static_cast<usize>(file_size.QuadPart);
+    void* data = nullptr;
+    if (byte_count > 0)
+    {
+        HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, is_writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle == nullptr)
+        {
+            CloseHandle(file_handle);
+            return false;
+        }
+
+        // The view keeps a reference to the file mapping, so its handle isn't needed anymore.
+        data = MapViewOfFile(mapping_handle, is_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping_handle);
+        if (data == nullptr)
+        {
+            CloseHandle(file_handle);
+            return false;
+        }
+    }
+
+    m_data = static_cast<u8*>(data);
+    m_byte_count = byte_count;
+    m_native_handle = file_handle;
+    m_access = access;
+    m_is_open = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!m_is_open)
+        return;
+
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_native_handle));
+
+    m_data = nullptr;
+    m_byte_count = 0;
+    m_native_handle = nullptr;
+    m_is_open = false;
+}
+
+void MappedFile::advise(FileAccessHint hint, usize offset, usize byte_count) const
+{
+    CAVE_ASSERT(m_is_open);
+    CAVE_ASSERT(offset <= m_byte_count && byte_count <= m_byte_count - offset);
+    if (m_data == nullptr || byte_count == 0 || hint != FileAccessHint::WillNeed)
+        return;
+
+    WIN32_MEMORY_RANGE_ENTRY memory_range;
+    memory_range.VirtualAddress = m_data + offset;
+    memory_range.NumberOfBytes = byte_count;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &memory_range, 0);
+}
+
+bool MappedFile::flush()
+{
+    CAVE_ASSERT(m_is_open);
+    if (m_data == nullptr || m_access != FileMappingAccess::ReadWrite)
+        return true;
+
+    // NOTE: `FlushViewOfFile` only starts writing the pages, while `FlushFileBuffers` waits until they are written.
+    if (!FlushViewOfFile(m_data, m_byte_count))
+        return false;
+    return FlushFileBuffers(static_cast<HANDLE>(m_native_handle));
+}
+
+#pragma endregion
+
+#pragma region FileSystem
+
+static DWORD get_file_attributes(StringView path)
+{
+    wchar_t wide_path[s_maximum_path_length + 1];
+    if (!get_wide_path(path, wide_path))
+        return INVALID_FILE_ATTRIBUTES;
+    return GetFileAttributesW(wide_path);
+}
+
+bool FileSystem::file_exists(StringView filepath)
+{
+    const DWORD attributes = get_file_attributes(filepath);
+    return (attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY));
+}
+
+bool FileSystem::directory_exists(StringView directory_path)
+{
+    const DWORD attributes = get_file_attributes(directory_path);
+    return (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY));
+}
+
+bool FileSystem::create_directory(StringView directory_path)
+{
+    wchar_t wide_directory_path[s_maximum_path_length + 1];
+    if (!get_wide_path(directory_path, wide_directory_path))
+        return false;
+
+    if (CreateDirectoryW(wide_directory_path, nullptr))
+        return true;
+    return (GetLastError() == ERROR_ALREADY_EXISTS && directory_exists(directory_path));
+}
+
+bool FileSystem::delete_file(StringView filepath)
+{
+    wchar_t wide_filepath[s_maximum_path_length + 1];
+    if (!get_wide_path(filepath, wide_filepath))
+        return false;
+    return DeleteFileW(wide_filepath);
+}
+
+bool FileSystem::enumerate_directory(StringView directory_path, Vector<DirectoryEntry>& out_entries)
+{
+    wchar_t wide_search_pattern[s_maximum_path_length + 1];
+    if (!get_wide_path(directory_path, wide_search_pattern))
+        return false;
+
+    // The search pattern matches all the entries of the directory.
+    const usize directory_path_length = wcslen(wide_search_pattern);
+    if (directory_path_length + 2 > s_maximum_path_length)
+        return false;
+    wide_search_pattern[directory_path_length + 0] = L'\\';
+    wide_search_pattern[directory_path_length + 1] = L'*';
+    wide_search_pattern[directory_path_length + 2] = 0;
+
+    WIN32_FIND_DATAW find_data;
+    HANDLE find_handle = FindFirstFileExW(wide_search_pattern, FindExInfoBasic, &find_data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (find_handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+        if (wcscmp(find_data.cFileName, L".") == 0 || wcscmp(find_data.cFileName, L"..") == 0)
+            continue;
+
+        char name[MAX_PATH * 3 + 1];
+        const int name_byte_count = WideCharToMultiByte(CP_UTF8, 0, find_data.cFileName, -1, name, static_cast<int>(sizeof(name)), nullptr, nullptr);
+        if (name_byte_count <= 0)
+            continue;
+
+        out_entries.emplace();
+        DirectoryEntry& entry = out_entries.last();
+        entry.name = StringView::create_from_utf8(name);
+        entry.is_directory = (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+        entry.byte_count = entry.is_directory ? 0 : ((static_cast<u64>(find_data.nFileSizeHigh) << 32) | find_data.nFileSizeLow);
+    } while (FindNextFileW(find_handle, &find_data));
+
+    FindClose(find_handle);
+    return true;
+}
+
+bool FileSystem::replace_file(StringView source_filepath, StringView destination_filepath)
+{
+    wchar_t wide_source_filepath[s_maximum_path_length + 1];
+    wchar_t wide_destination_filepath[s_maximum_path_length + 1];
+    if (!get_wide_path(source_filepath, wide_source_filepath) || !get_wide_path(destination_filepath, wide_destination_filepath))
+        return false;
+
+    // NOTE: `MOVEFILE_WRITE_THROUGH` doesn't return until the rename has been flushed to the storage device.
+    return MoveFileExW(wide_source_filepath, wide_destination_filepath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+}
+
+#pragma endregion
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/Futex.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: The `WaitOnAddress` family of functions is implemented in `Synchronization.lib`, which is linked by the
+// build system configuration.
+//
+
+void Futex::wait(const std::atomic<u32>& word, u32 expected_value)
+{
+    WaitOnAddress(const_cast<std::atomic<u32>*>(&word), &expected_value, sizeof(u32), INFINITE);
+}
+
+void Futex::wake_one(std::atomic<u32>& word)
+{
+    WakeByAddressSingle(&word);
+}
+
+void Futex::wake_all(std::atomic<u32>& word)
+{
+    WakeByAddressAll(&word);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
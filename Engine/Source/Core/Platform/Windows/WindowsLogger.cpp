@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Logging/Logger.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+    #include <cstdio>
+
+namespace CaveGame
+{
+
+static LPTOP_LEVEL_EXCEPTION_FILTER s_previous_exception_filter = nullptr;
+
+static LONG WINAPI unhandled_exception_filter(EXCEPTION_POINTERS* exception_pointers)
+{
+    char crash_reason[64];
+    snprintf(crash_reason, sizeof(crash_reason), "unhandled exception 0x%08lX", exception_pointers->ExceptionRecord->ExceptionCode);
+    Logger::flush_from_crash_handler(crash_reason);
+
+    // Let the previous filter (or the operating system) handle the exception, so crash dumps are still generated.
+    if (s_previous_exception_filter)
+        return s_previous_exception_filter(exception_pointers);
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void Logger::install_crash_handler()
+{
+    s_previous_exception_filter = SetUnhandledExceptionFilter(unhandled_exception_filter);
+}
+
+void Logger::uninstall_crash_handler()
+{
+    SetUnhandledExceptionFilter(s_previous_exception_filter);
+    s_previous_exception_filter = nullptr;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/PerformanceCounters.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: Windows only exposes the hardware counters to kernel drivers and to ETW sessions, which require administrator
+// privileges, thus the counters are reported as unavailable.
+//
+
+bool PerformanceCounterGroup::open()
+{
+    return false;
+}
+
+void PerformanceCounterGroup::close()
+{}
+
+bool PerformanceCounterGroup::read(MAYBE_UNUSED PerformanceCounterSample& out_sample) const
+{
+    return false;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -6,9 +6,17 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
-#include <Core/Assertion.h>
-#include <Core/Platform/PlatformCore.h>
-#include <Core/Platform/Windows/WindowsGuardedInclude.h>
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Assertion.h>
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/PlatformCore.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+    #include <cstdio>
+    #include <cstring>
+    #include <psapi.h>
 
 namespace CaveGame
 {
@@ -26,15 +34,14 @@ u64 PlatformCore::get_current_tick_counter()
     return tick_counter.QuadPart;
 }
 
-//
-// The performance counter frequency is fixed at boot time and thus its value can be cached.
-// https://learn.microsoft.com/en-us/windows/win32/api/profileapi/nf-profileapi-queryperformancefrequency
-//
-static u64 s_tick_counter_frequency = 0;
-
 u64 PlatformCore::get_tick_counter_frequency()
 {
-    if (s_tick_counter_frequency == 0)
+    //
+    // The performance counter frequency is fixed at boot time and thus its value can be cached.
+    // https://learn.microsoft.com/en-us/windows/win32/api/profileapi/nf-profileapi-queryperformancefrequency
+    // NOTE: The initialization of function-local static variables is thread-safe.
+    //
+    static const u64 s_tick_counter_frequency = []() -> u64
     {
         LARGE_INTEGER tick_counter_frequency;
         if (!QueryPerformanceFrequency(&tick_counter_frequency))
@@ -44,11 +51,125 @@ u64 PlatformCore::get_tick_counter_frequency()
             return 0;
         }
 
-        s_tick_counter_frequency = tick_counter_frequency.QuadPart;
-    }
+        return tick_counter_frequency.QuadPart;
+    }();
 
     CAVE_ASSERT(s_tick_counter_frequency != 0);
     return s_tick_counter_frequency;
 }
 
+// NOTE: Older versions of the Windows SDK don't define this flag, even though it's supported since Windows 10 (1803).
+    #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+    #endif // CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+
+//
+// The high resolution waitable timer of the calling thread. It is created by the first sleep (a frame pacer sleeps
+// every frame, thus creating a timer for every sleep is wasteful) and closed when the thread exits.
+//
+struct ThreadSleepTimer
+{
+    HANDLE handle { nullptr };
+    bool is_initialized { false };
+
+    ALWAYS_INLINE ~ThreadSleepTimer()
+    {
+        if (handle != nullptr)
+            CloseHandle(handle);
+    }
+};
+
+static thread_local ThreadSleepTimer t_sleep_timer;
+
+void PlatformCore::sleep_for_nanoseconds(u64 nanoseconds)
+{
+    //
+    // The resolution of `Sleep` is the system timer period (15.6 milliseconds by default), which is too coarse for
+    // frame pacing. High resolution waitable timers have a resolution of about 0.5 milliseconds.
+    // https://learn.microsoft.com/en-us/windows/win32/api/synchapi/nf-synchapi-createwaitabletimerexw
+    //
+    if (!t_sleep_timer.is_initialized)
+    {
+        t_sleep_timer.handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        t_sleep_timer.is_initialized = true;
+    }
+
+    if (t_sleep_timer.handle == nullptr)
+    {
+        // High resolution timers are not supported by the current version of Windows.
+        Sleep(static_cast<DWORD>(nanoseconds / 1000000));
+        return;
+    }
+
+    // A negative due time represents a relative interval, measured in 100 nanosecond units.
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -static_cast<LONGLONG>(nanoseconds / 100);
+
+    if (SetWaitableTimer(t_sleep_timer.handle, &due_time, 0, nullptr, nullptr, FALSE))
+        WaitForSingleObject(t_sleep_timer.handle, INFINITE);
+}
+
+u32 PlatformCore::get_logical_processor_count()
+{
+    // NOTE: Processors from all processor groups are counted, as systems with more than 64 logical processors have multiple groups.
+    const DWORD processor_count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    return (processor_count > 0) ? static_cast<u32>(processor_count) : 1;
+}
+
+void PlatformCore::yield_thread()
+{
+    SwitchToThread();
+}
+
+u32 PlatformCore::get_current_process_id()
+{
+    return static_cast<u32>(GetCurrentProcessId());
+}
+
+u64 PlatformCore::get_resident_memory_byte_count()
+{
+    // NOTE: `K32GetProcessMemoryInfo` is exported by kernel32, so the PSAPI library doesn't have to be linked.
+    PROCESS_MEMORY_COUNTERS memory_counters = {};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters)))
+        return 0;
+    return static_cast<u64>(memory_counters.WorkingSetSize);
+}
+
+u32 PlatformCore::capture_stack_trace(u64* out_addresses, u32 maximum_address_count)
+{
+    constexpr u32 maximum_captured_address_count = 62;
+    void* addresses[maximum_captured_address_count];
+
+    // NOTE: This function itself is skipped, so the first captured address is the return address into the caller.
+    const USHORT captured_address_count = RtlCaptureStackBackTrace(1, Math::min(maximum_address_count, maximum_captured_address_count), addresses, nullptr);
+    for (USHORT address_index = 0; address_index < captured_address_count; ++address_index)
+        out_addresses[address_index] = reinterpret_cast<uintptr>(addresses[address_index]);
+    return captured_address_count;
+}
+
+void PlatformCore::get_symbol_name(u64 address, char* out_buffer, usize buffer_size)
+{
+    //
+    // NOTE: Resolving the function names requires the program database and DbgHelp, which isn't thread-safe and
+    // must be initialized for the process. Only the module name and the offset in the module are written.
+    //
+    HMODULE module_handle = nullptr;
+    const DWORD flags = GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT;
+    if (!GetModuleHandleExA(flags, reinterpret_cast<LPCSTR>(address), &module_handle))
+    {
+        snprintf(out_buffer, buffer_size, "0x%llx", static_cast<unsigned long long>(address));
+        return;
+    }
+
+    char module_path[MAX_PATH];
+    const DWORD module_path_length = GetModuleFileNameA(module_handle, module_path, MAX_PATH);
+    const char* module_name = (module_path_length > 0) ? module_path : "unknown";
+    if (const char* last_separator = strrchr(module_name, '\\'))
+        module_name = last_separator + 1;
+
+    snprintf(out_buffer, buffer_size, "%s+0x%llx", module_name, static_cast<unsigned long long>(address - reinterpret_cast<uintptr>(module_handle)));
+}
+
 } // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
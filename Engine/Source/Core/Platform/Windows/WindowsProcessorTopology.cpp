@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/PlatformCore.h>
+    #include <Core/Platform/ProcessorTopology.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+namespace CaveGame
+{
+
+// Invokes the callback for every logical processor (identified by its `ProcessorSet` index) in the group mask.
+template<typename Callback>
+static void for_each_processor_in_group_mask(const GROUP_AFFINITY& group_mask, Callback callback)
+{
+    for (u32 bit_index = 0; bit_index < 64; ++bit_index)
+    {
+        if (group_mask.Mask & (static_cast<KAFFINITY>(1) << bit_index))
+        {
+            const u32 processor_index = static_cast<u32>(group_mask.Group) * 64 + bit_index;
+            if (processor_index < ProcessorSet::maximum_processor_count)
+                callback(processor_index);
+        }
+    }
+}
+
+bool PlatformCore::query_processor_topology(ProcessorTopology& out_topology)
+{
+    // The first call returns the size of the buffer required to store the processor information.
+    DWORD buffer_size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &buffer_size);
+
+    Vector<u8> buffer;
+    buffer.set_count_uninitialized(buffer_size);
+    if (buffer_size == 0 || !GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.elements()), &buffer_size))
+    {
+        // Report every logical processor as a separate physical core.
+        Vector<Detail::RawLogicalProcessorInfo> raw_processors;
+        for (u32 processor_index = 0; processor_index < get_logical_processor_count(); ++processor_index)
+            raw_processors.add({ processor_index, processor_index, 0, 0, processor_index, 0 });
+
+        Detail::build_processor_topology(raw_processors, out_topology);
+        return false;
+    }
+
+    // The raw identifiers are the indices of the relationship records, indexed by the logical processor index.
+    static constexpr u64 invalid_id = static_cast<u64>(-1);
+    Vector<Detail::RawLogicalProcessorInfo> processors_by_index;
+    processors_by_index.set_count(ProcessorSet::maximum_processor_count, { 0, invalid_id, 0, 0, invalid_id, invalid_id });
+
+    u64 record_index = 0;
+    for (DWORD offset = 0; offset < buffer_size; ++record_index)
+    {
+        const auto* information = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.elements() + offset);
+        offset += information->Size;
+
+        switch (information->Relationship)
+        {
+            case RelationProcessorCore:
+            {
+                for (WORD group_index = 0; group_index < information->Processor.GroupCount; ++group_index)
+                {
+                    for_each_processor_in_group_mask(
+                        information->Processor.GroupMask[group_index],
+                        [&](u32 processor_index) { processors_by_index[processor_index].physical_core_id = record_index; }
+                    );
+                }
+                break;
+            }
+
+            case RelationProcessorPackage:
+            {
+                for (WORD group_index = 0; group_index < information->Processor.GroupCount; ++group_index)
+                {
+                    for_each_processor_in_group_mask(
+                        information->Processor.GroupMask[group_index],
+                        [&](u32 processor_index) { processors_by_index[processor_index].package_id = record_index; }
+                    );
+                }
+                break;
+            }
+
+            case RelationNumaNode:
+            {
+                for_each_processor_in_group_mask(
+                    information->NumaNode.GroupMask,
+                    [&](u32 processor_index) { processors_by_index[processor_index].numa_node_id = information->NumaNode.NodeNumber; }
+                );
+                break;
+            }
+
+            case RelationCache:
+            {
+                const CACHE_RELATIONSHIP& cache = information->Cache;
+                if (cache.Type == CacheInstruction || (cache.Level != 2 && cache.Level != 3))
+                    break;
+
+                for_each_processor_in_group_mask(
+                    cache.GroupMask,
+                    [&](u32 processor_index)
+                    {
+                        if (cache.Level == 2)
+                            processors_by_index[processor_index].l2_cache_id = record_index;
+                        else
+                            processors_by_index[processor_index].l3_cache_id = record_index;
+                    }
+                );
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    Vector<Detail::RawLogicalProcessorInfo> raw_processors;
+    for (u32 processor_index = 0; processor_index < ProcessorSet::maximum_processor_count; ++processor_index)
+    {
+        Detail::RawLogicalProcessorInfo raw_processor = processors_by_index[processor_index];
+        if (raw_processor.physical_core_id == invalid_id)
+            continue;
+
+        // Processors without a dedicated L2 or L3 cache entry are assumed not to share them.
+        raw_processor.processor_index = processor_index;
+        if (raw_processor.l2_cache_id == invalid_id)
+            raw_processor.l2_cache_id = record_index + processor_index;
+        if (raw_processor.l3_cache_id == invalid_id)
+            raw_processor.l3_cache_id = raw_processor.package_id;
+        raw_processors.add(raw_processor);
+    }
+
+    Detail::build_processor_topology(raw_processors, out_topology);
+    return true;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Profiling/SamplingProfiler.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: Windows has no equivalent of per-thread profiling signals (sampling would require suspending the threads from
+// a separate thread), thus the sampling profiler is unavailable and `SamplingProfiler::start` always fails.
+//
+
+bool SamplingProfiler::start(MAYBE_UNUSED u32 sampling_frequency)
+{
+    return false;
+}
+
+void SamplingProfiler::stop()
+{}
+
+void SamplingProfiler::shutdown()
+{}
+
+bool SamplingProfiler::is_running()
+{
+    return false;
+}
+
+void SamplingProfiler::register_current_thread(MAYBE_UNUSED StringView name)
+{}
+
+void SamplingProfiler::process_samples()
+{}
+
+u64 SamplingProfiler::get_sample_count()
+{
+    return 0;
+}
+
+u64 SamplingProfiler::get_lost_sample_count()
+{
+    return 0;
+}
+
+void SamplingProfiler::reset()
+{}
+
+bool SamplingProfiler::write_folded_stacks(MAYBE_UNUSED StringView filepath)
+{
+    return false;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
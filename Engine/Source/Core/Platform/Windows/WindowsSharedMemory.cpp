@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/SharedMemory.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+    #include <cstdio>
+
+namespace CaveGame
+{
+
+static constexpr usize s_maximum_object_name_length = 255;
+
+//
+// NOTE: The `Local\` prefix places the object in the session namespace, which doesn't require any privileges (unlike
+// the `Global\` namespace). The processes of the same user session can access it.
+//
+static void get_file_mapping_name(StringView name, char (&out_object_name)[s_maximum_object_name_length + 1])
+{
+    snprintf(out_object_name, sizeof(out_object_name), "Local\\%.*s", static_cast<int>(name.byte_count()), name.characters());
+}
+
+bool SharedMemoryRegion::create(StringView name, usize byte_count)
+{
+    if (m_data != nullptr || byte_count == 0)
+        return false;
+
+    char object_name[s_maximum_object_name_length + 1];
+    get_file_mapping_name(name, object_name);
+
+    // The file mapping is backed by the paging file and its pages are zero-initialized.
+    const DWORD byte_count_high = static_cast<DWORD>(static_cast<u64>(byte_count) >> 32);
+    const DWORD byte_count_low = static_cast<DWORD>(byte_count & 0xFFFFFFFF);
+    HANDLE mapping_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, byte_count_high, byte_count_low, object_name);
+    if (mapping_handle == nullptr)
+        return false;
+
+    void* data = MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, byte_count);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping_handle);
+        return false;
+    }
+
+    m_data = data;
+    m_byte_count = byte_count;
+    m_native_handle = mapping_handle;
+    m_is_owner = true;
+    return true;
+}
+
+bool SharedMemoryRegion::open(StringView name)
+{
+    if (m_data != nullptr)
+        return false;
+
+    char object_name[s_maximum_object_name_length + 1];
+    get_file_mapping_name(name, object_name);
+
+    HANDLE mapping_handle = OpenFileMappingA(FILE_MAP_READ, FALSE, object_name);
+    if (mapping_handle == nullptr)
+        return false;
+
+    void* data = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping_handle);
+        return false;
+    }
+
+    // NOTE: The size of the view is rounded up to the page size, which is fine as the layout stores its own size.
+    MEMORY_BASIC_INFORMATION memory_information;
+    VirtualQuery(data, &memory_information, sizeof(memory_information));
+
+    m_data = data;
+    m_byte_count = memory_information.RegionSize;
+    m_native_handle = mapping_handle;
+    m_is_owner = false;
+    return true;
+}
+
+void SharedMemoryRegion::close()
+{
+    if (m_data == nullptr)
+        return;
+
+    // The file mapping is destroyed when the last process closes its handle, so the name doesn't have to be removed.
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_native_handle));
+
+    m_data = nullptr;
+    m_byte_count = 0;
+    m_native_handle = nullptr;
+    m_is_owner = false;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
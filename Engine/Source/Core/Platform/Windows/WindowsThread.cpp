@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/Thread.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+    #include <cstring>
+
+namespace CaveGame
+{
+
+static constexpr usize s_maximum_thread_name_size = 64;
+
+struct WindowsThreadStartData
+{
+    Thread::EntryPoint entry_point;
+    void* user_data;
+
+    // The description is copied, as the name might not outlive the call to `Thread::create`.
+    char name[s_maximum_thread_name_size];
+    ThreadPriority priority;
+    ProcessorSet affinity;
+};
+
+static DWORD WINAPI windows_thread_start_routine(LPVOID parameter)
+{
+    WindowsThreadStartData* start_data = static_cast<WindowsThreadStartData*>(parameter);
+
+    ThreadDescription description;
+    description.name = StringView::create_from_utf8(start_data->name);
+    description.priority = start_data->priority;
+    description.affinity = start_data->affinity;
+    Thread::apply_current_thread_description(description);
+
+    const Thread::EntryPoint entry_point = start_data->entry_point;
+    void* user_data = start_data->user_data;
+    delete start_data;
+
+    entry_point(user_data);
+    return 0;
+}
+
+bool Thread::create(EntryPoint entry_point, void* user_data, const ThreadDescription& description)
+{
+    if (m_native_handle != nullptr)
+    {
+        // The thread has already been created.
+        return false;
+    }
+
+    WindowsThreadStartData* start_data = new WindowsThreadStartData();
+    start_data->entry_point = entry_point;
+    start_data->user_data = user_data;
+    start_data->priority = description.priority;
+    start_data->affinity = description.affinity;
+
+    const usize name_byte_count = (description.name.byte_count() < s_maximum_thread_name_size) ? description.name.byte_count() : (s_maximum_thread_name_size - 1);
+    memcpy(start_data->name, description.name.characters(), name_byte_count);
+    start_data->name[name_byte_count] = '\0';
+
+    m_native_handle = CreateThread(nullptr, 0, windows_thread_start_routine, start_data, 0, nullptr);
+    if (m_native_handle == nullptr)
+    {
+        delete start_data;
+        return false;
+    }
+
+    return true;
+}
+
+void Thread::join()
+{
+    if (m_native_handle == nullptr)
+    {
+        // The thread hasn't been created or has already been joined.
+        return;
+    }
+
+    WaitForSingleObject(static_cast<HANDLE>(m_native_handle), INFINITE);
+    CloseHandle(static_cast<HANDLE>(m_native_handle));
+    m_native_handle = nullptr;
+}
+
+void Thread::set_current_thread_name(StringView name)
+{
+    // NOTE: Thread names are ASCII, so they can be widened by simply copying the characters.
+    wchar_t wide_name[s_maximum_thread_name_size];
+    const usize name_byte_count = (name.byte_count() < s_maximum_thread_name_size) ? name.byte_count() : (s_maximum_thread_name_size - 1);
+    for (usize index = 0; index < name_byte_count; ++index)
+        wide_name[index] = static_cast<wchar_t>(name.characters()[index]);
+    wide_name[name_byte_count] = L'\0';
+
+    SetThreadDescription(GetCurrentThread(), wide_name);
+}
+
+bool Thread::set_current_thread_priority(ThreadPriority priority)
+{
+    int native_priority = THREAD_PRIORITY_NORMAL;
+    switch (priority)
+    {
+        case ThreadPriority::Low: native_priority = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case ThreadPriority::Normal: native_priority = THREAD_PRIORITY_NORMAL; break;
+        case ThreadPriority::High: native_priority = THREAD_PRIORITY_ABOVE_NORMAL; break;
+        case ThreadPriority::Highest: native_priority = THREAD_PRIORITY_HIGHEST; break;
+    }
+
+    return (SetThreadPriority(GetCurrentThread(), native_priority) != 0);
+}
+
+bool Thread::set_current_thread_affinity(const ProcessorSet& affinity)
+{
+    // A thread can only be bound to the processors of a single group, which is the group of the first processor in the set.
+    for (u32 first_processor_index = 0; first_processor_index < ProcessorSet::maximum_processor_count; first_processor_index += 64)
+    {
+        const u64 group_mask = affinity.get_word(first_processor_index);
+        if (group_mask == 0)
+            continue;
+
+        GROUP_AFFINITY group_affinity = {};
+        group_affinity.Group = static_cast<WORD>(first_processor_index / 64);
+        group_affinity.Mask = static_cast<KAFFINITY>(group_mask);
+        return (SetThreadGroupAffinity(GetCurrentThread(), &group_affinity, nullptr) != 0);
+    }
+
+    return false;
+}
+
+bool Semaphore::initialize(u32 initial_count)
+{
+    if (m_native_handle != nullptr)
+    {
+        // The semaphore has already been initialized.
+        return false;
+    }
+
+    m_native_handle = CreateSemaphoreA(nullptr, static_cast<LONG>(initial_count), MAXLONG, nullptr);
+    return (m_native_handle != nullptr);
+}
+
+void Semaphore::shutdown()
+{
+    if (m_native_handle == nullptr)
+    {
+        // The semaphore has already been shut down.
+        return;
+    }
+
+    CloseHandle(static_cast<HANDLE>(m_native_handle));
+    m_native_handle = nullptr;
+}
+
+void Semaphore::wait()
+{
+    CAVE_ASSERT(m_native_handle != nullptr);
+    WaitForSingleObject(static_cast<HANDLE>(m_native_handle), INFINITE);
+}
+
+void Semaphore::signal(u32 count)
+{
+    CAVE_ASSERT(m_native_handle != nullptr);
+    ReleaseSemaphore(static_cast<HANDLE>(m_native_handle), static_cast<LONG>(count), nullptr);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/String.h>
+#include <Core/Profiling/CounterProfiler.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+struct CounterScopeEntry
+{
+    // Null if the entry is unused.
+    const char* name { nullptr };
+    u64 call_count { 0 };
+    PerformanceCounterSample totals;
+};
+
+struct CounterProfilerThreadData
+{
+    PerformanceCounterGroup counter_group;
+
+    // Protects the entries, which are read by the thread that collects the statistics.
+    SpinLock lock;
+
+    // Open-addressing hash table, indexed by the address of the scope name.
+    CounterScopeEntry entries[CounterProfiler::maximum_scope_count_per_thread];
+    u32 entry_count { 0 };
+};
+
+struct CounterProfilerData
+{
+    std::atomic<bool> is_enabled { false };
+
+    // Protects the registration of the threads.
+    SpinLock registry_lock;
+    CounterProfilerThreadData* threads[Profiler::maximum_thread_count] {};
+    u32 thread_count { 0 };
+
+    // Accessed only by the main thread.
+    PerformanceCounterSample frame_start_sample;
+    PerformanceCounterSample last_frame_sample;
+    bool has_frame_start_sample { false };
+};
+
+static CounterProfilerData s_counter_profiler;
+static thread_local CounterProfilerThreadData* t_counter_thread_data = nullptr;
+static thread_local bool t_is_counter_group_open_attempted = false;
+
+static constexpr const char* s_frame_scope_name = "Frame";
+
+#pragma region CounterScopeStatistics
+
+double CounterScopeStatistics::get_instructions_per_cycle() const
+{
+    const u64 cycles = totals.get(PerformanceCounterType::Cycles);
+    if (cycles == 0)
+        return 0.0;
+    return static_cast<double>(totals.get(PerformanceCounterType::Instructions)) / static_cast<double>(cycles);
+}
+
+double CounterScopeStatistics::get_events_per_kilo_instruction(PerformanceCounterType counter_type) const
+{
+    const u64 instructions = totals.get(PerformanceCounterType::Instructions);
+    if (instructions == 0)
+        return 0.0;
+    return static_cast<double>(totals.get(counter_type)) * 1000.0 / static_cast<double>(instructions);
+}
+
+#pragma endregion
+
+#pragma region CounterProfiler
+
+// Returns null if the counters can't be opened for the calling thread.
+NODISCARD static CounterProfilerThreadData* get_current_thread_data()
+{
+    if (t_counter_thread_data != nullptr || t_is_counter_group_open_attempted)
+        return t_counter_thread_data;
+
+    // NOTE: Opening the counters is only attempted once per thread, as it is a (slow) system call.
+    t_is_counter_group_open_attempted = true;
+
+    CounterProfilerThreadData* thread_data = new CounterProfilerThreadData();
+    if (!thread_data->counter_group.open())
+    {
+        delete thread_data;
+        return nullptr;
+    }
+
+    ScopedLock<SpinLock> registry_lock(s_counter_profiler.registry_lock);
+    if (s_counter_profiler.thread_count >= Profiler::maximum_thread_count)
+    {
+        thread_data->counter_group.close();
+        delete thread_data;
+        return nullptr;
+    }
+
+    s_counter_profiler.threads[s_counter_profiler.thread_count++] = thread_data;
+    t_counter_thread_data = thread_data;
+    return thread_data;
+}
+
+static void accumulate_scope_sample(CounterProfilerThreadData& thread_data, const char* name, const PerformanceCounterSample& delta_sample)
+{
+    static constexpr u32 entry_mask = CounterProfiler::maximum_scope_count_per_thread - 1;
+    static_assert((CounterProfiler::maximum_scope_count_per_thread & entry_mask) == 0);
+
+    ScopedLock<SpinLock> lock(thread_data.lock);
+
+    // Fibonacci hashing of the name address, skipping its low bits (which are mostly equal because of alignment).
+    u32 entry_index = static_cast<u32>(((reinterpret_cast<uintptr>(name) >> 3) * 0x9E3779B97F4A7C15ull) >> 56) & entry_mask;
+    for (u32 probe_count = 0; probe_count < CounterProfiler::maximum_scope_count_per_thread; ++probe_count)
+    {
+        CounterScopeEntry& entry = thread_data.entries[entry_index];
+        if (entry.name == nullptr)
+        {
+            entry.name = name;
+            ++thread_data.entry_count;
+        }
+
+        if (entry.name == name)
+        {
+            ++entry.call_count;
+            for (u8 counter_index = 0; counter_index < static_cast<u8>(PerformanceCounterType::Count); ++counter_index)
+                entry.totals.values[counter_index] += delta_sample.values[counter_index];
+            return;
+        }
+
+        entry_index = (entry_index + 1) & entry_mask;
+    }
+
+    // NOTE: The table is full, so the sample is dropped.
+}
+
+NODISCARD static PerformanceCounterSample compute_delta_sample(const PerformanceCounterSample& start_sample, const PerformanceCounterSample& end_sample)
+{
+    PerformanceCounterSample delta_sample;
+    for (u8 counter_index = 0; counter_index < static_cast<u8>(PerformanceCounterType::Count); ++counter_index)
+    {
+        // NOTE: The extrapolated values of multiplexed counters aren't guaranteed to be monotonic.
+        const u64 start_value = start_sample.values[counter_index];
+        const u64 end_value = end_sample.values[counter_index];
+        delta_sample.values[counter_index] = (end_value > start_value) ? (end_value - start_value) : 0;
+    }
+    return delta_sample;
+}
+
+bool CounterProfiler::initialize()
+{
+    if (is_enabled())
+    {
+        // The counter profiler has already been initialized.
+        return false;
+    }
+
+    // Retry opening the counters, in case a previous attempt has been made before the shutdown.
+    t_is_counter_group_open_attempted = false;
+    if (get_current_thread_data() == nullptr)
+        return false;
+
+    s_counter_profiler.has_frame_start_sample = false;
+    s_counter_profiler.last_frame_sample = {};
+    s_counter_profiler.is_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void CounterProfiler::shutdown()
+{
+    s_counter_profiler.is_enabled.store(false, std::memory_order_relaxed);
+
+    ScopedLock<SpinLock> registry_lock(s_counter_profiler.registry_lock);
+    for (u32 thread_index = 0; thread_index < s_counter_profiler.thread_count; ++thread_index)
+    {
+        s_counter_profiler.threads[thread_index]->counter_group.close();
+        delete s_counter_profiler.threads[thread_index];
+        s_counter_profiler.threads[thread_index] = nullptr;
+    }
+    s_counter_profiler.thread_count = 0;
+
+    // NOTE: The data of the other threads has been released, so they must not use counter scopes from now on.
+    t_counter_thread_data = nullptr;
+    t_is_counter_group_open_attempted = false;
+}
+
+bool CounterProfiler::is_enabled()
+{
+    return s_counter_profiler.is_enabled.load(std::memory_order_relaxed);
+}
+
+void CounterProfiler::mark_frame()
+{
+    if (!is_enabled())
+        return;
+
+    CounterProfilerThreadData* thread_data = get_current_thread_data();
+    if (thread_data == nullptr)
+        return;
+
+    PerformanceCounterSample frame_end_sample;
+    if (!thread_data->counter_group.read(frame_end_sample))
+        return;
+
+    if (s_counter_profiler.has_frame_start_sample)
+    {
+        s_counter_profiler.last_frame_sample = compute_delta_sample(s_counter_profiler.frame_start_sample, frame_end_sample);
+        accumulate_scope_sample(*thread_data, s_frame_scope_name, s_counter_profiler.last_frame_sample);
+    }
+
+    s_counter_profiler.frame_start_sample = frame_end_sample;
+    s_counter_profiler.has_frame_start_sample = true;
+}
+
+const PerformanceCounterSample& CounterProfiler::get_last_frame_sample()
+{
+    return s_counter_profiler.last_frame_sample;
+}
+
+bool CounterProfiler::begin_scope(PerformanceCounterSample& out_start_sample)
+{
+    CounterProfilerThreadData* thread_data = get_current_thread_data();
+    if (thread_data == nullptr)
+        return false;
+    return thread_data->counter_group.read(out_start_sample);
+}
+
+void CounterProfiler::end_scope(const char* name, const PerformanceCounterSample& start_sample)
+{
+    CounterProfilerThreadData* thread_data = t_counter_thread_data;
+    CAVE_ASSERT(thread_data != nullptr);
+
+    PerformanceCounterSample end_sample;
+    if (!thread_data->counter_group.read(end_sample))
+        return;
+
+    accumulate_scope_sample(*thread_data, name, compute_delta_sample(start_sample, end_sample));
+}
+
+void CounterProfiler::collect_scope_statistics(Vector<CounterScopeStatistics>& out_statistics)
+{
+    const usize first_statistics_index = out_statistics.count();
+
+    ScopedLock<SpinLock> registry_lock(s_counter_profiler.registry_lock);
+    for (u32 thread_index = 0; thread_index < s_counter_profiler.thread_count; ++thread_index)
+    {
+        CounterProfilerThreadData& thread_data = *s_counter_profiler.threads[thread_index];
+        ScopedLock<SpinLock> lock(thread_data.lock);
+
+        for (const CounterScopeEntry& entry : thread_data.entries)
+        {
+            if (entry.name == nullptr)
+                continue;
+
+            // The same name might be stored at different addresses, thus the names are compared by their contents.
+            CounterScopeStatistics* statistics = nullptr;
+            for (usize statistics_index = first_statistics_index; statistics_index < out_statistics.count(); ++statistics_index)
+            {
+                if (strcmp(out_statistics[statistics_index].name, entry.name) == 0)
+                {
+                    statistics = &out_statistics[statistics_index];
+                    break;
+                }
+            }
+
+            if (statistics == nullptr)
+            {
+                out_statistics.add({ entry.name, 0, {} });
+                statistics = &out_statistics.last();
+            }
+
+            statistics->call_count += entry.call_count;
+            for (u8 counter_index = 0; counter_index < static_cast<u8>(PerformanceCounterType::Count); ++counter_index)
+                statistics->totals.values[counter_index] += entry.totals.values[counter_index];
+        }
+    }
+}
+
+bool CounterProfiler::write_report(StringView filepath)
+{
+    if (!is_enabled())
+        return false;
+
+    Vector<CounterScopeStatistics> statistics;
+    collect_scope_statistics(statistics);
+
+    const String filepath_string = String(filepath);
+
+#if CAVE_COMPILER_MSVC
+    FILE* file = nullptr;
+    if (fopen_s(&file, filepath_string.characters(), "wb") != 0)
+        return false;
+#else
+    FILE* file = fopen(filepath_string.characters(), "wb");
+    if (!file)
+        return false;
+#endif // CAVE_COMPILER_MSVC
+
+    fputs("scope,calls,cycles,instructions,ipc,l1d_misses_pki,llc_misses_pki,branch_misses_pki\n", file);
+    for (const CounterScopeStatistics& scope_statistics : statistics)
+    {
+        fprintf(
+            file,
+            "%s,%llu,%llu,%llu,%.3f,%.3f,%.3f,%.3f\n",
+            scope_statistics.name,
+            static_cast<unsigned long long>(scope_statistics.call_count),
+            static_cast<unsigned long long>(scope_statistics.totals.get(PerformanceCounterType::Cycles)),
+            static_cast<unsigned long long>(scope_statistics.totals.get(PerformanceCounterType::Instructions)),
+            scope_statistics.get_instructions_per_cycle(),
+            scope_statistics.get_events_per_kilo_instruction(PerformanceCounterType::L1DataCacheMisses),
+            scope_statistics.get_events_per_kilo_instruction(PerformanceCounterType::LastLevelCacheMisses),
+            scope_statistics.get_events_per_kilo_instruction(PerformanceCounterType::BranchMisses)
+        );
+    }
+
+    const bool is_successful = (ferror(file) == 0);
+    fclose(file);
+    return is_successful;
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/StringView.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+#include <Core/Platform/PerformanceCounters.h>
+#include <Core/Profiling/Profiler.h>
+
+namespace CaveGame
+{
+
+// The hardware counter totals of all the executions of a profiled scope, on all threads.
+struct CounterScopeStatistics
+{
+    const char* name { nullptr };
+    u64 call_count { 0 };
+    PerformanceCounterSample totals;
+
+    // Instructions retired per cycle. Zero if the counters are unavailable.
+    NODISCARD double get_instructions_per_cycle() const;
+
+    // The number of events of the given type (usually misses) per thousand retired instructions.
+    NODISCARD double get_events_per_kilo_instruction(PerformanceCounterType counter_type) const;
+};
+
+//
+// Extension of the profiler that attaches hardware performance counter deltas to the scopes profiled with
+// `CAVE_PROFILE_COUNTERS_SCOPE` and to the frames. The deltas are accumulated per scope name and reported as
+// instructions per cycle and misses per thousand instructions, which tell whether the code is compute or memory bound.
+//
+// Reading the counters is a system call (about a microsecond), so only coarse scopes should be measured. The deltas
+// include the nested scopes. If the counters aren't available (see `PerformanceCounterGroup`), the counter scopes
+// only record regular profiler events.
+//
+class CounterProfiler
+{
+public:
+    static constexpr u32 maximum_scope_count_per_thread = 256;
+
+public:
+    //
+    // Enables the counters. Every thread opens its counters lazily, when it enters its first counter scope.
+    // Returns false if the counters can't be opened for the calling thread, in which case the profiler stays disabled.
+    //
+    static bool initialize();
+
+    // Closes the counters of all threads. No thread must use counter scopes during or after the shutdown.
+    static void shutdown();
+
+    NODISCARD static bool is_enabled();
+
+    // Accumulates the counter deltas of the frame that just ended. Invoked by the engine, only from the main thread.
+    static void mark_frame();
+
+    // Returns the counter deltas of the last completed frame, measured on the main thread.
+    NODISCARD static const PerformanceCounterSample& get_last_frame_sample();
+
+    // Appends the statistics of every scope (and of the frames, named "Frame"), merged across all threads by name.
+    static void collect_scope_statistics(Vector<CounterScopeStatistics>& out_statistics);
+
+    // Writes the scope statistics to the given file, in the CSV format. Returns false if the file can't be written.
+    static bool write_report(StringView filepath);
+
+public:
+    // Returns false if the counters aren't available for the calling thread.
+    NODISCARD static bool begin_scope(PerformanceCounterSample& out_start_sample);
+    static void end_scope(const char* name, const PerformanceCounterSample& start_sample);
+};
+
+// Records a regular profiler scope and accumulates the counter deltas of the scope.
+class CounterProfilerScope
+{
+    CAVE_MAKE_NONCOPYABLE(CounterProfilerScope);
+    CAVE_MAKE_NONMOVABLE(CounterProfilerScope);
+
+public:
+    ALWAYS_INLINE explicit CounterProfilerScope(const char* name)
+        : m_profiler_scope(name)
+        , m_name(name)
+    {
+        m_is_measured = CounterProfiler::is_enabled() && CounterProfiler::begin_scope(m_start_sample);
+    }
+
+    ALWAYS_INLINE ~CounterProfilerScope()
+    {
+        if (m_is_measured)
+            CounterProfiler::end_scope(m_name, m_start_sample);
+    }
+
+private:
+    ProfilerScope m_profiler_scope;
+    const char* m_name;
+    PerformanceCounterSample m_start_sample;
+    bool m_is_measured;
+};
+
+} // namespace CaveGame
+
+#if CAVE_ENABLE_PROFILING
+    // Profiles the enclosing scope and measures its hardware performance counters. The name must be a string literal.
+    #define CAVE_PROFILE_COUNTERS_SCOPE(name)   ::CaveGame::CounterProfilerScope CAVE_PROFILE_CONCATENATE(cave_counter_profiler_scope_, __LINE__)(name)
+    #define CAVE_PROFILE_COUNTERS_MARK_FRAME() ::CaveGame::CounterProfiler::mark_frame()
+#else
+    #define CAVE_PROFILE_COUNTERS_SCOPE(name)
+    #define CAVE_PROFILE_COUNTERS_MARK_FRAME()
+#endif // CAVE_ENABLE_PROFILING
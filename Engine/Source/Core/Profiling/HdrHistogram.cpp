@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Profiling/HdrHistogram.h>
+
+namespace CaveGame
+{
+
+HdrHistogram::HdrHistogram(u64 highest_trackable_value, u32 significant_digit_count)
+    : m_highest_trackable_value(highest_trackable_value)
+{
+    CAVE_ASSERT(significant_digit_count >= 1 && significant_digit_count <= 5);
+    CAVE_ASSERT(highest_trackable_value >= 2);
+
+    // The sub-buckets must be small enough to distinguish between `2 * 10^digits` consecutive values.
+    u64 largest_value_with_single_unit_resolution = 2;
+    for (u32 digit_index = 0; digit_index < significant_digit_count; ++digit_index)
+        largest_value_with_single_unit_resolution *= 10;
+
+    const u32 sub_bucket_count_magnitude = static_cast<u32>(std::bit_width(largest_value_with_single_unit_resolution - 1));
+    m_sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+    const u64 sub_bucket_count = static_cast<u64>(1) << sub_bucket_count_magnitude;
+    m_sub_bucket_half_count = sub_bucket_count / 2;
+    m_sub_bucket_mask = sub_bucket_count - 1;
+
+    // Every bucket doubles the range covered by the previous bucket.
+    u64 smallest_untrackable_value = sub_bucket_count;
+    u32 bucket_count = 1;
+    while (smallest_untrackable_value <= highest_trackable_value)
+    {
+        if (smallest_untrackable_value > (static_cast<u64>(-1) / 2))
+        {
+            ++bucket_count;
+            break;
+        }
+
+        smallest_untrackable_value <<= 1;
+        ++bucket_count;
+    }
+
+    m_counts.set_count_defaulted(static_cast<usize>(bucket_count + 1) * static_cast<usize>(m_sub_bucket_half_count));
+}
+
+void HdrHistogram::reset()
+{
+    for (u64& count : m_counts)
+        count = 0;
+
+    m_total_count = 0;
+    m_total_sum = 0;
+    m_minimum_value = static_cast<u64>(-1);
+    m_maximum_value = 0;
+}
+
+void HdrHistogram::add(const HdrHistogram& other)
+{
+    CAVE_ASSERT(m_counts.count() == other.m_counts.count());
+    CAVE_ASSERT(m_sub_bucket_half_count == other.m_sub_bucket_half_count);
+
+    for (usize counts_index = 0; counts_index < m_counts.count(); ++counts_index)
+        m_counts.unchecked_at(counts_index) += other.m_counts.unchecked_at(counts_index);
+
+    m_total_count += other.m_total_count;
+    m_total_sum += other.m_total_sum;
+    if (other.m_minimum_value < m_minimum_value)
+        m_minimum_value = other.m_minimum_value;
+    if (other.m_maximum_value > m_maximum_value)
+        m_maximum_value = other.m_maximum_value;
+}
+
+u64 HdrHistogram::get_value_at_percentile(double percentile) const
+{
+    if (m_total_count == 0)
+        return 0;
+
+    const double clamped_percentile = (percentile < 0.0) ? 0.0 : ((percentile > 100.0) ? 100.0 : percentile);
+    u64 count_at_percentile = static_cast<u64>(clamped_percentile / 100.0 * static_cast<double>(m_total_count) + 0.5);
+    if (count_at_percentile == 0)
+        count_at_percentile = 1;
+
+    u64 cumulative_count = 0;
+    for (usize counts_index = 0; counts_index < m_counts.count(); ++counts_index)
+    {
+        cumulative_count += m_counts.unchecked_at(counts_index);
+        if (cumulative_count >= count_at_percentile)
+        {
+            // NOTE: The highest equivalent value can exceed the largest recorded value, which is known exactly.
+            const u64 value = get_highest_equivalent_value(get_value_from_counts_index(counts_index));
+            return (value < m_maximum_value) ? value : m_maximum_value;
+        }
+    }
+
+    return m_maximum_value;
+}
+
+u64 HdrHistogram::get_count_above_value(u64 value) const
+{
+    if (value >= m_highest_trackable_value)
+        return 0;
+
+    u64 count = 0;
+    for (usize counts_index = get_counts_index(value) + 1; counts_index < m_counts.count(); ++counts_index)
+        count += m_counts.unchecked_at(counts_index);
+    return count;
+}
+
+u64 HdrHistogram::get_value_from_counts_index(usize counts_index) const
+{
+    i64 bucket_index = static_cast<i64>(counts_index >> m_sub_bucket_half_count_magnitude) - 1;
+    u64 sub_bucket_index = (counts_index & (m_sub_bucket_half_count - 1)) + m_sub_bucket_half_count;
+    if (bucket_index < 0)
+    {
+        // The first half of the first bucket isn't shared with a previous bucket.
+        sub_bucket_index -= m_sub_bucket_half_count;
+        bucket_index = 0;
+    }
+
+    return sub_bucket_index << bucket_index;
+}
+
+u64 HdrHistogram::get_highest_equivalent_value(u64 value) const
+{
+    const u32 bucket_index = get_bucket_index(value);
+    const u64 sub_bucket_index = value >> bucket_index;
+    const u64 lowest_equivalent_value = sub_bucket_index << bucket_index;
+
+    // The sub-buckets of a bucket are `2^bucket_index` values wide.
+    return lowest_equivalent_value + (static_cast<u64>(1) << bucket_index) - 1;
+}
+
+} // namespace CaveGame
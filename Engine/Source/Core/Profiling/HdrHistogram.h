@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+
+#include <bit>
+
+namespace CaveGame
+{
+
+//
+// High dynamic range histogram, based on the design by Gil Tene (https://hdrhistogram.github.io/HdrHistogram).
+//
+// Records non-negative integer values in `[0, highest_trackable_value]` with a constant relative precision, given by
+// the number of significant decimal digits: with 3 digits, every value is stored with an error of at most 0.1%.
+// The values are grouped in buckets whose width doubles with every bucket, and every bucket is split in the same
+// number of linear sub-buckets, thus recording a value is a few bit operations and an increment. The memory usage
+// only depends on the configuration, not on the number of recorded values.
+//
+class HdrHistogram
+{
+public:
+    HdrHistogram(u64 highest_trackable_value, u32 significant_digit_count = 3);
+
+    // Values greater than the highest trackable value are recorded as the highest trackable value.
+    ALWAYS_INLINE void record(u64 value, u64 count = 1)
+    {
+        const u64 clamped_value = (value <= m_highest_trackable_value) ? value : m_highest_trackable_value;
+        // NOTE: The value is clamped to the highest trackable value, so its index is always in bounds.
+        m_counts.unchecked_at(get_counts_index(clamped_value)) += count;
+
+        m_total_count += count;
+        m_total_sum += value * count;
+        if (value < m_minimum_value)
+            m_minimum_value = value;
+        if (value > m_maximum_value)
+            m_maximum_value = value;
+    }
+
+    void reset();
+
+    // Adds all the values recorded by another histogram, which must have the same configuration.
+    void add(const HdrHistogram& other);
+
+public:
+    NODISCARD ALWAYS_INLINE u64 get_highest_trackable_value() const { return m_highest_trackable_value; }
+    NODISCARD ALWAYS_INLINE u64 get_total_count() const { return m_total_count; }
+
+    // The minimum and maximum values are exact. Both return zero if no value has been recorded.
+    NODISCARD ALWAYS_INLINE u64 get_minimum_value() const { return (m_total_count > 0) ? m_minimum_value : 0; }
+    NODISCARD ALWAYS_INLINE u64 get_maximum_value() const { return m_maximum_value; }
+
+    NODISCARD ALWAYS_INLINE double get_mean_value() const
+    {
+        return (m_total_count > 0) ? static_cast<double>(m_total_sum) / static_cast<double>(m_total_count) : 0.0;
+    }
+
+    //
+    // Returns the smallest value that is greater than or equal to the given percentage (in `[0, 100]`) of the
+    // recorded values, rounded up to the precision of the histogram. Returns zero if no value has been recorded.
+    //
+    NODISCARD u64 get_value_at_percentile(double percentile) const;
+
+    // Returns the number of recorded values that are greater than the given value, at the precision of the histogram.
+    NODISCARD u64 get_count_above_value(u64 value) const;
+
+private:
+    NODISCARD ALWAYS_INLINE u32 get_bucket_index(u64 value) const
+    {
+        // The index of the most significant bit, relative to the first bucket.
+        return static_cast<u32>(64 - count_leading_zeros(value | m_sub_bucket_mask)) - (m_sub_bucket_half_count_magnitude + 1);
+    }
+
+    NODISCARD ALWAYS_INLINE usize get_counts_index(u64 value) const
+    {
+        const u32 bucket_index = get_bucket_index(value);
+        const u64 sub_bucket_index = value >> bucket_index;
+
+        // NOTE: The lower half of the sub-buckets of every bucket (except the first one) overlaps the previous bucket,
+        // so only the upper half is stored.
+        return (static_cast<usize>(bucket_index + 1) << m_sub_bucket_half_count_magnitude) + static_cast<usize>(sub_bucket_index - m_sub_bucket_half_count);
+    }
+
+    NODISCARD u64 get_value_from_counts_index(usize counts_index) const;
+    NODISCARD u64 get_highest_equivalent_value(u64 value) const;
+
+    NODISCARD ALWAYS_INLINE static u32 count_leading_zeros(u64 value) { return static_cast<u32>(std::countl_zero(value)); }
+
+private:
+    Vector<u64> m_counts;
+    u64 m_highest_trackable_value;
+
+    u32 m_sub_bucket_half_count_magnitude;
+    u64 m_sub_bucket_half_count;
+    u64 m_sub_bucket_mask;
+
+    u64 m_total_count { 0 };
+    u64 m_total_sum { 0 };
+    u64 m_minimum_value { static_cast<u64>(-1) };
+    u64 m_maximum_value { 0 };
+};
+
+} // namespace CaveGame
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/FastClock.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/SharedMemory.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/Metrics.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+Metrics::Shard Metrics::s_shards[shard_count];
+Metrics::Gauge Metrics::s_gauges[maximum_metric_count];
+
+struct MetricDescription
+{
+    char name[MetricsRegionEntry::maximum_name_length + 1];
+    MetricType type;
+    // The index of the first shard value (for counters and histograms) or the index of the gauge.
+    u32 storage_index;
+};
+
+struct MetricsData
+{
+    // Protects the registration of the metrics and the assignment of the thread shards.
+    SpinLock registry_lock;
+    MetricDescription metrics[Metrics::maximum_metric_count] {};
+    std::atomic<u32> metric_count { 0 };
+
+    //
+    // The first shard values and the first gauge are reserved: the handles of the metrics that can't be registered
+    // (because the registry is full) refer to them, so updating these handles is harmless and is never published.
+    // The reserved shard values must fit a histogram, which is the largest metric.
+    //
+    u32 next_value_index { MetricsRegionEntry::histogram_bucket_count + 1 };
+    u32 next_gauge_index { 1 };
+    u32 next_shard_index { 0 };
+
+    SharedMemoryRegion region;
+    Thread thread;
+    std::atomic<bool> should_stop { false };
+    u64 publish_interval_nanoseconds { 0 };
+    u64 publish_start_ticks { 0 };
+
+    MetricGauge resident_memory_gauge;
+};
+
+static MetricsData s_metrics;
+
+// The publishing thread checks whether it should stop at this interval.
+static constexpr u64 metrics_stop_polling_interval_nanoseconds = 50'000'000;
+
+#pragma region Registration
+
+static constexpr u32 invalid_metric_index = static_cast<u32>(-1);
+
+// Returns the index of the metric with the given name, or `invalid_metric_index` if it hasn't been registered.
+static u32 find_metric(StringView name)
+{
+    const u32 metric_count = s_metrics.metric_count.load(std::memory_order_relaxed);
+    for (u32 metric_index = 0; metric_index < metric_count; ++metric_index)
+    {
+        const MetricDescription& metric = s_metrics.metrics[metric_index];
+        const usize name_length = strlen(metric.name);
+        if (name_length == name.byte_count() && memcmp(metric.name, name.characters(), name_length) == 0)
+            return metric_index;
+    }
+    return invalid_metric_index;
+}
+
+//
+// Registers the metric and returns the index of its storage. Returns the reserved storage index (zero) if the metric
+// can't be registered. Must be called with the registry lock held.
+//
+static u32 register_metric(StringView name, MetricType type, u32 storage_value_count)
+{
+    const u32 existing_metric_index = find_metric(name);
+    if (existing_metric_index != invalid_metric_index)
+    {
+        const MetricDescription& metric = s_metrics.metrics[existing_metric_index];
+        CAVE_ASSERT(metric.type == type);
+        return (metric.type == type) ? metric.storage_index : 0;
+    }
+
+    CAVE_ASSERT(name.byte_count() <= MetricsRegionEntry::maximum_name_length);
+    const u32 metric_count = s_metrics.metric_count.load(std::memory_order_relaxed);
+    if (metric_count >= Metrics::maximum_metric_count)
+        return 0;
+
+    u32 storage_index;
+    if (type == MetricType::Gauge)
+    {
+        storage_index = s_metrics.next_gauge_index;
+        if (storage_index >= Metrics::maximum_metric_count)
+            return 0;
+        ++s_metrics.next_gauge_index;
+    }
+    else
+    {
+        storage_index = s_metrics.next_value_index;
+        if (storage_index + storage_value_count > Metrics::shard_value_capacity)
+            return 0;
+        s_metrics.next_value_index += storage_value_count;
+    }
+
+    MetricDescription& metric = s_metrics.metrics[metric_count];
+    const usize name_length = Math::min(name.byte_count(), static_cast<usize>(MetricsRegionEntry::maximum_name_length));
+    memcpy(metric.name, name.characters(), name_length);
+    metric.name[name_length] = 0;
+    metric.type = type;
+    metric.storage_index = storage_index;
+
+    // The publishing thread reads the descriptions without acquiring the registry lock.
+    s_metrics.metric_count.store(metric_count + 1, std::memory_order_release);
+    return storage_index;
+}
+
+MetricCounter Metrics::register_counter(StringView name)
+{
+    ScopedLock<SpinLock> registry_lock(s_metrics.registry_lock);
+    return MetricCounter(register_metric(name, MetricType::Counter, 1));
+}
+
+MetricGauge Metrics::register_gauge(StringView name)
+{
+    ScopedLock<SpinLock> registry_lock(s_metrics.registry_lock);
+    return MetricGauge(register_metric(name, MetricType::Gauge, 1));
+}
+
+MetricHistogram Metrics::register_histogram(StringView name)
+{
+    ScopedLock<SpinLock> registry_lock(s_metrics.registry_lock);
+    return MetricHistogram(register_metric(name, MetricType::Histogram, histogram_value_count));
+}
+
+u32 Metrics::assign_current_thread_shard()
+{
+    // NOTE: The shards are assigned round-robin, so the threads only share a shard if there are more than `shard_count`.
+    ScopedLock<SpinLock> registry_lock(s_metrics.registry_lock);
+    t_shard_index = s_metrics.next_shard_index;
+    s_metrics.next_shard_index = (s_metrics.next_shard_index + 1) % shard_count;
+    return t_shard_index;
+}
+
+#pragma endregion
+
+#pragma region Publishing
+
+u64 Metrics::sum_shard_values(u32 value_index)
+{
+    u64 value = 0;
+    for (u32 shard_index = 0; shard_index < shard_count; ++shard_index)
+        value += s_shards[shard_index].values[value_index].load(std::memory_order_relaxed);
+    return value;
+}
+
+void Metrics::publish()
+{
+    s_metrics.resident_memory_gauge.set(static_cast<i64>(PlatformCore::get_resident_memory_byte_count()));
+
+    MetricsRegionHeader* header = static_cast<MetricsRegionHeader*>(s_metrics.region.data());
+    MetricsRegionEntry* entries = reinterpret_cast<MetricsRegionEntry*>(header + 1);
+    const u32 metric_count = s_metrics.metric_count.load(std::memory_order_acquire);
+
+    // An odd sequence number marks the region as being modified (see `SeqLock`).
+    const u64 sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (u32 metric_index = 0; metric_index < metric_count; ++metric_index)
+    {
+        const MetricDescription& metric = s_metrics.metrics[metric_index];
+        MetricsRegionEntry& entry = entries[metric_index];
+
+        memcpy(entry.name, metric.name, sizeof(entry.name));
+        entry.type = metric.type;
+        entry.reserved = 0;
+        entry.value = 0;
+        entry.histogram_count = 0;
+        entry.histogram_sum = 0;
+        memset(entry.histogram_buckets, 0, sizeof(entry.histogram_buckets));
+
+        switch (metric.type)
+        {
+            case MetricType::Counter:
+                entry.value = static_cast<i64>(sum_shard_values(metric.storage_index));
+                break;
+            case MetricType::Gauge:
+                entry.value = s_gauges[metric.storage_index].value.load(std::memory_order_relaxed);
+                break;
+            case MetricType::Histogram:
+                for (u32 bucket_index = 0; bucket_index < MetricsRegionEntry::histogram_bucket_count; ++bucket_index)
+                {
+                    entry.histogram_buckets[bucket_index] = sum_shard_values(metric.storage_index + bucket_index);
+                    entry.histogram_count += entry.histogram_buckets[bucket_index];
+                }
+                entry.histogram_sum = sum_shard_values(metric.storage_index + MetricsRegionEntry::histogram_bucket_count);
+                break;
+        }
+    }
+
+    header->metric_count = metric_count;
+    header->publish_count += 1;
+    header->publish_time_nanoseconds = FastClock::ticks_to_nanoseconds(FastClock::get_ticks() - s_metrics.publish_start_ticks);
+
+    header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void Metrics::publishing_thread_entry_point(MAYBE_UNUSED void* user_data)
+{
+    while (!s_metrics.should_stop.load(std::memory_order_acquire))
+    {
+        publish();
+
+        // Sleep in short steps, so that stopping the publishing doesn't wait for a whole interval.
+        u64 slept_nanoseconds = 0;
+        while (slept_nanoseconds < s_metrics.publish_interval_nanoseconds && !s_metrics.should_stop.load(std::memory_order_acquire))
+        {
+            const u64 sleep_nanoseconds = Math::min(metrics_stop_polling_interval_nanoseconds, s_metrics.publish_interval_nanoseconds - slept_nanoseconds);
+            PlatformCore::sleep_for_nanoseconds(sleep_nanoseconds);
+            slept_nanoseconds += sleep_nanoseconds;
+        }
+    }
+}
+
+bool Metrics::start_publishing(StringView region_name, u32 publish_interval_milliseconds)
+{
+    if (s_metrics.region.is_open())
+        return false;
+    if (!s_metrics.region.create(region_name, get_region_byte_count()))
+        return false;
+
+    MetricsRegionHeader* header = static_cast<MetricsRegionHeader*>(s_metrics.region.data());
+    header->magic = MetricsRegionHeader::magic_value;
+    header->version = MetricsRegionHeader::current_version;
+    header->process_id = PlatformCore::get_current_process_id();
+
+    s_metrics.resident_memory_gauge = register_gauge("process.resident_memory_bytes"sv);
+    s_metrics.publish_interval_nanoseconds = Math::max(publish_interval_milliseconds, 1u) * 1'000'000ull;
+    s_metrics.publish_start_ticks = FastClock::get_ticks();
+    s_metrics.should_stop.store(false, std::memory_order_relaxed);
+
+    ThreadDescription description;
+    description.name = "Metrics"sv;
+    description.priority = ThreadPriority::Low;
+    if (!s_metrics.thread.create(publishing_thread_entry_point, nullptr, description))
+    {
+        s_metrics.region.close();
+        return false;
+    }
+
+    return true;
+}
+
+void Metrics::stop_publishing()
+{
+    if (!s_metrics.region.is_open())
+        return;
+
+    s_metrics.should_stop.store(true, std::memory_order_release);
+    s_metrics.thread.join();
+
+    // Publish the final values, in case a reader is still attached to the region.
+    publish();
+    s_metrics.region.close();
+}
+
+void Metrics::get_default_region_name(u32 process_id, char* out_buffer, usize buffer_size)
+{
+    snprintf(out_buffer, buffer_size, "CaveGame.%u", process_id);
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <bit>
+
+namespace CaveGame
+{
+
+enum class MetricType : u32
+{
+    // A monotonically increasing value, such as the number of executed jobs.
+    Counter = 1,
+    // A value that can increase and decrease, such as the number of loaded chunks or the used memory.
+    Gauge = 2,
+    // The distribution of a value, such as the frame duration, in power-of-two buckets.
+    Histogram = 3,
+};
+
+#pragma region Shared Memory Layout
+
+//
+// The layout of the shared memory region the metrics are published into. The layout is read by external tools, so it
+// must only be changed together with `MetricsRegionHeader::current_version`.
+//
+// The region is published with a sequence lock: the sequence number is odd while the publisher writes the region, so
+// the readers copy the region and retry if the sequence number has changed meanwhile (see `SeqLock`).
+//
+struct MetricsRegionHeader
+{
+    static constexpr u32 magic_value = 0x544D5643; // 'CVMT'
+    static constexpr u32 current_version = 1;
+
+    u32 magic;
+    u32 version;
+    u32 process_id;
+    u32 metric_count;
+    std::atomic<u64> sequence;
+    u64 publish_count;
+    // The time elapsed since the publishing has started, measured in nanoseconds.
+    u64 publish_time_nanoseconds;
+    u64 reserved;
+};
+
+struct MetricsRegionEntry
+{
+    static constexpr u32 maximum_name_length = 47;
+    static constexpr u32 histogram_bucket_count = 64;
+
+    char name[maximum_name_length + 1];
+    MetricType type;
+    u32 reserved;
+
+    // The value of the counter or of the gauge. Unused for histograms.
+    i64 value;
+
+    // The number of recorded values and their sum. Only used for histograms.
+    u64 histogram_count;
+    u64 histogram_sum;
+
+    //
+    // The first bucket counts the zero values, while the bucket `N` (with N > 0) counts the values in the range
+    // `[2^(N-1), 2^N)`. Only used for histograms.
+    //
+    u64 histogram_buckets[histogram_bucket_count];
+};
+
+static_assert(sizeof(MetricsRegionHeader) == 48, "The metrics region layout must be stable!");
+static_assert(sizeof(MetricsRegionEntry) == 592, "The metrics region layout must be stable!");
+
+#pragma endregion
+
+// Handle to a registered counter. Adding to it is a single uncontended atomic increment.
+class MetricCounter
+{
+public:
+    MetricCounter() = default;
+
+    ALWAYS_INLINE void add(u64 delta = 1) const;
+
+private:
+    friend class Metrics;
+    ALWAYS_INLINE explicit MetricCounter(u32 value_index)
+        : m_value_index(value_index)
+    {}
+
+    u32 m_value_index { 0 };
+};
+
+// Handle to a registered gauge.
+class MetricGauge
+{
+public:
+    MetricGauge() = default;
+
+    ALWAYS_INLINE void set(i64 value) const;
+    ALWAYS_INLINE void add(i64 delta) const;
+
+private:
+    friend class Metrics;
+    ALWAYS_INLINE explicit MetricGauge(u32 gauge_index)
+        : m_gauge_index(gauge_index)
+    {}
+
+    u32 m_gauge_index { 0 };
+};
+
+// Handle to a registered histogram. Recording a value is two uncontended atomic increments.
+class MetricHistogram
+{
+public:
+    MetricHistogram() = default;
+
+    ALWAYS_INLINE void record(u64 value) const;
+
+private:
+    friend class Metrics;
+    ALWAYS_INLINE explicit MetricHistogram(u32 value_index)
+        : m_value_index(value_index)
+    {}
+
+    u32 m_value_index { 0 };
+};
+
+//
+// Registry of named counters, gauges and histograms, which are published periodically into a shared memory region, so
+// they can be observed by other processes (for example, by the `MetricsReader` tool) without attaching a debugger.
+//
+// The counters and the histograms are sharded: every thread updates the values of the shard it is assigned to, so the
+// threads never contend for the same cache lines. The shards are only summed by the publisher. The gauges aren't
+// sharded, as they are usually set by a single system, so every gauge is stored in its own cache line.
+//
+// The handles returned by the registration are valid for the lifetime of the process, and registering a name twice
+// returns the same handle. If the registry is full, the handle refers to a slot that is never published.
+//
+class Metrics
+{
+public:
+    static constexpr u32 maximum_metric_count = 256;
+    static constexpr u32 shard_count = 16;
+    static constexpr u32 shard_value_capacity = 4096;
+    static constexpr u32 default_publish_interval_milliseconds = 250;
+
+public:
+    static MetricCounter register_counter(StringView name);
+    static MetricGauge register_gauge(StringView name);
+    static MetricHistogram register_histogram(StringView name);
+
+    //
+    // Creates the shared memory region with the given name and starts the thread that publishes the metrics into it.
+    // Returns false if the publishing has already started or if the region (or the thread) can't be created.
+    //
+    static bool start_publishing(StringView region_name, u32 publish_interval_milliseconds = default_publish_interval_milliseconds);
+
+    // Publishes the metrics one last time, stops the publishing thread and removes the shared memory region.
+    static void stop_publishing();
+
+    //
+    // Writes the name of the region that a process publishes its metrics into by default, which is derived from the
+    // process identifier, so multiple servers can run on the same machine.
+    //
+    static void get_default_region_name(u32 process_id, char* out_buffer, usize buffer_size);
+
+    // Returns the size of the shared memory region, which is fixed.
+    NODISCARD static constexpr usize get_region_byte_count() { return sizeof(MetricsRegionHeader) + maximum_metric_count * sizeof(MetricsRegionEntry); }
+
+    // Returns the index of the histogram bucket that counts the given value.
+    NODISCARD ALWAYS_INLINE static u32 get_histogram_bucket_index(u64 value)
+    {
+        const u32 bucket_index = static_cast<u32>(std::bit_width(value));
+        return (bucket_index < MetricsRegionEntry::histogram_bucket_count) ? bucket_index : (MetricsRegionEntry::histogram_bucket_count - 1);
+    }
+
+private:
+    friend class MetricCounter;
+    friend class MetricGauge;
+    friend class MetricHistogram;
+
+    // A histogram stores its buckets followed by the sum of the recorded values.
+    static constexpr u32 histogram_value_count = MetricsRegionEntry::histogram_bucket_count + 1;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<u64> values[shard_value_capacity];
+    };
+
+    struct alignas(64) Gauge
+    {
+        std::atomic<i64> value;
+    };
+
+    static constexpr u32 invalid_shard_index = static_cast<u32>(-1);
+
+    ALWAYS_INLINE static std::atomic<u64>* get_current_shard_values()
+    {
+        u32 shard_index = t_shard_index;
+        if (shard_index == invalid_shard_index)
+            UNLIKELY shard_index = assign_current_thread_shard();
+        return s_shards[shard_index].values;
+    }
+
+    static u32 assign_current_thread_shard();
+
+    // Sums the value with the given index over all shards.
+    NODISCARD static u64 sum_shard_values(u32 value_index);
+
+    // Writes the current values of all metrics into the shared memory region.
+    static void publish();
+    static void publishing_thread_entry_point(void* user_data);
+
+private:
+    static Shard s_shards[shard_count];
+    static Gauge s_gauges[maximum_metric_count];
+    static inline thread_local u32 t_shard_index = invalid_shard_index;
+};
+
+ALWAYS_INLINE void MetricCounter::add(u64 delta) const
+{
+    Metrics::get_current_shard_values()[m_value_index].fetch_add(delta, std::memory_order_relaxed);
+}
+
+ALWAYS_INLINE void MetricGauge::set(i64 value) const
+{
+    Metrics::s_gauges[m_gauge_index].value.store(value, std::memory_order_relaxed);
+}
+
+ALWAYS_INLINE void MetricGauge::add(i64 delta) const
+{
+    Metrics::s_gauges[m_gauge_index].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+ALWAYS_INLINE void MetricHistogram::record(u64 value) const
+{
+    std::atomic<u64>* values = Metrics::get_current_shard_values() + m_value_index;
+    values[Metrics::get_histogram_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    values[MetricsRegionEntry::histogram_bucket_count].fetch_add(value, std::memory_order_relaxed);
+}
+
+} // namespace CaveGame
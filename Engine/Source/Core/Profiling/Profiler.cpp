@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/String.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Profiling/Profiler.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+struct ProfilerData
+{
+    // Protects the registration of the threads and their names.
+    SpinLock registry_lock;
+    ProfilerThreadBuffer* thread_buffers[Profiler::maximum_thread_count] {};
+    std::atomic<u32> thread_count { 0 };
+
+    // The start of the frames, measured in `FastClock` ticks. Written only by the main thread.
+    std::atomic<u64> frame_start_ticks[Profiler::frame_marker_capacity] {};
+    std::atomic<u64> frame_count { 0 };
+};
+
+static ProfilerData s_profiler;
+static thread_local bool t_is_registration_failed = false;
+
+struct CapturedEvent
+{
+    const char* name;
+    u64 ticks_and_type;
+};
+
+ProfilerThreadBuffer* Profiler::register_current_thread()
+{
+    if (t_is_registration_failed)
+        return nullptr;
+
+    ScopedLock<SpinLock> registry_lock(s_profiler.registry_lock);
+
+    const u32 thread_index = s_profiler.thread_count.load(std::memory_order_relaxed);
+    if (thread_index >= maximum_thread_count)
+    {
+        t_is_registration_failed = true;
+        return nullptr;
+    }
+
+    ProfilerThreadBuffer* buffer = new ProfilerThreadBuffer();
+    buffer->thread_index = thread_index;
+    snprintf(buffer->thread_name, sizeof(buffer->thread_name), "Thread %u", thread_index);
+
+    s_profiler.thread_buffers[thread_index] = buffer;
+    s_profiler.thread_count.store(thread_index + 1, std::memory_order_release);
+
+    t_thread_buffer = buffer;
+    return buffer;
+}
+
+void Profiler::shutdown()
+{
+    ScopedLock<SpinLock> registry_lock(s_profiler.registry_lock);
+
+    const u32 thread_count = s_profiler.thread_count.load(std::memory_order_relaxed);
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        delete s_profiler.thread_buffers[thread_index];
+        s_profiler.thread_buffers[thread_index] = nullptr;
+    }
+
+    s_profiler.thread_count.store(0, std::memory_order_relaxed);
+    s_profiler.frame_count.store(0, std::memory_order_relaxed);
+
+    // NOTE: The buffers of the other threads have been released, so they must not record any events from now on.
+    t_thread_buffer = nullptr;
+}
+
+void Profiler::set_current_thread_name(StringView name)
+{
+    ProfilerThreadBuffer* buffer = t_thread_buffer;
+    if (buffer == nullptr)
+    {
+        buffer = register_current_thread();
+        if (buffer == nullptr)
+            return;
+    }
+
+    ScopedLock<SpinLock> registry_lock(s_profiler.registry_lock);
+    const usize name_length = Math::min(name.byte_count(), ProfilerThreadBuffer::maximum_thread_name_length);
+    for (usize index = 0; index < name_length; ++index)
+        buffer->thread_name[index] = name.characters()[index];
+    buffer->thread_name[name_length] = '\0';
+}
+
+void Profiler::mark_frame()
+{
+    const u64 frame_index = s_profiler.frame_count.load(std::memory_order_relaxed);
+
+    // NOTE: The same publication protocol as for the thread events (see `Profiler::record_event`).
+    std::atomic_thread_fence(std::memory_order_release);
+    s_profiler.frame_start_ticks[frame_index % frame_marker_capacity].store(FastClock::get_ticks(), std::memory_order_relaxed);
+    s_profiler.frame_count.store(frame_index + 1, std::memory_order_release);
+}
+
+#pragma region Chrome Trace
+
+static void write_json_string(FILE* file, const char* string)
+{
+    fputc('"', file);
+    for (const char* character = string; *character != '\0'; ++character)
+    {
+        switch (*character)
+        {
+            case '"': fputs("\\\"", file); break;
+            case '\\': fputs("\\\\", file); break;
+            default:
+                if (static_cast<u8>(*character) < 0x20)
+                    fprintf(file, "\\u%04x", static_cast<u32>(*character));
+                else
+                    fputc(*character, file);
+                break;
+        }
+    }
+    fputc('"', file);
+}
+
+NODISCARD ALWAYS_INLINE static double ticks_to_trace_timestamp(u64 ticks, u64 capture_start_ticks)
+{
+    // The trace timestamps are measured in microseconds.
+    return static_cast<double>(FastClock::ticks_to_nanoseconds(ticks - capture_start_ticks)) / 1000.0;
+}
+
+//
+// Copies the events that are still stored in the ring buffer. The events that are overwritten by the owner thread
+// while they are copied are discarded, which is detected by reading the write index again after the copy.
+// Returns the number of events at the start of the output that have been discarded.
+//
+NODISCARD static usize copy_thread_events(const ProfilerThreadBuffer& buffer, Vector<CapturedEvent>& out_events)
+{
+    static constexpr u64 capacity = ProfilerThreadBuffer::event_capacity;
+
+    const u64 end_index = buffer.write_index.load(std::memory_order_acquire);
+    const u64 begin_index = (end_index > capacity) ? (end_index - capacity) : 0;
+
+    for (u64 index = begin_index; index < end_index; ++index)
+    {
+        const ProfilerEvent& event = buffer.events[index % capacity];
+        out_events.add({ event.name.load(std::memory_order_relaxed), event.ticks_and_type.load(std::memory_order_relaxed) });
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const u64 current_write_index = buffer.write_index.load(std::memory_order_relaxed);
+
+    // The slots of the events older than this index might have been overwritten during the copy.
+    const u64 first_valid_index = (current_write_index >= capacity) ? (current_write_index - capacity + 1) : 0;
+    if (first_valid_index <= begin_index)
+        return 0;
+    return static_cast<usize>(Math::min(first_valid_index, end_index) - begin_index);
+}
+
+bool Profiler::write_chrome_trace(StringView filepath, u32 frame_count)
+{
+    const String filepath_string = String(filepath);
+
+#if CAVE_COMPILER_MSVC
+    FILE* file = nullptr;
+    if (fopen_s(&file, filepath_string.characters(), "wb") != 0)
+        return false;
+#else
+    FILE* file = fopen(filepath_string.characters(), "wb");
+    if (!file)
+        return false;
+#endif // CAVE_COMPILER_MSVC
+
+    const u64 capture_end_ticks = FastClock::get_ticks();
+
+    // Determine the first captured frame. The start of the oldest frame marker might be overwritten during the capture,
+    // so it is never used.
+    const u64 total_frame_count = s_profiler.frame_count.load(std::memory_order_acquire);
+    u64 first_frame_index = (total_frame_count > frame_count) ? (total_frame_count - frame_count) : 0;
+    if (total_frame_count >= frame_marker_capacity)
+        first_frame_index = Math::max(first_frame_index, total_frame_count - frame_marker_capacity + 1);
+
+    const u64 capture_start_ticks =
+        (first_frame_index < total_frame_count) ? s_profiler.frame_start_ticks[first_frame_index % frame_marker_capacity].load(std::memory_order_relaxed) : 0;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CaveGame\"}}", file);
+
+    for (u64 frame_index = first_frame_index; frame_index < total_frame_count; ++frame_index)
+    {
+        const u64 frame_start_ticks = s_profiler.frame_start_ticks[frame_index % frame_marker_capacity].load(std::memory_order_relaxed);
+        fprintf(
+            file,
+            ",\n{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":0,\"tid\":0}",
+            static_cast<unsigned long long>(frame_index),
+            ticks_to_trace_timestamp(frame_start_ticks, capture_start_ticks)
+        );
+    }
+
+    Vector<CapturedEvent> events;
+    const u32 thread_count = s_profiler.thread_count.load(std::memory_order_acquire);
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        ProfilerThreadBuffer* buffer = s_profiler.thread_buffers[thread_index];
+
+        char thread_name[ProfilerThreadBuffer::maximum_thread_name_length + 1];
+        {
+            ScopedLock<SpinLock> registry_lock(s_profiler.registry_lock);
+            memcpy(thread_name, buffer->thread_name, sizeof(thread_name));
+        }
+
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", thread_index);
+        write_json_string(file, thread_name);
+        fputs("}}", file);
+
+        events.clear();
+        const usize first_valid_event_index = copy_thread_events(*buffer, events);
+
+        // NOTE: The scopes that started before the capture are skipped entirely, as their begin events are dropped.
+        u32 open_scope_count = 0;
+        for (usize event_index = first_valid_event_index; event_index < events.count(); ++event_index)
+        {
+            const CapturedEvent& event = events[event_index];
+            const bool is_end_event = (event.ticks_and_type & end_event_flag) != 0;
+            const u64 ticks = event.ticks_and_type & ~end_event_flag;
+
+            // The events recorded during the capture are dropped, as their scopes might end after the capture.
+            if (ticks > capture_end_ticks)
+                break;
+
+            if (is_end_event)
+            {
+                if (open_scope_count == 0)
+                    continue;
+                --open_scope_count;
+            }
+            else
+            {
+                if (ticks < capture_start_ticks)
+                    continue;
+                ++open_scope_count;
+            }
+
+            fputs(",\n{\"name\":", file);
+            write_json_string(file, event.name);
+            fprintf(
+                file,
+                ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}",
+                is_end_event ? 'E' : 'B',
+                ticks_to_trace_timestamp(ticks, capture_start_ticks),
+                thread_index
+            );
+        }
+
+        // Close the scopes that are still open at the end of the capture.
+        for (; open_scope_count > 0; --open_scope_count)
+        {
+            fprintf(
+                file,
+                ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}",
+                ticks_to_trace_timestamp(capture_end_ticks, capture_start_ticks),
+                thread_index
+            );
+        }
+    }
+
+    fputs("\n]}\n", file);
+    const bool is_successful = (ferror(file) == 0);
+    fclose(file);
+    return is_successful;
+}
+
+#pragma endregion
+
+} // namespace CaveGame
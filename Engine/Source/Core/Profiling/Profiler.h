@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+#include <Core/Platform/FastClock.h>
+
+#include <atomic>
+
+//
+// The profiler instrumentation is enabled in Debug and Development builds. In Shipping builds the profiling macros
+// expand to nothing, so the instrumented code has no overhead at all.
+//
+
+#ifndef CAVE_ENABLE_PROFILING
+    #if CAVE_CONFIGURATION_SHIPPING
+        #define CAVE_ENABLE_PROFILING 0
+    #else
+        #define CAVE_ENABLE_PROFILING 1
+    #endif // CAVE_CONFIGURATION_SHIPPING
+#endif // CAVE_ENABLE_PROFILING
+
+namespace CaveGame
+{
+
+struct ProfilerEvent
+{
+    // NOTE: The fields are atomic only because the capture might read an event while it is being overwritten.
+    std::atomic<const char*> name;
+    // The most significant bit is set for the end events.
+    std::atomic<u64> ticks_and_type;
+};
+
+//
+// The ring buffer that stores the events recorded by a thread. Written only by its owner thread and read by the
+// thread that performs the capture. Once the buffer is full the oldest events are overwritten.
+//
+struct ProfilerThreadBuffer
+{
+    static constexpr usize event_capacity = 64 * 1024;
+    static constexpr usize maximum_thread_name_length = 31;
+
+    ProfilerEvent events[event_capacity];
+
+    // The total number of events that have ever been recorded into the buffer.
+    alignas(64) std::atomic<u64> write_index { 0 };
+
+    u32 thread_index { 0 };
+    char thread_name[maximum_thread_name_length + 1] {};
+};
+
+//
+// Hierarchical, instrumentation-based CPU profiler.
+//
+// Every thread records the begin and end events of the profiled scopes (see `CAVE_PROFILE_SCOPE`) into its own ring
+// buffer, which requires no locks and no atomic read-modify-write operations. The engine marks the start of every
+// frame, and the events of the last frames can be captured at any time as a Chrome Trace Event JSON file, which can be
+// inspected with Perfetto (https://ui.perfetto.dev) or `chrome://tracing`.
+//
+class Profiler
+{
+public:
+    static constexpr u32 maximum_thread_count = 128;
+    static constexpr u32 frame_marker_capacity = 1024;
+    static constexpr u64 end_event_flag = static_cast<u64>(1) << 63;
+
+public:
+    // Releases the buffers of all threads. No thread must record events during or after the shutdown.
+    static void shutdown();
+
+    //
+    // Sets the name of the calling thread, as displayed by the trace viewer. Invoked automatically when the thread
+    // name is set by `Thread::apply_current_thread_description`.
+    //
+    static void set_current_thread_name(StringView name);
+
+    // Marks the start of a new frame. Invoked by the engine, only from the main thread.
+    static void mark_frame();
+
+    //
+    // Writes the events recorded during the last `frame_count` frames (and the current, unfinished frame) to the
+    // given file, in the Chrome Trace Event JSON format. The capture can be performed from any thread, while the
+    // other threads keep recording events, but the events that are older than the ring buffers are lost.
+    // Returns false if the file can't be written.
+    //
+    static bool write_chrome_trace(StringView filepath, u32 frame_count);
+
+public:
+    // NOTE: The name must point to memory that outlives the profiler, usually a string literal.
+    ALWAYS_INLINE static void begin_event(const char* name) { record_event(name, FastClock::get_ticks()); }
+    ALWAYS_INLINE static void end_event(const char* name) { record_event(name, FastClock::get_ticks() | end_event_flag); }
+
+private:
+    ALWAYS_INLINE static void record_event(const char* name, u64 ticks_and_type)
+    {
+        ProfilerThreadBuffer* buffer = t_thread_buffer;
+        if (buffer == nullptr)
+        {
+            buffer = register_current_thread();
+            if (buffer == nullptr)
+                return;
+        }
+
+        const u64 write_index = buffer->write_index.load(std::memory_order_relaxed);
+
+        //
+        // NOTE: The fence orders the publication of the previous event before the event slot is overwritten, which
+        // allows the capture to detect the events that have been overwritten while it was reading them. It is free on
+        // x86, as stores are never reordered with other stores.
+        //
+        std::atomic_thread_fence(std::memory_order_release);
+
+        ProfilerEvent& event = buffer->events[write_index % ProfilerThreadBuffer::event_capacity];
+        event.name.store(name, std::memory_order_relaxed);
+        event.ticks_and_type.store(ticks_and_type, std::memory_order_relaxed);
+        buffer->write_index.store(write_index + 1, std::memory_order_release);
+    }
+
+    // Returns null if the maximum number of threads has been reached, in which case the events are dropped.
+    static ProfilerThreadBuffer* register_current_thread();
+
+private:
+    static inline thread_local ProfilerThreadBuffer* t_thread_buffer = nullptr;
+};
+
+// Records the begin event on construction and the end event on destruction.
+class ProfilerScope
+{
+    CAVE_MAKE_NONCOPYABLE(ProfilerScope);
+    CAVE_MAKE_NONMOVABLE(ProfilerScope);
+
+public:
+    ALWAYS_INLINE explicit ProfilerScope(const char* name)
+        : m_name(name)
+    {
+        Profiler::begin_event(m_name);
+    }
+
+    ALWAYS_INLINE ~ProfilerScope() { Profiler::end_event(m_name); }
+
+private:
+    const char* m_name;
+};
+
+} // namespace CaveGame
+
+#if CAVE_ENABLE_PROFILING
+    #define CAVE_PROFILE_CONCATENATE_IMPL(a, b) a##b
+    #define CAVE_PROFILE_CONCATENATE(a, b)      CAVE_PROFILE_CONCATENATE_IMPL(a, b)
+
+    // Profiles the enclosing scope. The name must be a string literal.
+    #define CAVE_PROFILE_SCOPE(name)  ::CaveGame::ProfilerScope CAVE_PROFILE_CONCATENATE(cave_profiler_scope_, __LINE__)(name)
+    #define CAVE_PROFILE_FUNCTION()   CAVE_PROFILE_SCOPE(__FUNCTION__)
+    #define CAVE_PROFILE_MARK_FRAME() ::CaveGame::Profiler::mark_frame()
+#else
+    #define CAVE_PROFILE_SCOPE(name)
+    #define CAVE_PROFILE_FUNCTION()
+    #define CAVE_PROFILE_MARK_FRAME()
+#endif // CAVE_ENABLE_PROFILING
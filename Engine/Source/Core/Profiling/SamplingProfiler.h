@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Statistical profiler that periodically interrupts the registered threads and records their call stacks, so the
+// hot code is found without any instrumentation. Cheap enough to stay enabled during long sessions: the cost is one
+// signal and a short stack walk per sample.
+//
+// Every registered thread gets a timer that measures its CPU time (`timer_create` with `CLOCK_THREAD_CPUTIME_ID`)
+// and delivers `SIGPROF` to it at the sampling frequency, thus idle threads aren't sampled. The signal handler walks
+// the frame pointer chain and writes the stack into the lock-free ring buffer of the thread. The engine moves the
+// samples into the aggregated call stack table once per frame, which is written as a folded stacks file at the end
+// of the capture.
+//
+// NOTE: Only implemented on Linux. The stacks are only complete for code that keeps the frame pointers, which is
+// ensured for the engine and game code by the build configuration (`-fno-omit-frame-pointer`).
+//
+class SamplingProfiler
+{
+public:
+    static constexpr u32 maximum_stack_depth = 64;
+    static constexpr u32 sample_capacity_per_thread = 1024;
+    static constexpr u32 default_sampling_frequency = 997;
+
+public:
+    //
+    // Starts sampling all the registered threads (and the threads registered while the profiler runs) at the given
+    // frequency, measured in samples per second of CPU time. Returns false if the profiler is already running or if
+    // the signal handler can't be installed.
+    //
+    static bool start(u32 sampling_frequency = default_sampling_frequency);
+    static void stop();
+
+    // Stops the profiler and releases the buffers of all threads. No registered thread must be running.
+    static void shutdown();
+
+    NODISCARD static bool is_running();
+
+    //
+    // Registers the calling thread for sampling. The name is used as the root frame of its call stacks. Invoked
+    // automatically when the thread name is set by `Thread::apply_current_thread_description`.
+    // NOTE: The buffer of a thread is kept until the shutdown, so the threads don't have to unregister before exiting.
+    //
+    static void register_current_thread(StringView name);
+
+    //
+    // Moves the samples from the ring buffers of the threads into the aggregated call stack table. Must be called
+    // periodically (the engine calls it once per frame), otherwise the oldest samples are overwritten and lost.
+    //
+    static void process_samples();
+
+    NODISCARD static u64 get_sample_count();
+    NODISCARD static u64 get_lost_sample_count();
+
+    // Discards all the aggregated call stacks.
+    static void reset();
+
+    //
+    // Processes the pending samples and writes the aggregated call stacks in the folded format used by flame graph
+    // tools (Brendan Gregg's flamegraph.pl, speedscope, inferno): one line per call stack, with the frames separated
+    // by semicolons (the root first) followed by the number of samples. Returns false if the file can't be written.
+    //
+    static bool write_folded_stacks(StringView filepath);
+};
+
+} // namespace CaveGame
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/Futex.h>
+#include <Core/Threading/Mutex.h>
+#include <Core/Threading/SpinLock.h>
+
+namespace CaveGame
+{
+
+#pragma region Mutex
+
+void Mutex::lock_contended()
+{
+    // Spin while the owner is likely to release the mutex soon, without announcing this thread as a waiter.
+    SpinBackoff backoff;
+    while (!backoff.is_exhausted())
+    {
+        backoff.pause();
+
+        u32 expected_state = state_unlocked;
+        if (m_state.load(std::memory_order_relaxed) == state_unlocked &&
+            m_state.compare_exchange_weak(expected_state, state_locked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    //
+    // NOTE: The mutex is acquired as contended, even if this thread turns out to be the only one waiting, as the
+    // other threads that are sleeping on it can't be detected. This only costs an unnecessary wake-up call.
+    //
+    while (m_state.exchange(state_locked_with_waiters, std::memory_order_acquire) != state_unlocked)
+        Futex::wait(m_state, state_locked_with_waiters);
+}
+
+void Mutex::wake_up_waiter()
+{
+    Futex::wake_one(m_state);
+}
+
+#pragma endregion
+
+#pragma region Condition
+
+void Condition::wait(Mutex& mutex)
+{
+    m_waiter_count.fetch_add(1, std::memory_order_relaxed);
+
+    // The sequence must be read before releasing the mutex, otherwise a notification could be missed.
+    const u32 sequence = m_sequence.load(std::memory_order_relaxed);
+    mutex.unlock();
+
+    Futex::wait(m_sequence, sequence);
+
+    // Other threads might have been woken up by the same notification, so the mutex is acquired as contended.
+    while (mutex.m_state.exchange(Mutex::state_locked_with_waiters, std::memory_order_acquire) != Mutex::state_unlocked)
+        Futex::wait(mutex.m_state, Mutex::state_locked_with_waiters);
+
+    m_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Condition::notify_one()
+{
+    m_sequence.fetch_add(1, std::memory_order_release);
+    if (m_waiter_count.load(std::memory_order_seq_cst) > 0)
+        Futex::wake_one(m_sequence);
+}
+
+void Condition::notify_all()
+{
+    m_sequence.fetch_add(1, std::memory_order_release);
+    if (m_waiter_count.load(std::memory_order_seq_cst) > 0)
+        Futex::wake_all(m_sequence);
+}
+
+#pragma endregion
+
+} // namespace CaveGame
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Futex-based mutex, as described in "Futexes Are Tricky" (Ulrich Drepper, 2011).
+//
+// Acquiring and releasing an uncontended mutex is a single atomic instruction, without any system call. A contended
+// mutex spins for a short while (most critical sections are shorter than a context switch) and then sleeps in the
+// kernel. Unlike `std::mutex`, the unlock never performs a system call unless a thread is actually sleeping.
+//
+class Mutex
+{
+    CAVE_MAKE_NONCOPYABLE(Mutex);
+    CAVE_MAKE_NONMOVABLE(Mutex);
+
+public:
+    Mutex() = default;
+    ALWAYS_INLINE ~Mutex() { CAVE_ASSERT(m_state.load(std::memory_order_relaxed) == state_unlocked); }
+
+    ALWAYS_INLINE void lock()
+    {
+        u32 expected_state = state_unlocked;
+        if (m_state.compare_exchange_strong(expected_state, state_locked, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+        lock_contended();
+    }
+
+    NODISCARD ALWAYS_INLINE bool try_lock()
+    {
+        u32 expected_state = state_unlocked;
+        return m_state.compare_exchange_strong(expected_state, state_locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    ALWAYS_INLINE void unlock()
+    {
+        if (m_state.exchange(state_unlocked, std::memory_order_release) == state_locked_with_waiters)
+            wake_up_waiter();
+    }
+
+private:
+    friend class Condition;
+
+    // The mutex is unlocked.
+    static constexpr u32 state_unlocked = 0;
+    // The mutex is locked and no thread is sleeping on it.
+    static constexpr u32 state_locked = 1;
+    // The mutex is locked and threads might be sleeping on it, thus unlocking it must wake one of them up.
+    static constexpr u32 state_locked_with_waiters = 2;
+
+    void lock_contended();
+    void wake_up_waiter();
+
+private:
+    std::atomic<u32> m_state { state_unlocked };
+};
+
+//
+// Condition variable that works together with `Mutex`. Notifying a condition that no thread waits for doesn't
+// perform any system call.
+//
+// NOTE: Waiting can return spuriously, so the predicate must always be checked in a loop (or use the overload of
+// `Condition::wait` that accepts a predicate).
+//
+class Condition
+{
+    CAVE_MAKE_NONCOPYABLE(Condition);
+    CAVE_MAKE_NONMOVABLE(Condition);
+
+public:
+    Condition() = default;
+    ALWAYS_INLINE ~Condition() { CAVE_ASSERT(m_waiter_count.load(std::memory_order_relaxed) == 0); }
+
+    // Atomically releases the mutex and blocks the calling thread. The mutex is acquired again before returning.
+    void wait(Mutex& mutex);
+
+    // Blocks the calling thread until the predicate returns true. The predicate is evaluated while holding the mutex.
+    template<typename Predicate>
+    ALWAYS_INLINE void wait(Mutex& mutex, Predicate predicate)
+    {
+        while (!predicate())
+            wait(mutex);
+    }
+
+    //
+    // Wakes up one (or all) of the waiting threads. The state the waiting threads check must be modified while
+    // holding the mutex, but the notification itself can be performed after the mutex has been released.
+    //
+    void notify_one();
+    void notify_all();
+
+private:
+    // Incremented by every notification. The waiting threads sleep until it changes.
+    std::atomic<u32> m_sequence { 0 };
+    // Modified only while holding the mutex, so the notifying thread is guaranteed to see the waiters.
+    std::atomic<u32> m_waiter_count { 0 };
+};
+
+} // namespace CaveGame
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/Futex.h>
+#include <Core/Threading/ReadWriteLock.h>
+#include <Core/Threading/SpinLock.h>
+
+namespace CaveGame
+{
+
+static std::atomic<u32> s_next_reader_slot_index { 0 };
+static thread_local u32 t_reader_slot_index = ReadWriteLock::reader_slot_count;
+
+u32 ReadWriteLock::get_reader_slot_index()
+{
+    if (t_reader_slot_index == reader_slot_count)
+        t_reader_slot_index = s_next_reader_slot_index.fetch_add(1, std::memory_order_relaxed) % reader_slot_count;
+    return t_reader_slot_index;
+}
+
+void ReadWriteLock::lock_for_reading_contended(ReaderSlot& reader_slot)
+{
+    do
+    {
+        // Back off, so that the writer doesn't wait for this reader, and sleep until the writer has finished.
+        reader_slot.reader_count.fetch_sub(1, std::memory_order_seq_cst);
+        wake_up_writer();
+
+        while (m_is_writer_active.load(std::memory_order_seq_cst) != 0)
+            Futex::wait(m_is_writer_active, 1);
+
+        reader_slot.reader_count.fetch_add(1, std::memory_order_seq_cst);
+    } while (m_is_writer_active.load(std::memory_order_seq_cst) != 0);
+}
+
+void ReadWriteLock::wake_up_writer()
+{
+    m_departed_reader_sequence.fetch_add(1, std::memory_order_seq_cst);
+    Futex::wake_one(m_departed_reader_sequence);
+}
+
+void ReadWriteLock::lock_for_writing()
+{
+    m_writer_mutex.lock();
+    m_is_writer_active.store(1, std::memory_order_seq_cst);
+
+    SpinBackoff backoff;
+    for (u32 slot_index = 0; slot_index < reader_slot_count; ++slot_index)
+    {
+        while (true)
+        {
+            // The sequence must be read before the reader count, so that a reader that leaves in between wakes this thread up.
+            const u32 departed_reader_sequence = m_departed_reader_sequence.load(std::memory_order_seq_cst);
+            if (m_reader_slots[slot_index].reader_count.load(std::memory_order_seq_cst) == 0)
+                break;
+
+            if (!backoff.is_exhausted())
+                backoff.pause();
+            else
+                Futex::wait(m_departed_reader_sequence, departed_reader_sequence);
+        }
+    }
+}
+
+void ReadWriteLock::unlock_for_writing()
+{
+    m_is_writer_active.store(0, std::memory_order_seq_cst);
+    Futex::wake_all(m_is_writer_active);
+    m_writer_mutex.unlock();
+}
+
+} // namespace CaveGame
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Threading/Mutex.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Reader-writer lock optimized for data that is read very often and modified rarely.
+//
+// Every thread is assigned one of the reader slots, each placed on its own cache line, so readers running on
+// different cores never write to the same cache line (a single shared reader counter would bounce between all of
+// them, which makes a classic reader-writer lock slower than a plain mutex under heavy read traffic). In exchange,
+// acquiring the lock for writing is expensive, as the writer has to wait for every reader slot to drain.
+//
+// Writers have priority: once a writer is waiting, new readers block until it has finished.
+//
+// NOTE: The lock isn't recursive. A thread that holds the lock for reading must not acquire it again, as a writer
+// might be waiting in between.
+//
+class ReadWriteLock
+{
+    CAVE_MAKE_NONCOPYABLE(ReadWriteLock);
+    CAVE_MAKE_NONMOVABLE(ReadWriteLock);
+
+public:
+    static constexpr u32 reader_slot_count = 16;
+
+public:
+    ReadWriteLock() = default;
+    ALWAYS_INLINE ~ReadWriteLock() { CAVE_ASSERT(m_is_writer_active.load(std::memory_order_relaxed) == 0); }
+
+    ALWAYS_INLINE void lock_for_reading()
+    {
+        ReaderSlot& reader_slot = m_reader_slots[get_reader_slot_index()];
+        reader_slot.reader_count.fetch_add(1, std::memory_order_seq_cst);
+
+        // NOTE: Pairs with the sequentially consistent store performed by the writer. Either the writer sees this reader
+        // when it scans the slots, or this reader sees the writer and backs off.
+        if (m_is_writer_active.load(std::memory_order_seq_cst) != 0)
+            lock_for_reading_contended(reader_slot);
+    }
+
+    ALWAYS_INLINE void unlock_for_reading()
+    {
+        ReaderSlot& reader_slot = m_reader_slots[get_reader_slot_index()];
+        reader_slot.reader_count.fetch_sub(1, std::memory_order_seq_cst);
+        if (m_is_writer_active.load(std::memory_order_seq_cst) != 0)
+            wake_up_writer();
+    }
+
+    void lock_for_writing();
+    void unlock_for_writing();
+
+private:
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<u32> reader_count { 0 };
+    };
+
+    // Returns the reader slot assigned to the calling thread. Threads are assigned slots in a round-robin fashion.
+    NODISCARD static u32 get_reader_slot_index();
+
+    void lock_for_reading_contended(ReaderSlot& reader_slot);
+    void wake_up_writer();
+
+private:
+    ReaderSlot m_reader_slots[reader_slot_count];
+
+    // Serializes the writers, so that only one of them waits for the readers at any given time.
+    Mutex m_writer_mutex;
+
+    // Set while a writer is waiting for (or holding) the lock. Readers sleep on it.
+    alignas(64) std::atomic<u32> m_is_writer_active { 0 };
+
+    // Incremented by the readers that leave while a writer is active. The writer sleeps on it.
+    std::atomic<u32> m_departed_reader_sequence { 0 };
+};
+
+// Acquires the lock for reading for the lifetime of the object.
+class ScopedReadLock
+{
+    CAVE_MAKE_NONCOPYABLE(ScopedReadLock);
+    CAVE_MAKE_NONMOVABLE(ScopedReadLock);
+
+public:
+    ALWAYS_INLINE explicit ScopedReadLock(ReadWriteLock& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock_for_reading();
+    }
+
+    ALWAYS_INLINE ~ScopedReadLock() { m_lock.unlock_for_reading(); }
+
+private:
+    ReadWriteLock& m_lock;
+};
+
+// Acquires the lock for writing for the lifetime of the object.
+class ScopedWriteLock
+{
+    CAVE_MAKE_NONCOPYABLE(ScopedWriteLock);
+    CAVE_MAKE_NONMOVABLE(ScopedWriteLock);
+
+public:
+    ALWAYS_INLINE explicit ScopedWriteLock(ReadWriteLock& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock_for_writing();
+    }
+
+    ALWAYS_INLINE ~ScopedWriteLock() { m_lock.unlock_for_writing(); }
+
+private:
+    ReadWriteLock& m_lock;
+};
+
+} // namespace CaveGame
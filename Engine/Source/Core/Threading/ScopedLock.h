@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+// Acquires the lock (any type that provides `lock` and `unlock`) for the lifetime of the object.
+template<typename LockType>
+class ScopedLock
+{
+    CAVE_MAKE_NONCOPYABLE(ScopedLock);
+    CAVE_MAKE_NONMOVABLE(ScopedLock);
+
+public:
+    ALWAYS_INLINE explicit ScopedLock(LockType& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+
+    ALWAYS_INLINE ~ScopedLock() { m_lock.unlock(); }
+
+private:
+    LockType& m_lock;
+};
+
+} // namespace CaveGame
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <cstring>
+#include <immintrin.h>
+#include <type_traits>
+
+namespace CaveGame
+{
+
+//
+// Sequence lock that publishes snapshots of a small, trivially copyable value (such as the camera transform or the
+// frame statistics) from one writer thread to any number of reader threads.
+//
+// Readers never write to shared memory, so they don't slow down each other or the writer. Instead, a reader retries
+// if the value has been modified while it was copying it. The writer never waits.
+//
+// NOTE: Only a single thread can write at a time. If multiple threads can write, they must be serialized externally.
+//
+// The value is stored as an array of relaxed atomic words (as recommended by "Can Seqlocks Get Along With Programming
+// Language Memory Models?", Hans Boehm, 2012), so that the torn reads, which are discarded anyway, aren't data races.
+//
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "The values protected by a sequence lock must be trivially copyable!");
+
+    CAVE_MAKE_NONCOPYABLE(SeqLock);
+    CAVE_MAKE_NONMOVABLE(SeqLock);
+
+public:
+    SeqLock() = default;
+    ALWAYS_INLINE explicit SeqLock(const T& initial_value) { store(initial_value); }
+
+    ALWAYS_INLINE void store(const T& value)
+    {
+        u64 value_words[word_count] = {};
+        std::memcpy(value_words, &value, sizeof(T));
+
+        // An odd sequence number marks the value as being modified.
+        const u32 sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (usize word_index = 0; word_index < word_count; ++word_index)
+            m_words[word_index].store(value_words[word_index], std::memory_order_relaxed);
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    NODISCARD ALWAYS_INLINE T load() const
+    {
+        u64 value_words[word_count];
+        while (true)
+        {
+            const u32 sequence_before = m_sequence.load(std::memory_order_acquire);
+            if (sequence_before & 1)
+            {
+                // The writer is modifying the value.
+                _mm_pause();
+                continue;
+            }
+
+            for (usize word_index = 0; word_index < word_count; ++word_index)
+                value_words[word_index] = m_words[word_index].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence_before)
+                break;
+        }
+
+        T value;
+        std::memcpy(&value, value_words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr usize word_count = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+private:
+    std::atomic<u32> m_sequence { 0 };
+    std::atomic<u64> m_words[word_count] {};
+};
+
+} // namespace CaveGame
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Threading/SpinLock.h>
+
+namespace CaveGame
+{
+
+void SpinBackoff::yield()
+{
+    PlatformCore::yield_thread();
+}
+
+void SpinLock::lock_contended()
+{
+    SpinBackoff backoff;
+    do
+    {
+        // Only read the lock while it is taken, as the exchange always invalidates the cache line of the other cores.
+        while (m_is_locked.load(std::memory_order_relaxed))
+            backoff.pause();
+    } while (m_is_locked.exchange(true, std::memory_order_acquire));
+}
+
+} // namespace CaveGame
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <immintrin.h>
+
+namespace CaveGame
+{
+
+//
+// Exponential backoff used while spinning on a contended memory location. Every failed attempt doubles the number
+// of `pause` instructions executed (which reduces the traffic on the contended cache line and frees the execution
+// resources for the SMT sibling), until the limit is reached, after which the remaining time slice is yielded.
+//
+class SpinBackoff
+{
+public:
+    static constexpr u32 maximum_pause_count = 64;
+
+public:
+    ALWAYS_INLINE void pause()
+    {
+        if (m_pause_count <= maximum_pause_count)
+        {
+            for (u32 pause_index = 0; pause_index < m_pause_count; ++pause_index)
+                _mm_pause();
+            m_pause_count *= 2;
+        }
+        else
+        {
+            yield();
+        }
+    }
+
+    // Returns true if the backoff has reached the limit and started yielding, meaning that blocking is preferable.
+    NODISCARD ALWAYS_INLINE bool is_exhausted() const { return (m_pause_count > maximum_pause_count); }
+
+    ALWAYS_INLINE void reset() { m_pause_count = 1; }
+
+private:
+    // Wrapper around `PlatformCore::yield_thread`, which keeps the platform header out of this file.
+    static void yield();
+
+private:
+    u32 m_pause_count { 1 };
+};
+
+//
+// Test-and-test-and-set spin lock with exponential backoff. Meant for critical sections that only take a few hundred
+// cycles, where putting the thread to sleep costs much more than waiting. Use `Mutex` for everything else.
+//
+// NOTE: A spin lock that is frequently acquired by different threads should be placed on its own cache line.
+//
+class SpinLock
+{
+    CAVE_MAKE_NONCOPYABLE(SpinLock);
+    CAVE_MAKE_NONMOVABLE(SpinLock);
+
+public:
+    SpinLock() = default;
+
+    ALWAYS_INLINE void lock()
+    {
+        if (!m_is_locked.exchange(true, std::memory_order_acquire))
+            return;
+        lock_contended();
+    }
+
+    NODISCARD ALWAYS_INLINE bool try_lock()
+    {
+        // Check before writing, so that failed attempts don't steal the cache line from the owner.
+        return !m_is_locked.load(std::memory_order_relaxed) && !m_is_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    ALWAYS_INLINE void unlock() { m_is_locked.store(false, std::memory_order_release); }
+
+    NODISCARD ALWAYS_INLINE bool is_locked() const { return m_is_locked.load(std::memory_order_relaxed); }
+
+private:
+    void lock_contended();
+
+private:
+    std::atomic<bool> m_is_locked { false };
+};
+
+} // namespace CaveGame
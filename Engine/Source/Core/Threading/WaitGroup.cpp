@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/Futex.h>
+#include <Core/Threading/SpinLock.h>
+#include <Core/Threading/WaitGroup.h>
+
+namespace CaveGame
+{
+
+void WaitGroup::done()
+{
+    u32 state = m_state.load(std::memory_order_relaxed);
+    u32 new_state;
+    do
+    {
+        CAVE_ASSERT((state & pending_count_mask) > 0);
+        // The last operation also clears the waiters flag, as all of them are about to be woken up.
+        new_state = ((state & pending_count_mask) == 1) ? 0 : (state - 1);
+    } while (!m_state.compare_exchange_weak(state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (new_state == 0 && (state & has_waiters_flag))
+        Futex::wake_all(m_state);
+}
+
+void WaitGroup::wait()
+{
+    // The remaining operations are often about to finish, so spin for a short while before going to sleep.
+    SpinBackoff backoff;
+    while (!backoff.is_exhausted())
+    {
+        if (is_finished())
+            return;
+        backoff.pause();
+    }
+
+    u32 state = m_state.load(std::memory_order_acquire);
+    while ((state & pending_count_mask) != 0)
+    {
+        // Announce this thread as a waiter before going to sleep. Fails if an operation has finished in between.
+        if (!(state & has_waiters_flag) &&
+            !m_state.compare_exchange_weak(state, state | has_waiters_flag, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        Futex::wait(m_state, state | has_waiters_flag);
+        state = m_state.load(std::memory_order_acquire);
+    }
+}
+
+} // namespace CaveGame
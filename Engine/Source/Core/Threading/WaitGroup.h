@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Waits for a group of operations (usually executed by other threads) to finish. The number of pending operations is
+// increased with `WaitGroup::add` before they are started, and decreased by `WaitGroup::done` when each finishes.
+//
+// NOTE: Use `JobCounter` for jobs scheduled with the job system, as its wait executes other jobs instead of sleeping.
+//
+class WaitGroup
+{
+    CAVE_MAKE_NONCOPYABLE(WaitGroup);
+    CAVE_MAKE_NONMOVABLE(WaitGroup);
+
+public:
+    WaitGroup() = default;
+    ALWAYS_INLINE ~WaitGroup() { CAVE_ASSERT(m_state.load(std::memory_order_relaxed) == 0); }
+
+    ALWAYS_INLINE void add(u32 count = 1)
+    {
+        MAYBE_UNUSED const u32 previous_state = m_state.fetch_add(count, std::memory_order_relaxed);
+        CAVE_ASSERT((previous_state & pending_count_mask) + count <= pending_count_mask);
+    }
+
+    void done();
+
+    NODISCARD ALWAYS_INLINE bool is_finished() const { return ((m_state.load(std::memory_order_acquire) & pending_count_mask) == 0); }
+
+    // Blocks the calling thread until all the pending operations are done.
+    void wait();
+
+private:
+    //
+    // The pending operation count and the flag that marks the presence of sleeping waiters share the same word, so
+    // that the last operation clears both with a single atomic operation and never accesses the wait group again
+    // (except for the wake-up system call, which only uses its address). Thus, the waiting thread is allowed to
+    // destroy the wait group as soon as the wait returns.
+    //
+    static constexpr u32 has_waiters_flag = 1U << 31;
+    static constexpr u32 pending_count_mask = has_waiters_flag - 1;
+
+private:
+    std::atomic<u32> m_state { 0 };
+};
+
+} // namespace CaveGame
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Memory/Hash.h>
+#include <Core/Memory/LzCompression.h>
+#include <Engine/AssetArchive.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace CaveGame
+{
+
+NODISCARD static u64 hash_entry_name(StringView name)
+{
+    return hash_bytes(name.characters(), name.byte_count());
+}
+
+#pragma region AssetArchive
+
+bool AssetArchive::open(StringView filepath)
+{
+    if (is_open())
+        return false;
+    if (!m_mapped_file.open(filepath, FileMappingAccess::ReadOnly))
+        return false;
+
+    if (!validate_layout())
+    {
+        m_mapped_file.close();
+        return false;
+    }
+
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(m_mapped_file.data());
+    m_entries = reinterpret_cast<const AssetArchiveEntry*>(m_mapped_file.data() + header->entry_table_offset);
+    m_names = reinterpret_cast<const char*>(m_mapped_file.data() + header->name_table_offset);
+    m_entry_count = header->entry_count;
+
+    // The lookups read the entry table at random positions, so read it into the page cache right away.
+    m_mapped_file.advise(FileAccessHint::WillNeed, header->entry_table_offset, static_cast<usize>(m_entry_count) * sizeof(AssetArchiveEntry));
+    return true;
+}
+
+void AssetArchive::close()
+{
+    m_mapped_file.close();
+    m_entries = nullptr;
+    m_names = nullptr;
+    m_entry_count = 0;
+}
+
+// Returns true if the range `[offset, offset + byte_count)` is inside a buffer of the given size, without overflowing.
+NODISCARD ALWAYS_INLINE static bool is_range_in_bounds(u64 offset, u64 byte_count, u64 buffer_byte_count)
+{
+    return (offset <= buffer_byte_count && byte_count <= buffer_byte_count - offset);
+}
+
+bool AssetArchive::validate_layout() const
+{
+    const u64 file_byte_count = m_mapped_file.byte_count();
+    if (file_byte_count < sizeof(AssetArchiveHeader))
+        return false;
+
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(m_mapped_file.data());
+    if (header->magic != AssetArchiveHeader::magic_value || header->version != AssetArchiveHeader::current_version)
+        return false;
+    if (header->archive_byte_count != file_byte_count)
+        return false;
+
+    const u64 entry_table_byte_count = static_cast<u64>(header->entry_count) * sizeof(AssetArchiveEntry);
+    if (header->entry_table_offset % alignof(AssetArchiveEntry) != 0 || !is_range_in_bounds(header->entry_table_offset, entry_table_byte_count, file_byte_count))
+        return false;
+    if (!is_range_in_bounds(header->name_table_offset, header->name_table_byte_count, file_byte_count))
+        return false;
+
+    const AssetArchiveEntry* entries = reinterpret_cast<const AssetArchiveEntry*>(m_mapped_file.data() + header->entry_table_offset);
+    for (u32 entry_index = 0; entry_index < header->entry_count; ++entry_index)
+    {
+        const AssetArchiveEntry& entry = entries[entry_index];
+        if (!is_range_in_bounds(entry.name_offset, entry.name_byte_count, header->name_table_byte_count))
+            return false;
+        if (entry.blob_offset % AssetArchiveHeader::blob_alignment != 0 || !is_range_in_bounds(entry.blob_offset, entry.stored_byte_count, file_byte_count))
+            return false;
+
+        // The binary search relies on the order of the entries.
+        if (entry_index > 0 && entries[entry_index - 1].name_hash > entry.name_hash)
+            return false;
+
+        switch (entry.compression)
+        {
+            case AssetCompression::None:
+                if (entry.stored_byte_count != entry.byte_count)
+                    return false;
+                break;
+            case AssetCompression::Lz:
+            {
+                // The reader allocates the decompressed size up front, thus it must be plausible for the stored frame.
+                // The frame ends with its total decompressed size, which must match the size in the entry.
+                constexpr u64 frame_end_byte_count = sizeof(u32) + sizeof(u64);
+                if (entry.stored_byte_count < sizeof(LzFrameHeader) + frame_end_byte_count)
+                    return false;
+                if (entry.byte_count > entry.stored_byte_count * LzCodec::maximum_expansion_ratio)
+                    return false;
+
+                u64 frame_byte_count;
+                memcpy(&frame_byte_count, m_mapped_file.data() + entry.blob_offset + entry.stored_byte_count - sizeof(u64), sizeof(u64));
+                if (frame_byte_count != entry.byte_count)
+                    return false;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+u32 AssetArchive::find_entry(StringView name) const
+{
+    const u64 name_hash = hash_entry_name(name);
+
+    // Find the first entry whose hash isn't lower than the hash of the name.
+    u32 first_index = 0;
+    u32 count = m_entry_count;
+    while (count > 0)
+    {
+        const u32 half_count = count / 2;
+        if (m_entries[first_index + half_count].name_hash < name_hash)
+        {
+            first_index += half_count + 1;
+            count -= half_count + 1;
+        }
+        else
+        {
+            count = half_count;
+        }
+    }
+
+    // NOTE: Different names can have the same hash, in which case their entries are adjacent.
+    for (u32 entry_index = first_index; entry_index < m_entry_count && m_entries[entry_index].name_hash == name_hash; ++entry_index)
+    {
+        const AssetArchiveEntry& entry = m_entries[entry_index];
+        if (entry.name_byte_count == name.byte_count() && memcmp(m_names + entry.name_offset, name.characters(), name.byte_count()) == 0)
+            return entry_index;
+    }
+
+    return invalid_entry_index;
+}
+
+StringView AssetArchive::get_entry_name(u32 entry_index) const
+{
+    const AssetArchiveEntry& entry = get_entry(entry_index);
+    return StringView::create_from_utf8(m_names + entry.name_offset, entry.name_byte_count);
+}
+
+const AssetArchiveEntry& AssetArchive::get_entry(u32 entry_index) const
+{
+    CAVE_ASSERT(entry_index < m_entry_count);
+    return m_entries[entry_index];
+}
+
+ReadonlyByteSpan AssetArchive::get_entry_bytes(u32 entry_index) const
+{
+    const AssetArchiveEntry& entry = get_entry(entry_index);
+    CAVE_ASSERT(entry.compression == AssetCompression::None);
+    return ReadonlyByteSpan(m_mapped_file.data() + entry.blob_offset, static_cast<usize>(entry.byte_count));
+}
+
+bool AssetArchive::read_entry(u32 entry_index, Vector<u8>& out_bytes) const
+{
+    const AssetArchiveEntry& entry = get_entry(entry_index);
+    const u8* blob = m_mapped_file.data() + entry.blob_offset;
+
+    switch (entry.compression)
+    {
+        case AssetCompression::None:
+            out_bytes.set_count_uninitialized(static_cast<usize>(entry.byte_count));
+            memcpy(out_bytes.elements(), blob, out_bytes.count());
+            return true;
+
+        case AssetCompression::Lz:
+            out_bytes.clear();
+            out_bytes.ensure_capacity(static_cast<usize>(entry.byte_count));
+            if (!decompress_lz_frame(blob, static_cast<usize>(entry.stored_byte_count), out_bytes))
+                return false;
+            return (out_bytes.count() == entry.byte_count);
+    }
+
+    return false;
+}
+
+void AssetArchive::prefetch_entry(u32 entry_index) const
+{
+    const AssetArchiveEntry& entry = get_entry(entry_index);
+    m_mapped_file.advise(FileAccessHint::WillNeed, static_cast<usize>(entry.blob_offset), static_cast<usize>(entry.stored_byte_count));
+}
+
+bool AssetArchive::verify_content_hash() const
+{
+    CAVE_ASSERT(is_open());
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(m_mapped_file.data());
+    const usize content_byte_count = m_mapped_file.byte_count() - sizeof(AssetArchiveHeader);
+    return (hash_bytes(m_mapped_file.data() + sizeof(AssetArchiveHeader), content_byte_count) == header->content_hash);
+}
+
+bool AssetArchive::verify_entry(u32 entry_index) const
+{
+    const AssetArchiveEntry& entry = get_entry(entry_index);
+    if (entry.compression == AssetCompression::None)
+    {
+        const ReadonlyByteSpan bytes = get_entry_bytes(entry_index);
+        return (hash_bytes(bytes.elements(), bytes.count()) == entry.content_hash);
+    }
+
+    Vector<u8> bytes;
+    if (!read_entry(entry_index, bytes))
+        return false;
+    return (hash_bytes(bytes.elements(), bytes.count()) == entry.content_hash);
+}
+
+#pragma endregion
+
+#pragma region AssetArchiveWriter
+
+void AssetArchiveWriter::add_entry(StringView name, const void* bytes, usize byte_count, AssetCompression compression)
+{
+    m_entries.emplace();
+    PendingEntry& entry = m_entries.last();
+    entry.name = name;
+    entry.name_hash = hash_entry_name(name);
+    entry.data_offset = m_data.count();
+    entry.byte_count = byte_count;
+    entry.content_hash = hash_bytes(bytes, byte_count);
+
+    if (compression == AssetCompression::Lz)
+    {
+        // NOTE: The blocks aren't hashed, as the content hash of the entry already detects corruption.
+        LzFrameSettings settings;
+        settings.level = LzCompressionLevel::High;
+        settings.hash_blocks = false;
+
+        if (compress_lz_frame(bytes, byte_count, m_data, settings) && m_data.count() - entry.data_offset < byte_count)
+        {
+            entry.stored_byte_count = m_data.count() - entry.data_offset;
+            entry.compression = AssetCompression::Lz;
+            return;
+        }
+    }
+
+    entry.stored_byte_count = byte_count;
+    entry.compression = AssetCompression::None;
+    m_data.set_count_uninitialized(entry.data_offset + byte_count);
+    memcpy(m_data.elements() + entry.data_offset, bytes, byte_count);
+}
+
+NODISCARD ALWAYS_INLINE static u64 align_blob_offset(u64 offset)
+{
+    return (offset + AssetArchiveHeader::blob_alignment - 1) & ~(AssetArchiveHeader::blob_alignment - 1);
+}
+
+bool AssetArchiveWriter::write(StringView filepath) const
+{
+    // Sort the entries by the hash of their names. Entries with the same hash are ordered by name, so duplicates are adjacent.
+    Vector<u32> entry_order;
+    entry_order.set_count_uninitialized(m_entries.count());
+    for (u32 entry_index = 0; entry_index < entry_order.count(); ++entry_index)
+        entry_order[entry_index] = entry_index;
+
+    std::sort(
+        entry_order.elements(),
+        entry_order.elements() + entry_order.count(),
+        [this](u32 lhs_index, u32 rhs_index)
+        {
+            const PendingEntry& lhs = m_entries[lhs_index];
+            const PendingEntry& rhs = m_entries[rhs_index];
+            if (lhs.name_hash != rhs.name_hash)
+                return (lhs.name_hash < rhs.name_hash);
+            return (strcmp(lhs.name.characters(), rhs.name.characters()) < 0);
+        }
+    );
+
+    for (usize order_index = 1; order_index < entry_order.count(); ++order_index)
+    {
+        const PendingEntry& previous_entry = m_entries[entry_order[order_index - 1]];
+        const PendingEntry& entry = m_entries[entry_order[order_index]];
+        if (previous_entry.name_hash == entry.name_hash && strcmp(previous_entry.name.characters(), entry.name.characters()) == 0)
+            return false;
+    }
+
+    // Lay out the archive.
+    const u64 entry_table_offset = sizeof(AssetArchiveHeader);
+    const u64 name_table_offset = entry_table_offset + m_entries.count() * sizeof(AssetArchiveEntry);
+    u64 name_table_byte_count = 0;
+    for (const PendingEntry& entry : m_entries)
+        name_table_byte_count += entry.name.view().byte_count();
+
+    u64 archive_byte_count = align_blob_offset(name_table_offset + name_table_byte_count);
+    Vector<u64> blob_offsets;
+    blob_offsets.set_count_uninitialized(m_entries.count());
+    for (u32 entry_index : entry_order)
+    {
+        blob_offsets[entry_index] = archive_byte_count;
+        archive_byte_count = align_blob_offset(archive_byte_count + m_entries[entry_index].stored_byte_count);
+    }
+
+    Vector<u8> archive;
+    archive.set_count_uninitialized(static_cast<usize>(archive_byte_count));
+    memset(archive.elements(), 0, archive.count());
+    u8* archive_bytes = archive.elements();
+
+    AssetArchiveEntry* entries = reinterpret_cast<AssetArchiveEntry*>(archive_bytes + entry_table_offset);
+    u64 name_offset = 0;
+    for (usize order_index = 0; order_index < entry_order.count(); ++order_index)
+    {
+        const PendingEntry& pending_entry = m_entries[entry_order[order_index]];
+        const StringView name = pending_entry.name.view();
+        const u8* bytes = m_data.elements() + pending_entry.data_offset;
+
+        AssetArchiveEntry& entry = entries[order_index];
+        entry.name_hash = pending_entry.name_hash;
+        entry.name_offset = static_cast<u32>(name_offset);
+        entry.name_byte_count = static_cast<u32>(name.byte_count());
+        entry.blob_offset = blob_offsets[entry_order[order_index]];
+        entry.stored_byte_count = pending_entry.stored_byte_count;
+        entry.byte_count = pending_entry.byte_count;
+        entry.content_hash = pending_entry.content_hash;
+        entry.compression = pending_entry.compression;
+
+        memcpy(archive_bytes + name_table_offset + name_offset, name.characters(), name.byte_count());
+        name_offset += name.byte_count();
+        memcpy(archive_bytes + entry.blob_offset, bytes, pending_entry.stored_byte_count);
+    }
+
+    AssetArchiveHeader* header = reinterpret_cast<AssetArchiveHeader*>(archive_bytes);
+    header->magic = AssetArchiveHeader::magic_value;
+    header->version = AssetArchiveHeader::current_version;
+    header->entry_count = static_cast<u32>(m_entries.count());
+    header->entry_table_offset = entry_table_offset;
+    header->name_table_offset = name_table_offset;
+    header->name_table_byte_count = name_table_byte_count;
+    header->archive_byte_count = archive_byte_count;
+    header->content_hash = hash_bytes(archive_bytes + sizeof(AssetArchiveHeader), archive.count() - sizeof(AssetArchiveHeader));
+
+    return FileSystem::write_entire_file_atomically(filepath, archive.elements(), archive.count());
+}
+
+#pragma endregion
+
+} // namespace CaveGame
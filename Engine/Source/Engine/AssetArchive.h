@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Span.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+#include <Core/Platform/File.h>
+
+namespace CaveGame
+{
+
+#pragma region Archive Layout
+
+//
+// The layout of a `.cpak` asset archive. All integers are little endian and all offsets are relative to the start
+// of the archive. The layout must only be changed together with `AssetArchiveHeader::current_version`.
+//
+//     [header] [entry table] [name table] [padding] [blob 0] [padding] [blob 1] ...
+//
+// The entries are sorted by the hash of their names, so an entry is found with a binary search over the entry table
+// without reading the name table. Every blob starts at a 64-byte boundary, so the mapped data can be used directly
+// by code that requires aligned (SIMD) loads.
+//
+struct AssetArchiveHeader
+{
+    static constexpr u32 magic_value = 0x4B415043; // 'CPAK'
+    static constexpr u32 current_version = 1;
+    static constexpr u64 blob_alignment = 64;
+
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 reserved;
+    u64 entry_table_offset;
+    u64 name_table_offset;
+    u64 name_table_byte_count;
+    // The size of the entire archive, which must match the size of the file.
+    u64 archive_byte_count;
+    // The hash of all the bytes that follow the header (see `hash_bytes`).
+    u64 content_hash;
+    u64 reserved_for_future_use;
+};
+
+enum class AssetCompression : u32
+{
+    // The blob stores the bytes of the asset, so they can be viewed directly in the mapped archive.
+    None = 0,
+
+    // The blob stores an LZ frame (see `LzFrameCompressor`), which is decompressed when the asset is read.
+    Lz = 1,
+};
+
+struct AssetArchiveEntry
+{
+    // The hash of the name (see `hash_bytes`), which is the key the entry table is sorted by.
+    u64 name_hash;
+    u32 name_offset;
+    u32 name_byte_count;
+    u64 blob_offset;
+    // The size of the blob stored in the archive, which is smaller than the asset if it is compressed.
+    u64 stored_byte_count;
+    u64 byte_count;
+    // The hash of the asset bytes (after decompression).
+    u64 content_hash;
+    AssetCompression compression;
+    u32 reserved;
+    u64 reserved_for_future_use;
+};
+
+static_assert(sizeof(AssetArchiveHeader) == 64, "The asset archive layout must be stable!");
+static_assert(sizeof(AssetArchiveEntry) == 64, "The asset archive layout must be stable!");
+
+#pragma endregion
+
+//
+// Read-only view of a `.cpak` archive. The archive is memory mapped, so opening it costs a single `open` and `mmap`
+// regardless of the number of assets, and the uncompressed assets are viewed directly in the page cache, without
+// being copied.
+//
+// NOTE: The structure of the archive is validated when it is opened, so a truncated or corrupted archive never
+// causes out-of-bounds reads. The content hashes are only checked on request, as that requires reading every page.
+//
+class AssetArchive
+{
+    CAVE_MAKE_NONCOPYABLE(AssetArchive);
+    CAVE_MAKE_NONMOVABLE(AssetArchive);
+
+public:
+    static constexpr u32 invalid_entry_index = static_cast<u32>(-1);
+
+public:
+    AssetArchive() = default;
+    ALWAYS_INLINE ~AssetArchive() { CAVE_ASSERT(!is_open()); }
+
+    // Maps the archive and validates its structure. Returns false if the archive can't be opened or is malformed.
+    bool open(StringView filepath);
+    void close();
+
+    NODISCARD ALWAYS_INLINE bool is_open() const { return m_mapped_file.is_open(); }
+    NODISCARD ALWAYS_INLINE u32 get_entry_count() const { return m_entry_count; }
+    NODISCARD ALWAYS_INLINE u64 get_archive_byte_count() const { return m_mapped_file.byte_count(); }
+
+    // Returns the index of the entry with the given name, or `invalid_entry_index` if there is no such entry.
+    NODISCARD u32 find_entry(StringView name) const;
+
+    NODISCARD StringView get_entry_name(u32 entry_index) const;
+    NODISCARD const AssetArchiveEntry& get_entry(u32 entry_index) const;
+
+    NODISCARD ALWAYS_INLINE bool is_entry_compressed(u32 entry_index) const { return (get_entry(entry_index).compression != AssetCompression::None); }
+
+    //
+    // Returns the view of the bytes of an uncompressed entry, inside the mapped archive. The view is valid until the
+    // archive is closed.
+    //
+    NODISCARD ReadonlyByteSpan get_entry_bytes(u32 entry_index) const;
+
+    // Copies (or decompresses) the bytes of the entry into the buffer. Returns false if the entry can't be decoded.
+    bool read_entry(u32 entry_index, Vector<u8>& out_bytes) const;
+
+    // Asks the operating system to read the blob of the entry into the page cache in the background.
+    void prefetch_entry(u32 entry_index) const;
+
+    // Returns false if the bytes of the archive don't match the content hash stored in the header.
+    NODISCARD bool verify_content_hash() const;
+
+    // Returns false if the bytes of the entry (after decompression) don't match its content hash.
+    NODISCARD bool verify_entry(u32 entry_index) const;
+
+private:
+    bool validate_layout() const;
+
+private:
+    MappedFile m_mapped_file;
+    const AssetArchiveEntry* m_entries { nullptr };
+    const char* m_names { nullptr };
+    u32 m_entry_count { 0 };
+};
+
+//
+// Builds a `.cpak` archive in memory. Used by the `AssetPacker` tool when the assets are cooked.
+//
+class AssetArchiveWriter
+{
+public:
+    //
+    // Copies the bytes of the asset. The name is usually the path of the asset, relative to the asset directory.
+    // Compressed assets are compressed right away, with the high level, and they are stored uncompressed if that
+    // doesn't make them smaller.
+    //
+    void add_entry(StringView name, const void* bytes, usize byte_count, AssetCompression compression = AssetCompression::None);
+
+    NODISCARD ALWAYS_INLINE usize get_entry_count() const { return m_entries.count(); }
+
+    //
+    // Lays out the archive and writes it atomically (see `FileSystem::write_entire_file_atomically`).
+    // Returns false if two entries have the same name or if the file can't be written.
+    //
+    bool write(StringView filepath) const;
+
+private:
+    struct PendingEntry
+    {
+        String name;
+        u64 name_hash { 0 };
+        usize data_offset { 0 };
+        usize stored_byte_count { 0 };
+        usize byte_count { 0 };
+        u64 content_hash { 0 };
+        AssetCompression compression { AssetCompression::None };
+    };
+
+private:
+    Vector<PendingEntry> m_entries;
+    Vector<u8> m_data;
+};
+
+} // namespace CaveGame
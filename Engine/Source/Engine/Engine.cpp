@@ -6,8 +6,21 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
-#include <Core/Platform/Timer.h>
+#include <Core/Logging/Logger.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/AsyncFileIo.h>
+#include <Core/Platform/FastClock.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Profiling/CounterProfiler.h>
+#include <Core/Profiling/Metrics.h>
+#include <Core/Profiling/Profiler.h>
+#include <Core/Profiling/SamplingProfiler.h>
 #include <Engine/Engine.h>
+#include <Engine/FramePacer.h>
+#include <Engine/FramePipeline.h>
+#include <Engine/FrameStatistics.h>
+#include <Engine/JobSystem.h>
+#include <Engine/Task.h>
 
 namespace CaveGame
 {
@@ -15,6 +28,7 @@ namespace CaveGame
 struct EngineData
 {
     Window window;
+    FrameStatistics frame_statistics;
 };
 
 static EngineData* s_engine;
@@ -32,6 +46,8 @@ bool Engine::initialize()
 
     if (!s_engine->window.initialize())
     {
+        CAVE_LOG_ERROR("The window can't be created.");
+
         // NOTE: If the window creation fails there is no point in continuing the program execution.
         // Without a window, the game is definetely unplayable.
         return false;
@@ -62,26 +78,130 @@ void Engine::run(GameLoop& game_loop)
         return;
     }
 
-    // NOTE: For the first frame assume that the game runs at 60FPS.
-    // Running the update function with a delta time of 0 might cause errors.
-    float last_frame_delta_time = 1.0F / 60.0F;
+    FramePacer frame_pacer;
+
+    // NOTE: If the render thread can't be started, the extracted frames are rendered on the simulation thread.
+    const bool is_pipelined_rendering_enabled = game_loop.is_pipelined_rendering_enabled();
+    FramePipeline frame_pipeline;
+    if (is_pipelined_rendering_enabled && !frame_pipeline.start(game_loop))
+        CAVE_LOG_WARNING("The render thread can't be started. The frames are rendered on the simulation thread.");
+
+    // The simulation time that has elapsed but hasn't been simulated yet, measured in `FastClock` ticks.
+    u64 accumulated_ticks = 0;
+    u64 last_frame_start_ticks = FastClock::get_ticks();
 
     while (game_loop.is_running())
     {
-        Timer frame_timer;
+        CAVE_PROFILE_MARK_FRAME();
+        CAVE_PROFILE_COUNTERS_MARK_FRAME();
+        const u64 frame_start_ticks = FastClock::get_ticks();
+        const u64 frame_delta_ticks = frame_start_ticks - last_frame_start_ticks;
+        last_frame_start_ticks = frame_start_ticks;
+
+        FrameStatistics& frame_statistics = s_engine->frame_statistics;
+        u64 stage_start_ticks = frame_start_ticks;
+
+        {
+            CAVE_PROFILE_SCOPE("ProcessEvents");
+            s_engine->window.process_event_queue();
+        }
+
+        const u64 process_events_end_ticks = FastClock::get_ticks();
+        frame_statistics.record_stage_duration(FrameStage::ProcessEvents, process_events_end_ticks - stage_start_ticks);
 
-        s_engine->window.process_event_queue();
         if (s_engine->window.should_close())
         {
             game_loop.stop_running();
             continue;
         }
 
-        game_loop.on_game_update(last_frame_delta_time);
-        last_frame_delta_time = frame_timer.stop_and_get_elapsed_seconds();
+        // Move the call stacks sampled during the last frame out of the ring buffers, before they are overwritten.
+        if (SamplingProfiler::is_running())
+            SamplingProfiler::process_samples();
+
+        // Invoke the callbacks of the finished file operations, which can schedule jobs or spawn tasks.
+        {
+            CAVE_PROFILE_SCOPE("ProcessFileCompletions");
+            AsyncFileIo::process_completions();
+        }
+
+        // Resume the tasks that are waiting for this frame or whose background operations have finished.
+        {
+            CAVE_PROFILE_SCOPE("PumpTasks");
+            TaskScheduler::pump();
+        }
+
+        // NOTE: The timing settings are read every frame, so the game loop is allowed to change them at any time.
+        const u64 tick_duration_ticks = FastClock::get_tick_frequency() / game_loop.get_tick_rate();
+        const float tick_delta_time = 1.0F / static_cast<float>(game_loop.get_tick_rate());
+        frame_pacer.set_target_frame_rate(game_loop.get_target_frame_rate());
+
+        // Prevent the 'spiral of death': if the simulation can't keep up, drop the time that can't be simulated
+        // during this frame instead of accumulating an ever increasing backlog.
+        const u64 maximum_accumulated_ticks = tick_duration_ticks * game_loop.get_maximum_ticks_per_frame();
+        accumulated_ticks = Math::min(accumulated_ticks + frame_delta_ticks, maximum_accumulated_ticks);
+
+        stage_start_ticks = FastClock::get_ticks();
+        while (accumulated_ticks >= tick_duration_ticks && game_loop.is_running())
+        {
+            CAVE_PROFILE_COUNTERS_SCOPE("Update");
+            game_loop.on_game_update(tick_delta_time);
+            accumulated_ticks -= tick_duration_ticks;
+        }
+
+        const u64 update_end_ticks = FastClock::get_ticks();
+        frame_statistics.record_stage_duration(FrameStage::Update, update_end_ticks - stage_start_ticks);
+
+        const float interpolation_alpha = static_cast<float>(accumulated_ticks) / static_cast<float>(tick_duration_ticks);
+        const float frame_delta_time = FastClock::ticks_to_seconds(frame_delta_ticks);
+
+        if (frame_pipeline.is_running())
+        {
+            // The render thread renders the extracted state while the next frame is simulated.
+            const u32 frame_state_index = frame_pipeline.acquire_frame_state();
+            CAVE_PROFILE_SCOPE("Extract");
+            game_loop.on_game_extract(frame_state_index, interpolation_alpha);
+            frame_pipeline.submit_frame_state(frame_state_index, frame_delta_time);
+        }
+        else if (is_pipelined_rendering_enabled)
+        {
+            CAVE_PROFILE_COUNTERS_SCOPE("Render");
+            game_loop.on_game_extract(0, interpolation_alpha);
+            game_loop.on_game_render_extracted(0, frame_delta_time);
+        }
+        else
+        {
+            CAVE_PROFILE_COUNTERS_SCOPE("Render");
+            game_loop.on_game_render(frame_delta_time, interpolation_alpha);
+        }
+
+        const u64 render_end_ticks = FastClock::get_ticks();
+        frame_statistics.record_stage_duration(FrameStage::Render, render_end_ticks - update_end_ticks);
+
+        {
+            CAVE_PROFILE_SCOPE("WaitForNextFrame");
+            frame_pacer.wait_for_next_frame();
+        }
+
+        const u64 frame_end_ticks = FastClock::get_ticks();
+        frame_statistics.record_stage_duration(FrameStage::WaitForNextFrame, frame_end_ticks - render_end_ticks);
+        frame_statistics.record_stage_duration(FrameStage::Frame, frame_end_ticks - frame_start_ticks);
+        frame_statistics.end_frame();
     }
 
+    // The frames that are still being rendered might access the game state that is released by the game end function.
+    frame_pipeline.stop();
     game_loop.on_game_end();
+
+    const FrameStatistics& frame_statistics = s_engine->frame_statistics;
+    if (!frame_statistics.get_report_filepath().is_empty() && !frame_statistics.write_report(frame_statistics.get_report_filepath().view()))
+        CAVE_LOG_WARNING("The frame statistics report '{}' can't be written.", frame_statistics.get_report_filepath());
+}
+
+FrameStatistics& Engine::get_frame_statistics()
+{
+    CAVE_ASSERT(s_engine);
+    return s_engine->frame_statistics;
 }
 
 Window& Engine::get_window()
@@ -90,12 +210,62 @@ Window& Engine::get_window()
     return s_engine->window;
 }
 
-bool initialize_core_systems()
+bool initialize_core_systems(ThreadPlacementPolicy thread_placement_policy)
 {
+    // NOTE: The clock must be calibrated before any timing (including the frame timer) is performed.
+    if (!FastClock::initialize())
+        return false;
+
+    // NOTE: The logger is started before the other systems, so that they can report their initialization failures.
+    if (!Logger::initialize("CaveGame.log"sv))
+        return false;
+
+    if (!JobSystem::initialize(thread_placement_policy))
+    {
+        CAVE_LOG_FATAL("The job system can't be initialized.");
+        return false;
+    }
+
+    if (!TaskScheduler::initialize())
+    {
+        CAVE_LOG_FATAL("The task scheduler can't be initialized.");
+        return false;
+    }
+
+    if (!AsyncFileIo::initialize())
+    {
+        CAVE_LOG_FATAL("The asynchronous file I/O service can't be initialized.");
+        return false;
+    }
+    CAVE_LOG_INFO("The asynchronous file I/O service uses the {} backend.", (AsyncFileIo::get_backend() == AsyncIoBackend::Native) ? "native" : "thread pool");
+
+    // NOTE: The metrics are optional, so failing to publish them doesn't prevent the engine from running.
+    char metrics_region_name[64];
+    Metrics::get_default_region_name(PlatformCore::get_current_process_id(), metrics_region_name, sizeof(metrics_region_name));
+    if (Metrics::start_publishing(StringView::create_from_utf8(metrics_region_name)))
+        CAVE_LOG_INFO("Publishing the metrics to the shared memory region '{}'.", metrics_region_name);
+    else
+        CAVE_LOG_WARNING("The metrics can't be published to the shared memory region '{}'.", metrics_region_name);
+
+    CAVE_LOG_INFO("Core systems initialized. The job system uses {} workers.", JobSystem::get_worker_count());
+
     return true;
 }
 
 void shutdown_core_systems()
-{}
+{
+    Metrics::stop_publishing();
+    AsyncFileIo::shutdown();
+    TaskScheduler::shutdown();
+    JobSystem::shutdown();
+
+    // NOTE: All the threads that record profiler events must have been stopped.
+    CounterProfiler::shutdown();
+    SamplingProfiler::shutdown();
+    Profiler::shutdown();
+
+    // NOTE: The logger is shut down last, so that the other systems can log until they are shut down.
+    Logger::shutdown();
+}
 
 } // namespace CaveGame
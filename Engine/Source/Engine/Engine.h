@@ -9,7 +9,9 @@
 #pragma once
 
 #include <Core/Platform/Window.h>
+#include <Engine/FrameStatistics.h>
 #include <Engine/GameLoop.h>
+#include <Engine/JobSystem.h>
 
 namespace CaveGame
 {
@@ -34,11 +36,18 @@ public:
     //
     NODISCARD static Window& get_window();
 
+    // Returns the durations of the frames (and of their stages) measured by the engine.
+    NODISCARD static FrameStatistics& get_frame_statistics();
+
 private:
     static void run(GameLoop& game_loop);
 };
 
-bool initialize_core_systems();
+//
+// Initializes the systems that are required before the engine can be created (the clock, the job system and the task
+// scheduler). The placement policy controls how the main thread and the job system workers are bound to processors.
+//
+bool initialize_core_systems(ThreadPlacementPolicy thread_placement_policy = ThreadPlacementPolicy::PhysicalCores);
 void shutdown_core_systems();
 
 } // namespace CaveGame
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/FastClock.h>
+#include <Engine/FramePacer.h>
+
+#include <immintrin.h>
+
+namespace CaveGame
+{
+
+// The bounds of the sleep slack, measured in microseconds.
+static constexpr u64 s_initial_sleep_slack_microseconds = 1000;
+static constexpr u64 s_minimum_sleep_slack_microseconds = 50;
+static constexpr u64 s_maximum_sleep_slack_microseconds = 4000;
+
+NODISCARD ALWAYS_INLINE static u64 microseconds_to_ticks(u64 microseconds)
+{
+    return (microseconds * FastClock::get_tick_frequency()) / 1000000;
+}
+
+void FramePacer::set_target_frame_rate(u32 target_frame_rate)
+{
+    if (target_frame_rate == m_target_frame_rate)
+        return;
+
+    m_target_frame_rate = target_frame_rate;
+    m_target_frame_ticks = (target_frame_rate > 0) ? (FastClock::get_tick_frequency() / target_frame_rate) : 0;
+    m_frame_deadline = 0;
+
+    if (m_sleep_slack_ticks == 0)
+        m_sleep_slack_ticks = microseconds_to_ticks(s_initial_sleep_slack_microseconds);
+}
+
+void FramePacer::wait_for_next_frame()
+{
+    if (m_target_frame_ticks == 0)
+    {
+        // The frame rate is not limited.
+        return;
+    }
+
+    u64 current_ticks = FastClock::get_ticks();
+    if (m_frame_deadline == 0 || current_ticks >= m_frame_deadline + m_target_frame_ticks)
+    {
+        // NOTE: This is either the first paced frame or the frame took longer than two frame times. Trying to
+        // catch up by running the following frames back-to-back would only produce uneven frame times.
+        m_frame_deadline = current_ticks;
+    }
+
+    if (current_ticks + m_sleep_slack_ticks < m_frame_deadline)
+    {
+        const u64 requested_sleep_ticks = m_frame_deadline - current_ticks - m_sleep_slack_ticks;
+        PlatformCore::sleep_for_nanoseconds(FastClock::ticks_to_nanoseconds(requested_sleep_ticks));
+
+        const u64 wake_up_ticks = FastClock::get_ticks();
+        const u64 actual_sleep_ticks = wake_up_ticks - current_ticks;
+        const u64 oversleep_ticks = (actual_sleep_ticks > requested_sleep_ticks) ? (actual_sleep_ticks - requested_sleep_ticks) : 0;
+        current_ticks = wake_up_ticks;
+
+        // Grow the slack immediately when the sleep overshoots it, but shrink it slowly, so a single
+        // precise wake-up doesn't cause the following deadlines to be missed.
+        if (oversleep_ticks > m_sleep_slack_ticks)
+            m_sleep_slack_ticks = oversleep_ticks;
+        else
+            m_sleep_slack_ticks -= (m_sleep_slack_ticks - oversleep_ticks) / 16;
+
+        m_sleep_slack_ticks = Math::clamp(
+            m_sleep_slack_ticks,
+            microseconds_to_ticks(s_minimum_sleep_slack_microseconds),
+            microseconds_to_ticks(s_maximum_sleep_slack_microseconds)
+        );
+    }
+
+    while (current_ticks < m_frame_deadline)
+    {
+        _mm_pause();
+        current_ticks = FastClock::get_ticks();
+    }
+
+    m_frame_deadline += m_target_frame_ticks;
+}
+
+} // namespace CaveGame
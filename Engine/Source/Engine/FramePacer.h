@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Limits the frame rate by waiting until the start of the next frame.
+//
+// The OS sleep functions are cheap but imprecise, while spinning is precise but keeps the core busy. Thus, the pacer
+// sleeps until shortly before the deadline and spins for the remaining time. The length of the spinning interval
+// adapts to the oversleep measured on the current machine, so the deadlines are hit within about 0.1 milliseconds
+// while the thread sleeps for most of the time.
+//
+class FramePacer
+{
+public:
+    // Zero (0) disables the frame rate limit.
+    void set_target_frame_rate(u32 target_frame_rate);
+
+    //
+    // Blocks the calling thread until the start of the next frame. If the frame took longer than the target frame
+    // time the function returns immediately and the following deadlines are computed relative to the current time.
+    //
+    void wait_for_next_frame();
+
+private:
+    u32 m_target_frame_rate { 0 };
+    u64 m_target_frame_ticks { 0 };
+
+    // The deadline of the current frame, measured in `FastClock` ticks. Zero if no frame has been paced yet.
+    u64 m_frame_deadline { 0 };
+
+    // How long before the deadline the sleep should end, measured in `FastClock` ticks.
+    u64 m_sleep_slack_ticks { 0 };
+};
+
+} // namespace CaveGame
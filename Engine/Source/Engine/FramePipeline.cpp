@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Profiling/Profiler.h>
+#include <Engine/FramePipeline.h>
+
+namespace CaveGame
+{
+
+bool FramePipeline::start(GameLoop& game_loop)
+{
+    CAVE_ASSERT(!is_running());
+    m_game_loop = &game_loop;
+    m_next_frame_state_index = 0;
+    m_is_stop_requested.store(false, std::memory_order_relaxed);
+
+    if (!m_free_frame_states.initialize(GameLoop::frame_state_count))
+        return false;
+
+    if (!m_submitted_frame_states.initialize(0))
+    {
+        m_free_frame_states.shutdown();
+        return false;
+    }
+
+    ThreadDescription description;
+    description.name = "Render"sv;
+    description.priority = ThreadPriority::High;
+
+    if (!m_render_thread.create(render_thread_entry_point, this, description))
+    {
+        m_submitted_frame_states.shutdown();
+        m_free_frame_states.shutdown();
+        return false;
+    }
+
+    return true;
+}
+
+void FramePipeline::stop()
+{
+    if (!is_running())
+    {
+        // The frame pipeline has already been stopped.
+        return;
+    }
+
+    // Once all the buffers have been acquired, every submitted frame has been rendered.
+    for (u32 index = 0; index < GameLoop::frame_state_count; ++index)
+        m_free_frame_states.wait();
+
+    m_is_stop_requested.store(true, std::memory_order_relaxed);
+    m_submitted_frame_states.signal();
+    m_render_thread.join();
+
+    m_submitted_frame_states.shutdown();
+    m_free_frame_states.shutdown();
+}
+
+u32 FramePipeline::acquire_frame_state()
+{
+    CAVE_ASSERT(is_running());
+    m_free_frame_states.wait();
+
+    const u32 frame_state_index = m_next_frame_state_index;
+    m_next_frame_state_index = (m_next_frame_state_index + 1) % GameLoop::frame_state_count;
+    return frame_state_index;
+}
+
+void FramePipeline::submit_frame_state(u32 frame_state_index, float frame_delta_time)
+{
+    CAVE_ASSERT(frame_state_index < GameLoop::frame_state_count);
+    m_frame_delta_times[frame_state_index] = frame_delta_time;
+
+    // NOTE: Signaling the semaphore makes the writes to the frame state buffer visible to the render thread.
+    m_submitted_frame_states.signal();
+}
+
+void FramePipeline::render_thread_entry_point(void* user_data)
+{
+    FramePipeline& pipeline = *static_cast<FramePipeline*>(user_data);
+
+    // The buffers are acquired in round-robin order, so they are rendered in the same order.
+    u32 frame_state_index = 0;
+    while (true)
+    {
+        pipeline.m_submitted_frame_states.wait();
+        if (pipeline.m_is_stop_requested.load(std::memory_order_relaxed))
+            break;
+
+        {
+            CAVE_PROFILE_SCOPE("Render");
+            pipeline.m_game_loop->on_game_render_extracted(frame_state_index, pipeline.m_frame_delta_times[frame_state_index]);
+        }
+        pipeline.m_free_frame_states.signal();
+
+        frame_state_index = (frame_state_index + 1) % GameLoop::frame_state_count;
+    }
+}
+
+} // namespace CaveGame
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Platform/Thread.h>
+#include <Engine/GameLoop.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Renders the frames on a dedicated thread, overlapping the rendering of frame N with the simulation of frame N+1.
+//
+// The simulation thread extracts the state of every frame into one of the frame state buffers owned by the game and
+// hands it over to the render thread, which renders the frames in submission order. A buffer is reused only after
+// its frame has been rendered, so the simulation can't run more than one frame ahead of the rendering.
+//
+class FramePipeline
+{
+    CAVE_MAKE_NONCOPYABLE(FramePipeline);
+    CAVE_MAKE_NONMOVABLE(FramePipeline);
+
+public:
+    FramePipeline() = default;
+    ALWAYS_INLINE ~FramePipeline() { CAVE_ASSERT(!m_render_thread.is_created()); }
+
+    // Starts the render thread. Returns false if the thread creation has failed.
+    bool start(GameLoop& game_loop);
+
+    // Waits until all the submitted frames have been rendered and stops the render thread.
+    void stop();
+
+    NODISCARD ALWAYS_INLINE bool is_running() const { return m_render_thread.is_created(); }
+
+    // Blocks until a frame state buffer is no longer used by the render thread and returns its index.
+    NODISCARD u32 acquire_frame_state();
+
+    // Hands over the extracted frame state buffer to the render thread.
+    void submit_frame_state(u32 frame_state_index, float frame_delta_time);
+
+private:
+    static void render_thread_entry_point(void* user_data);
+
+private:
+    GameLoop* m_game_loop { nullptr };
+    Thread m_render_thread;
+
+    // Counts the frame state buffers that can be written by the simulation thread.
+    Semaphore m_free_frame_states;
+
+    // Counts the frame state buffers that have been submitted but not yet rendered.
+    Semaphore m_submitted_frame_states;
+
+    float m_frame_delta_times[GameLoop::frame_state_count] {};
+    u32 m_next_frame_state_index { 0 };
+    std::atomic<bool> m_is_stop_requested { false };
+};
+
+} // namespace CaveGame
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/FastClock.h>
+#include <Engine/FrameStatistics.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+const char* get_frame_stage_name(FrameStage stage)
+{
+    switch (stage)
+    {
+        case FrameStage::Frame: return "Frame";
+        case FrameStage::ProcessEvents: return "ProcessEvents";
+        case FrameStage::Update: return "Update";
+        case FrameStage::Render: return "Render";
+        case FrameStage::WaitForNextFrame: return "WaitForNextFrame";
+        case FrameStage::Count: break;
+    }
+
+    CAVE_ASSERT(false);
+    return "Unknown";
+}
+
+FrameStatistics::StageHistograms::StageHistograms()
+    : total(highest_trackable_microseconds)
+    , window(highest_trackable_microseconds)
+{}
+
+FrameStatistics::FrameStatistics()
+{
+    for (u8 stage_index = 0; stage_index < static_cast<u8>(FrameStage::Count); ++stage_index)
+    {
+        char metric_name[MetricsRegionEntry::maximum_name_length + 1];
+        snprintf(metric_name, sizeof(metric_name), "frame_time_us.%s", get_frame_stage_name(static_cast<FrameStage>(stage_index)));
+        m_stage_metrics[stage_index] = Metrics::register_histogram(StringView::create_from_utf8(metric_name));
+    }
+
+    m_frame_count_metric = Metrics::register_counter("engine.frames"sv);
+}
+
+void FrameStatistics::record_stage_duration(FrameStage stage, u64 duration_ticks)
+{
+    CAVE_ASSERT(stage < FrameStage::Count);
+    const u64 duration_microseconds = FastClock::ticks_to_nanoseconds(duration_ticks) / 1000;
+
+    StageHistograms& histograms = m_stage_histograms[static_cast<u8>(stage)];
+    histograms.total.record(duration_microseconds);
+    histograms.window.record(duration_microseconds);
+    m_stage_metrics[static_cast<u8>(stage)].record(duration_microseconds);
+}
+
+void FrameStatistics::end_frame()
+{
+    ++m_frame_count;
+    m_frame_count_metric.add();
+    if (++m_window_frame_count < m_rolling_window_frame_count)
+        return;
+
+    for (u8 stage_index = 0; stage_index < static_cast<u8>(FrameStage::Count); ++stage_index)
+    {
+        m_rolling_summaries[stage_index] = compute_summary(m_stage_histograms[stage_index].window);
+        m_stage_histograms[stage_index].window.reset();
+    }
+
+    m_window_frame_count = 0;
+}
+
+void FrameStatistics::reset()
+{
+    for (u8 stage_index = 0; stage_index < static_cast<u8>(FrameStage::Count); ++stage_index)
+    {
+        m_stage_histograms[stage_index].total.reset();
+        m_stage_histograms[stage_index].window.reset();
+        m_rolling_summaries[stage_index] = {};
+    }
+
+    m_frame_count = 0;
+    m_window_frame_count = 0;
+}
+
+FrameStageSummary FrameStatistics::compute_total_summary(FrameStage stage) const
+{
+    CAVE_ASSERT(stage < FrameStage::Count);
+    return compute_summary(m_stage_histograms[static_cast<u8>(stage)].total);
+}
+
+FrameStageSummary FrameStatistics::compute_summary(const HdrHistogram& histogram) const
+{
+    const auto to_milliseconds = [](u64 microseconds) { return static_cast<float>(microseconds) / 1000.0F; };
+
+    FrameStageSummary summary;
+    summary.sample_count = histogram.get_total_count();
+    summary.mean_milliseconds = static_cast<float>(histogram.get_mean_value() / 1000.0);
+    summary.p50_milliseconds = to_milliseconds(histogram.get_value_at_percentile(50.0));
+    summary.p95_milliseconds = to_milliseconds(histogram.get_value_at_percentile(95.0));
+    summary.p99_milliseconds = to_milliseconds(histogram.get_value_at_percentile(99.0));
+    summary.p999_milliseconds = to_milliseconds(histogram.get_value_at_percentile(99.9));
+    summary.maximum_milliseconds = to_milliseconds(histogram.get_maximum_value());
+    summary.hitch_count = histogram.get_count_above_value(m_hitch_threshold_microseconds);
+    return summary;
+}
+
+bool FrameStatistics::write_report(StringView filepath) const
+{
+    const String filepath_string = String(filepath);
+
+#if CAVE_COMPILER_MSVC
+    FILE* file = nullptr;
+    if (fopen_s(&file, filepath_string.characters(), "wb") != 0)
+        return false;
+#else
+    FILE* file = fopen(filepath_string.characters(), "wb");
+    if (!file)
+        return false;
+#endif // CAVE_COMPILER_MSVC
+
+    const StringView csv_extension = ".csv"sv;
+    const bool is_csv = filepath.byte_count() >= csv_extension.byte_count() &&
+                        memcmp(filepath.characters() + filepath.byte_count() - csv_extension.byte_count(), csv_extension.characters(), csv_extension.byte_count()) == 0;
+
+    if (is_csv)
+        fputs("stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,p999_ms,max_ms,hitches\n", file);
+    else
+        fprintf(file, "{\n    \"frame_count\": %llu,\n    \"hitch_threshold_ms\": %.3f,\n    \"stages\": {", static_cast<unsigned long long>(m_frame_count), get_hitch_threshold_milliseconds());
+
+    for (u8 stage_index = 0; stage_index < static_cast<u8>(FrameStage::Count); ++stage_index)
+    {
+        const FrameStageSummary summary = compute_total_summary(static_cast<FrameStage>(stage_index));
+        const char* stage_name = get_frame_stage_name(static_cast<FrameStage>(stage_index));
+
+        if (is_csv)
+        {
+            fprintf(
+                file,
+                "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%llu\n",
+                stage_name,
+                static_cast<unsigned long long>(summary.sample_count),
+                summary.mean_milliseconds,
+                summary.p50_milliseconds,
+                summary.p95_milliseconds,
+                summary.p99_milliseconds,
+                summary.p999_milliseconds,
+                summary.maximum_milliseconds,
+                static_cast<unsigned long long>(summary.hitch_count)
+            );
+        }
+        else
+        {
+            fprintf(
+                file,
+                "%s\n        \"%s\": { \"samples\": %llu, \"mean_ms\": %.3f, \"p50_ms\": %.3f, \"p95_ms\": %.3f, \"p99_ms\": %.3f, \"p999_ms\": %.3f, "
+                "\"max_ms\": %.3f, \"hitches\": %llu }",
+                (stage_index > 0) ? "," : "",
+                stage_name,
+                static_cast<unsigned long long>(summary.sample_count),
+                summary.mean_milliseconds,
+                summary.p50_milliseconds,
+                summary.p95_milliseconds,
+                summary.p99_milliseconds,
+                summary.p999_milliseconds,
+                summary.maximum_milliseconds,
+                static_cast<unsigned long long>(summary.hitch_count)
+            );
+        }
+    }
+
+    if (!is_csv)
+        fputs("\n    }\n}\n", file);
+
+    const bool is_successful = (ferror(file) == 0);
+    fclose(file);
+    return is_successful;
+}
+
+} // namespace CaveGame
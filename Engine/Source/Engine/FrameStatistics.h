@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+#include <Core/Profiling/HdrHistogram.h>
+#include <Core/Profiling/Metrics.h>
+
+namespace CaveGame
+{
+
+// The parts of a frame whose durations are recorded by `FrameStatistics`.
+enum class FrameStage : u8
+{
+    // The entire frame, including the wait for the start of the next frame.
+    Frame,
+    ProcessEvents,
+    // All the simulation ticks executed during the frame.
+    Update,
+    // The rendering on the main thread, or the extraction of the frame state when rendering is pipelined.
+    Render,
+    // The time spent by the frame pacer waiting for the start of the next frame.
+    WaitForNextFrame,
+
+    Count,
+};
+
+NODISCARD const char* get_frame_stage_name(FrameStage stage);
+
+struct FrameStageSummary
+{
+    u64 sample_count { 0 };
+    float mean_milliseconds { 0.0F };
+    float p50_milliseconds { 0.0F };
+    float p95_milliseconds { 0.0F };
+    float p99_milliseconds { 0.0F };
+    float p999_milliseconds { 0.0F };
+    float maximum_milliseconds { 0.0F };
+
+    // The number of samples that are longer than the hitch threshold.
+    u64 hitch_count { 0 };
+};
+
+//
+// Records the duration of every frame (and of its stages) into HDR histograms, so that the tail latencies are
+// reported with a constant relative precision (0.1%) regardless of how long the game runs.
+//
+// Two sets of statistics are kept: the rolling statistics, which describe the last completed window of frames and
+// are updated when a window completes, and the total statistics, which describe all the frames since the start.
+// The stage durations are also published as metrics (see `Metrics`), named `frame_time_us.<StageName>`.
+// NOTE: The statistics are recorded and queried only from the main thread.
+//
+class FrameStatistics
+{
+    CAVE_MAKE_NONCOPYABLE(FrameStatistics);
+    CAVE_MAKE_NONMOVABLE(FrameStatistics);
+
+public:
+    // The longest duration that can be recorded. Longer durations are recorded as this value.
+    static constexpr u64 highest_trackable_microseconds = 60ull * 1000 * 1000;
+
+public:
+    FrameStatistics();
+
+    void record_stage_duration(FrameStage stage, u64 duration_ticks);
+
+    // Completes the current frame. Every `get_rolling_window_frame_count()` frames the rolling statistics are updated.
+    void end_frame();
+
+    void reset();
+
+public:
+    NODISCARD ALWAYS_INLINE u64 get_frame_count() const { return m_frame_count; }
+
+    NODISCARD ALWAYS_INLINE u32 get_rolling_window_frame_count() const { return m_rolling_window_frame_count; }
+    ALWAYS_INLINE void set_rolling_window_frame_count(u32 frame_count)
+    {
+        CAVE_ASSERT(frame_count > 0);
+        m_rolling_window_frame_count = frame_count;
+    }
+
+    // The samples longer than the threshold are counted as hitches. The default is 33.3 ms (30 FPS).
+    NODISCARD ALWAYS_INLINE float get_hitch_threshold_milliseconds() const { return static_cast<float>(m_hitch_threshold_microseconds) / 1000.0F; }
+    ALWAYS_INLINE void set_hitch_threshold_milliseconds(float milliseconds) { m_hitch_threshold_microseconds = static_cast<u64>(milliseconds * 1000.0F); }
+
+    // Returns the statistics of the last completed window of frames. Empty until the first window completes.
+    NODISCARD ALWAYS_INLINE const FrameStageSummary& get_rolling_summary(FrameStage stage) const
+    {
+        CAVE_ASSERT(stage < FrameStage::Count);
+        return m_rolling_summaries[static_cast<u8>(stage)];
+    }
+
+    // Returns the statistics of all the frames recorded since the start (or the last reset).
+    NODISCARD FrameStageSummary compute_total_summary(FrameStage stage) const;
+
+public:
+    //
+    // Writes the total statistics of every stage to the given file. The file is written as CSV if its extension is
+    // `.csv` and as JSON otherwise. Returns false if the file can't be written.
+    //
+    bool write_report(StringView filepath) const;
+
+    // If a report filepath is set, the report is written when the engine stops running the game loop.
+    NODISCARD ALWAYS_INLINE const String& get_report_filepath() const { return m_report_filepath; }
+    ALWAYS_INLINE void set_report_filepath(StringView filepath) { m_report_filepath = filepath; }
+
+private:
+    struct StageHistograms
+    {
+        StageHistograms();
+
+        HdrHistogram total;
+        HdrHistogram window;
+    };
+
+    NODISCARD FrameStageSummary compute_summary(const HdrHistogram& histogram) const;
+
+private:
+    StageHistograms m_stage_histograms[static_cast<u8>(FrameStage::Count)];
+    FrameStageSummary m_rolling_summaries[static_cast<u8>(FrameStage::Count)];
+    MetricHistogram m_stage_metrics[static_cast<u8>(FrameStage::Count)];
+    MetricCounter m_frame_count_metric;
+
+    u64 m_frame_count { 0 };
+    u32 m_window_frame_count { 0 };
+    u32 m_rolling_window_frame_count { 600 };
+    u64 m_hitch_threshold_microseconds { 33333 };
+
+    String m_report_filepath;
+};
+
+} // namespace CaveGame
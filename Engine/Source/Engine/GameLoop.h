@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <Core/Assertion.h>
 #include <Core/CoreTypes.h>
 
 namespace CaveGame
@@ -20,14 +21,80 @@ public:
     
     virtual void on_game_end() {}
 
+    //
+    // Advances the simulation by one tick. Invoked at a fixed rate (see `GameLoop::set_tick_rate`), thus
+    // `delta_time` is always equal to `1 / tick_rate` seconds. Zero, one or multiple ticks can be executed per frame.
+    //
     virtual void on_game_update(float delta_time) = 0;
 
+    //
+    // Invoked once per frame, after the simulation ticks of the frame have been executed.
+    // The `interpolation_alpha` (in the `[0, 1)` range) represents how far the current time is between the last
+    // simulated tick and the next one, and should be used to blend between the previous and the current state.
+    //
+    virtual void on_game_render(MAYBE_UNUSED float frame_delta_time, MAYBE_UNUSED float interpolation_alpha) {}
+
+    //
+    // Invoked once per frame instead of `GameLoop::on_game_render` when pipelined rendering is enabled, on the same
+    // thread as `GameLoop::on_game_update`. Should copy the (interpolated) state required to render the frame into the
+    // frame state buffer with the given index, which is owned by the game and is no longer read by the render thread.
+    //
+    virtual void on_game_extract(MAYBE_UNUSED u32 frame_state_index, MAYBE_UNUSED float interpolation_alpha) {}
+
+    //
+    // Invoked on the render thread for every extracted frame, while the simulation of the next frame is executed.
+    // Must only read the frame state buffer with the given index, as the rest of the game state is modified
+    // concurrently. NOTE: Jobs and tasks can't be scheduled from the render thread.
+    //
+    virtual void on_game_render_extracted(MAYBE_UNUSED u32 frame_state_index, MAYBE_UNUSED float frame_delta_time) {}
+
 public:
     NODISCARD ALWAYS_INLINE bool is_running() const { return m_is_running; }
     ALWAYS_INLINE void stop_running() { m_is_running = false; }
 
+public:
+    // The number of frame state buffers used by pipelined rendering. The frame state indices are in `[0, count)`.
+    static constexpr u32 frame_state_count = 2;
+
+    //
+    // When enabled, the extracted state of frame N is rendered on a dedicated thread while frame N+1 is simulated.
+    // Increases the frame rate when the simulation and the rendering take a similar amount of time, at the cost of
+    // one frame of latency. Must be configured before (or during) `GameLoop::on_game_start`.
+    //
+    NODISCARD ALWAYS_INLINE bool is_pipelined_rendering_enabled() const { return m_is_pipelined_rendering_enabled; }
+    ALWAYS_INLINE void set_pipelined_rendering_enabled(bool is_enabled) { m_is_pipelined_rendering_enabled = is_enabled; }
+
+public:
+    // The number of simulation ticks per second.
+    NODISCARD ALWAYS_INLINE u32 get_tick_rate() const { return m_tick_rate; }
+    ALWAYS_INLINE void set_tick_rate(u32 tick_rate)
+    {
+        CAVE_ASSERT(tick_rate > 0);
+        m_tick_rate = tick_rate;
+    }
+
+    // The maximum number of frames per second. Zero (0) means that the frame rate is not limited.
+    NODISCARD ALWAYS_INLINE u32 get_target_frame_rate() const { return m_target_frame_rate; }
+    ALWAYS_INLINE void set_target_frame_rate(u32 target_frame_rate) { m_target_frame_rate = target_frame_rate; }
+
+    //
+    // The maximum number of ticks executed during a single frame. If the simulation falls further behind, the
+    // excess time is dropped (the game slows down) instead of trying to catch up, which would only make the
+    // following frames even longer (the 'spiral of death').
+    //
+    NODISCARD ALWAYS_INLINE u32 get_maximum_ticks_per_frame() const { return m_maximum_ticks_per_frame; }
+    ALWAYS_INLINE void set_maximum_ticks_per_frame(u32 maximum_ticks_per_frame)
+    {
+        CAVE_ASSERT(maximum_ticks_per_frame > 0);
+        m_maximum_ticks_per_frame = maximum_ticks_per_frame;
+    }
+
 private:
     bool m_is_running { true };
+    u32 m_tick_rate { 60 };
+    u32 m_target_frame_rate { 0 };
+    u32 m_maximum_ticks_per_frame { 5 };
+    bool m_is_pipelined_rendering_enabled { false };
 };
 
 } // namespace CaveGame
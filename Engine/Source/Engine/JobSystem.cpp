@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/Metrics.h>
+#include <Core/Profiling/Profiler.h>
+#include <Engine/JobSystem.h>
+
+#include <cstdio>
+#include <immintrin.h>
+
+namespace CaveGame
+{
+
+#pragma region JobCounter
+
+Job JobCounter::s_released_marker;
+
+void JobCounter::increment()
+{
+    if (m_pending_job_count.fetch_add(1, std::memory_order_acq_rel) != 0)
+        return;
+
+    //
+    // The counter is re-armed. NOTE: Any thread can increment the counter (nested jobs schedule more jobs with it), so
+    // the thread that has decremented the pending job count to zero might not have released the dependent jobs yet.
+    // The list is only cleared once it holds the released marker, otherwise that release would overwrite it and mark
+    // the counter as finished while this job is still pending.
+    //
+    Job* expected_dependent_jobs = &s_released_marker;
+    while (!m_dependent_jobs.compare_exchange_weak(expected_dependent_jobs, nullptr, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        expected_dependent_jobs = &s_released_marker;
+        _mm_pause();
+    }
+}
+
+bool JobCounter::try_add_dependent_job(Job* job)
+{
+    Job* first_dependent_job = m_dependent_jobs.load(std::memory_order_acquire);
+    do
+    {
+        if (first_dependent_job == &s_released_marker)
+            return false;
+        job->next_dependent_job = first_dependent_job;
+    } while (!m_dependent_jobs.compare_exchange_weak(first_dependent_job, job, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
+}
+
+Job* JobCounter::decrement()
+{
+    if (m_pending_job_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return nullptr;
+
+    // This was the last pending job, so all the dependent jobs can now be scheduled. Marking the counter as released
+    // is the last access to it, as it might be destroyed immediately after.
+    Job* dependent_jobs = m_dependent_jobs.exchange(&s_released_marker, std::memory_order_acq_rel);
+    CAVE_ASSERT(dependent_jobs != &s_released_marker);
+    return dependent_jobs;
+}
+
+#pragma endregion
+
+#pragma region Work-Stealing Deque
+
+//
+// Bounded Chase-Lev work-stealing deque, using the memory orderings described in "Correct and Efficient Work-Stealing
+// for Weak Memory Models" (Lê, Pop, Cohen, Zappa Nardelli, 2013). Only the owner thread can push and pop jobs, while
+// any thread can steal them.
+//
+class WorkStealingDeque
+{
+public:
+    static constexpr i64 capacity = 4096;
+
+public:
+    // Returns false if the deque is full.
+    bool push(Job* job)
+    {
+        const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+        const i64 top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= capacity)
+            return false;
+
+        // NOTE: The paper uses a release fence followed by a relaxed store, which is equivalent to a release store.
+        m_jobs[bottom & (capacity - 1)].store(job, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* pop()
+    {
+        const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // The deque is empty.
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_jobs[bottom & (capacity - 1)].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // This is the last job in the deque, so a thief might be trying to steal it at the same time.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    Job* steal()
+    {
+        i64 top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            // The deque is empty.
+            return nullptr;
+        }
+
+        Job* job = m_jobs[top & (capacity - 1)].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            // Another thief (or the owner) has taken the job.
+            return nullptr;
+        }
+
+        return job;
+    }
+
+private:
+    // NOTE: The indices are placed on separate cache lines, as they are written by different threads.
+    alignas(64) std::atomic<i64> m_top { 0 };
+    alignas(64) std::atomic<i64> m_bottom { 0 };
+    alignas(64) std::atomic<Job*> m_jobs[capacity] {};
+};
+
+#pragma endregion
+
+#pragma region JobSystem
+
+// The number of jobs in the ring buffer of each worker. A slot is only reused once its job has finished.
+static constexpr u32 s_job_ring_capacity = 4096;
+
+// The number of unsuccessful attempts to find a job before an idle worker thread goes to sleep.
+static constexpr u32 s_idle_spin_count = 64;
+
+struct alignas(64) Worker
+{
+    WorkStealingDeque deque;
+    Job job_ring[s_job_ring_capacity];
+    u32 job_ring_index { 0 };
+    // The state of the random number generator used to pick the steal victims.
+    u32 random_state { 0 };
+    Thread thread;
+};
+
+struct JobSystemData
+{
+    Worker* workers { nullptr };
+    u32 worker_count { 0 };
+
+    ProcessorTopology processor_topology;
+
+    std::atomic<bool> is_running { false };
+    std::atomic<u32> sleeping_worker_count { 0 };
+    Semaphore wake_up_semaphore;
+
+    MetricCounter executed_job_counter;
+};
+
+static JobSystemData s_job_system;
+
+// The index of the worker executed by the current thread. Threads that aren't workers store an invalid index.
+static constexpr u32 s_invalid_worker_index = 0xFFFFFFFF;
+static thread_local u32 t_worker_index = s_invalid_worker_index;
+
+NODISCARD ALWAYS_INLINE static Worker& get_current_worker()
+{
+    CAVE_ASSERT(t_worker_index < s_job_system.worker_count);
+    return s_job_system.workers[t_worker_index];
+}
+
+NODISCARD static Job* find_job(Worker& worker)
+{
+    if (Job* job = worker.deque.pop())
+        return job;
+
+    // Try to steal a job from the other workers, starting with a random victim to spread the contention.
+    worker.random_state ^= worker.random_state << 13;
+    worker.random_state ^= worker.random_state >> 17;
+    worker.random_state ^= worker.random_state << 5;
+
+    const u32 first_victim_index = worker.random_state % s_job_system.worker_count;
+    for (u32 offset = 0; offset < s_job_system.worker_count; ++offset)
+    {
+        Worker& victim = s_job_system.workers[(first_victim_index + offset) % s_job_system.worker_count];
+        if (&victim == &worker)
+            continue;
+
+        if (Job* job = victim.deque.steal())
+            return job;
+    }
+
+    return nullptr;
+}
+
+static void wake_up_sleeping_workers()
+{
+    // NOTE: Pairs with the sequentially consistent increment of the sleeping worker count, so that either the sleeping
+    // worker sees the new job when it checks the deques one last time, or this thread sees the sleeping worker.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s_job_system.sleeping_worker_count.load(std::memory_order_relaxed) > 0)
+        s_job_system.wake_up_semaphore.signal();
+}
+
+//
+// The processors assigned to the main thread and to each worker thread. An empty processor set means that the thread
+// isn't bound to any processor.
+//
+struct ThreadPlacement
+{
+    ProcessorSet main_thread_affinity;
+    Vector<ProcessorSet> worker_affinities;
+};
+
+static void compute_thread_placement(ThreadPlacementPolicy placement_policy, const ProcessorTopology& topology, ThreadPlacement& out_placement)
+{
+    if (topology.logical_processors.is_empty())
+        return;
+
+    // NOTE: The processors are sorted by their physical core, so the first processor is the first thread of the first core.
+    const LogicalProcessorInfo& main_thread_processor = topology.logical_processors.first();
+
+    switch (placement_policy)
+    {
+        case ThreadPlacementPolicy::Unrestricted:
+        {
+            for (u32 worker_index = 1; worker_index < topology.get_logical_processor_count(); ++worker_index)
+                out_placement.worker_affinities.add(ProcessorSet());
+            break;
+        }
+
+        case ThreadPlacementPolicy::PhysicalCores:
+        case ThreadPlacementPolicy::SingleNumaNode:
+        {
+            out_placement.main_thread_affinity = ProcessorSet::from_processor(main_thread_processor.processor_index);
+            for (const LogicalProcessorInfo& processor : topology.logical_processors)
+            {
+                if (processor.smt_sibling_index != 0 || processor.physical_core_index == main_thread_processor.physical_core_index)
+                    continue;
+                if (placement_policy == ThreadPlacementPolicy::SingleNumaNode && processor.numa_node_index != main_thread_processor.numa_node_index)
+                    continue;
+
+                out_placement.worker_affinities.add(ProcessorSet::from_processor(processor.processor_index));
+            }
+            break;
+        }
+
+        case ThreadPlacementPolicy::LogicalProcessors:
+        {
+            out_placement.main_thread_affinity = ProcessorSet::from_processor(main_thread_processor.processor_index);
+            for (const LogicalProcessorInfo& processor : topology.logical_processors)
+            {
+                if (processor.physical_core_index != main_thread_processor.physical_core_index)
+                    out_placement.worker_affinities.add(ProcessorSet::from_processor(processor.processor_index));
+            }
+            break;
+        }
+    }
+}
+
+bool JobSystem::initialize(ThreadPlacementPolicy placement_policy, u32 worker_thread_count)
+{
+    if (s_job_system.workers != nullptr)
+    {
+        // The job system has already been initialized.
+        return false;
+    }
+
+    // NOTE: An incomplete topology still describes every available processor, just without the sharing information.
+    PlatformCore::query_processor_topology(s_job_system.processor_topology);
+
+    ThreadPlacement placement;
+    compute_thread_placement(placement_policy, s_job_system.processor_topology, placement);
+
+    if (worker_thread_count == 0)
+    {
+        // There must always be at least one worker, otherwise the jobs would only be executed while the main thread waits.
+        worker_thread_count = Math::max(static_cast<u32>(placement.worker_affinities.count()), 1U);
+    }
+
+    // The workers that don't have a dedicated processor aren't bound to any processor.
+    while (placement.worker_affinities.count() < worker_thread_count)
+        placement.worker_affinities.add(ProcessorSet());
+
+    if (!s_job_system.wake_up_semaphore.initialize())
+        return false;
+
+    // NOTE: The main thread is always the first worker.
+    s_job_system.executed_job_counter = Metrics::register_counter("jobs.executed"sv);
+    s_job_system.worker_count = worker_thread_count + 1;
+    s_job_system.workers = new Worker[s_job_system.worker_count];
+    for (u32 worker_index = 0; worker_index < s_job_system.worker_count; ++worker_index)
+        s_job_system.workers[worker_index].random_state = 0x9E3779B9U * (worker_index + 1);
+
+    ThreadDescription main_thread_description;
+    main_thread_description.name = "Main"sv;
+    main_thread_description.affinity = placement.main_thread_affinity;
+    Thread::apply_current_thread_description(main_thread_description);
+
+    t_worker_index = 0;
+    s_job_system.is_running.store(true, std::memory_order_release);
+
+    for (u32 worker_index = 1; worker_index < s_job_system.worker_count; ++worker_index)
+    {
+        char worker_name[32];
+        snprintf(worker_name, sizeof(worker_name), "Worker %u", worker_index);
+
+        ThreadDescription worker_description;
+        worker_description.name = StringView::create_from_utf8(worker_name);
+        worker_description.affinity = placement.worker_affinities[worker_index - 1];
+
+        Worker& worker = s_job_system.workers[worker_index];
+        if (!worker.thread.create(worker_thread_entry_point, reinterpret_cast<void*>(static_cast<uintptr>(worker_index)), worker_description))
+        {
+            // Continue with the workers that have been successfully created.
+            CAVE_ASSERT(false);
+            s_job_system.worker_count = worker_index;
+            break;
+        }
+    }
+
+    return true;
+}
+
+void JobSystem::shutdown()
+{
+    if (s_job_system.workers == nullptr)
+    {
+        // The job system has already been shut down.
+        return;
+    }
+
+    s_job_system.is_running.store(false, std::memory_order_release);
+    s_job_system.wake_up_semaphore.signal(s_job_system.worker_count);
+
+    for (u32 worker_index = 1; worker_index < s_job_system.worker_count; ++worker_index)
+        s_job_system.workers[worker_index].thread.join();
+
+    delete[] s_job_system.workers;
+    s_job_system.workers = nullptr;
+    s_job_system.worker_count = 0;
+    s_job_system.sleeping_worker_count.store(0, std::memory_order_relaxed);
+    s_job_system.wake_up_semaphore.shutdown();
+    t_worker_index = s_invalid_worker_index;
+}
+
+bool JobSystem::is_initialized()
+{
+    return (s_job_system.workers != nullptr);
+}
+
+u32 JobSystem::get_worker_count()
+{
+    return s_job_system.worker_count;
+}
+
+u32 JobSystem::get_current_worker_index()
+{
+    return t_worker_index;
+}
+
+const ProcessorTopology& JobSystem::get_processor_topology()
+{
+    return s_job_system.processor_topology;
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    Worker& worker = get_current_worker();
+    while (!counter.is_finished())
+    {
+        if (Job* job = find_job(worker))
+        {
+            execute_job(job);
+            continue;
+        }
+
+        // NOTE: The waiting thread never sleeps, as the remaining jobs are usually about to finish.
+        _mm_pause();
+    }
+}
+
+Job* JobSystem::allocate_job()
+{
+    Worker& worker = get_current_worker();
+    Job* job = &worker.job_ring[worker.job_ring_index];
+
+    // NOTE: Only the owning worker allocates jobs from its ring buffer, thus the flag can only be cleared concurrently.
+    if (job->is_in_use.load(std::memory_order_acquire))
+        return nullptr;
+    job->is_in_use.store(true, std::memory_order_relaxed);
+
+    worker.job_ring_index = (worker.job_ring_index + 1) % s_job_ring_capacity;
+    return job;
+}
+
+void JobSystem::submit_job(Job* job)
+{
+    Worker& worker = get_current_worker();
+    if (!worker.deque.push(job))
+    {
+        // The deque is full, so the job is executed immediately. This is always correct, as jobs can't depend on
+        // being executed asynchronously, and it naturally throttles the workers that produce too many jobs.
+        execute_job(job);
+        return;
+    }
+
+    wake_up_sleeping_workers();
+}
+
+void JobSystem::execute_job(Job* job)
+{
+    {
+        CAVE_PROFILE_SCOPE("Job");
+        job->invoke_function(*job);
+    }
+    s_job_system.executed_job_counter.add();
+
+    // NOTE: The job can be reused as soon as it is marked as finished, and the counter as soon as it is decremented.
+    JobCounter* counter = job->counter;
+    job->is_in_use.store(false, std::memory_order_release);
+    Job* dependent_job = counter->decrement();
+    while (dependent_job != nullptr)
+    {
+        Job* next_dependent_job = dependent_job->next_dependent_job;
+        submit_job(dependent_job);
+        dependent_job = next_dependent_job;
+    }
+}
+
+void JobSystem::worker_thread_entry_point(void* user_data)
+{
+    t_worker_index = static_cast<u32>(reinterpret_cast<uintptr>(user_data));
+    Worker& worker = get_current_worker();
+
+    u32 idle_spin_count = 0;
+    while (s_job_system.is_running.load(std::memory_order_acquire))
+    {
+        if (Job* job = find_job(worker))
+        {
+            execute_job(job);
+            idle_spin_count = 0;
+            continue;
+        }
+
+        if (idle_spin_count < s_idle_spin_count)
+        {
+            ++idle_spin_count;
+            _mm_pause();
+            continue;
+        }
+
+        s_job_system.sleeping_worker_count.fetch_add(1, std::memory_order_seq_cst);
+
+        // Check the deques one last time, as a job might have been scheduled before this worker was counted as sleeping.
+        if (Job* job = find_job(worker))
+        {
+            s_job_system.sleeping_worker_count.fetch_sub(1, std::memory_order_relaxed);
+            execute_job(job);
+            idle_spin_count = 0;
+            continue;
+        }
+
+        s_job_system.wake_up_semaphore.wait();
+        s_job_system.sleeping_worker_count.fetch_sub(1, std::memory_order_relaxed);
+        idle_spin_count = 0;
+    }
+}
+
+#pragma endregion
+
+} // namespace CaveGame
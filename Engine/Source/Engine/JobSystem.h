@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/ProcessorTopology.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+class JobCounter;
+
+//
+// A unit of work. The function object is stored inline, so scheduling a job never allocates memory.
+//
+struct Job
+{
+    static constexpr usize payload_size = 48;
+
+    void (*invoke_function)(Job& job) { nullptr };
+    JobCounter* counter { nullptr };
+    Job* next_dependent_job { nullptr };
+    // Set while the job is scheduled or executing, so that its slot in the job ring isn't reused.
+    std::atomic<bool> is_in_use { false };
+    alignas(16) u8 payload[payload_size];
+};
+
+//
+// Tracks the number of unfinished jobs that have been scheduled with it. Used to wait for a group of jobs and to
+// express dependencies between jobs (see `JobSystem::schedule_after`).
+//
+// A counter can be reused once all its jobs have finished, but it must outlive all the jobs scheduled with it.
+//
+class JobCounter
+{
+    CAVE_MAKE_NONCOPYABLE(JobCounter);
+    CAVE_MAKE_NONMOVABLE(JobCounter);
+
+public:
+    JobCounter() = default;
+    ALWAYS_INLINE ~JobCounter() { CAVE_ASSERT(is_finished()); }
+
+    //
+    // NOTE: The counter is finished once the dependent jobs have been released, which is the last access performed
+    // by the job that finishes last. Checking the pending job count instead would allow the waiting thread to destroy
+    // the counter while that job still uses it.
+    //
+    NODISCARD ALWAYS_INLINE bool is_finished() const { return (m_dependent_jobs.load(std::memory_order_acquire) == &s_released_marker); }
+
+private:
+    friend class JobSystem;
+
+    // The address of this job is stored in `m_dependent_jobs` while the counter is finished, in which case
+    // dependent jobs are scheduled immediately.
+    static Job s_released_marker;
+
+    void increment();
+
+    // If the last pending job has finished, returns the list of dependent jobs that can now be scheduled.
+    NODISCARD Job* decrement();
+
+    // Returns false if the counter is finished, in which case the job should be scheduled immediately.
+    bool try_add_dependent_job(Job* job);
+
+private:
+    std::atomic<u32> m_pending_job_count { 0 };
+    std::atomic<Job*> m_dependent_jobs { &s_released_marker };
+};
+
+//
+// Controls how the main thread and the worker threads are placed on the logical processors.
+//
+enum class ThreadPlacementPolicy : u8
+{
+    // The threads aren't bound to any processor, thus the operating system scheduler is free to move them around.
+    // One worker is started for every logical processor, except the one used by the main thread.
+    Unrestricted,
+
+    //
+    // One thread per physical core: the main thread is bound to the first core and every worker to a different core.
+    // The SMT siblings are left idle, so the hot threads never compete for the execution resources of a core.
+    //
+    PhysicalCores,
+
+    //
+    // The main thread is bound to the first core, whose SMT siblings are left idle, while a worker is bound to every
+    // logical processor of the other cores. Favours the throughput of the workers over their latency.
+    //
+    LogicalProcessors,
+
+    //
+    // Same as `ThreadPlacementPolicy::PhysicalCores`, but only the cores of the NUMA node the main thread runs on are
+    // used, so the workers never access memory that is attached to another socket.
+    //
+    SingleNumaNode,
+};
+
+//
+// Work-stealing job system.
+//
+// Every worker thread (including the main thread, which is always worker zero) owns a Chase-Lev deque: the owner
+// pushes and pops jobs at the bottom (LIFO, which is cache friendly), while idle workers steal jobs from the top
+// (FIFO, which steals the largest pieces of work first). Idle workers spin briefly and then sleep until new jobs
+// are scheduled.
+//
+// NOTE: Jobs can only be scheduled from the worker threads. Threads that wait for a job counter execute other jobs
+// while waiting, so waiting from inside a job never deadlocks.
+//
+class JobSystem
+{
+public:
+    //
+    // Starts the worker threads and binds them (and the calling thread, which becomes the main thread) to the logical
+    // processors selected by the placement policy. By default, the number of workers is determined by the policy.
+    // At least one worker is always started, so that background jobs make progress while the main thread is busy.
+    // Returns false if the job system has already been initialized.
+    //
+    static bool initialize(ThreadPlacementPolicy placement_policy = ThreadPlacementPolicy::PhysicalCores, u32 worker_thread_count = 0);
+    static void shutdown();
+
+    NODISCARD static bool is_initialized();
+
+    // Returns the number of workers, including the main thread.
+    NODISCARD static u32 get_worker_count();
+
+    // Returns the index of the worker that executes the calling thread. The main thread is worker zero.
+    NODISCARD static u32 get_current_worker_index();
+
+    // Returns the processor topology that has been used to place the threads.
+    NODISCARD static const ProcessorTopology& get_processor_topology();
+
+public:
+    //
+    // Schedules the function (any callable object, invoked without arguments) for execution on any worker.
+    // The function object must fit in `Job::payload_size` bytes.
+    //
+    template<typename Function>
+    ALWAYS_INLINE static void schedule(JobCounter& counter, Function&& function)
+    {
+        Job* job = allocate_job();
+        if (job == nullptr)
+        {
+            // Every job of the ring buffer is still unfinished, so the function is executed immediately (like when
+            // the deque is full). The counter isn't involved, as the function has finished before this returns.
+            function();
+            return;
+        }
+
+        initialize_job(job, counter, forward<Function>(function));
+        submit_job(job);
+    }
+
+    // Schedules the function for execution after all jobs scheduled with `dependency` have finished.
+    template<typename Function>
+    ALWAYS_INLINE static void schedule_after(JobCounter& dependency, JobCounter& counter, Function&& function)
+    {
+        Job* job = allocate_job();
+        if (job == nullptr)
+        {
+            // Same as in `JobSystem::schedule`, but the dependency must finish first.
+            wait(dependency);
+            function();
+            return;
+        }
+
+        initialize_job(job, counter, forward<Function>(function));
+        if (!dependency.try_add_dependent_job(job))
+            submit_job(job);
+    }
+
+    // Blocks until all jobs scheduled with the counter have finished. Other jobs are executed while waiting.
+    static void wait(const JobCounter& counter);
+
+public:
+    //
+    // Invokes `function(begin_index, end_index)` over disjoint sub-ranges that cover `[0, count)`, in parallel.
+    //
+    // The range is split adaptively: each job splits off the upper half of its range as a new job (which idle workers
+    // can steal) until it contains at most `batch_size` elements. The batch size grows with the range size relative
+    // to the worker count, so large ranges are never split into more jobs than required for load balancing.
+    // Returns after all sub-ranges have been processed.
+    //
+    template<typename Function>
+    static void parallel_for(usize count, usize minimum_batch_size, Function&& function)
+    {
+        if (count == 0)
+            return;
+
+        // Four batches per worker provide enough slack for load balancing with uneven work.
+        const usize batch_count_per_worker = 4;
+        const usize batch_size = Math::max(Math::max(minimum_batch_size, static_cast<usize>(1)), count / (get_worker_count() * batch_count_per_worker));
+
+        //
+        // NOTE: The calling thread holds a reference to the counter while it splits the range and processes its own
+        // sub-range, otherwise the jobs that have been stolen could finish in the meantime and release the counter
+        // before all the sub-ranges have been scheduled.
+        //
+        JobCounter counter;
+        counter.increment();
+        parallel_for_range(counter, &function, 0, count, batch_size);
+        MAYBE_UNUSED Job* dependent_jobs = counter.decrement();
+        CAVE_ASSERT(dependent_jobs == nullptr);
+        wait(counter);
+    }
+
+    // Invokes `function(element, index)` for every element of the container, in parallel.
+    template<typename T, typename Function>
+    ALWAYS_INLINE static void parallel_for(Vector<T>& elements, Function&& function, usize minimum_batch_size = 1)
+    {
+        T* element_data = elements.elements();
+        parallel_for(
+            elements.count(),
+            minimum_batch_size,
+            [element_data, &function](usize begin_index, usize end_index)
+            {
+                for (usize index = begin_index; index < end_index; ++index)
+                    function(element_data[index], index);
+            }
+        );
+    }
+
+private:
+    //
+    // Returns the next job from the ring buffer of the current worker, or nullptr if that job hasn't finished yet
+    // (the worker has scheduled 4096 jobs that are still queued or executing), in which case the caller must execute
+    // the function immediately.
+    //
+    NODISCARD static Job* allocate_job();
+
+    static void submit_job(Job* job);
+    static void execute_job(Job* job);
+    static void worker_thread_entry_point(void* user_data);
+
+    template<typename Function>
+    ALWAYS_INLINE static void initialize_job(Job* job, JobCounter& counter, Function&& function)
+    {
+        using FunctionType = RemoveReference<Function>;
+        static_assert(sizeof(FunctionType) <= Job::payload_size, "The job function object is too large!");
+        static_assert(alignof(FunctionType) <= 16, "The job function object alignment is too large!");
+
+        new (job->payload) FunctionType(forward<Function>(function));
+        job->invoke_function = [](Job& job_to_invoke)
+        {
+            FunctionType* function_object = reinterpret_cast<FunctionType*>(job_to_invoke.payload);
+            (*function_object)();
+            function_object->~FunctionType();
+        };
+
+        job->counter = &counter;
+        counter.increment();
+    }
+
+    template<typename Function>
+    static void parallel_for_range(JobCounter& counter, Function* function, usize begin_index, usize end_index, usize batch_size)
+    {
+        while (end_index - begin_index > batch_size)
+        {
+            const usize middle_index = begin_index + (end_index - begin_index) / 2;
+            schedule(
+                counter,
+                [&counter, function, middle_index, end_index, batch_size]()
+                {
+                    parallel_for_range(counter, function, middle_index, end_index, batch_size);
+                }
+            );
+            end_index = middle_index;
+        }
+
+        (*function)(begin_index, end_index);
+    }
+};
+
+} // namespace CaveGame
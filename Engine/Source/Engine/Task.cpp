@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/File.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Engine/Task.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+#pragma region TaskFrameAllocator
+
+static constexpr usize s_frame_size_class_count = TaskFrameAllocator::maximum_pooled_frame_size / TaskFrameAllocator::size_class_granularity;
+
+struct FreeFrame
+{
+    FreeFrame* next;
+};
+
+struct TaskFrameAllocatorData
+{
+    FreeFrame* free_lists[s_frame_size_class_count] {};
+
+    // The chunks from which new frames are carved. Only the last chunk has any space left.
+    Vector<u8*> chunks;
+    usize current_chunk_offset { TaskFrameAllocator::chunk_size };
+
+    usize allocated_frame_count { 0 };
+};
+
+static TaskFrameAllocatorData s_frame_allocator;
+
+NODISCARD ALWAYS_INLINE static usize get_frame_size_class_index(usize byte_count)
+{
+    return (byte_count + TaskFrameAllocator::size_class_granularity - 1) / TaskFrameAllocator::size_class_granularity - 1;
+}
+
+void* TaskFrameAllocator::allocate(usize byte_count)
+{
+    CAVE_ASSERT(TaskScheduler::is_scheduler_thread());
+    ++s_frame_allocator.allocated_frame_count;
+
+    if (byte_count == 0 || byte_count > maximum_pooled_frame_size)
+        return ::operator new(byte_count);
+
+    const usize size_class_index = get_frame_size_class_index(byte_count);
+    if (FreeFrame* frame = s_frame_allocator.free_lists[size_class_index])
+    {
+        s_frame_allocator.free_lists[size_class_index] = frame->next;
+        return frame;
+    }
+
+    const usize frame_size = (size_class_index + 1) * size_class_granularity;
+    if (s_frame_allocator.current_chunk_offset + frame_size > chunk_size)
+    {
+        // NOTE: The space left at the end of the current chunk is wasted, which is at most one frame.
+        s_frame_allocator.chunks.add(new u8[chunk_size]);
+        s_frame_allocator.current_chunk_offset = 0;
+    }
+
+    void* frame = s_frame_allocator.chunks.last() + s_frame_allocator.current_chunk_offset;
+    s_frame_allocator.current_chunk_offset += frame_size;
+    return frame;
+}
+
+void TaskFrameAllocator::release(void* frame, usize byte_count)
+{
+    CAVE_ASSERT(TaskScheduler::is_scheduler_thread());
+    CAVE_ASSERT(s_frame_allocator.allocated_frame_count > 0);
+    --s_frame_allocator.allocated_frame_count;
+
+    if (byte_count == 0 || byte_count > maximum_pooled_frame_size)
+    {
+        ::operator delete(frame);
+        return;
+    }
+
+    const usize size_class_index = get_frame_size_class_index(byte_count);
+    FreeFrame* free_frame = static_cast<FreeFrame*>(frame);
+    free_frame->next = s_frame_allocator.free_lists[size_class_index];
+    s_frame_allocator.free_lists[size_class_index] = free_frame;
+}
+
+void TaskFrameAllocator::shutdown()
+{
+    CAVE_ASSERT(s_frame_allocator.allocated_frame_count == 0);
+
+    for (u8* chunk : s_frame_allocator.chunks)
+        delete[] chunk;
+    s_frame_allocator.chunks.clear_and_shrink();
+    s_frame_allocator.current_chunk_offset = chunk_size;
+
+    for (usize size_class_index = 0; size_class_index < s_frame_size_class_count; ++size_class_index)
+        s_frame_allocator.free_lists[size_class_index] = nullptr;
+}
+
+usize TaskFrameAllocator::get_allocated_frame_count()
+{
+    return s_frame_allocator.allocated_frame_count;
+}
+
+#pragma endregion
+
+#pragma region TaskScheduler
+
+struct TaskSchedulerData
+{
+    // Intrusive stack of the continuations that are queued for the next pump, pushed by any thread.
+    std::atomic<TaskContinuation*> queued_continuations { nullptr };
+
+    Detail::TaskPromiseBase* first_spawned_task { nullptr };
+    u32 spawned_task_count { 0 };
+
+    // Only used to schedule the background jobs, which are never waited for through it (see `background_job_count`).
+    JobCounter background_job_counter;
+
+    //
+    // The number of background jobs that haven't finished yet. Each job decrements it after its last access to the
+    // task frames, thus shutdown waits for it to reach zero rather than for the (constantly re-armed) job counter.
+    //
+    std::atomic<u32> background_job_count { 0 };
+
+    bool is_initialized { false };
+};
+
+static TaskSchedulerData s_task_scheduler;
+static thread_local bool t_is_scheduler_thread = false;
+
+std::coroutine_handle<> Detail::TaskPromiseBase::on_final_suspend(std::coroutine_handle<> handle) noexcept
+{
+    if (m_continuation)
+        return m_continuation;
+
+    if (m_detached_handle)
+    {
+        // NOTE: Destroying the coroutine while it is suspended at the final suspension point is allowed.
+        TaskScheduler::on_spawned_task_finished(*this);
+        handle.destroy();
+    }
+
+    return std::noop_coroutine();
+}
+
+bool TaskScheduler::initialize()
+{
+    if (s_task_scheduler.is_initialized)
+    {
+        // The task scheduler has already been initialized.
+        return false;
+    }
+
+    CAVE_ASSERT(JobSystem::is_initialized());
+    t_is_scheduler_thread = true;
+    s_task_scheduler.is_initialized = true;
+    return true;
+}
+
+void TaskScheduler::shutdown()
+{
+    if (!s_task_scheduler.is_initialized)
+    {
+        // The task scheduler has already been shut down.
+        return;
+    }
+
+    CAVE_ASSERT(is_scheduler_thread());
+
+    //
+    // The background operations reference the frames of the suspended tasks, so they must finish first.
+    // NOTE: At least one worker thread is always running, which steals the jobs queued by this thread.
+    //
+    while (s_task_scheduler.background_job_count.load(std::memory_order_acquire) != 0)
+        PlatformCore::yield_thread();
+
+    // The queued continuations belong to the tasks that are destroyed below.
+    s_task_scheduler.queued_continuations.store(nullptr, std::memory_order_relaxed);
+
+    // Destroying a spawned task also destroys all the tasks it awaits, as they are owned by its frame.
+    while (Detail::TaskPromiseBase* promise = s_task_scheduler.first_spawned_task)
+    {
+        std::coroutine_handle<> handle = promise->m_detached_handle;
+        on_spawned_task_finished(*promise);
+        handle.destroy();
+    }
+
+    TaskFrameAllocator::shutdown();
+
+    t_is_scheduler_thread = false;
+    s_task_scheduler.is_initialized = false;
+}
+
+bool TaskScheduler::is_scheduler_thread()
+{
+    return t_is_scheduler_thread;
+}
+
+void TaskScheduler::spawn(Task<void>&& task)
+{
+    CAVE_ASSERT(is_scheduler_thread());
+    CAVE_ASSERT(task.is_valid());
+
+    Task<void>::HandleType handle = task.release_handle();
+    Detail::TaskPromiseBase& promise = handle.promise();
+    promise.m_detached_handle = handle;
+
+    promise.m_next_detached_task = s_task_scheduler.first_spawned_task;
+    if (s_task_scheduler.first_spawned_task)
+        s_task_scheduler.first_spawned_task->m_previous_detached_task = &promise;
+    s_task_scheduler.first_spawned_task = &promise;
+    ++s_task_scheduler.spawned_task_count;
+
+    handle.resume();
+}
+
+u32 TaskScheduler::get_spawned_task_count()
+{
+    return s_task_scheduler.spawned_task_count;
+}
+
+void TaskScheduler::pump()
+{
+    CAVE_ASSERT(is_scheduler_thread());
+
+    TaskContinuation* continuation = s_task_scheduler.queued_continuations.exchange(nullptr, std::memory_order_acquire);
+
+    // The continuations are stored in reverse order, so reverse the list to resume them in the order they were queued.
+    TaskContinuation* first_continuation = nullptr;
+    while (continuation)
+    {
+        TaskContinuation* next_continuation = continuation->next;
+        continuation->next = first_continuation;
+        first_continuation = continuation;
+        continuation = next_continuation;
+    }
+
+    while (first_continuation)
+    {
+        // NOTE: Resuming the coroutine might destroy the continuation, so the next pointer must be read before.
+        TaskContinuation* next_continuation = first_continuation->next;
+        first_continuation->handle.resume();
+        first_continuation = next_continuation;
+    }
+}
+
+void TaskScheduler::enqueue(TaskContinuation& continuation)
+{
+    TaskContinuation* first_continuation = s_task_scheduler.queued_continuations.load(std::memory_order_relaxed);
+    do
+    {
+        continuation.next = first_continuation;
+    } while (!s_task_scheduler.queued_continuations.compare_exchange_weak(
+        first_continuation,
+        &continuation,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ));
+}
+
+JobCounter& TaskScheduler::get_background_job_counter()
+{
+    return s_task_scheduler.background_job_counter;
+}
+
+void TaskScheduler::on_background_job_scheduled()
+{
+    s_task_scheduler.background_job_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TaskScheduler::on_background_job_finished()
+{
+    s_task_scheduler.background_job_count.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskScheduler::on_spawned_task_finished(Detail::TaskPromiseBase& promise)
+{
+    if (promise.m_previous_detached_task)
+        promise.m_previous_detached_task->m_next_detached_task = promise.m_next_detached_task;
+    else
+        s_task_scheduler.first_spawned_task = promise.m_next_detached_task;
+
+    if (promise.m_next_detached_task)
+        promise.m_next_detached_task->m_previous_detached_task = promise.m_previous_detached_task;
+
+    CAVE_ASSERT(s_task_scheduler.spawned_task_count > 0);
+    --s_task_scheduler.spawned_task_count;
+}
+
+#pragma endregion
+
+#pragma region Awaiters
+
+void TaskScheduler::ReadFileAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    m_continuation.handle = handle;
+    on_background_job_scheduled();
+    JobSystem::schedule(
+        get_background_job_counter(),
+        [this]()
+        {
+            m_result.is_successful = FileSystem::read_entire_file(m_filepath.view(), m_result.bytes);
+            if (!m_result.is_successful)
+                m_result.bytes.clear_and_shrink();
+
+            // NOTE: The awaiter might be destroyed as soon as the continuation is queued.
+            enqueue(m_continuation);
+            on_background_job_finished();
+        }
+    );
+}
+
+#pragma endregion
+
+} // namespace CaveGame
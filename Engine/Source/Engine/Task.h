@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+#include <Engine/JobSystem.h>
+
+#include <coroutine>
+#include <new>
+#include <type_traits>
+
+namespace CaveGame
+{
+
+//
+// Allocates the coroutine frames of the tasks, so that starting a task doesn't allocate from the general purpose heap.
+//
+// Frames are rounded up to a multiple of the size class granularity and recycled through one free list per size class,
+// thus after the first few frames the allocator never requests new memory. Frames larger than the largest size class
+// fall back to the global allocator.
+//
+// NOTE: Coroutine frames can only be allocated and released by the task scheduler thread (see `TaskScheduler`).
+//
+class TaskFrameAllocator
+{
+public:
+    static constexpr usize size_class_granularity = 64;
+    static constexpr usize maximum_pooled_frame_size = 4 * KiB;
+    static constexpr usize chunk_size = 64 * KiB;
+
+public:
+    NODISCARD static void* allocate(usize byte_count);
+    static void release(void* frame, usize byte_count);
+
+    // Releases the memory chunks used by the pools. All frames must have been released before.
+    static void shutdown();
+
+    // Returns the number of frames that are currently allocated.
+    NODISCARD static usize get_allocated_frame_count();
+};
+
+//
+// A suspended coroutine waiting to be resumed by the task scheduler. The continuation is stored inside the awaiter
+// (which lives in the coroutine frame while it is suspended), so queueing a coroutine never allocates memory.
+//
+struct TaskContinuation
+{
+    std::coroutine_handle<> handle;
+    TaskContinuation* next { nullptr };
+};
+
+template<typename T>
+class Task;
+
+class TaskScheduler;
+
+namespace Detail
+{
+
+//
+// Storage for the result of an operation that is produced on one side of a suspension point and consumed on the other.
+//
+template<typename T>
+class TaskResult
+{
+    CAVE_MAKE_NONCOPYABLE(TaskResult);
+    CAVE_MAKE_NONMOVABLE(TaskResult);
+
+public:
+    TaskResult() = default;
+    ALWAYS_INLINE ~TaskResult()
+    {
+        if (m_has_value)
+            reinterpret_cast<T*>(m_storage)->~T();
+    }
+
+    template<typename U>
+    ALWAYS_INLINE void set(U&& value)
+    {
+        CAVE_ASSERT(!m_has_value);
+        new (m_storage) T(forward<U>(value));
+        m_has_value = true;
+    }
+
+    NODISCARD ALWAYS_INLINE T take()
+    {
+        CAVE_ASSERT(m_has_value);
+        return move(*reinterpret_cast<T*>(m_storage));
+    }
+
+private:
+    alignas(T) u8 m_storage[sizeof(T)];
+    bool m_has_value { false };
+};
+
+template<>
+class TaskResult<void>
+{
+public:
+    ALWAYS_INLINE void take() {}
+};
+
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        NODISCARD ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+
+        template<typename PromiseType>
+        NODISCARD ALWAYS_INLINE std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseType> handle) noexcept
+        {
+            return handle.promise().on_final_suspend(handle);
+        }
+
+        ALWAYS_INLINE void await_resume() const noexcept {}
+    };
+
+public:
+    // Tasks are started lazily, either when they are awaited or when they are spawned.
+    NODISCARD ALWAYS_INLINE std::suspend_always initial_suspend() const noexcept { return {}; }
+    NODISCARD ALWAYS_INLINE FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    // NOTE: Exceptions are disabled, so this function is never invoked. The coroutine machinery still requires it.
+    ALWAYS_INLINE void unhandled_exception() { CAVE_VERIFY(false); }
+
+    NODISCARD ALWAYS_INLINE static void* operator new(usize byte_count) { return TaskFrameAllocator::allocate(byte_count); }
+    ALWAYS_INLINE static void operator delete(void* frame, usize byte_count) { TaskFrameAllocator::release(frame, byte_count); }
+
+private:
+    friend class ::CaveGame::TaskScheduler;
+    template<typename T>
+    friend class ::CaveGame::Task;
+
+    //
+    // Returns the coroutine that is resumed after this task has finished. Tasks that are owned by the scheduler
+    // destroy themselves, as nobody is waiting for their result.
+    //
+    NODISCARD std::coroutine_handle<> on_final_suspend(std::coroutine_handle<> handle) noexcept;
+
+private:
+    // The coroutine that awaits the result of this task.
+    std::coroutine_handle<> m_continuation;
+
+    // Intrusive list of the tasks that are owned by the scheduler (see `TaskScheduler::spawn`).
+    std::coroutine_handle<> m_detached_handle;
+    TaskPromiseBase* m_previous_detached_task { nullptr };
+    TaskPromiseBase* m_next_detached_task { nullptr };
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    NODISCARD ALWAYS_INLINE Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    ALWAYS_INLINE void return_value(U&& value)
+    {
+        m_result.set(forward<U>(value));
+    }
+
+    NODISCARD ALWAYS_INLINE T take_result() { return m_result.take(); }
+
+private:
+    TaskResult<T> m_result;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    NODISCARD ALWAYS_INLINE Task<void> get_return_object() noexcept;
+
+    ALWAYS_INLINE void return_void() {}
+    ALWAYS_INLINE void take_result() {}
+};
+
+} // namespace Detail
+
+//
+// A coroutine that produces a value of type `T` (or nothing, for `Task<void>`).
+//
+// Tasks are lazy: the coroutine body starts executing when the task is awaited (`co_await task`) or handed to the
+// scheduler (`TaskScheduler::spawn`). When a task finishes, the coroutine that awaited it is resumed immediately on the
+// same thread (symmetric transfer), so long chains of tasks never grow the call stack.
+//
+// All coroutines execute on the task scheduler thread (the main thread). Work is moved to the worker threads
+// explicitly, by awaiting `TaskScheduler::run_in_background`.
+//
+template<typename T = void>
+class Task
+{
+    CAVE_MAKE_NONCOPYABLE(Task);
+
+public:
+    using promise_type = Detail::TaskPromise<T>;
+    using HandleType = std::coroutine_handle<promise_type>;
+
+    struct Awaiter
+    {
+        NODISCARD ALWAYS_INLINE bool await_ready() const noexcept { return handle.done(); }
+
+        NODISCARD ALWAYS_INLINE std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting_handle) noexcept
+        {
+            handle.promise().m_continuation = awaiting_handle;
+            return handle;
+        }
+
+        ALWAYS_INLINE T await_resume() { return handle.promise().take_result(); }
+
+        HandleType handle;
+    };
+
+public:
+    Task() = default;
+    ALWAYS_INLINE explicit Task(HandleType handle)
+        : m_handle(handle)
+    {}
+
+    ALWAYS_INLINE Task(Task&& other) noexcept
+        : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    ALWAYS_INLINE Task& operator=(Task&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        destroy();
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+        return *this;
+    }
+
+    ALWAYS_INLINE ~Task() { destroy(); }
+
+    NODISCARD ALWAYS_INLINE bool is_valid() const { return static_cast<bool>(m_handle); }
+    NODISCARD ALWAYS_INLINE bool is_finished() const { return m_handle && m_handle.done(); }
+
+    NODISCARD ALWAYS_INLINE Awaiter operator co_await() const noexcept
+    {
+        CAVE_ASSERT(is_valid());
+        return Awaiter { m_handle };
+    }
+
+    // Transfers the ownership of the coroutine to the caller.
+    NODISCARD ALWAYS_INLINE HandleType release_handle()
+    {
+        HandleType handle = m_handle;
+        m_handle = nullptr;
+        return handle;
+    }
+
+private:
+    ALWAYS_INLINE void destroy()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+    }
+
+private:
+    HandleType m_handle;
+};
+
+namespace Detail
+{
+
+template<typename T>
+ALWAYS_INLINE Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+ALWAYS_INLINE Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace Detail
+
+// The result of `TaskScheduler::read_file`.
+struct FileReadResult
+{
+    Vector<u8> bytes;
+    bool is_successful { false };
+};
+
+//
+// Resumes the suspended tasks on the main thread. The scheduler is pumped once per frame by `Engine::run`, before the
+// simulation ticks are executed, thus a task that awaits the next frame (or a background operation) is resumed at the
+// beginning of the following frame.
+//
+// Example of a multi-stage operation that never blocks the frame:
+//
+//     Task<void> stream_chunk(ChunkCoordinates coordinates)
+//     {
+//         FileReadResult file = co_await TaskScheduler::read_file(get_chunk_file_path(coordinates));
+//         ChunkData chunk = co_await TaskScheduler::run_in_background([&]() { return generate_chunk(file.bytes); });
+//         ChunkMesh mesh = co_await TaskScheduler::run_in_background([&]() { return build_chunk_mesh(chunk); });
+//         co_await TaskScheduler::next_frame();
+//         upload_chunk_mesh(mesh);
+//     }
+//
+//     TaskScheduler::spawn(stream_chunk(coordinates));
+//
+class TaskScheduler
+{
+public:
+    struct NextFrameAwaiter
+    {
+        NODISCARD ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+
+        ALWAYS_INLINE void await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            continuation.handle = handle;
+            TaskScheduler::enqueue(continuation);
+        }
+
+        ALWAYS_INLINE void await_resume() const noexcept {}
+
+        TaskContinuation continuation;
+    };
+
+    template<typename Function>
+    class BackgroundJobAwaiter
+    {
+        CAVE_MAKE_NONCOPYABLE(BackgroundJobAwaiter);
+        CAVE_MAKE_NONMOVABLE(BackgroundJobAwaiter);
+
+    public:
+        using ResultType = std::invoke_result_t<Function&>;
+
+    public:
+        template<typename FunctionArgument>
+        ALWAYS_INLINE explicit BackgroundJobAwaiter(FunctionArgument&& function)
+            : m_function(forward<FunctionArgument>(function))
+        {}
+
+        NODISCARD ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+
+        ALWAYS_INLINE void await_suspend(std::coroutine_handle<> handle)
+        {
+            m_continuation.handle = handle;
+            TaskScheduler::on_background_job_scheduled();
+            JobSystem::schedule(
+                TaskScheduler::get_background_job_counter(),
+                [this]()
+                {
+                    if constexpr (std::is_void_v<ResultType>)
+                        m_function();
+                    else
+                        m_result.set(m_function());
+
+                    // NOTE: The awaiter might be destroyed as soon as the continuation is queued.
+                    TaskScheduler::enqueue(m_continuation);
+                    TaskScheduler::on_background_job_finished();
+                }
+            );
+        }
+
+        ALWAYS_INLINE ResultType await_resume() { return m_result.take(); }
+
+    private:
+        Function m_function;
+        Detail::TaskResult<ResultType> m_result;
+        TaskContinuation m_continuation;
+    };
+
+    class ReadFileAwaiter
+    {
+        CAVE_MAKE_NONCOPYABLE(ReadFileAwaiter);
+        CAVE_MAKE_NONMOVABLE(ReadFileAwaiter);
+
+    public:
+        ALWAYS_INLINE explicit ReadFileAwaiter(StringView filepath)
+            : m_filepath(filepath)
+        {}
+
+        NODISCARD ALWAYS_INLINE bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        NODISCARD ALWAYS_INLINE FileReadResult await_resume() { return move(m_result); }
+
+    private:
+        String m_filepath;
+        FileReadResult m_result;
+        TaskContinuation m_continuation;
+    };
+
+public:
+    // Must be called from the main thread, after the job system has been initialized.
+    static bool initialize();
+
+    //
+    // Waits for the pending background operations and destroys the spawned tasks that haven't finished yet, without
+    // resuming them.
+    //
+    static void shutdown();
+
+    // Returns true if the calling thread is the one that executes the tasks (the main thread).
+    NODISCARD static bool is_scheduler_thread();
+
+    //
+    // Transfers the ownership of the task to the scheduler and starts executing it immediately, until its
+    // first suspension point. The task is destroyed when it finishes.
+    //
+    static void spawn(Task<void>&& task);
+
+    // Returns the number of spawned tasks that haven't finished yet.
+    NODISCARD static u32 get_spawned_task_count();
+
+    //
+    // Resumes all the tasks that have been queued since the previous invocation. The tasks that are queued while
+    // pumping are resumed by the next invocation.
+    //
+    static void pump();
+
+    // Queues a suspended coroutine to be resumed by the next pump. Can be called from any thread.
+    static void enqueue(TaskContinuation& continuation);
+
+public:
+    // Suspends the calling task until the next frame.
+    NODISCARD ALWAYS_INLINE static NextFrameAwaiter next_frame() { return {}; }
+
+    //
+    // Suspends the calling task while the function is executed on a worker thread. The task is resumed on the main
+    // thread (by the next pump) and receives the value returned by the function.
+    //
+    // NOTE: The function object is stored in the frame of the calling coroutine, so it can safely capture references
+    // to the local variables of the task.
+    //
+    template<typename Function>
+    NODISCARD ALWAYS_INLINE static BackgroundJobAwaiter<RemoveReference<Function>> run_in_background(Function&& function)
+    {
+        return BackgroundJobAwaiter<RemoveReference<Function>>(forward<Function>(function));
+    }
+
+    //
+    // Suspends the calling task while the file is read on a worker thread. The filepath is copied by the awaiter.
+    // Large assets that don't need a private copy should be mapped with `MappedFile` instead.
+    //
+    NODISCARD ALWAYS_INLINE static ReadFileAwaiter read_file(StringView filepath) { return ReadFileAwaiter(filepath); }
+
+private:
+    friend class Detail::TaskPromiseBase;
+
+    // All background operations are scheduled with this counter.
+    NODISCARD static JobCounter& get_background_job_counter();
+
+    //
+    // Track the background operations that are in flight, so that shutdown can wait for them. A job reports that it
+    // has finished after queuing its continuation, which is its last access to the awaiter.
+    //
+    static void on_background_job_scheduled();
+    static void on_background_job_finished();
+
+    static void on_spawned_task_finished(Detail::TaskPromiseBase& promise);
+};
+
+} // namespace CaveGame
@@ -17,6 +17,9 @@ function setup_project_configuration_settings()
         optimize "on"
         symbols "on"
         defines { "CAVE_CONFIGURATION_DEVELOPMENT=1" }
+        -- NOTE: The container accessors and the math functions are used by every inner loop, thus their assertions
+        -- are disabled (`CAVE_ASSERT_LEVEL_NONE`), so that Development builds perform close to Shipping builds.
+        defines { "CAVE_ASSERT_LEVEL_CONTAINERS=0", "CAVE_ASSERT_LEVEL_MATH=0" }
     filter {}
 
     filter "configurations:Shipping"
@@ -24,6 +27,16 @@ function setup_project_configuration_settings()
         symbols "off"
         defines { "CAVE_CONFIGURATION_SHIPPING=1" }
     filter {}
+
+    -- NOTE: The vectorized noise functions must produce bit-exact results compared to the scalar ones, thus the
+    -- compiler must never contract multiplications and additions into fused multiply-adds.
+    filter "platforms:windows"
+        buildoptions { "/fp:precise" }
+    filter {}
+
+    filter "platforms:linux"
+        buildoptions { "-ffp-contract=off" }
+    filter {}
 end
 
 workspace "CaveGame"
@@ -36,7 +49,8 @@ workspace "CaveGame"
 
     platforms
     {
-        "Windows"
+        "Windows",
+        "Linux"
     }
 
     filter "platforms:windows"
@@ -44,6 +58,11 @@ workspace "CaveGame"
         architecture "x64"
     filter {}
 
+    filter "platforms:linux"
+        system "linux"
+        architecture "x64"
+    filter {}
+
     startproject "CaveGame"
 
     project "Engine"
@@ -57,6 +76,7 @@ workspace "CaveGame"
         exceptionhandling "off"
         rtti "off"
         characterset "unicode"
+        vectorextensions "AVX2"
 
         targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
         objdir "%{wks.location}/Intermediate"
@@ -81,9 +101,17 @@ workspace "CaveGame"
             {
                 "d3d11.lib",
                 "d3dcompiler.lib",
-                "dxgi.lib"
+                "dxgi.lib",
+                "synchronization.lib"
             }
         filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            -- NOTE: GCC and clang don't enable F16C as part of `-mavx2`, unlike MSVC with `/arch:AVX2`.
+            -- The frame pointers are required by the sampling profiler to walk the call stacks.
+            buildoptions { "-mf16c", "-fno-omit-frame-pointer" }
+        filter {}
     -- endproject "Engine"
 
     project "CaveGame"
@@ -97,6 +125,7 @@ workspace "CaveGame"
         exceptionhandling "off"
         rtti "off"
         characterset "unicode"
+        vectorextensions "AVX2"
 
         targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
         objdir "%{wks.location}/Intermediate"
@@ -123,4 +152,238 @@ workspace "CaveGame"
             systemversion "latest"    
             defines { "CAVE_PLATFORM_WINDOWS=1" }
         filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c", "-fno-omit-frame-pointer" }
+            -- NOTE: The symbols of the executable are exported so the sampling profiler can resolve them with `dladdr`.
+            linkoptions { "-rdynamic" }
+            links { "pthread", "dl", "rt" }
+        filter {}
     -- endproject "CaveGame"
+
+    project "MetricsReader"
+        kind "ConsoleApp"
+        location "%{wks.location}/Tools/MetricsReader"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+        vectorextensions "AVX2"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Tools/MetricsReader/**.cpp",
+            "%{wks.location}/Tools/MetricsReader/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c" }
+            -- NOTE: The POSIX shared memory functions live in `librt` on glibc versions older than 2.34.
+            links { "pthread", "dl", "rt" }
+        filter {}
+    -- endproject "MetricsReader"
+
+    project "AssetPacker"
+        kind "ConsoleApp"
+        location "%{wks.location}/Tools/AssetPacker"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+        vectorextensions "AVX2"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Tools/AssetPacker/**.cpp",
+            "%{wks.location}/Tools/AssetPacker/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c" }
+            links { "pthread", "dl", "rt" }
+        filter {}
+    -- endproject "AssetPacker"
+
+    project "CompressionBenchmark"
+        kind "ConsoleApp"
+        location "%{wks.location}/Tools/CompressionBenchmark"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+        vectorextensions "AVX2"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Tools/CompressionBenchmark/**.cpp",
+            "%{wks.location}/Tools/CompressionBenchmark/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c" }
+            links { "pthread", "dl", "rt" }
+        filter {}
+    -- endproject "CompressionBenchmark"
+
+    project "ThreadingBenchmark"
+        kind "ConsoleApp"
+        location "%{wks.location}/Tools/ThreadingBenchmark"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+        vectorextensions "AVX2"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Tools/ThreadingBenchmark/**.cpp",
+            "%{wks.location}/Tools/ThreadingBenchmark/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c" }
+            links { "pthread", "dl", "rt" }
+        filter {}
+    -- endproject "ThreadingBenchmark"
+
+    project "QueueBenchmark"
+        kind "ConsoleApp"
+        location "%{wks.location}/Tools/QueueBenchmark"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+        vectorextensions "AVX2"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Tools/QueueBenchmark/**.cpp",
+            "%{wks.location}/Tools/QueueBenchmark/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+            buildoptions { "-mf16c" }
+            links { "pthread", "dl", "rt" }
+        filter {}
+    -- endproject "QueueBenchmark"
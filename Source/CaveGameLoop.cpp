@@ -13,6 +13,14 @@ namespace CaveGame
 
 bool CaveGameLoop::on_game_start()
 {
+    set_tick_rate(60);
+
+#if CAVE_PLATFORM_LINUX
+    // NOTE: The Linux builds are headless (dedicated servers and benchmarks), so nothing is gained by running
+    // more frames than simulation ticks.
+    set_target_frame_rate(get_tick_rate());
+#endif // CAVE_PLATFORM_LINUX
+
     return true;
 }
 
@@ -22,4 +30,7 @@ void CaveGameLoop::on_game_end()
 void CaveGameLoop::on_game_update(float delta_time)
 {}
 
+void CaveGameLoop::on_game_render(MAYBE_UNUSED float frame_delta_time, MAYBE_UNUSED float interpolation_alpha)
+{}
+
 } // namespace CaveGame
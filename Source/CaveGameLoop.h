@@ -18,6 +18,7 @@ class CaveGameLoop : public GameLoop
 public:
     virtual bool on_game_start() override;
     virtual void on_game_update(float delta_time) override;
+    virtual void on_game_render(float frame_delta_time, float interpolation_alpha) override;
     virtual void on_game_end() override;
 };
 
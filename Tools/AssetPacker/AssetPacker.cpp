@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+//
+// Packs the files of a directory into a `.cpak` asset archive (see `AssetArchive`).
+// The entries are named by their paths relative to the input directory, using `/` as the separator.
+//
+// Usage: AssetPacker [--compress] <input directory> <output archive>
+// With `--compress`, the assets are compressed with the LZ codec (unless that doesn't make them smaller).
+//
+
+#include <Engine/AssetArchive.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+static constexpr usize maximum_path_length = 4096;
+
+struct PackerStatistics
+{
+    u32 file_count { 0 };
+    u64 byte_count { 0 };
+    AssetCompression compression { AssetCompression::None };
+};
+
+//
+// Adds every file of the directory (and its subdirectories) to the archive writer.
+// `path` holds the path of the directory and `relative_path_offset` is the offset of the relative path within it.
+// Returns false if a directory or a file can't be read.
+//
+static bool add_directory(AssetArchiveWriter& writer, char* path, usize path_length, usize relative_path_offset, PackerStatistics& statistics)
+{
+    Vector<DirectoryEntry> directory_entries;
+    if (!FileSystem::enumerate_directory(StringView::create_from_utf8(path, path_length), directory_entries))
+    {
+        fprintf(stderr, "The directory '%s' can't be enumerated.\n", path);
+        return false;
+    }
+
+    Vector<u8> file_bytes;
+    for (const DirectoryEntry& directory_entry : directory_entries)
+    {
+        const usize name_length = directory_entry.name.view().byte_count();
+        const usize child_path_length = path_length + 1 + name_length;
+        if (child_path_length >= maximum_path_length)
+        {
+            fprintf(stderr, "The path of '%s' inside '%s' is too long.\n", directory_entry.name.characters(), path);
+            return false;
+        }
+
+        path[path_length] = '/';
+        memcpy(path + path_length + 1, directory_entry.name.characters(), name_length);
+        path[child_path_length] = 0;
+
+        if (directory_entry.is_directory)
+        {
+            if (!add_directory(writer, path, child_path_length, relative_path_offset, statistics))
+                return false;
+        }
+        else
+        {
+            if (!FileSystem::read_entire_file(StringView::create_from_utf8(path, child_path_length), file_bytes))
+            {
+                fprintf(stderr, "The file '%s' can't be read.\n", path);
+                return false;
+            }
+
+            const StringView entry_name = StringView::create_from_utf8(path + relative_path_offset, child_path_length - relative_path_offset);
+            writer.add_entry(entry_name, file_bytes.elements(), file_bytes.count(), statistics.compression);
+            ++statistics.file_count;
+            statistics.byte_count += file_bytes.count();
+        }
+
+        path[path_length] = 0;
+    }
+
+    return true;
+}
+
+static int asset_packer_main(int argument_count, char** arguments)
+{
+    PackerStatistics statistics;
+    int argument_index = 1;
+    if (argument_index < argument_count && strcmp(arguments[argument_index], "--compress") == 0)
+    {
+        statistics.compression = AssetCompression::Lz;
+        ++argument_index;
+    }
+
+    if (argument_count - argument_index < 2)
+    {
+        fprintf(stderr, "Usage: %s [--compress] <input directory> <output archive>\n", arguments[0]);
+        return 1;
+    }
+    const char* input_directory_path = arguments[argument_index];
+    const char* archive_path = arguments[argument_index + 1];
+
+    char path[maximum_path_length];
+    usize path_length = strlen(input_directory_path);
+    while (path_length > 1 && (input_directory_path[path_length - 1] == '/' || input_directory_path[path_length - 1] == '\\'))
+        --path_length;
+    if (path_length >= maximum_path_length)
+    {
+        fprintf(stderr, "The input directory path is too long.\n");
+        return 1;
+    }
+    memcpy(path, input_directory_path, path_length);
+    path[path_length] = 0;
+
+    AssetArchiveWriter writer;
+    if (!add_directory(writer, path, path_length, path_length + 1, statistics))
+        return 1;
+
+    if (!writer.write(StringView::create_from_utf8(archive_path)))
+    {
+        fprintf(stderr, "The archive '%s' can't be written.\n", archive_path);
+        return 1;
+    }
+
+    // Open the archive that has just been written, which validates its layout and hashes.
+    AssetArchive archive;
+    if (!archive.open(StringView::create_from_utf8(archive_path)) || !archive.verify_content_hash())
+    {
+        fprintf(stderr, "The archive '%s' has been written, but it can't be validated.\n", archive_path);
+        return 1;
+    }
+    const u64 archive_byte_count = archive.get_archive_byte_count();
+    archive.close();
+
+    printf(
+        "Packed %u files (%llu bytes) into '%s' (%llu bytes).\n",
+        statistics.file_count,
+        static_cast<unsigned long long>(statistics.byte_count),
+        archive_path,
+        static_cast<unsigned long long>(archive_byte_count)
+    );
+    return 0;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::asset_packer_main(argument_count, arguments);
+    return return_code;
+}
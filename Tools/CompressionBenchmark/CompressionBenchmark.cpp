@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+//
+// Measures the compression ratio and throughput of the LZ codec (see `LzCodec`) on voxel chunk payloads, which are
+// generated with the same kind of noise as the terrain, and optionally on files.
+//
+// Usage: CompressionBenchmark [file...]
+// Every chunk is compressed as an independent block (like a chunk save or a network packet), both without and
+// with a dictionary. The files are compressed as frames.
+//
+
+#include <Core/Math/Noise.h>
+#include <Core/Memory/LzCompression.h>
+#include <Core/Platform/File.h>
+#include <Core/Platform/PlatformCore.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+static constexpr u32 chunk_size = Noise::grid_size;
+static constexpr u32 chunk_voxel_count = chunk_size * chunk_size * chunk_size;
+
+// The world region covered by the benchmark, measured in chunks.
+static constexpr u32 region_size_x = 8;
+static constexpr u32 region_size_y = 6;
+static constexpr u32 region_size_z = 8;
+
+// The number of times the chunks are decompressed, as a single pass is too short to be timed reliably.
+static constexpr u32 decompression_pass_count = 10;
+
+enum class VoxelType : u16
+{
+    Air,
+    Stone,
+    Dirt,
+    Grass,
+    Water,
+    Ore,
+};
+
+static constexpr i32 sea_level = 48;
+
+struct ChunkGenerator
+{
+    NoiseSettings height_settings;
+    NoiseSettings cave_settings;
+    NoiseSettings ore_settings;
+
+    ChunkGenerator()
+    {
+        height_settings.type = NoiseType::OpenSimplex2;
+        height_settings.fractal_type = FractalType::FBm;
+        height_settings.frequency = 0.004F;
+        height_settings.octave_count = 4;
+
+        cave_settings.type = NoiseType::Perlin;
+        cave_settings.fractal_type = FractalType::Ridged;
+        cave_settings.frequency = 0.02F;
+        cave_settings.seed = 7331;
+
+        ore_settings.type = NoiseType::OpenSimplex2;
+        ore_settings.frequency = 0.12F;
+        ore_settings.seed = 4242;
+    }
+
+    // Fills the payload of the chunk, which stores one 16-bit voxel type per voxel (the X axis varies the fastest).
+    void generate(i32 chunk_x, i32 chunk_y, i32 chunk_z, u16* out_voxels) const
+    {
+        const float origin_x = static_cast<float>(chunk_x * static_cast<i32>(chunk_size));
+        const float origin_y = static_cast<float>(chunk_y * static_cast<i32>(chunk_size));
+        const float origin_z = static_cast<float>(chunk_z * static_cast<i32>(chunk_size));
+
+        static float s_heights[chunk_size * chunk_size];
+        static float s_caves[chunk_voxel_count];
+        static float s_ores[chunk_voxel_count];
+        Noise::fill_grid_2d(height_settings, Vector2(origin_x, origin_z), 1.0F, chunk_size, chunk_size, s_heights);
+        Noise::fill_chunk_grid(cave_settings, Vector3(origin_x, origin_y, origin_z), 1.0F, s_caves);
+        Noise::fill_chunk_grid(ore_settings, Vector3(origin_x, origin_y, origin_z), 1.0F, s_ores);
+
+        for (u32 z = 0; z < chunk_size; ++z)
+        {
+            for (u32 y = 0; y < chunk_size; ++y)
+            {
+                for (u32 x = 0; x < chunk_size; ++x)
+                {
+                    const u32 voxel_index = (z * chunk_size + y) * chunk_size + x;
+                    const i32 world_y = chunk_y * static_cast<i32>(chunk_size) + static_cast<i32>(y);
+                    const i32 terrain_height = 64 + static_cast<i32>(s_heights[z * chunk_size + x] * 40.0F);
+
+                    VoxelType type;
+                    if (world_y > terrain_height)
+                        type = (world_y <= sea_level) ? VoxelType::Water : VoxelType::Air;
+                    else if (s_caves[voxel_index] > 0.6F)
+                        type = VoxelType::Air;
+                    else if (world_y == terrain_height)
+                        type = (world_y < sea_level) ? VoxelType::Dirt : VoxelType::Grass;
+                    else if (world_y > terrain_height - 4)
+                        type = VoxelType::Dirt;
+                    else
+                        type = (s_ores[voxel_index] > 0.8F) ? VoxelType::Ore : VoxelType::Stone;
+
+                    out_voxels[voxel_index] = static_cast<u16>(type);
+                }
+            }
+        }
+    }
+};
+
+NODISCARD static double get_elapsed_seconds(u64 start_tick)
+{
+    const u64 elapsed_ticks = PlatformCore::get_current_tick_counter() - start_tick;
+    return static_cast<double>(elapsed_ticks) / static_cast<double>(PlatformCore::get_tick_counter_frequency());
+}
+
+NODISCARD static double get_megabytes_per_second(u64 byte_count, double seconds)
+{
+    return (seconds > 0.0) ? (static_cast<double>(byte_count) / (1024.0 * 1024.0) / seconds) : 0.0;
+}
+
+static bool decompress_chunks(
+    const Vector<u8>& compressed,
+    usize compressed_capacity,
+    const Vector<usize>& compressed_byte_counts,
+    usize payload_byte_count,
+    Vector<u8>& decompressed,
+    const LzDictionary* dictionary
+)
+{
+    for (usize payload_index = 0; payload_index < compressed_byte_counts.count(); ++payload_index)
+    {
+        const u8* compressed_payload = compressed.elements() + payload_index * compressed_capacity;
+        u8* decompressed_payload = decompressed.elements() + payload_index * payload_byte_count;
+        usize decompressed_byte_count = 0;
+        if (!LzCodec::decompress_block(compressed_payload, compressed_byte_counts[payload_index], decompressed_payload, payload_byte_count, decompressed_byte_count, dictionary))
+            return false;
+        if (decompressed_byte_count != payload_byte_count)
+            return false;
+    }
+    return true;
+}
+
+static bool benchmark_chunks(const Vector<u8>& payloads, usize payload_byte_count, LzCompressionLevel level, const LzDictionary* dictionary)
+{
+    const usize payload_count = payloads.count() / payload_byte_count;
+    const usize compressed_capacity = LzCodec::get_compressed_byte_count_bound(payload_byte_count);
+
+    Vector<u8> compressed;
+    compressed.set_count_uninitialized(payload_count * compressed_capacity);
+    memset(compressed.elements(), 0, compressed.count());
+    Vector<usize> compressed_byte_counts;
+    compressed_byte_counts.set_count_uninitialized(payload_count);
+
+    u64 start_tick = PlatformCore::get_current_tick_counter();
+    u64 total_compressed_byte_count = 0;
+    for (usize payload_index = 0; payload_index < payload_count; ++payload_index)
+    {
+        const u8* payload = payloads.elements() + payload_index * payload_byte_count;
+        u8* compressed_payload = compressed.elements() + payload_index * compressed_capacity;
+        compressed_byte_counts[payload_index] = LzCodec::compress_block(payload, payload_byte_count, compressed_payload, compressed_capacity, level, dictionary);
+        if (compressed_byte_counts[payload_index] == 0)
+            return false;
+        total_compressed_byte_count += compressed_byte_counts[payload_index];
+    }
+    const double compression_seconds = get_elapsed_seconds(start_tick);
+
+    // The first pass verifies the round trip and touches the destination pages, so they aren't faulted in while timing.
+    Vector<u8> decompressed;
+    decompressed.set_count_uninitialized(payloads.count());
+    if (!decompress_chunks(compressed, compressed_capacity, compressed_byte_counts, payload_byte_count, decompressed, dictionary))
+        return false;
+    if (memcmp(decompressed.elements(), payloads.elements(), payloads.count()) != 0)
+        return false;
+
+    start_tick = PlatformCore::get_current_tick_counter();
+    for (u32 pass_index = 0; pass_index < decompression_pass_count; ++pass_index)
+        decompress_chunks(compressed, compressed_capacity, compressed_byte_counts, payload_byte_count, decompressed, dictionary);
+    const double decompression_seconds = get_elapsed_seconds(start_tick);
+
+    printf(
+        "    %-5s %-13s ratio %6.2f  %9.1f KiB/chunk  compress %8.1f MiB/s  decompress %8.1f MiB/s\n",
+        (level == LzCompressionLevel::Fast) ? "fast" : "high",
+        dictionary ? "dictionary" : "no dictionary",
+        static_cast<double>(payloads.count()) / static_cast<double>(total_compressed_byte_count),
+        static_cast<double>(total_compressed_byte_count) / static_cast<double>(payload_count) / 1024.0,
+        get_megabytes_per_second(payloads.count(), compression_seconds),
+        get_megabytes_per_second(static_cast<u64>(payloads.count()) * decompression_pass_count, decompression_seconds)
+    );
+    return true;
+}
+
+static bool benchmark_file(const char* filepath, LzCompressionLevel level)
+{
+    Vector<u8> bytes;
+    if (!FileSystem::read_entire_file(StringView::create_from_utf8(filepath), bytes))
+    {
+        fprintf(stderr, "The file '%s' can't be read.\n", filepath);
+        return false;
+    }
+
+    LzFrameSettings settings;
+    settings.level = level;
+
+    Vector<u8> frame;
+    u64 start_tick = PlatformCore::get_current_tick_counter();
+    if (!compress_lz_frame(bytes.elements(), bytes.count(), frame, settings))
+        return false;
+    const double compression_seconds = get_elapsed_seconds(start_tick);
+
+    Vector<u8> decompressed;
+    if (!decompress_lz_frame(frame.elements(), frame.count(), decompressed))
+        return false;
+    if (decompressed.count() != bytes.count() || memcmp(decompressed.elements(), bytes.elements(), bytes.count()) != 0)
+        return false;
+
+    start_tick = PlatformCore::get_current_tick_counter();
+    for (u32 pass_index = 0; pass_index < decompression_pass_count; ++pass_index)
+    {
+        decompressed.clear();
+        decompress_lz_frame(frame.elements(), frame.count(), decompressed);
+    }
+    const double decompression_seconds = get_elapsed_seconds(start_tick);
+
+    printf(
+        "    %-5s %-40s ratio %6.2f  compress %8.1f MiB/s  decompress %8.1f MiB/s\n",
+        (level == LzCompressionLevel::Fast) ? "fast" : "high",
+        filepath,
+        (frame.count() > 0) ? static_cast<double>(bytes.count()) / static_cast<double>(frame.count()) : 0.0,
+        get_megabytes_per_second(bytes.count(), compression_seconds),
+        get_megabytes_per_second(static_cast<u64>(bytes.count()) * decompression_pass_count, decompression_seconds)
+    );
+    return true;
+}
+
+static int compression_benchmark_main(int argument_count, char** arguments)
+{
+    const usize payload_byte_count = chunk_voxel_count * sizeof(u16);
+    const u32 chunk_count = region_size_x * region_size_y * region_size_z;
+
+    ChunkGenerator generator;
+    Vector<u8> payloads;
+    payloads.set_count_uninitialized(chunk_count * payload_byte_count);
+
+    u32 chunk_index = 0;
+    for (u32 chunk_z = 0; chunk_z < region_size_z; ++chunk_z)
+    {
+        for (u32 chunk_y = 0; chunk_y < region_size_y; ++chunk_y)
+        {
+            for (u32 chunk_x = 0; chunk_x < region_size_x; ++chunk_x)
+            {
+                u16* voxels = reinterpret_cast<u16*>(payloads.elements() + chunk_index * payload_byte_count);
+                generator.generate(static_cast<i32>(chunk_x), static_cast<i32>(chunk_y), static_cast<i32>(chunk_z), voxels);
+                ++chunk_index;
+            }
+        }
+    }
+
+    // The dictionary is a surface chunk from outside the benchmarked region, which contains every common voxel type.
+    Vector<u8> dictionary_payload;
+    dictionary_payload.set_count_uninitialized(payload_byte_count);
+    generator.generate(-16, 1, -16, reinterpret_cast<u16*>(dictionary_payload.elements()));
+    LzDictionary dictionary;
+    dictionary.initialize(dictionary_payload.elements(), dictionary_payload.count());
+
+    printf("%u chunk payloads of %zu KiB:\n", chunk_count, payload_byte_count / 1024);
+    const LzCompressionLevel levels[] = { LzCompressionLevel::Fast, LzCompressionLevel::High };
+    for (const LzCompressionLevel level : levels)
+    {
+        if (!benchmark_chunks(payloads, payload_byte_count, level, nullptr) || !benchmark_chunks(payloads, payload_byte_count, level, &dictionary))
+        {
+            fprintf(stderr, "The chunk payloads failed to round trip.\n");
+            return 1;
+        }
+    }
+
+    if (argument_count > 1)
+        printf("Files:\n");
+    for (int argument_index = 1; argument_index < argument_count; ++argument_index)
+    {
+        for (const LzCompressionLevel level : levels)
+        {
+            if (!benchmark_file(arguments[argument_index], level))
+            {
+                fprintf(stderr, "The file '%s' failed to round trip.\n", arguments[argument_index]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::compression_benchmark_main(argument_count, arguments);
+    return return_code;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+//
+// Prints the metrics published by a running CaveGame process (see `Metrics`), by mapping its shared memory region.
+//
+// Usage: MetricsReader <process id> [refresh interval in milliseconds]
+// Without a refresh interval, the metrics are printed once.
+//
+
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/SharedMemory.h>
+#include <Core/Profiling/Metrics.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <immintrin.h>
+
+namespace CaveGame
+{
+
+// The copy of the region, which is read while the game keeps publishing into the shared memory.
+static u8 s_region_copy[Metrics::get_region_byte_count()];
+
+// The number of attempts to copy a consistent snapshot of the region before giving up.
+static constexpr u32 maximum_copy_attempt_count = 1000;
+
+//
+// Copies the region into `s_region_copy`, retrying while the publisher modifies it (see `SeqLock`).
+// Returns false if a consistent snapshot can't be copied.
+//
+static bool copy_region(const SharedMemoryRegion& region)
+{
+    const MetricsRegionHeader* header = static_cast<const MetricsRegionHeader*>(region.data());
+    for (u32 attempt_index = 0; attempt_index < maximum_copy_attempt_count; ++attempt_index)
+    {
+        const u64 sequence_before = header->sequence.load(std::memory_order_acquire);
+        if (sequence_before & 1)
+        {
+            _mm_pause();
+            continue;
+        }
+
+        memcpy(s_region_copy, region.data(), sizeof(s_region_copy));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->sequence.load(std::memory_order_relaxed) == sequence_before)
+            return true;
+    }
+
+    return false;
+}
+
+// Returns the largest value counted by the histogram bucket, which is used as the approximate value of its samples.
+static u64 get_bucket_upper_bound(u32 bucket_index)
+{
+    if (bucket_index == 0)
+        return 0;
+    if (bucket_index >= 64)
+        return static_cast<u64>(-1);
+    return (static_cast<u64>(1) << bucket_index) - 1;
+}
+
+// Returns the upper bound of the bucket that contains the given percentile of the histogram samples.
+static u64 get_histogram_percentile(const MetricsRegionEntry& entry, double percentile)
+{
+    const u64 target_count = static_cast<u64>(static_cast<double>(entry.histogram_count) * percentile / 100.0 + 0.5);
+    u64 cumulative_count = 0;
+    for (u32 bucket_index = 0; bucket_index < MetricsRegionEntry::histogram_bucket_count; ++bucket_index)
+    {
+        cumulative_count += entry.histogram_buckets[bucket_index];
+        if (cumulative_count >= target_count && cumulative_count > 0)
+            return get_bucket_upper_bound(bucket_index);
+    }
+    return 0;
+}
+
+static void print_metrics(const MetricsRegionHeader& header, const MetricsRegionEntry* entries)
+{
+    printf(
+        "Process %u, publish #%llu at %.3f s, %u metrics\n",
+        header.process_id,
+        static_cast<unsigned long long>(header.publish_count),
+        static_cast<double>(header.publish_time_nanoseconds) * 1e-9,
+        header.metric_count
+    );
+
+    for (u32 metric_index = 0; metric_index < header.metric_count; ++metric_index)
+    {
+        const MetricsRegionEntry& entry = entries[metric_index];
+        char name[MetricsRegionEntry::maximum_name_length + 1];
+        memcpy(name, entry.name, sizeof(name));
+        name[MetricsRegionEntry::maximum_name_length] = 0;
+
+        switch (entry.type)
+        {
+            case MetricType::Counter:
+                printf("    counter    %-48s %llu\n", name, static_cast<unsigned long long>(entry.value));
+                break;
+            case MetricType::Gauge:
+                printf("    gauge      %-48s %lld\n", name, static_cast<long long>(entry.value));
+                break;
+            case MetricType::Histogram:
+            {
+                const double mean = (entry.histogram_count > 0) ? static_cast<double>(entry.histogram_sum) / static_cast<double>(entry.histogram_count) : 0.0;
+                printf(
+                    "    histogram  %-48s count=%llu mean=%.1f p50<=%llu p99<=%llu\n",
+                    name,
+                    static_cast<unsigned long long>(entry.histogram_count),
+                    mean,
+                    static_cast<unsigned long long>(get_histogram_percentile(entry, 50.0)),
+                    static_cast<unsigned long long>(get_histogram_percentile(entry, 99.0))
+                );
+                break;
+            }
+            default:
+                printf("    unknown    %-48s\n", name);
+                break;
+        }
+    }
+
+    fflush(stdout);
+}
+
+static int metrics_reader_main(int argument_count, char** arguments)
+{
+    if (argument_count < 2)
+    {
+        fprintf(stderr, "Usage: %s <process id> [refresh interval in milliseconds]\n", arguments[0]);
+        return 1;
+    }
+
+    const u32 process_id = static_cast<u32>(strtoul(arguments[1], nullptr, 10));
+    const u32 refresh_interval_milliseconds = (argument_count >= 3) ? static_cast<u32>(strtoul(arguments[2], nullptr, 10)) : 0;
+
+    char region_name[64];
+    Metrics::get_default_region_name(process_id, region_name, sizeof(region_name));
+
+    SharedMemoryRegion region;
+    if (!region.open(StringView::create_from_utf8(region_name)))
+    {
+        fprintf(stderr, "The metrics region '%s' can't be opened. Is the process running?\n", region_name);
+        return 1;
+    }
+
+    int return_code = 0;
+    if (region.byte_count() < sizeof(s_region_copy))
+    {
+        fprintf(stderr, "The metrics region '%s' is too small.\n", region_name);
+        return_code = 1;
+    }
+
+    while (return_code == 0)
+    {
+        if (!copy_region(region))
+        {
+            fprintf(stderr, "A consistent snapshot of the metrics region can't be copied.\n");
+            return_code = 1;
+            break;
+        }
+
+        const MetricsRegionHeader* header = reinterpret_cast<const MetricsRegionHeader*>(s_region_copy);
+        if (header->magic != MetricsRegionHeader::magic_value || header->version != MetricsRegionHeader::current_version)
+        {
+            fprintf(stderr, "The metrics region '%s' has an unsupported format (version %u).\n", region_name, header->version);
+            return_code = 1;
+            break;
+        }
+        if (header->metric_count > Metrics::maximum_metric_count)
+        {
+            fprintf(stderr, "The metrics region '%s' is corrupted.\n", region_name);
+            return_code = 1;
+            break;
+        }
+
+        print_metrics(*header, reinterpret_cast<const MetricsRegionEntry*>(header + 1));
+        if (refresh_interval_milliseconds == 0)
+            break;
+
+        PlatformCore::sleep_for_nanoseconds(static_cast<u64>(refresh_interval_milliseconds) * 1'000'000);
+    }
+
+    region.close();
+    return return_code;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::metrics_reader_main(argument_count, arguments);
+    return return_code;
+}
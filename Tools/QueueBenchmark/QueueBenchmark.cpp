@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+//
+// Measures the throughput and the handoff latency of the thread-safe queues (`SpscQueue`, `MpscQueue` and `MpmcQueue`)
+// with one producer and one consumer (1P1C), many producers and one consumer (NP1C), and many producers and many
+// consumers (NPNC). Every queue is only measured in the configurations it supports.
+//
+// Usage: QueueBenchmark [thread count]
+// The throughput is measured with the producers pushing as fast as they can. The handoff latency (the time between
+// the push of a message and its pop) is measured separately, with every producer waiting for its previous message to
+// be popped, so that it doesn't include the time spent waiting behind other messages.
+//
+
+#include <Core/Containers/MpmcQueue.h>
+#include <Core/Containers/MpscQueue.h>
+#include <Core/Containers/SpscQueue.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/FastClock.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/HdrHistogram.h>
+#include <Core/Threading/Mutex.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SpinLock.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace CaveGame
+{
+
+static constexpr u32 maximum_thread_count = 64;
+
+// The capacity of the bounded queues, similar to the queues used for job submission.
+static constexpr usize queue_capacity = 1024;
+
+// The number of messages pushed by all the producers together, when measuring the throughput and the latency.
+static constexpr u32 throughput_message_count = 1 << 20;
+static constexpr u32 latency_message_count = 1 << 15;
+
+// The messages that are slower than this are recorded as this value.
+static constexpr u64 highest_trackable_nanoseconds = 10ULL * 1000 * 1000 * 1000;
+
+// The messages are passed by pointer (like jobs or log records), and can also be linked into the intrusive queue.
+struct QueueMessage : public MpscQueueNode
+{
+    u64 push_ticks;
+    u32 producer_index;
+};
+
+#pragma region Queue adapters
+
+// Gives all the queues the same interface: pushes that can fail if the queue is full, and pops that return null if
+// the queue is empty.
+struct SpscQueueAdapter
+{
+    static constexpr const char* name = "SpscQueue";
+
+    SpscQueue<QueueMessage*> queue { queue_capacity };
+
+    NODISCARD ALWAYS_INLINE bool try_push(QueueMessage* message) { return queue.try_push(message); }
+    NODISCARD ALWAYS_INLINE QueueMessage* try_pop()
+    {
+        QueueMessage* message;
+        return queue.try_pop(message) ? message : nullptr;
+    }
+};
+
+struct MpscQueueAdapter
+{
+    static constexpr const char* name = "MpscQueue";
+
+    MpscQueue<QueueMessage> queue;
+
+    // The intrusive queue is unbounded, thus pushing never fails.
+    NODISCARD ALWAYS_INLINE bool try_push(QueueMessage* message)
+    {
+        queue.push(message);
+        return true;
+    }
+    NODISCARD ALWAYS_INLINE QueueMessage* try_pop() { return queue.pop(); }
+};
+
+struct MpmcQueueAdapter
+{
+    static constexpr const char* name = "MpmcQueue";
+
+    MpmcQueue<QueueMessage*> queue { queue_capacity };
+
+    NODISCARD ALWAYS_INLINE bool try_push(QueueMessage* message) { return queue.try_push(message); }
+    NODISCARD ALWAYS_INLINE QueueMessage* try_pop()
+    {
+        QueueMessage* message;
+        return queue.try_pop(message) ? message : nullptr;
+    }
+};
+
+#pragma endregion
+
+// The number of messages of a producer that have been popped, on its own cache line.
+struct alignas(64) ProducerProgress
+{
+    std::atomic<u32> popped_message_count { 0 };
+};
+
+template<typename QueueAdapter>
+struct QueueBenchmarkRun
+{
+    QueueAdapter queue_adapter;
+    u32 producer_count { 0 };
+    u32 consumer_count { 0 };
+    u32 message_count_per_producer { 0 };
+    bool is_measuring_latency { false };
+
+    // Every producer pushes its own range of messages, thus no message is pushed again before it has been popped.
+    QueueMessage* messages { nullptr };
+    ProducerProgress producer_progress[maximum_thread_count];
+
+    // The threads wait until all of them have started, so that they contend from the very first message.
+    std::atomic<u32> ready_thread_count { 0 };
+    std::atomic<bool> is_started { false };
+    alignas(64) std::atomic<u32> popped_message_count { 0 };
+
+    Mutex histogram_mutex;
+    HdrHistogram histogram { highest_trackable_nanoseconds };
+};
+
+template<typename QueueAdapter>
+struct QueueBenchmarkThread
+{
+    QueueBenchmarkRun<QueueAdapter>* run { nullptr };
+    u32 thread_index { 0 };
+    Thread thread;
+};
+
+template<typename QueueAdapter>
+static void wait_for_start(QueueBenchmarkRun<QueueAdapter>& run)
+{
+    run.ready_thread_count.fetch_add(1, std::memory_order_release);
+    while (!run.is_started.load(std::memory_order_acquire))
+        _mm_pause();
+}
+
+template<typename QueueAdapter>
+static void producer_thread_main(void* user_data)
+{
+    const QueueBenchmarkThread<QueueAdapter>* benchmark_thread = static_cast<const QueueBenchmarkThread<QueueAdapter>*>(user_data);
+    QueueBenchmarkRun<QueueAdapter>& run = *benchmark_thread->run;
+    const u32 producer_index = benchmark_thread->thread_index;
+    QueueMessage* messages = run.messages + static_cast<usize>(producer_index) * run.message_count_per_producer;
+    wait_for_start(run);
+
+    SpinBackoff backoff;
+    for (u32 message_index = 0; message_index < run.message_count_per_producer; ++message_index)
+    {
+        // When measuring the latency, only a single message of every producer is in the queue at any given time.
+        if (run.is_measuring_latency)
+        {
+            while (run.producer_progress[producer_index].popped_message_count.load(std::memory_order_acquire) < message_index)
+                backoff.pause();
+            backoff.reset();
+        }
+
+        QueueMessage* message = &messages[message_index];
+        message->producer_index = producer_index;
+        message->push_ticks = FastClock::get_ticks_ordered();
+        while (!run.queue_adapter.try_push(message))
+            backoff.pause();
+        backoff.reset();
+    }
+}
+
+template<typename QueueAdapter>
+static void consumer_thread_main(void* user_data)
+{
+    const QueueBenchmarkThread<QueueAdapter>* benchmark_thread = static_cast<const QueueBenchmarkThread<QueueAdapter>*>(user_data);
+    QueueBenchmarkRun<QueueAdapter>& run = *benchmark_thread->run;
+    const u32 total_message_count = run.producer_count * run.message_count_per_producer;
+    HdrHistogram histogram(highest_trackable_nanoseconds);
+    wait_for_start(run);
+
+    SpinBackoff backoff;
+    while (run.popped_message_count.load(std::memory_order_relaxed) < total_message_count)
+    {
+        QueueMessage* message = run.queue_adapter.try_pop();
+        if (message == nullptr)
+        {
+            backoff.pause();
+            continue;
+        }
+        backoff.reset();
+
+        if (run.is_measuring_latency)
+        {
+            histogram.record(FastClock::ticks_to_nanoseconds(FastClock::get_ticks_ordered() - message->push_ticks));
+            run.producer_progress[message->producer_index].popped_message_count.fetch_add(1, std::memory_order_release);
+        }
+        run.popped_message_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ScopedLock<Mutex> histogram_lock(run.histogram_mutex);
+    run.histogram.add(histogram);
+}
+
+// Passes all the messages through the queue and returns the elapsed time, measured in seconds.
+template<typename QueueAdapter>
+static double run_queue_benchmark(QueueBenchmarkRun<QueueAdapter>& run, u32 message_count)
+{
+    run.message_count_per_producer = message_count / run.producer_count;
+    // NOTE: The nodes of the intrusive queue can't be moved, thus the messages can't be stored in a `Vector`.
+    run.messages = new QueueMessage[static_cast<usize>(run.producer_count) * run.message_count_per_producer];
+
+    const u32 thread_count = run.producer_count + run.consumer_count;
+    QueueBenchmarkThread<QueueAdapter> threads[maximum_thread_count];
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        QueueBenchmarkThread<QueueAdapter>& thread = threads[thread_index];
+        thread.run = &run;
+        if (thread_index < run.producer_count)
+        {
+            thread.thread_index = thread_index;
+            thread.thread.create(producer_thread_main<QueueAdapter>, &thread);
+        }
+        else
+        {
+            thread.thread_index = thread_index - run.producer_count;
+            thread.thread.create(consumer_thread_main<QueueAdapter>, &thread);
+        }
+    }
+
+    while (run.ready_thread_count.load(std::memory_order_acquire) < thread_count)
+        PlatformCore::yield_thread();
+
+    const u64 start_tick = PlatformCore::get_current_tick_counter();
+    run.is_started.store(true, std::memory_order_release);
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        threads[thread_index].thread.join();
+    const u64 elapsed_ticks = PlatformCore::get_current_tick_counter() - start_tick;
+
+    delete[] run.messages;
+    run.messages = nullptr;
+    return static_cast<double>(elapsed_ticks) / static_cast<double>(PlatformCore::get_tick_counter_frequency());
+}
+
+template<typename QueueAdapter>
+static void benchmark_queue(const char* configuration_name, u32 producer_count, u32 consumer_count)
+{
+    QueueBenchmarkRun<QueueAdapter> throughput_run;
+    throughput_run.producer_count = producer_count;
+    throughput_run.consumer_count = consumer_count;
+    const double elapsed_seconds = run_queue_benchmark(throughput_run, throughput_message_count);
+    const double message_count = static_cast<double>(producer_count) * static_cast<double>(throughput_run.message_count_per_producer);
+
+    QueueBenchmarkRun<QueueAdapter> latency_run;
+    latency_run.producer_count = producer_count;
+    latency_run.consumer_count = consumer_count;
+    latency_run.is_measuring_latency = true;
+    run_queue_benchmark(latency_run, latency_message_count);
+    const HdrHistogram& histogram = latency_run.histogram;
+
+    printf(
+        "    %-9s %-4s producers %2u  consumers %2u  %8.2f Mops/s  handoff p50 %7llu ns  p99 %7llu ns  p99.9 %8llu ns  max %9llu ns\n",
+        QueueAdapter::name,
+        configuration_name,
+        producer_count,
+        consumer_count,
+        (elapsed_seconds > 0.0) ? message_count / elapsed_seconds / 1e6 : 0.0,
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(50.0)),
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(99.0)),
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(99.9)),
+        static_cast<unsigned long long>(histogram.get_maximum_value())
+    );
+}
+
+static int queue_benchmark_main(int argument_count, char** arguments)
+{
+    if (!FastClock::initialize())
+        return 1;
+
+    u32 thread_count = Math::min(PlatformCore::get_logical_processor_count(), 8U);
+    if (argument_count >= 2)
+        thread_count = static_cast<u32>(strtoul(arguments[1], nullptr, 10));
+    thread_count = Math::clamp(thread_count, 2U, maximum_thread_count);
+
+    const u32 many_producer_count = thread_count - 1;
+    const u32 half_thread_count = Math::max(thread_count / 2, 1U);
+
+    benchmark_queue<SpscQueueAdapter>("1P1C", 1, 1);
+    benchmark_queue<MpscQueueAdapter>("1P1C", 1, 1);
+    benchmark_queue<MpscQueueAdapter>("NP1C", many_producer_count, 1);
+    benchmark_queue<MpmcQueueAdapter>("1P1C", 1, 1);
+    benchmark_queue<MpmcQueueAdapter>("NP1C", many_producer_count, 1);
+    benchmark_queue<MpmcQueueAdapter>("NPNC", half_thread_count, half_thread_count);
+
+    return 0;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::queue_benchmark_main(argument_count, arguments);
+    return return_code;
+}
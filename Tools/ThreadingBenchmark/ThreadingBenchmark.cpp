@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+//
+// Measures the latency and the throughput of the threading primitives (see `Core/Threading`), both uncontended (a
+// single thread) and contended (all the benchmark threads hammer the same primitive).
+//
+// Usage: ThreadingBenchmark [thread count]
+// Every benchmark runs twice: once untimed to measure the throughput, and once with every operation timed by
+// `FastClock` to measure the latency distribution. The timed operations include the cost of reading the clock (a few
+// nanoseconds), which dominates the latency of the uncontended operations.
+//
+
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/FastClock.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Profiling/HdrHistogram.h>
+#include <Core/Threading/Mutex.h>
+#include <Core/Threading/ReadWriteLock.h>
+#include <Core/Threading/ScopedLock.h>
+#include <Core/Threading/SeqLock.h>
+#include <Core/Threading/SpinLock.h>
+#include <Core/Threading/WaitGroup.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+namespace CaveGame
+{
+
+static constexpr u32 maximum_thread_count = 64;
+
+// The number of operations performed by every thread, in each of the two runs of a benchmark.
+static constexpr u32 iteration_count = 200000;
+
+// The operations that are slower than this are recorded as this value.
+static constexpr u64 highest_trackable_nanoseconds = 10ULL * 1000 * 1000 * 1000;
+
+struct BenchmarkRun
+{
+    void* operation { nullptr };
+    u32 thread_count { 0 };
+    bool is_measuring_latency { false };
+
+    // The threads wait until all of them have started, so that they contend from the very first operation.
+    std::atomic<u32> ready_thread_count { 0 };
+    std::atomic<bool> is_started { false };
+
+    Mutex histogram_mutex;
+    HdrHistogram histogram { highest_trackable_nanoseconds };
+};
+
+struct BenchmarkThread
+{
+    BenchmarkRun* run { nullptr };
+    u32 thread_index { 0 };
+    Thread thread;
+};
+
+template<typename Operation>
+static void benchmark_thread_main(void* user_data)
+{
+    const BenchmarkThread* benchmark_thread = static_cast<const BenchmarkThread*>(user_data);
+    BenchmarkRun& run = *benchmark_thread->run;
+    Operation& operation = *static_cast<Operation*>(run.operation);
+    const u32 thread_index = benchmark_thread->thread_index;
+
+    run.ready_thread_count.fetch_add(1, std::memory_order_release);
+    while (!run.is_started.load(std::memory_order_acquire))
+        _mm_pause();
+
+    if (!run.is_measuring_latency)
+    {
+        for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+            operation(thread_index, iteration_index);
+        return;
+    }
+
+    HdrHistogram histogram(highest_trackable_nanoseconds);
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        const u64 start_ticks = FastClock::get_ticks_ordered();
+        operation(thread_index, iteration_index);
+        histogram.record(FastClock::ticks_to_nanoseconds(FastClock::get_ticks_ordered() - start_ticks));
+    }
+
+    ScopedLock<Mutex> histogram_lock(run.histogram_mutex);
+    run.histogram.add(histogram);
+}
+
+// Executes the operation `iteration_count` times on every thread and returns the elapsed time, measured in seconds.
+template<typename Operation>
+static double run_benchmark(BenchmarkRun& run, Operation& operation)
+{
+    run.operation = &operation;
+
+    BenchmarkThread threads[maximum_thread_count];
+    for (u32 thread_index = 0; thread_index < run.thread_count; ++thread_index)
+    {
+        threads[thread_index].run = &run;
+        threads[thread_index].thread_index = thread_index;
+        threads[thread_index].thread.create(benchmark_thread_main<Operation>, &threads[thread_index]);
+    }
+
+    while (run.ready_thread_count.load(std::memory_order_acquire) < run.thread_count)
+        PlatformCore::yield_thread();
+
+    const u64 start_tick = PlatformCore::get_current_tick_counter();
+    run.is_started.store(true, std::memory_order_release);
+    for (u32 thread_index = 0; thread_index < run.thread_count; ++thread_index)
+        threads[thread_index].thread.join();
+    const u64 elapsed_ticks = PlatformCore::get_current_tick_counter() - start_tick;
+
+    return static_cast<double>(elapsed_ticks) / static_cast<double>(PlatformCore::get_tick_counter_frequency());
+}
+
+template<typename Operation>
+static void benchmark(const char* name, u32 thread_count, Operation operation)
+{
+    BenchmarkRun throughput_run;
+    throughput_run.thread_count = thread_count;
+    const double elapsed_seconds = run_benchmark(throughput_run, operation);
+    const double operation_count = static_cast<double>(thread_count) * static_cast<double>(iteration_count);
+
+    BenchmarkRun latency_run;
+    latency_run.thread_count = thread_count;
+    latency_run.is_measuring_latency = true;
+    run_benchmark(latency_run, operation);
+    const HdrHistogram& histogram = latency_run.histogram;
+
+    printf(
+        "    %-30s threads %2u  %9.2f Mops/s  p50 %7llu ns  p99 %7llu ns  p99.9 %8llu ns  max %9llu ns\n",
+        name,
+        thread_count,
+        (elapsed_seconds > 0.0) ? operation_count / elapsed_seconds / 1e6 : 0.0,
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(50.0)),
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(99.0)),
+        static_cast<unsigned long long>(histogram.get_value_at_percentile(99.9)),
+        static_cast<unsigned long long>(histogram.get_maximum_value())
+    );
+}
+
+// The data protected by the locks. Every critical section reads and modifies it, like a typical short critical section.
+struct alignas(64) SharedCounter
+{
+    u64 value { 0 };
+};
+
+// A small snapshot, similar to the camera transform published through a sequence lock.
+struct Snapshot
+{
+    float position[3];
+    float rotation[4];
+    u64 frame_index;
+};
+
+template<typename LockType>
+static void benchmark_exclusive_lock(const char* name, u32 thread_count)
+{
+    alignas(64) LockType lock;
+    SharedCounter counter;
+    benchmark(name, thread_count, [&](u32, u32) {
+        lock.lock();
+        ++counter.value;
+        lock.unlock();
+    });
+}
+
+static void benchmark_read_write_lock(u32 thread_count)
+{
+    ReadWriteLock lock;
+    SharedCounter counter;
+
+    benchmark("ReadWriteLock (read)", thread_count, [&](u32, u32) {
+        ScopedReadLock read_lock(lock);
+        MAYBE_UNUSED volatile u64 value = counter.value;
+    });
+    benchmark("ReadWriteLock (write)", thread_count, [&](u32, u32) {
+        ScopedWriteLock write_lock(lock);
+        ++counter.value;
+    });
+    // The expected usage: one write for every thousand reads.
+    benchmark("ReadWriteLock (read-mostly)", thread_count, [&](u32, u32 iteration_index) {
+        if (iteration_index % 1000 == 0)
+        {
+            ScopedWriteLock write_lock(lock);
+            ++counter.value;
+        }
+        else
+        {
+            ScopedReadLock read_lock(lock);
+            MAYBE_UNUSED volatile u64 value = counter.value;
+        }
+    });
+}
+
+static void benchmark_seq_lock(u32 thread_count)
+{
+    SeqLock<Snapshot> seq_lock(Snapshot {});
+
+    if (thread_count == 1)
+    {
+        benchmark("SeqLock (store)", 1, [&](u32, u32 iteration_index) {
+            Snapshot snapshot = {};
+            snapshot.frame_index = iteration_index;
+            seq_lock.store(snapshot);
+        });
+        benchmark("SeqLock (load)", 1, [&](u32, u32) { MAYBE_UNUSED volatile u64 frame_index = seq_lock.load().frame_index; });
+        return;
+    }
+
+    // The first thread is the only writer, as the sequence lock doesn't support concurrent writers.
+    benchmark("SeqLock (1 writer, N readers)", thread_count, [&](u32 thread_index, u32 iteration_index) {
+        if (thread_index == 0)
+        {
+            Snapshot snapshot = {};
+            snapshot.frame_index = iteration_index;
+            seq_lock.store(snapshot);
+        }
+        else
+        {
+            MAYBE_UNUSED volatile u64 frame_index = seq_lock.load().frame_index;
+        }
+    });
+}
+
+static void benchmark_wait_group(u32 thread_count)
+{
+    WaitGroup wait_group;
+    if (thread_count == 1)
+    {
+        benchmark("WaitGroup (add, done, wait)", 1, [&](u32, u32) {
+            wait_group.add();
+            wait_group.done();
+            wait_group.wait();
+        });
+        return;
+    }
+
+    benchmark("WaitGroup (add, done)", thread_count, [&](u32, u32) {
+        wait_group.add();
+        wait_group.done();
+    });
+}
+
+// Two threads pass the turn back and forth, so every operation is a wake-up of the other thread.
+static void benchmark_condition_handoff()
+{
+    Mutex mutex;
+    Condition condition;
+    u32 turn_thread_index = 0;
+
+    benchmark("Condition (handoff)", 2, [&](u32 thread_index, u32) {
+        {
+            ScopedLock<Mutex> lock(mutex);
+            condition.wait(mutex, [&]() { return (turn_thread_index == thread_index); });
+            turn_thread_index = 1 - thread_index;
+        }
+        condition.notify_one();
+    });
+}
+
+static int threading_benchmark_main(int argument_count, char** arguments)
+{
+    if (!FastClock::initialize())
+        return 1;
+
+    u32 thread_count = Math::min(PlatformCore::get_logical_processor_count(), 8U);
+    if (argument_count >= 2)
+        thread_count = static_cast<u32>(strtoul(arguments[1], nullptr, 10));
+    thread_count = Math::clamp(thread_count, 2U, maximum_thread_count);
+
+    printf("Uncontended:\n");
+    benchmark_exclusive_lock<SpinLock>("SpinLock", 1);
+    benchmark_exclusive_lock<Mutex>("Mutex", 1);
+    benchmark_exclusive_lock<std::mutex>("std::mutex", 1);
+    benchmark_read_write_lock(1);
+    benchmark_seq_lock(1);
+    benchmark_wait_group(1);
+
+    printf("Contended:\n");
+    benchmark_exclusive_lock<SpinLock>("SpinLock", thread_count);
+    benchmark_exclusive_lock<Mutex>("Mutex", thread_count);
+    benchmark_exclusive_lock<std::mutex>("std::mutex", thread_count);
+    benchmark_read_write_lock(thread_count);
+    benchmark_seq_lock(thread_count);
+    benchmark_wait_group(thread_count);
+    benchmark_condition_handoff();
+
+    return 0;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::threading_benchmark_main(argument_count, arguments);
+    return return_code;
+}